@@ -1,6 +1,7 @@
 #include <Arduino.h>
 #include <SHA512.h>
 #include "CryptnoxWallet.h"
+#include "Trace.h"
 
 #define RESPONSE_GETCARDCERTIFICATE_IN_BYTES    148
 #define RESPONSE_SELECT_IN_BYTES                 26
@@ -21,7 +22,8 @@
  * - If ISO-DEP card detected → select app, request certificate, open secure channel.
  * - Otherwise → try reading UID of simple NFC tag.
  */
-bool CryptnoxWallet::processCard() {
+bool CryptnoxWallet::processCard(CryptnoxSessionKeys* keys) {
+    TRACE_SCOPE("processCard", "wallet");
     bool ret = false;
     /* Local response buffer */
     uint8_t cardCertificate[GETCARDCERTIFICATE_IN_BYTES];
@@ -35,15 +37,23 @@ bool CryptnoxWallet::processCard() {
     uint8_t cardEphemeralPubKey[CARDEPHEMERALPUBKEY_SIZE];
 
     /* Check for ISO-DEP capable target (APDU-capable card) */
-    if (driver.inListPassiveTarget()) {
+    bool listed;
+    {
+        TRACE_SCOPE("inListPassiveTarget", "pn532");
+        listed = driver.inListPassiveTarget();
+    }
+    if (listed) {
         /* Try selecting Cryptnox app */
         if (selectApdu()) {
-            /* Get certificate and establish secure channel */
-            getCardCertificate(cardCertificate, cardCertificateLength);
-            extractCardEphemeralKey(cardCertificate, cardEphemeralPubKey);
-            openSecureChannel(openSecureChannelSalt, clientPublicKey, clientPrivateKey, sessionCurve);
-            mutuallyAuthenticate(openSecureChannelSalt, clientPublicKey, clientPrivateKey, sessionCurve, cardEphemeralPubKey);
-            ret = true;
+            /* Get certificate and establish secure channel; each step needs the previous one */
+            ret = getCardCertificate(cardCertificate, cardCertificateLength) &&
+                  extractCardEphemeralKey(cardCertificate, cardEphemeralPubKey) &&
+                  openSecureChannel(openSecureChannelSalt, clientPublicKey, clientPrivateKey, sessionCurve) &&
+                  mutuallyAuthenticate(openSecureChannelSalt, clientPublicKey, clientPrivateKey, sessionCurve, cardEphemeralPubKey);
+            if ((ret != false) && (keys != nullptr)) {
+                memcpy(keys->cardEphemeralPubKey, cardEphemeralPubKey, CARDEPHEMERALPUBKEY_SIZE);
+                memcpy(keys->clientPublicKey, clientPublicKey, CLIENT_PUBLIC_KEY_SIZE);
+            }
         }
     }
     else {
@@ -51,13 +61,13 @@ bool CryptnoxWallet::processCard() {
         uint8_t uid[7];
         uint8_t uidLength;
         if (driver.readUID(uid, uidLength)) {
-            Serial.print(F("Card UID: "));
+            CRYPTNOX_LOG.print(F("Card UID: "));
             for (uint8_t i = 0; i < uidLength; i++) {
-                if (uid[i] < 16) Serial.print(F("0"));
-                Serial.print(uid[i], HEX);
-                Serial.print(F(" "));
+                if (uid[i] < 16) CRYPTNOX_LOG.print(F("0"));
+                CRYPTNOX_LOG.print(uid[i], HEX);
+                CRYPTNOX_LOG.print(F(" "));
             }
-            Serial.println();
+            CRYPTNOX_LOG.println();
         }
     }
 
@@ -76,6 +86,7 @@ bool CryptnoxWallet::printPN532FirmwareVersion() {
 
 /* SELECT APDU to activate Cryptnox application */
 bool CryptnoxWallet::selectApdu() {
+    TRACE_SCOPE("selectApdu", "wallet");
     bool ret = false;
 
     /* Application AID selection command */
@@ -95,18 +106,18 @@ bool CryptnoxWallet::selectApdu() {
     uint8_t response[RESPONSE_SELECT_IN_BYTES];
     uint8_t responseLength = sizeof(response);
 
-    Serial.println(F("Sending Select APDU..."));
+    CRYPTNOX_LOG.println(F("Sending Select APDU..."));
 
     /* Send SELECT command */
     if (driver.sendAPDU(selectApdu, sizeof(selectApdu), response, responseLength)) {
         if (checkStatusWord(response,responseLength, 0x90, 0x00)) {
-            Serial.println(F("APDU exchange successful!"));
+            CRYPTNOX_LOG.println(F("APDU exchange successful!"));
             ret = true;
         } else {
-            Serial.println(F("APDU SW1/SW2 not expected. Error."));
+            CRYPTNOX_LOG.println(F("APDU SW1/SW2 not expected. Error."));
         }
     } else {
-        Serial.println(F("APDU select failed."));
+        CRYPTNOX_LOG.println(F("APDU select failed."));
     }
 
     return ret;
@@ -130,6 +141,7 @@ bool CryptnoxWallet::selectApdu() {
  * @return true if the APDU exchange and key extraction succeeded, false otherwise.
  */
 bool CryptnoxWallet::getCardCertificate(uint8_t* cardCertificate, uint8_t &cardCertificateLength) {
+    TRACE_SCOPE("getCardCertificate", "wallet");
     bool ret = false;
     uint8_t getCardCertificateResponse[RESPONSE_GETCARDCERTIFICATE_IN_BYTES];
     uint8_t getCardCertificateResponseLength = sizeof(getCardCertificateResponse);
@@ -156,7 +168,7 @@ bool CryptnoxWallet::getCardCertificate(uint8_t* cardCertificate, uint8_t &cardC
         /* Print APDU */
         printApdu(fullApdu, sizeof(fullApdu));
 
-        Serial.println(F("Sending getCardCertificate APDU..."));
+        CRYPTNOX_LOG.println(F("Sending getCardCertificate APDU..."));
 
         /* Send APDU */
         if (driver.sendAPDU(fullApdu, sizeof(fullApdu), getCardCertificateResponse, getCardCertificateResponseLength)) {
@@ -167,13 +179,13 @@ bool CryptnoxWallet::getCardCertificate(uint8_t* cardCertificate, uint8_t &cardC
                 /* Copy only the useful data (the salt) into the buffer */
                 memcpy(cardCertificate, getCardCertificateResponse, cardCertificateLength);
 
-                Serial.println(F("APDU exchange successful!"));    
+                CRYPTNOX_LOG.println(F("APDU exchange successful!"));    
                 ret = true;
             } else {
-                Serial.println(F("APDU SW1/SW2 not expected. Error."));
+                CRYPTNOX_LOG.println(F("APDU SW1/SW2 not expected. Error."));
             }
         } else {
-            Serial.println(F("APDU getCardCertificate failed."));
+            CRYPTNOX_LOG.println(F("APDU getCardCertificate failed."));
         }
     }
     
@@ -193,17 +205,22 @@ bool CryptnoxWallet::getCardCertificate(uint8_t* cardCertificate, uint8_t &cardC
  * @return true if the APDU exchange succeeded and the salt was retrieved, false otherwise.
  */
 bool CryptnoxWallet::openSecureChannel(uint8_t* salt, uint8_t* clientPublicKey, uint8_t* clientPrivateKey, const uECC_Curve_t* sessionCurve) {
+    TRACE_SCOPE("openSecureChannel", "wallet");
     bool ret = false;
 
     /* ECC setup and random generation */
     uECC_set_rng(&uECC_RNG);
 
     /* Generate keypair */
-    bool eccSuccess = uECC_make_key(clientPublicKey, clientPrivateKey, sessionCurve);
+    bool eccSuccess;
+    {
+        TRACE_SCOPE("uECC_make_key", "crypto");
+        eccSuccess = uECC_make_key(clientPublicKey, clientPrivateKey, sessionCurve);
+    }
 
     /* Abort if ECC fails */
     if (!eccSuccess) {
-        Serial.println(F("ECC key generation failed."));
+        CRYPTNOX_LOG.println(F("ECC key generation failed."));
     }
     else {
         /* APDU header for OPEN SECURE CHANNEL */
@@ -228,7 +245,7 @@ bool CryptnoxWallet::openSecureChannel(uint8_t* salt, uint8_t* clientPublicKey,
         /* Print APDU */
         printApdu(fullApdu, sizeof(fullApdu));
 
-        Serial.println(F("Sending OpenSecureChannel APDU..."));
+        CRYPTNOX_LOG.println(F("Sending OpenSecureChannel APDU..."));
 
         /* Send OPC request */
         if (driver.sendAPDU(fullApdu, sizeof(fullApdu), response, responseLength)) {
@@ -240,17 +257,17 @@ bool CryptnoxWallet::openSecureChannel(uint8_t* salt, uint8_t* clientPublicKey,
                     /* Copy only the useful data (the salt) into the buffer */
                     memcpy(salt, response, dataLength);
 
-                    Serial.println(F("APDU exchange successful!"));    
+                    CRYPTNOX_LOG.println(F("APDU exchange successful!"));    
                     ret = true;
                 } 
                 else {
-                    Serial.println(F("Unexpected response size."));
+                    CRYPTNOX_LOG.println(F("Unexpected response size."));
                 }
             } else {
-                Serial.println(F("APDU SW1/SW2 not expected. Error."));
+                CRYPTNOX_LOG.println(F("APDU SW1/SW2 not expected. Error."));
             }
         } else {
-            Serial.println(F("APDU exchange failed."));
+            CRYPTNOX_LOG.println(F("APDU exchange failed."));
         }
     }
 
@@ -271,6 +288,7 @@ bool CryptnoxWallet::openSecureChannel(uint8_t* salt, uint8_t* clientPublicKey,
  * @return true if the shared secret was successfully generated, false otherwise.
  */
 bool CryptnoxWallet::mutuallyAuthenticate(uint8_t* salt, uint8_t* clientPublicKey, uint8_t* clientPrivateKey, const uECC_Curve_t* sessionCurve, uint8_t* cardEphemeralPubKey) {
+    TRACE_SCOPE("mutuallyAuthenticate", "wallet");
     bool ret = false;
     uint8_t sharedSecret[32];
     uint8_t concat[32 + sizeof(COMMON_PAIRING_DATA) - 1 + 32]; /* sharedSecret || pairingKey || salt */
@@ -281,12 +299,17 @@ bool CryptnoxWallet::mutuallyAuthenticate(uint8_t* salt, uint8_t* clientPublicKe
     size_t concatLen;
 
     /* Generate ECDH shared secret */
-    if (uECC_shared_secret(cardEphemeralPubKey, clientPrivateKey, sharedSecret, sessionCurve) == 0) {
-        Serial.println(F("ECDH shared secret generation failed!"));
+    int eccResult;
+    {
+        TRACE_SCOPE("uECC_shared_secret", "crypto");
+        eccResult = uECC_shared_secret(cardEphemeralPubKey, clientPrivateKey, sharedSecret, sessionCurve);
+    }
+    if (eccResult == 0) {
+        CRYPTNOX_LOG.println(F("ECDH shared secret generation failed!"));
         return false;
     }
     else {
-        Serial.println(F("ECDH shared secret generated."));
+        CRYPTNOX_LOG.println(F("ECDH shared secret generated."));
 
         /* Concatenate sharedSecret, pairingKey, and salt */
         pairingKeyLen = sizeof(COMMON_PAIRING_DATA) - 1U; /* exclude null terminator */
@@ -297,17 +320,20 @@ bool CryptnoxWallet::mutuallyAuthenticate(uint8_t* salt, uint8_t* clientPublicKe
         memcpy(concat + 32U + pairingKeyLen, salt, 32U); /* copy salt */
 
         /* Calculate SHA-512 over concatenated buffer */
-        SHA512 sha;
-        sha.update(concat, concatLen);
-        sha.finalize(sha512Output, sizeof(sha512Output));
+        {
+            TRACE_SCOPE("SHA512", "crypto");
+            SHA512 sha;
+            sha.update(concat, concatLen);
+            sha.finalize(sha512Output, sizeof(sha512Output));
+        }
 
-        Serial.println(F("SHA-512 calculated."));
+        CRYPTNOX_LOG.println(F("SHA-512 calculated."));
 
         /* Split SHA-512 output into Kenc and Kmac */
         memcpy(Kenc, sha512Output, 32U);       /* first 32 bytes for encryption key */
         memcpy(Kmac, sha512Output + 32U, 32U); /* last 32 bytes for MAC key */
 
-        Serial.println(F("Kenc and Kmac derived."));
+        CRYPTNOX_LOG.println(F("Kenc and Kmac derived."));
 
         ret = true;
     }
@@ -349,20 +375,20 @@ int CryptnoxWallet::uECC_RNG(uint8_t *dest, unsigned size) {
  * @param label Optional label to prepend (default: "APDU to send").
  */
 void CryptnoxWallet::printApdu(const uint8_t* apdu, uint8_t length, const char* label) {
-    Serial.print(label);
-    Serial.print(F(": "));
-    Serial.println();
+    CRYPTNOX_LOG.print(label);
+    CRYPTNOX_LOG.print(F(": "));
+    CRYPTNOX_LOG.println();
     for (uint8_t i = 0; i < length; i++) {
-        if (apdu[i] < 16) Serial.print("0");
-        Serial.print("0x");
-        Serial.print(apdu[i], HEX);
-        Serial.print(" ");
+        if (apdu[i] < 16) CRYPTNOX_LOG.print("0");
+        CRYPTNOX_LOG.print("0x");
+        CRYPTNOX_LOG.print(apdu[i], HEX);
+        CRYPTNOX_LOG.print(" ");
         
         /* Wrap line every 16 bytes */
-        if ((i + 1) % 16 == 0 && (i + 1) != length) Serial.println();
+        if ((i + 1) % 16 == 0 && (i + 1) != length) CRYPTNOX_LOG.println();
     }
     
-    Serial.println();
+    CRYPTNOX_LOG.println();
 }
 
 /**
@@ -378,21 +404,21 @@ bool CryptnoxWallet::checkStatusWord(const uint8_t* response, uint8_t responseLe
     bool ret = false;
 
     if (response == nullptr || responseLength < 2) {
-        Serial.println(F("checkStatusWord: response too short."));
+        CRYPTNOX_LOG.println(F("checkStatusWord: response too short."));
         ret = false;
     }
     else {
         uint8_t sw1 = response[responseLength - 2];
         uint8_t sw2 = response[responseLength - 1];
 
-        Serial.print(F("Received SW1/SW2: "));
-        Serial.print(F("0x"));
-        if (sw1 < 16) Serial.print("0");
-        Serial.print(sw1, HEX);
-        Serial.print(F(" "));
-        Serial.print(F("0x"));
-        if (sw2 < 16) Serial.print("0");
-        Serial.println(sw2, HEX);
+        CRYPTNOX_LOG.print(F("Received SW1/SW2: "));
+        CRYPTNOX_LOG.print(F("0x"));
+        if (sw1 < 16) CRYPTNOX_LOG.print("0");
+        CRYPTNOX_LOG.print(sw1, HEX);
+        CRYPTNOX_LOG.print(F(" "));
+        CRYPTNOX_LOG.print(F("0x"));
+        if (sw2 < 16) CRYPTNOX_LOG.print("0");
+        CRYPTNOX_LOG.println(sw2, HEX);
 
         if ((sw1 == sw1Expected) && (sw2 == sw2Expected)) {
             ret = true;
@@ -421,12 +447,14 @@ bool CryptnoxWallet::checkStatusWord(const uint8_t* response, uint8_t responseLe
  *                                    for use with uECC_shared_secret. Must be at least 64 bytes.
  * @param[out] fullEphemeralPubKey65  Optional buffer to store **65 bytes** including the 0x04 prefix.
  *                                    Can be nullptr if not needed.
+ * @return true if the key was extracted, false on a null buffer.
  */
 bool CryptnoxWallet::extractCardEphemeralKey(const uint8_t* cardCertificate, uint8_t* cardEphemeralPubKey, uint8_t* fullEphemeralPubKey65) {
+    TRACE_SCOPE("extractCardEphemeralKey", "wallet");
     bool ret = false;
 
-    Serial.print(F("Full Ephemeral Public Key (65 bytes):"));
-    Serial.println();
+    CRYPTNOX_LOG.print(F("Full Ephemeral Public Key (65 bytes):"));
+    CRYPTNOX_LOG.println();
     if ((cardCertificate == nullptr) || (cardEphemeralPubKey == nullptr)) {
         ret = false; // invalid input
     }
@@ -449,18 +477,19 @@ bool CryptnoxWallet::extractCardEphemeralKey(const uint8_t* cardCertificate, uin
             }
 
             /* Print hex to Serial for debugging */
-            Serial.print("0x");
+            CRYPTNOX_LOG.print("0x");
             if (b < 0x10u) {
-                Serial.print('0');
+                CRYPTNOX_LOG.print('0');
             }
-            Serial.print(b, HEX);
-            Serial.print(' ');
+            CRYPTNOX_LOG.print(b, HEX);
+            CRYPTNOX_LOG.print(' ');
 
             /* Wrap line every 16 bytes */
-            if ((i + 1) % 16 == 0 && (i + 1) != fullKeyLength) Serial.println();
+            if ((i + 1) % 16 == 0 && (i + 1) != fullKeyLength) CRYPTNOX_LOG.println();
         }
 
-        Serial.println();
+        CRYPTNOX_LOG.println();
+        ret = true;
     }
 
     return ret;
@@ -5,6 +5,14 @@
 #include <Arduino.h>
 #include "uECC.h"
 
+/**
+ * @brief Public keys of the secure channel opened during a card tap.
+ */
+struct CryptnoxSessionKeys {
+    uint8_t cardEphemeralPubKey[64]; /**< Card's ephemeral EC P-256 key, X||Y */
+    uint8_t clientPublicKey[64];     /**< Reader's session EC P-256 key, X||Y */
+};
+
 /**
  * @class CryptnoxWallet
  * @brief High-level interface for interacting with a PN532-based wallet.
@@ -69,12 +77,16 @@ public:
     /**
      * @brief Detect and process an NFC card for Cryptnox wallet operations.
      *
-     * If an ISO-DEP card is detected, SELECT APDU is sent and certificate is retrieved.
+     * If an ISO-DEP card is detected, SELECT APDU is sent, the certificate is
+     * retrieved and the secure channel is opened.
      * If only a passive card is detected, the UID is printed.
      *
-     * @return true if a card was successfully processed, false otherwise.
+     * @param[out] keys Optional, receives the public keys of the secure
+     *             channel. Only written when the function returns true.
+     * @return true if the secure channel with a wallet card was opened,
+     *         false otherwise.
      */
-    bool processCard();
+    bool processCard(CryptnoxSessionKeys* keys = nullptr);
 
     /**
      * @brief Send the SELECT APDU to select the wallet application.
@@ -114,6 +126,27 @@ public:
     */
     bool printPN532FirmwareVersion();
 
+    /**
+     * @brief Read the raw PN532 firmware version word without printing it.
+     *
+     * @param[out] version Firmware version as returned by the PN532.
+     * @return true if the PN532 answered, false otherwise.
+     */
+    bool getFirmwareVersion(uint32_t &version) {
+        return driver.getFirmwareVersion(version);
+    }
+
+    /**
+     * @brief Write the reader's APDU statistics snapshot.
+     *
+     * @param[out] buffer Destination, at least PN532_STATS_SNAPSHOT_SIZE bytes.
+     * @param size Size of buffer in bytes.
+     * @return Number of bytes written, 0 if buffer is too small.
+     */
+    size_t serializeStats(uint8_t* buffer, size_t size) const {
+        return driver.serializeStats(buffer, size);
+    }
+
     /**
     * @brief Retrieves the initial 32-byte salt from the card for starting a secure channel.
     *
@@ -135,6 +168,7 @@ public:
     *                                    for use with uECC_shared_secret. Must be at least 64 bytes.
     * @param[out] fullEphemeralPubKey65  Optional buffer to store **65 bytes** including the 0x04 prefix.
     *                                    Can be nullptr if not needed.
+    * @return true if the key was extracted, false on a null buffer.
     */
     bool extractCardEphemeralKey(const uint8_t* cardCertificate, uint8_t* cardEphemeralPubKey, uint8_t* fullEphemeralPubKey65 = nullptr);
 
@@ -0,0 +1,112 @@
+#include "HostBridge.h"
+
+/**
+ * @brief Store a 32-bit value little-endian.
+ *
+ * @param out Destination, 4 bytes.
+ * @param value Value to store.
+ */
+static void putU32(uint8_t* out, uint32_t value) {
+    out[0] = (uint8_t)(value & 0xFFU);
+    out[1] = (uint8_t)((value >> 8U) & 0xFFU);
+    out[2] = (uint8_t)((value >> 16U) & 0xFFU);
+    out[3] = (uint8_t)((value >> 24U) & 0xFFU);
+}
+
+void HostBridge::poll(void) {
+    while (port.available() > 0) {
+        int c = port.read();
+        if (c < 0) {
+            break;
+        }
+
+        if (c != 0) {
+            if (rxLength < sizeof(rxBuffer)) {
+                rxBuffer[rxLength] = (uint8_t)c;
+                rxLength++;
+            } else {
+                rxOverflow = true;
+            }
+            continue;
+        }
+
+        /* Delimiter: the frame is complete unless it overflowed */
+        if ((rxOverflow == false) && (rxLength > 0U)) {
+            uint8_t frame[HOSTBRIDGE_MAX_ENCODED];
+            size_t length = hostBridgeParseFrame(rxBuffer, rxLength, frame);
+            if (length >= 2U) {
+                handleFrame(frame, length);
+            }
+        }
+        rxLength = 0U;
+        rxOverflow = false;
+    }
+}
+
+void HostBridge::handleFrame(const uint8_t* frame, size_t length) {
+    uint8_t type = frame[0];
+    uint8_t seq = frame[1];
+    size_t payloadLength = length - 2U;
+    uint8_t response[HOSTBRIDGE_MAX_PAYLOAD];
+    size_t responseLength = 1U;
+
+    if ((type & HOSTBRIDGE_RESPONSE) != 0U) {
+        /* Responses never travel host to reader; ignore rather than echo */
+        return;
+    }
+
+    switch (type) {
+    case HOSTBRIDGE_CMD_INFO: {
+        uint32_t version = 0U;
+        if (payloadLength != 0U) {
+            response[0] = HOSTBRIDGE_STATUS_BAD_REQUEST;
+            break;
+        }
+        response[0] = (wallet.getFirmwareVersion(version) != false) ?
+                      HOSTBRIDGE_STATUS_OK : HOSTBRIDGE_STATUS_FAILED;
+        putU32(&response[1], version);
+        responseLength = 5U + wallet.serializeStats(&response[5],
+                                                    sizeof(response) - 5U);
+        break;
+    }
+
+    case HOSTBRIDGE_CMD_TAP: {
+        CryptnoxSessionKeys keys;
+        uint32_t start;
+        bool ok;
+        if (payloadLength != 0U) {
+            response[0] = HOSTBRIDGE_STATUS_BAD_REQUEST;
+            break;
+        }
+        start = micros();
+        ok = wallet.processCard(&keys);
+        response[0] = (ok != false) ? HOSTBRIDGE_STATUS_OK : HOSTBRIDGE_STATUS_FAILED;
+        putU32(&response[1], micros() - start);
+        responseLength = 5U;
+        if (ok != false) {
+            memcpy(&response[5], keys.cardEphemeralPubKey, HOSTBRIDGE_KEY_SIZE);
+            memcpy(&response[5U + HOSTBRIDGE_KEY_SIZE], keys.clientPublicKey,
+                   HOSTBRIDGE_KEY_SIZE);
+            responseLength += 2U * HOSTBRIDGE_KEY_SIZE;
+        }
+        break;
+    }
+
+    case HOSTBRIDGE_CMD_SIGN:
+        /* The wallet does not expose signing yet; keep the command number reserved */
+    default:
+        response[0] = HOSTBRIDGE_STATUS_UNSUPPORTED;
+        break;
+    }
+
+    sendResponse(type, seq, response, responseLength);
+}
+
+void HostBridge::sendResponse(uint8_t type, uint8_t seq, const uint8_t* payload, size_t length) {
+    uint8_t encoded[HOSTBRIDGE_MAX_ENCODED + 1U];
+    size_t n = hostBridgeBuildFrame((uint8_t)(type | HOSTBRIDGE_RESPONSE), seq,
+                                    payload, length, encoded);
+    if (n > 0U) {
+        (void)port.write(encoded, n);
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef HOSTBRIDGE_H
+#define HOSTBRIDGE_H
+
+#include <Arduino.h>
+#include "CryptnoxWallet.h"
+#include "HostBridgeProtocol.h"
+
+/**
+ * @class HostBridge
+ * @brief Serves HostBridgeProtocol requests from a host over a Stream.
+ *
+ * Call poll() from loop(). Bytes are collected until a 0x00 delimiter, then
+ * the frame is checked and dispatched; frames with a bad CRC or length are
+ * dropped silently and the host retries on timeout. Every accepted request
+ * gets exactly one response carrying the request's seq.
+ *
+ * Build with CRYPTNOX_HOST_BRIDGE so the SDK's text output does not share
+ * the port with the binary frames.
+ */
+class HostBridge {
+public:
+    /**
+     * @brief Construct a bridge.
+     *
+     * @param port Stream carrying the frames (usually Serial).
+     * @param wallet Wallet that executes the requests.
+     */
+    HostBridge(Stream &port, CryptnoxWallet &wallet)
+        : port(port), wallet(wallet), rxLength(0U), rxOverflow(false) {}
+
+    /**
+     * @brief Read pending bytes and handle any complete request.
+     */
+    void poll(void);
+
+private:
+    Stream &port;            /**< Link to the host */
+    CryptnoxWallet &wallet;  /**< Executes the requests */
+    uint8_t rxBuffer[HOSTBRIDGE_MAX_ENCODED]; /**< Encoded bytes of the frame being received */
+    size_t rxLength;         /**< Bytes held in rxBuffer */
+    bool rxOverflow;         /**< Current frame is too long and will be dropped */
+
+    /**
+     * @brief Dispatch one decoded request.
+     *
+     * @param frame Decoded type, seq and payload.
+     * @param length Length of type + seq + payload.
+     */
+    void handleFrame(const uint8_t* frame, size_t length);
+
+    /**
+     * @brief Send a response frame.
+     *
+     * @param type Request type; HOSTBRIDGE_RESPONSE is added.
+     * @param seq Sequence number of the request.
+     * @param payload Response payload, starting with the status byte.
+     * @param length Payload length.
+     */
+    void sendResponse(uint8_t type, uint8_t seq, const uint8_t* payload, size_t length);
+};
+
+#endif // HOSTBRIDGE_H
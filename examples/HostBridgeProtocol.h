@@ -0,0 +1,190 @@
+#ifndef HOSTBRIDGEPROTOCOL_H
+#define HOSTBRIDGEPROTOCOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file HostBridgeProtocol.h
+ * @brief Binary framing shared by the reader firmware and host tools.
+ *
+ * Every message is
+ *
+ *     type (1) | seq (1) | payload (0..HOSTBRIDGE_MAX_PAYLOAD) | CRC-16 (2, LE)
+ *
+ * COBS-encoded and terminated by a single 0x00 byte. The CRC is
+ * CRC-16/CCITT-FALSE over type, seq and payload. Requests use the
+ * HOSTBRIDGE_CMD_* types; the reader answers each one with the same type
+ * ORed with HOSTBRIDGE_RESPONSE and the same seq, payload starting with a
+ * HOSTBRIDGE_STATUS_* byte. Requests are handled in order, so a host may
+ * send several before reading the answers.
+ *
+ * Response payloads after the status byte:
+ *
+ *     INFO  firmware version (4, LE) | APDU statistics snapshot
+ *     TAP   duration in us (4, LE) | card ephemeral key (64) |
+ *           session public key (64)
+ *
+ * The TAP keys are X||Y of the secure channel's EC P-256 public keys and
+ * are only present with HOSTBRIDGE_STATUS_OK.
+ *
+ * This header has no Arduino dependency so host code can include it as is.
+ */
+
+#define HOSTBRIDGE_MAX_PAYLOAD  (136U) /**< Largest payload in bytes */
+#define HOSTBRIDGE_MAX_FRAME    (HOSTBRIDGE_MAX_PAYLOAD + 4U) /**< Decoded frame size */
+#define HOSTBRIDGE_MAX_ENCODED  (HOSTBRIDGE_MAX_FRAME + 2U) /**< COBS-encoded frame size, without delimiter */
+
+#define HOSTBRIDGE_CMD_INFO     (0x01U) /**< Reader firmware version and APDU statistics */
+#define HOSTBRIDGE_CMD_TAP      (0x02U) /**< Process one card tap */
+#define HOSTBRIDGE_CMD_SIGN     (0x03U) /**< Sign a digest with the card */
+#define HOSTBRIDGE_RESPONSE     (0x80U) /**< Set in the type of every response */
+
+#define HOSTBRIDGE_KEY_SIZE     (64U)   /**< Public key in a TAP response, X||Y */
+
+#define HOSTBRIDGE_STATUS_OK          (0x00U) /**< Request completed */
+#define HOSTBRIDGE_STATUS_FAILED      (0x01U) /**< Request ran but did not succeed */
+#define HOSTBRIDGE_STATUS_UNSUPPORTED (0x02U) /**< Unknown or unimplemented request */
+#define HOSTBRIDGE_STATUS_BAD_REQUEST (0x03U) /**< Malformed request payload */
+
+/**
+ * @brief CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF).
+ *
+ * @param data Bytes to checksum.
+ * @param length Number of bytes.
+ * @param crc Running CRC, to checksum data in pieces.
+ * @return Updated CRC.
+ */
+static inline uint16_t hostBridgeCrc16(const uint8_t* data, size_t length,
+                                       uint16_t crc = 0xFFFFU) {
+    for (size_t i = 0U; i < length; i++) {
+        crc ^= (uint16_t)((uint16_t)data[i] << 8U);
+        for (uint8_t bit = 0U; bit < 8U; bit++) {
+            crc = ((crc & 0x8000U) != 0U) ? (uint16_t)((crc << 1U) ^ 0x1021U)
+                                         : (uint16_t)(crc << 1U);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief COBS-encode a buffer.
+ *
+ * @param in Bytes to encode.
+ * @param length Number of bytes, at most 253 so one block suffices.
+ * @param out Destination, at least length + 1 bytes. No delimiter is added.
+ * @return Number of bytes written.
+ */
+static inline size_t hostBridgeCobsEncode(const uint8_t* in, size_t length,
+                                          uint8_t* out) {
+    size_t codePos = 0U;
+    size_t pos = 1U;
+    uint8_t code = 1U;
+
+    for (size_t i = 0U; i < length; i++) {
+        if (in[i] == 0U) {
+            out[codePos] = code;
+            codePos = pos++;
+            code = 1U;
+        } else {
+            out[pos++] = in[i];
+            code++;
+        }
+    }
+    out[codePos] = code;
+    return pos;
+}
+
+/**
+ * @brief Decode one COBS block (without its delimiter).
+ *
+ * @param in Encoded bytes.
+ * @param length Number of encoded bytes.
+ * @param out Destination, at least length bytes.
+ * @return Number of decoded bytes, or 0 if the input is malformed.
+ */
+static inline size_t hostBridgeCobsDecode(const uint8_t* in, size_t length,
+                                          uint8_t* out) {
+    size_t pos = 0U;
+    size_t i = 0U;
+
+    while (i < length) {
+        uint8_t code = in[i++];
+        if ((code == 0U) || ((i + code - 1U) > length)) {
+            return 0U;
+        }
+        for (uint8_t k = 1U; k < code; k++) {
+            out[pos++] = in[i++];
+        }
+        if ((code != 0xFFU) && (i < length)) {
+            out[pos++] = 0U;
+        }
+    }
+    return pos;
+}
+
+/**
+ * @brief Build a complete encoded frame, delimiter included.
+ *
+ * @param type Message type.
+ * @param seq Sequence number.
+ * @param payload Payload bytes, may be nullptr if length is 0.
+ * @param length Payload length, at most HOSTBRIDGE_MAX_PAYLOAD.
+ * @param out Destination, at least HOSTBRIDGE_MAX_ENCODED + 1 bytes.
+ * @return Number of bytes to send, or 0 if the payload is too long.
+ */
+static inline size_t hostBridgeBuildFrame(uint8_t type, uint8_t seq,
+                                          const uint8_t* payload, size_t length,
+                                          uint8_t* out) {
+    uint8_t frame[HOSTBRIDGE_MAX_FRAME];
+    uint16_t crc;
+    size_t n;
+
+    if (length > HOSTBRIDGE_MAX_PAYLOAD) {
+        return 0U;
+    }
+    frame[0] = type;
+    frame[1] = seq;
+    for (size_t i = 0U; i < length; i++) {
+        frame[2U + i] = payload[i];
+    }
+    crc = hostBridgeCrc16(frame, length + 2U);
+    frame[length + 2U] = (uint8_t)(crc & 0xFFU);
+    frame[length + 3U] = (uint8_t)(crc >> 8U);
+
+    n = hostBridgeCobsEncode(frame, length + 4U, out);
+    out[n] = 0U;
+    return n + 1U;
+}
+
+/**
+ * @brief Decode and check one received frame.
+ *
+ * @param encoded Bytes received before the 0x00 delimiter.
+ * @param length Number of encoded bytes.
+ * @param frame Destination, at least HOSTBRIDGE_MAX_ENCODED bytes. On
+ *              success it holds type, seq and payload.
+ * @return Payload length + 2, or 0 if the frame is malformed or its CRC
+ *         does not match.
+ */
+static inline size_t hostBridgeParseFrame(const uint8_t* encoded, size_t length,
+                                          uint8_t* frame) {
+    size_t n;
+    uint16_t crc;
+
+    if ((length == 0U) || (length > HOSTBRIDGE_MAX_ENCODED)) {
+        return 0U;
+    }
+    n = hostBridgeCobsDecode(encoded, length, frame);
+    if (n < 4U) {
+        return 0U;
+    }
+    crc = hostBridgeCrc16(frame, n - 2U);
+    if ((frame[n - 2U] != (uint8_t)(crc & 0xFFU)) ||
+        (frame[n - 1U] != (uint8_t)(crc >> 8U))) {
+        return 0U;
+    }
+    return n - 2U;
+}
+
+#endif // HOSTBRIDGEPROTOCOL_H
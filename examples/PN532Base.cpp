@@ -1,15 +1,59 @@
 #include "PN532Base.h"
+#include "Trace.h"
 #include <Arduino.h>
 
+#ifdef CRYPTNOX_LOG_QUIET
+NullPrint cryptnoxNullLog;
+#endif
+
+#ifdef CRYPTNOX_TRACE
+/**
+ * @brief Record a timed driver step (command and its ACK, ready wait,
+ *        frame read) as a "pn532" trace event.
+ *
+ * @param context Unused.
+ * @param step Step name, a string literal in the driver.
+ * @param startUs Start time from micros().
+ * @param durationUs Step duration in microseconds.
+ */
+static void traceDriverStep(void* context, const char* step,
+                            uint32_t startUs, uint32_t durationUs) {
+    (void)context;
+    Trace::complete(step, "pn532", startUs, durationUs);
+}
+#endif
+
+/**
+ * @brief Store a 32-bit value little-endian.
+ *
+ * @param buffer Destination buffer.
+ * @param pos Offset in buffer to write at.
+ * @param value Value to store.
+ * @return Offset just past the stored value.
+ */
+static size_t putU32(uint8_t* buffer, size_t pos, uint32_t value) {
+    buffer[pos]      = (uint8_t)(value);
+    buffer[pos + 1U] = (uint8_t)(value >> 8U);
+    buffer[pos + 2U] = (uint8_t)(value >> 16U);
+    buffer[pos + 3U] = (uint8_t)(value >> 24U);
+    return pos + 4U;
+}
+
 /**
  * @brief Initialize the PN532 module and configure it for normal operation.
  *
  * Calls the base Adafruit_PN532 `begin()`, reads the firmware version, 
  * prints a detailed status message, and performs SAM configuration.
  *
+ * With CRYPTNOX_TRACE, also hooks the driver's command, wait and read
+ * steps into the trace.
+ *
  * @return true if the PN532 module was successfully initialized and detected, false otherwise.
  */
 bool PN532Base::begin(void) {
+#ifdef CRYPTNOX_TRACE
+  setTraceHook(traceDriverStep);
+#endif
   return Adafruit_PN532::begin();
 }
 
@@ -62,59 +106,59 @@ bool PN532Base::printFirmwareVersion(void)
         uint8_t flags    =  versionData        & 0xFFU;
         bool first       = true;
 
-        Serial.println(F("PN532 detected"));
-        Serial.print(F(" ├─ Raw firmware: 0x"));
-        Serial.println(versionData, HEX);
+        CRYPTNOX_LOG.println(F("PN532 detected"));
+        CRYPTNOX_LOG.print(F(" ├─ Raw firmware: 0x"));
+        CRYPTNOX_LOG.println(versionData, HEX);
 
-        Serial.print(F(" ├─ IC Chip: "));
+        CRYPTNOX_LOG.print(F(" ├─ IC Chip: "));
         if (ic == 0x32U)
         {
-            Serial.println(F("PN532"));
+            CRYPTNOX_LOG.println(F("PN532"));
         }
         else
         {
-            Serial.println(F("Unknown"));
+            CRYPTNOX_LOG.println(F("Unknown"));
         }
 
-        Serial.print(F(" ├─ Firmware: "));
-        Serial.print(verMajor);
-        Serial.print(F("."));
-        Serial.println(verMinor);
+        CRYPTNOX_LOG.print(F(" ├─ Firmware: "));
+        CRYPTNOX_LOG.print(verMajor);
+        CRYPTNOX_LOG.print(F("."));
+        CRYPTNOX_LOG.println(verMinor);
 
-        Serial.print(F(" └─ Features: "));
+        CRYPTNOX_LOG.print(F(" └─ Features: "));
         if ((flags & 0x01U) != 0U) {
-            Serial.print(F("MIFARE"));
+            CRYPTNOX_LOG.print(F("MIFARE"));
             first = false;
         }
         if ((flags & 0x02U) != 0U) {
             if (!first)
             {
-                Serial.print(F(" + "));
+                CRYPTNOX_LOG.print(F(" + "));
             }
-            Serial.print(F("ISO-DEP"));
+            CRYPTNOX_LOG.print(F("ISO-DEP"));
             first = false;
         }
         if ((flags & 0x04U) != 0U) {
             if (!first)
             {
-                Serial.print(F(" + "));
+                CRYPTNOX_LOG.print(F(" + "));
             }
-            Serial.print(F("FeliCa"));
+            CRYPTNOX_LOG.print(F("FeliCa"));
             first = false;
         }
         if (first) {
-            Serial.print(F("Unknown"));
+            CRYPTNOX_LOG.print(F("Unknown"));
         }
 
-        Serial.print(F(" (0x"));
-        Serial.print(flags, HEX);
-        Serial.println(F(")"));
+        CRYPTNOX_LOG.print(F(" (0x"));
+        CRYPTNOX_LOG.print(flags, HEX);
+        CRYPTNOX_LOG.println(F(")"));
 
         SAMConfig(); /* Configure the PN532 for normal operation */
         result = true;
     }
     else {
-        Serial.println(F("PN532 not found!"));
+        CRYPTNOX_LOG.println(F("PN532 not found!"));
         result = false;
     }
 
@@ -132,34 +176,219 @@ bool PN532Base::printFirmwareVersion(void)
  */
 bool PN532Base::sendAPDU(const uint8_t* apdu, uint8_t apduLength,
                          uint8_t* response, uint8_t &responseLength) {
-    bool success = inDataExchange(
-        (uint8_t*)apdu,
-        apduLength,
-        response,
-        &responseLength
-    );
+    TRACE_SCOPE("sendAPDU", "pn532");
+    uint32_t start = micros();
+    bool success;
+    {
+        TRACE_SCOPE("inDataExchange", "pn532");
+        success = inDataExchange(
+            (uint8_t*)apdu,
+            apduLength,
+            response,
+            &responseLength
+        );
+    }
+
+    recordExchange(getExchangeError(), micros() - start, apduLength,
+                   (success != false) ? responseLength : 0U);
 
     if (success == false) {
-        Serial.println(F("APDU exchange failed!"));
+        CRYPTNOX_LOG.println(F("APDU exchange failed!"));
         return false;
     }
 
-    Serial.print(F("APDU response ("));
-    Serial.print(responseLength);
-    Serial.println(F(" bytes):"));
+    CRYPTNOX_LOG.print(F("APDU response ("));
+    CRYPTNOX_LOG.print(responseLength);
+    CRYPTNOX_LOG.println(F(" bytes):"));
 
     for (uint8_t i = 0; i < responseLength; i++) {
-        Serial.print("0x");
+        CRYPTNOX_LOG.print("0x");
         if (response[i] < 16) {
-            Serial.print("0");
+            CRYPTNOX_LOG.print("0");
         }
-        Serial.print(response[i], HEX);
-        Serial.print(" ");
+        CRYPTNOX_LOG.print(response[i], HEX);
+        CRYPTNOX_LOG.print(" ");
 
         /* Wrap line every 16 bytes */
-        if ((i + 1) % 16 == 0 && (i + 1) != responseLength) Serial.println();
+        if ((i + 1) % 16 == 0 && (i + 1) != responseLength) CRYPTNOX_LOG.println();
     }
-    Serial.println();
+    CRYPTNOX_LOG.println();
 
     return true;
 }
+
+/**
+ * @brief Check whether the activated ISO14443-4 card is still in the field.
+ *
+ * Sends Diagnose with NumTst 0x06 (attention request test). The PN532 answers
+ * with a single status byte which is 0x00 when the card responded. A test
+ * still running at the timeout is aborted with an ACK frame.
+ *
+ * @param timeout Maximum time in milliseconds to wait for the PN532, 0 for
+ *        the card's frame waiting time plus PN532_PRESENCE_MARGIN_MS.
+ * @return true if the card answered, false otherwise.
+ */
+bool PN532Base::isCardPresent(uint16_t timeout) {
+    TRACE_SCOPE("isCardPresent", "pn532");
+    uint8_t cmd[2] = { PN532_COMMAND_DIAGNOSE, 0x06U };
+    uint8_t status[2];
+    uint8_t statusLength = sizeof(status);
+    bool present = false;
+
+    if (timeout == 0U) {
+        /* The card may take a full FWT to answer the attention request */
+        timeout = getFrameWaitTime() + PN532_PRESENCE_MARGIN_MS;
+    }
+
+    if (beginCommand(cmd, sizeof(cmd), timeout) != false) {
+        uint32_t start = millis();
+        bool ready = false;
+
+        {
+            TRACE_SCOPE("waitready", "pn532");
+            while ((ready == false) && ((millis() - start) < timeout)) {
+                ready = isComplete();
+                if (ready == false) {
+                    delay(1);
+                }
+            }
+        }
+
+        if (ready == false) {
+            /* Drop the test so its late response is not read as the
+             * answer to the next command */
+            (void)abortCommand();
+        }
+        else if ((finishCommand(status, &statusLength) != false) &&
+                 (statusLength >= 1U)) {
+            present = (status[0] == 0x00U);
+        }
+    }
+
+    return present;
+}
+
+/**
+ * @brief Put the PN532 into PowerDown while waiting for the next tap.
+ *
+ * @param wakeSources OR of PN532_WAKESRC_* bits for extra wake sources.
+ * @return true if the PN532 entered PowerDown, false otherwise.
+ */
+bool PN532Base::enterIdle(uint8_t wakeSources) {
+    TRACE_SCOPE("enterIdle", "pn532");
+    return powerDown(wakeSources);
+}
+
+/**
+ * @brief Wake the PN532 from PowerDown and wait until it answers again.
+ *
+ * The firmware version query serves as the readiness probe: the PN532 only
+ * acknowledges it once its oscillator is running. The elapsed time is kept
+ * for getWakeLatency().
+ *
+ * @return true if the PN532 is ready for commands, false otherwise.
+ */
+bool PN532Base::leaveIdle(void) {
+    bool ready = true;
+
+    if (isPoweredDown() != false) {
+        TRACE_SCOPE("leaveIdle", "pn532");
+        uint32_t start = micros();
+
+        ready = (fastWakeup() != false) &&
+                (Adafruit_PN532::getFirmwareVersion() != 0U);
+        wakeLatencyUs = micros() - start;
+    }
+
+    return ready;
+}
+
+/**
+ * @brief Time taken by the last leaveIdle() from wake pulse to the first
+ *        answered command.
+ *
+ * @return Wake-to-ready latency in microseconds, 0 if never woken.
+ */
+uint32_t PN532Base::getWakeLatency(void) const {
+    return wakeLatencyUs;
+}
+
+/**
+ * @brief Account one finished exchange in the statistics.
+ *
+ * Costs a handful of integer operations: three counter updates, a max and a
+ * bucket lookup that shifts the latency at most 15 times.
+ *
+ * @param result PN532_XCHG_* outcome of the exchange.
+ * @param latencyUs Duration of the exchange in microseconds.
+ * @param sent Number of APDU bytes sent.
+ * @param received Number of response bytes received.
+ */
+void PN532Base::recordExchange(uint8_t result, uint32_t latencyUs,
+                               uint8_t sent, uint8_t received) {
+    uint32_t scaled = latencyUs >> 9U;
+    uint8_t bucket = 0U;
+
+    if (result < PN532_XCHG_COUNT) {
+        stats.results[result]++;
+    }
+    stats.bytesOut += sent;
+    stats.bytesIn += received;
+    if (latencyUs > stats.maxLatencyUs) {
+        stats.maxLatencyUs = latencyUs;
+    }
+
+    while ((scaled != 0U) && (bucket < (PN532_STATS_BUCKETS - 1U))) {
+        scaled >>= 1U;
+        bucket++;
+    }
+    stats.latency[bucket]++;
+}
+
+/**
+ * @brief Copy the APDU statistics gathered since the last reset.
+ *
+ * @param out Reference to the structure receiving the counters.
+ */
+void PN532Base::getStats(PN532Stats &out) const {
+    out = stats;
+}
+
+/**
+ * @brief Clear all APDU statistics.
+ */
+void PN532Base::resetStats(void) {
+    stats = PN532Stats();
+}
+
+/**
+ * @brief Write the APDU statistics as a versioned little-endian snapshot.
+ *
+ * @param buffer Destination buffer.
+ * @param size Size of buffer in bytes.
+ * @return Number of bytes written, or 0 if the buffer is too small.
+ */
+size_t PN532Base::serializeStats(uint8_t* buffer, size_t size) const {
+    size_t pos = 4U;
+
+    if ((buffer == nullptr) || (size < PN532_STATS_SNAPSHOT_SIZE)) {
+        return 0U;
+    }
+
+    buffer[0] = 1U; /* Snapshot version */
+    buffer[1] = PN532_XCHG_COUNT;
+    buffer[2] = PN532_STATS_BUCKETS;
+    buffer[3] = 0U;
+
+    for (uint8_t i = 0U; i < PN532_XCHG_COUNT; i++) {
+        pos = putU32(buffer, pos, stats.results[i]);
+    }
+    pos = putU32(buffer, pos, stats.bytesOut);
+    pos = putU32(buffer, pos, stats.bytesIn);
+    pos = putU32(buffer, pos, stats.maxLatencyUs);
+    for (uint8_t i = 0U; i < PN532_STATS_BUCKETS; i++) {
+        pos = putU32(buffer, pos, stats.latency[i]);
+    }
+
+    return pos;
+}
@@ -3,6 +3,77 @@
 
 #include <Adafruit_PN532.h>
 
+/**
+ * @brief Build with CRYPTNOX_HOST_BRIDGE to keep the serial port free for the
+ *        binary host protocol; the human-readable output is then discarded.
+ *        CRYPTNOX_TRACE does the same so the port carries only the trace, and
+ *        the spans do not include time spent printing.
+ */
+#if (defined(CRYPTNOX_HOST_BRIDGE) || defined(CRYPTNOX_TRACE)) && !defined(CRYPTNOX_LOG_QUIET)
+#define CRYPTNOX_LOG_QUIET
+#endif
+
+#ifdef CRYPTNOX_LOG_QUIET
+/**
+ * @class NullPrint
+ * @brief Print sink that drops everything written to it.
+ */
+class NullPrint : public Print {
+public:
+    /**
+     * @brief Discard one byte.
+     * @param c Byte to discard.
+     * @return Always 1, so callers see a successful write.
+     */
+    size_t write(uint8_t c) override {
+        (void)c;
+        return 1U;
+    }
+};
+
+extern NullPrint cryptnoxNullLog; /**< Sink used when logging is quiet */
+#define CRYPTNOX_LOG cryptnoxNullLog
+#endif
+
+/**
+ * @brief Sink for the SDK's human-readable progress and APDU dumps.
+ */
+#ifndef CRYPTNOX_LOG
+#define CRYPTNOX_LOG Serial
+#endif
+
+/**
+ * @brief Number of latency histogram buckets.
+ *
+ * Bucket 0 counts exchanges under 512 us, bucket i (1..14) those in
+ * [256 << i, 512 << i) us, and the last bucket everything from about 8.4 s up.
+ */
+#define PN532_STATS_BUCKETS (16U)
+
+/**
+ * @brief Size in bytes of the snapshot written by PN532Base::serializeStats().
+ */
+#define PN532_STATS_SNAPSHOT_SIZE (4U + (4U * (PN532_XCHG_COUNT + 3U + PN532_STATS_BUCKETS)))
+
+/**
+ * @brief Time in milliseconds added to the card's frame waiting time for the
+ *        PN532 and the host bus when isCardPresent() derives its timeout.
+ */
+#ifndef PN532_PRESENCE_MARGIN_MS
+#define PN532_PRESENCE_MARGIN_MS (20U)
+#endif
+
+/**
+ * @brief APDU exchange statistics gathered by PN532Base::sendAPDU().
+ */
+typedef struct {
+    uint32_t results[PN532_XCHG_COUNT];      /**< Exchanges by outcome, indexed by PN532_XCHG_* (PN532_XCHG_OK counts successes) */
+    uint32_t bytesOut;                       /**< APDU bytes sent to cards */
+    uint32_t bytesIn;                        /**< Response bytes received from cards */
+    uint32_t maxLatencyUs;                   /**< Slowest exchange seen, in microseconds */
+    uint32_t latency[PN532_STATS_BUCKETS];   /**< Exchange latency histogram, see PN532_STATS_BUCKETS */
+} PN532Stats;
+
 /**
  * @class PN532Base
  * @brief Wrapper around Adafruit_PN532 providing extended utility functions for NFC card operations.
@@ -78,6 +149,96 @@ public:
      */
     bool sendAPDU(const uint8_t* apdu, uint8_t apduLength,
                   uint8_t* response, uint8_t &responseLength);
+
+    /**
+     * @brief Check whether the activated ISO14443-4 card is still in the field.
+     *
+     * Runs the PN532 Diagnose attention test (NumTst 0x06), which pings the
+     * card without sending an APDU. It completes in a few milliseconds, so it
+     * can be polled to keep an open session alive instead of re-detecting.
+     * If the PN532 does not answer in time the test is aborted, so its late
+     * response cannot be taken for the answer to the next command.
+     *
+     * @param timeout Maximum time in milliseconds to wait for the PN532, or 0
+     *        to use the card's frame waiting time plus
+     *        PN532_PRESENCE_MARGIN_MS.
+     * @return true if the card answered, false if it left the field or the
+     *         PN532 did not respond in time.
+     */
+    bool isCardPresent(uint16_t timeout = 0U);
+
+    /**
+     * @brief Put the PN532 into PowerDown while waiting for the next tap.
+     *
+     * The RF field is switched off until a wake source fires or leaveIdle()
+     * is called. The host interface is always a wake source, so by default
+     * the host decides when to look for the next card, e.g. on a timer or
+     * a button. A card tap cannot wake the PN532 on its own: with the field
+     * off the card is unpowered, and PN532_WAKESRC_RF only reacts to the
+     * field of another reader.
+     *
+     * @param wakeSources OR of PN532_WAKESRC_* bits for extra wake sources.
+     * @return true if the PN532 entered PowerDown, false otherwise.
+     */
+    bool enterIdle(uint8_t wakeSources = 0U);
+
+    /**
+     * @brief Wake the PN532 from PowerDown and wait until it answers again.
+     *
+     * SAM configuration is only sent again if the PN532 was reset while idle.
+     * Does nothing if the PN532 is not powered down.
+     *
+     * @return true if the PN532 is ready for commands, false otherwise.
+     */
+    bool leaveIdle(void);
+
+    /**
+     * @brief Time taken by the last leaveIdle() from wake pulse to the first
+     *        answered command.
+     *
+     * @return Wake-to-ready latency in microseconds, 0 if never woken.
+     */
+    uint32_t getWakeLatency(void) const;
+
+    /**
+     * @brief Copy the APDU statistics gathered since the last reset.
+     *
+     * @param stats Reference to the structure receiving the counters.
+     */
+    void getStats(PN532Stats &stats) const;
+
+    /**
+     * @brief Clear all APDU statistics.
+     */
+    void resetStats(void);
+
+    /**
+     * @brief Write the APDU statistics as a versioned little-endian snapshot.
+     *
+     * Layout: a 4-byte header (version, result count, bucket count, reserved)
+     * followed by every PN532Stats field as a 32-bit value in declaration order.
+     *
+     * @param buffer Destination buffer.
+     * @param size Size of buffer in bytes.
+     * @return Number of bytes written (PN532_STATS_SNAPSHOT_SIZE), or 0 if the
+     *         buffer is too small.
+     */
+    size_t serializeStats(uint8_t* buffer, size_t size) const;
+
+private:
+    /**
+     * @brief Account one finished exchange in the statistics.
+     *
+     * @param result PN532_XCHG_* outcome of the exchange.
+     * @param latencyUs Duration of the exchange in microseconds.
+     * @param sent Number of APDU bytes sent.
+     * @param received Number of response bytes received.
+     */
+    void recordExchange(uint8_t result, uint32_t latencyUs,
+                        uint8_t sent, uint8_t received);
+
+    uint32_t wakeLatencyUs = 0U; /**< Latency measured by the last leaveIdle() */
+    PN532Stats stats = {};       /**< APDU exchange statistics */
 };
 
 #endif // PN532BASE_H
@@ -0,0 +1,100 @@
+#include "StackProfiler.h"
+
+#if defined(__AVR__)
+extern char __heap_start;
+extern char* __brkval;
+#elif defined(__arm__)
+/* Bottom of the stack region; weak so that linker scripts without it still
+ * link and leave the window to STACK_PROFILER_WINDOW */
+extern char __StackLimit __attribute__((weak));
+#endif
+
+uint8_t* StackProfiler::top = nullptr;
+uint8_t* StackProfiler::bottom = nullptr;
+
+/**
+ * @brief Paint the free stack below the caller.
+ *
+ * Kept out of line so that its frame sits just below the caller's, inside
+ * the guard area. The window is written through a volatile pointer so the
+ * stores are not optimized away. It never extends below the stack limit
+ * known for the target, see STACK_PROFILER_WINDOW.
+ */
+__attribute__((noinline)) void StackProfiler::paint(void) {
+    uint8_t marker = 0U;
+    uint8_t* sp = &marker;
+    uint8_t* limit = nullptr;
+    size_t size = STACK_PROFILER_WINDOW;
+
+#if defined(__AVR__)
+    limit = (uint8_t*)((__brkval != nullptr) ? __brkval : &__heap_start);
+#elif defined(__arm__)
+    limit = (uint8_t*)&__StackLimit;
+#endif
+
+    if ((limit != nullptr) && (limit < sp) &&
+        ((size == 0U) || ((size_t)(sp - limit) < size))) {
+        size = (size_t)(sp - limit);
+    }
+
+    if (size <= (2U * STACK_PROFILER_GUARD)) {
+        top = nullptr;
+        bottom = nullptr;
+        return;
+    }
+
+    top = sp - STACK_PROFILER_GUARD;
+    bottom = sp - (size - STACK_PROFILER_GUARD);
+
+    volatile uint8_t* p = bottom;
+    while (p < top) {
+        *p = STACK_PROFILER_PATTERN;
+        p++;
+    }
+}
+
+/**
+ * @brief Peak stack growth since the last paint().
+ *
+ * Scans upward from the bottom of the window for the first byte that lost
+ * the pattern; everything from there to the caller's frame was in use.
+ *
+ * @return Bytes of the painted window that were overwritten.
+ */
+size_t StackProfiler::used(void) {
+    const volatile uint8_t* p = bottom;
+
+    if (bottom == nullptr) {
+        return 0U;
+    }
+    while ((p < top) && (*p == STACK_PROFILER_PATTERN)) {
+        p++;
+    }
+    return (size_t)(top - p) + STACK_PROFILER_GUARD;
+}
+
+/**
+ * @brief Size of the window painted by the last paint().
+ *
+ * @return Window size in bytes.
+ */
+size_t StackProfiler::window(void) {
+    return (bottom == nullptr) ? 0U : (size_t)(top - bottom) + STACK_PROFILER_GUARD;
+}
+
+/**
+ * @brief Print "<name>: <used> of <window> bytes stack" to a sink.
+ *
+ * @param out Sink for the report line.
+ * @param name Label of the measured call.
+ */
+void StackProfiler::report(Print &out, const char* name) {
+    size_t peak = used();
+
+    out.print(name);
+    out.print(F(": "));
+    out.print((unsigned long)peak);
+    out.print(F(" of "));
+    out.print((unsigned long)window());
+    out.println(F(" bytes stack"));
+}
@@ -0,0 +1,95 @@
+#ifndef STACKPROFILER_H
+#define STACKPROFILER_H
+
+#include <Arduino.h>
+
+/**
+ * @file StackProfiler.h
+ * @brief Run-time stack high-water-mark measurement by stack painting.
+ *
+ * paint() fills the free stack below the caller with a known pattern. After
+ * the code under test has run, used() scans for the deepest byte that no
+ * longer holds the pattern, which is how far the stack grew in between.
+ * The figure is exact to within STACK_PROFILER_GUARD bytes.
+ */
+
+/**
+ * @brief Bytes just below the painting frame that are left unpainted.
+ *
+ * Covers the profiler's own frame, interrupt frames and the host red zone.
+ */
+#ifndef STACK_PROFILER_GUARD
+#define STACK_PROFILER_GUARD (64U)
+#endif
+
+/**
+ * @brief Upper bound on the painted window, in bytes.
+ *
+ * AVR paints all memory between the heap and the stack, and ARM paints down
+ * to the linker's __StackLimit symbol (CMSIS-style linker scripts). Other
+ * targets have no known stack limit: define this to a size known to lie
+ * inside the stack, or paint() leaves memory untouched and used() reports 0.
+ * When both a limit and this size are known, the smaller window is used.
+ */
+#ifndef STACK_PROFILER_WINDOW
+#define STACK_PROFILER_WINDOW (0U)
+#endif
+
+/**
+ * @brief Value written to every painted byte.
+ */
+#define STACK_PROFILER_PATTERN (0xC5U)
+
+/**
+ * @class StackProfiler
+ * @brief Measures the peak stack depth of a call.
+ */
+class StackProfiler {
+public:
+    /**
+     * @brief Paint the free stack below the caller.
+     */
+    static void paint(void);
+
+    /**
+     * @brief Peak stack growth since the last paint().
+     *
+     * @return Bytes of the painted window that were overwritten.
+     */
+    static size_t used(void);
+
+    /**
+     * @brief Size of the window painted by the last paint().
+     *
+     * @return Window size in bytes; used() can never exceed it.
+     */
+    static size_t window(void);
+
+    /**
+     * @brief Print "<name>: <used> of <window> bytes stack" to a sink.
+     *
+     * @param out Sink for the report line.
+     * @param name Label of the measured call.
+     */
+    static void report(Print &out, const char* name);
+
+private:
+    static uint8_t* top;    /**< Highest painted address + 1 */
+    static uint8_t* bottom; /**< Lowest painted address */
+};
+
+/**
+ * @brief Run a call between paint() and report().
+ *
+ * @param out Sink for the report line.
+ * @param name Label of the measured call.
+ * @param call Expression to measure; its value is discarded.
+ */
+#define STACK_PROFILE(out, name, call) \
+    do { \
+        StackProfiler::paint(); \
+        (void)(call); \
+        StackProfiler::report((out), (name)); \
+    } while (0)
+
+#endif // STACKPROFILER_H
@@ -0,0 +1,91 @@
+#include "Trace.h"
+
+#ifdef CRYPTNOX_TRACE
+
+Print* Trace::sink = nullptr;
+Trace::Event Trace::events[CRYPTNOX_TRACE_EVENTS];
+uint32_t Trace::count = 0U;
+
+/**
+ * @brief Start a trace with an empty event ring.
+ *
+ * @param out Sink receiving the JSON text at end().
+ */
+void Trace::begin(Print &out) {
+    sink = &out;
+    count = 0U;
+}
+
+/**
+ * @brief Write the recorded events as a JSON array and stop tracing.
+ *
+ * Names and categories are written verbatim, so they must not contain
+ * characters that need JSON escaping. Events are written oldest first; if
+ * the ring wrapped, a "trace_dropped" counter records how many were lost.
+ */
+void Trace::end(void) {
+    if (sink == nullptr) {
+        return;
+    }
+
+    uint32_t kept = count;
+    uint32_t first = 0U;
+    if (count > CRYPTNOX_TRACE_EVENTS) {
+        kept = CRYPTNOX_TRACE_EVENTS;
+        first = count % CRYPTNOX_TRACE_EVENTS;
+    }
+
+    sink->println(F("["));
+    for (uint32_t i = 0U; i < kept; i++) {
+        const Event &event = events[(first + i) % CRYPTNOX_TRACE_EVENTS];
+        if (i != 0U) {
+            sink->println(F(","));
+        }
+        sink->print(F("{\"name\":\""));
+        sink->print(event.name);
+        sink->print(F("\",\"cat\":\""));
+        sink->print(event.category);
+        sink->print(F("\",\"ph\":\"X\",\"ts\":"));
+        sink->print(event.startUs);
+        sink->print(F(",\"dur\":"));
+        sink->print(event.durationUs);
+        sink->print(F(",\"pid\":1,\"tid\":1}"));
+    }
+    if (kept < count) {
+        if (kept != 0U) {
+            sink->println(F(","));
+        }
+        sink->print(F("{\"name\":\"trace_dropped\",\"ph\":\"C\",\"ts\":"));
+        sink->print(events[first].startUs);
+        sink->print(F(",\"pid\":1,\"args\":{\"events\":"));
+        sink->print(count - kept);
+        sink->print(F("}}"));
+    }
+    sink->println(F("\n]"));
+    sink = nullptr;
+}
+
+/**
+ * @brief Record one complete event, overwriting the oldest once the ring is
+ *        full.
+ *
+ * @param name Span name.
+ * @param category Span category.
+ * @param startUs Start time from micros().
+ * @param durationUs Span duration in microseconds.
+ */
+void Trace::complete(const char* name, const char* category,
+                     uint32_t startUs, uint32_t durationUs) {
+    if (sink == nullptr) {
+        return;
+    }
+
+    Event &event = events[count % CRYPTNOX_TRACE_EVENTS];
+    event.name = name;
+    event.category = category;
+    event.startUs = startUs;
+    event.durationUs = durationUs;
+    count++;
+}
+
+#endif // CRYPTNOX_TRACE
@@ -0,0 +1,129 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <Arduino.h>
+
+/**
+ * @file Trace.h
+ * @brief Optional Chrome / Perfetto trace-event instrumentation.
+ *
+ * Build with CRYPTNOX_TRACE defined to record every TRACE_SCOPE as a
+ * trace-event "complete" (ph "X") record in the JSON array format, which
+ * chrome://tracing and ui.perfetto.dev load directly. Scopes may nest; the
+ * viewers rebuild the hierarchy from the timestamps.
+ *
+ * Events are kept in a fixed ring in RAM and only written out by
+ * Trace::end(), so printing never runs inside a span and stretches its
+ * parents. When more than CRYPTNOX_TRACE_EVENTS spans end during one trace,
+ * the oldest are overwritten and their number is reported as a counter.
+ *
+ * Without CRYPTNOX_TRACE the macros compile to nothing.
+ */
+
+#ifdef CRYPTNOX_TRACE
+
+/**
+ * @brief Number of events the trace ring holds (12 bytes each on AVR, 16 on
+ *        32-bit cores). A wallet tap with the driver's spans records about
+ *        30 events, just under the AVR default.
+ */
+#ifndef CRYPTNOX_TRACE_EVENTS
+#if defined(__AVR__)
+#define CRYPTNOX_TRACE_EVENTS (32U)
+#else
+#define CRYPTNOX_TRACE_EVENTS (64U)
+#endif
+#endif
+
+/**
+ * @class Trace
+ * @brief Records trace events and writes them to a Print sink (Serial, a
+ *        file on host runs...).
+ */
+class Trace {
+public:
+    /**
+     * @brief Start a trace with an empty event ring.
+     *
+     * @param out Sink receiving the JSON text at end(). Use a sink that
+     *            carries nothing else, or the debug prints will corrupt the
+     *            trace.
+     */
+    static void begin(Print &out);
+
+    /**
+     * @brief Write the recorded events as a JSON array and stop tracing.
+     */
+    static void end(void);
+
+    /**
+     * @brief Record one complete event.
+     *
+     * @param name Span name, must stay valid until end().
+     * @param category Span category, e.g. "wallet", "pn532" or "crypto".
+     * @param startUs Start time from micros().
+     * @param durationUs Span duration in microseconds.
+     */
+    static void complete(const char* name, const char* category,
+                         uint32_t startUs, uint32_t durationUs);
+
+private:
+    /**
+     * @brief One recorded span.
+     */
+    typedef struct {
+        const char* name;     /**< Span name */
+        const char* category; /**< Span category */
+        uint32_t startUs;     /**< Start time in microseconds */
+        uint32_t durationUs;  /**< Duration in microseconds */
+    } Event;
+
+    static Print* sink;                          /**< Current sink, nullptr when not tracing */
+    static Event events[CRYPTNOX_TRACE_EVENTS];  /**< Event ring */
+    static uint32_t count;                       /**< Events recorded since begin() */
+};
+
+/**
+ * @class TraceScope
+ * @brief Records the lifetime of a C++ scope as one trace event.
+ */
+class TraceScope {
+public:
+    /**
+     * @brief Start the span.
+     *
+     * @param spanName Span name, must outlive the scope.
+     * @param spanCategory Span category, must outlive the scope.
+     */
+    TraceScope(const char* spanName, const char* spanCategory)
+        : name(spanName), category(spanCategory), start(micros()) {}
+
+    /**
+     * @brief End the span and record it.
+     */
+    ~TraceScope() {
+        Trace::complete(name, category, start, micros() - start);
+    }
+
+private:
+    const char* name;     /**< Span name */
+    const char* category; /**< Span category */
+    uint32_t start;       /**< Start time in microseconds */
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+
+/**
+ * @brief Trace the rest of the enclosing scope as a span.
+ */
+#define TRACE_SCOPE(name, category) \
+    TraceScope TRACE_CONCAT(traceScope_, __LINE__)((name), (category))
+
+#else
+
+#define TRACE_SCOPE(name, category) do { } while (0)
+
+#endif // CRYPTNOX_TRACE
+
+#endif // TRACE_H
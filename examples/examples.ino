@@ -9,6 +9,11 @@
 
 #include <Wire.h>
 #include "CryptnoxWallet.h"
+#include "StackProfiler.h"
+#include "Trace.h"
+#ifdef CRYPTNOX_HOST_BRIDGE
+#include "HostBridge.h"
+#endif
 
 /**
  * @def PN532_SS
@@ -18,6 +23,11 @@
 
 CryptnoxWallet wallet(PN532_SS, &SPI);
 
+#ifdef CRYPTNOX_HOST_BRIDGE
+/** @brief Binary request/response link to the host over the USB serial port. */
+HostBridge bridge(Serial, wallet);
+#endif
+
 /**
  * @brief Arduino setup function.
  *
@@ -35,9 +45,9 @@ void setup() {
 
     /* Initialize the PN532 module */
     if (wallet.begin()) {
-        Serial.println(F("PN532 initialized"));
+        CRYPTNOX_LOG.println(F("PN532 initialized"));
     } else {
-        Serial.println(F("PN532 init failed"));
+        CRYPTNOX_LOG.println(F("PN532 init failed"));
         /* Halt program if initialization fails */
         while(1);
     }
@@ -55,9 +65,28 @@ void setup() {
  */
 void loop() {
 
+#ifdef CRYPTNOX_HOST_BRIDGE
+    /* Taps are driven by the host; just serve its requests */
+    bridge.poll();
+#else
+#ifdef CRYPTNOX_TRACE
+    /* Record the tap; its JSON array is printed once the tap is over */
+    Trace::begin(Serial);
+#endif
+
     /* Process any detected NFC card */
+#ifdef CRYPTNOX_STACK_PROFILE
+    /* Also report how deep the stack grew while handling the tap */
+    STACK_PROFILE(Serial, "processCard", wallet.processCard());
+#else
     (void)wallet.processCard();
+#endif
+
+#ifdef CRYPTNOX_TRACE
+    Trace::end();
+#endif
 
     /* Wait 1 second before next loop iteration */
     delay(1000);
+#endif
 }
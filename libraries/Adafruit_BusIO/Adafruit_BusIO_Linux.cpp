@@ -0,0 +1,448 @@
+#include "Adafruit_BusIO_Linux.h"
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include <fcntl.h>
+#include <linux/i2c-dev.h>
+#include <linux/i2c.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+/*!
+ *    @brief  Create a spidev backed SPI device
+ *    @param  path Device node, e.g. "/dev/spidev0.0"
+ *    @param  freq The SPI clock frequency to use, defaults to 1MHz
+ *    @param  dataMode The SPI mode to use, 0-3, defaults to 0
+ *    @param  lsbFirst True to shift bytes out LSB first (PN532 needs this),
+ * not every controller supports it
+ */
+Adafruit_LinuxSPIDevice::Adafruit_LinuxSPIDevice(const char *path,
+                                                 uint32_t freq,
+                                                 uint8_t dataMode,
+                                                 bool lsbFirst) {
+  _path = path;
+  _fd = -1;
+  _freq = freq;
+  _dataMode = dataMode;
+  _lsbFirst = lsbFirst;
+  _ioctl = nullptr;
+  _ioctlContext = nullptr;
+  _xferCount = 0;
+}
+
+/*!
+ *    @brief  Release the spidev file descriptor
+ */
+Adafruit_LinuxSPIDevice::~Adafruit_LinuxSPIDevice(void) { end(); }
+
+/*!
+ *    @brief  Open the device node and configure mode, bit order and clock.
+ * With a replacement ioctl installed the node is not opened at all.
+ *    @return True if the device could be opened and configured
+ */
+bool Adafruit_LinuxSPIDevice::begin(void) {
+  if (!_ioctl) {
+    _fd = open(_path, O_RDWR);
+    if (_fd < 0) {
+      return false;
+    }
+  }
+
+  uint8_t mode = _dataMode;
+  uint8_t lsb = _lsbFirst ? 1 : 0;
+  uint8_t bits = 8;
+  if ((doIoctl(SPI_IOC_WR_MODE, &mode) < 0) ||
+      (doIoctl(SPI_IOC_WR_LSB_FIRST, &lsb) < 0) ||
+      (doIoctl(SPI_IOC_WR_BITS_PER_WORD, &bits) < 0) ||
+      (doIoctl(SPI_IOC_WR_MAX_SPEED_HZ, &_freq) < 0)) {
+    end();
+    return false;
+  }
+  return true;
+}
+
+/*!
+ *    @brief  Close the device node
+ */
+void Adafruit_LinuxSPIDevice::end(void) {
+  if (_fd >= 0) {
+    close(_fd);
+    _fd = -1;
+  }
+}
+
+/*!
+ *    @brief  Send every transfer to a fake device instead of the kernel.
+ * Must be called before begin().
+ *    @param  func Replacement ioctl, or nullptr for the real one
+ *    @param  context Passed back to func on every call
+ */
+void Adafruit_LinuxSPIDevice::setIoctl(busio_linux_ioctl_t func,
+                                       void *context) {
+  _ioctl = func;
+  _ioctlContext = context;
+}
+
+/*!
+ *    @brief  Read from the SPI device in one SPI_IOC_MESSAGE
+ *    @param  buffer Pointer to buffer of data to read into
+ *    @param  len Number of bytes from buffer to read.
+ *    @param  sendvalue The 8-bits of data to write when doing the data read,
+ * defaults to 0xFF
+ *    @return True if the kernel accepted the transfer
+ */
+bool Adafruit_LinuxSPIDevice::read(uint8_t *buffer, size_t len,
+                                   uint8_t sendvalue) {
+  BusIO_ReadSegment seg = {buffer, len};
+  return readv(&seg, 1, sendvalue);
+}
+
+/*!
+ *    @brief  Write a buffer, with an optional prefix, in one SPI_IOC_MESSAGE
+ *    @param  buffer Pointer to buffer of data to write
+ *    @param  len Number of bytes from buffer to write
+ *    @param  prefix_buffer Pointer to optional array of data to write before
+ * buffer.
+ *    @param  prefix_len Number of bytes from prefix buffer to write
+ *    @return True if the kernel accepted the transfer
+ */
+bool Adafruit_LinuxSPIDevice::write(const uint8_t *buffer, size_t len,
+                                    const uint8_t *prefix_buffer,
+                                    size_t prefix_len) {
+  BusIO_WriteSegment segs[2] = {{prefix_buffer, prefix_len}, {buffer, len}};
+  return writev(segs, 2);
+}
+
+/*!
+ *    @brief  Write some data, then read some data, with CS held across both,
+ * in one SPI_IOC_MESSAGE
+ *    @param  write_buffer Pointer to buffer of data to write from
+ *    @param  write_len Number of bytes from buffer to write.
+ *    @param  read_buffer Pointer to buffer of data to read into.
+ *    @param  read_len Number of bytes from buffer to read.
+ *    @param  sendvalue The 8-bits of data to write when doing the data read,
+ * defaults to 0xFF
+ *    @return True if the kernel accepted the transfer
+ */
+bool Adafruit_LinuxSPIDevice::write_then_read(const uint8_t *write_buffer,
+                                              size_t write_len,
+                                              uint8_t *read_buffer,
+                                              size_t read_len,
+                                              uint8_t sendvalue) {
+  _xferCount = 0;
+  if (!addTransfer(write_buffer, nullptr, write_len)) {
+    return false;
+  }
+  memset(read_buffer, sendvalue, read_len);
+  if (!addTransfer(read_buffer, read_buffer, read_len)) {
+    return false;
+  }
+  return submit();
+}
+
+/*!
+ *    @brief  Write several buffers within one CS assertion, as a single
+ * SPI_IOC_MESSAGE with one transfer per segment
+ *    @param  segments Array of buffers to send, in order
+ *    @param  count Number of entries in segments
+ *    @return True if the kernel accepted the transfer, false if it failed or
+ * needed more than BUSIO_LINUX_SPI_MAXXFERS transfers
+ */
+bool Adafruit_LinuxSPIDevice::writev(const BusIO_WriteSegment *segments,
+                                     uint8_t count) {
+  _xferCount = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    if (!addTransfer(segments[i].data, nullptr, segments[i].len)) {
+      return false;
+    }
+  }
+  return submit();
+}
+
+/*!
+ *    @brief  Read within one CS assertion, scattering the bytes over several
+ * buffers, as a single SPI_IOC_MESSAGE
+ *    @param  segments Array of buffers to fill, in order. A segment with a
+ * nullptr data pointer clocks that many bytes and discards them.
+ *    @param  count Number of entries in segments
+ *    @param  sendvalue The 8-bits of data to write when doing the data read,
+ * defaults to 0xFF
+ *    @return True if the kernel accepted the transfer, false if it failed or
+ * needed more than BUSIO_LINUX_SPI_MAXXFERS transfers
+ */
+bool Adafruit_LinuxSPIDevice::readv(const BusIO_ReadSegment *segments,
+                                    uint8_t count, uint8_t sendvalue) {
+  _xferCount = 0;
+  memset(_fill, sendvalue, sizeof(_fill));
+  for (uint8_t i = 0; i < count; i++) {
+    if (segments[i].data != nullptr) {
+      memset(segments[i].data, sendvalue, segments[i].len);
+      if (!addTransfer(segments[i].data, segments[i].data, segments[i].len)) {
+        return false;
+      }
+      continue;
+    }
+    // Discarded bytes are clocked through the scratch buffers
+    for (size_t done = 0; done < segments[i].len; done += sizeof(_sink)) {
+      size_t n = segments[i].len - done;
+      if (n > sizeof(_sink)) {
+        n = sizeof(_sink);
+      }
+      if (!addTransfer(_fill, _sink, n)) {
+        return false;
+      }
+    }
+  }
+  return submit();
+}
+
+bool Adafruit_LinuxSPIDevice::addTransfer(const uint8_t *tx, uint8_t *rx,
+                                          size_t len) {
+  if (len == 0) {
+    return true;
+  }
+  if (_xferCount == BUSIO_LINUX_SPI_MAXXFERS) {
+    return false;
+  }
+  struct spi_ioc_transfer *x = &_xfers[_xferCount++];
+  memset(x, 0, sizeof(*x));
+  x->tx_buf = (unsigned long)tx;
+  x->rx_buf = (unsigned long)rx;
+  x->len = len;
+  x->speed_hz = _freq;
+  x->bits_per_word = 8;
+  return true;
+}
+
+bool Adafruit_LinuxSPIDevice::submit(void) {
+  if (_xferCount == 0) {
+    return true;
+  }
+  return doIoctl(SPI_IOC_MESSAGE(_xferCount), _xfers) >= 0;
+}
+
+int Adafruit_LinuxSPIDevice::doIoctl(unsigned long request, void *arg) {
+  if (_ioctl) {
+    return _ioctl(_ioctlContext, _fd, request, arg);
+  }
+  return ioctl(_fd, request, arg);
+}
+
+/*!
+ *    @brief  Create an i2c-dev backed I2C device
+ *    @param  path Device node, e.g. "/dev/i2c-1"
+ *    @param  addr The 7-bit I2C address for the device
+ */
+Adafruit_LinuxI2CDevice::Adafruit_LinuxI2CDevice(const char *path,
+                                                 uint8_t addr) {
+  _path = path;
+  _fd = -1;
+  _addr = addr;
+  _ioctl = nullptr;
+  _ioctlContext = nullptr;
+}
+
+/*!
+ *    @brief  Release the i2c-dev file descriptor
+ */
+Adafruit_LinuxI2CDevice::~Adafruit_LinuxI2CDevice(void) { end(); }
+
+/*!
+ *    @brief  Get the 7-bit address
+ *    @return The 7-bit address
+ */
+uint8_t Adafruit_LinuxI2CDevice::address(void) { return _addr; }
+
+/*!
+ *    @brief  Open the device node and check that the adapter supports
+ * combined I2C_RDWR transactions. With a replacement ioctl installed the
+ * node is not opened at all.
+ *    @param  addr_detect Whether we should attempt to detect the I2C address
+ * with a one byte read
+ *    @return True if the adapter is usable and, if requested, the device
+ * answered
+ */
+bool Adafruit_LinuxI2CDevice::begin(bool addr_detect) {
+  if (!_ioctl) {
+    _fd = open(_path, O_RDWR);
+    if (_fd < 0) {
+      return false;
+    }
+  }
+
+  unsigned long funcs = 0;
+  uint8_t probe;
+  if ((doIoctl(I2C_FUNCS, &funcs) < 0) || !(funcs & I2C_FUNC_I2C) ||
+      (addr_detect && !read(&probe, 1))) {
+    end();
+    return false;
+  }
+  return true;
+}
+
+/*!
+ *    @brief  Close the device node
+ */
+void Adafruit_LinuxI2CDevice::end(void) {
+  if (_fd >= 0) {
+    close(_fd);
+    _fd = -1;
+  }
+}
+
+/*!
+ *    @brief  Send every transfer to a fake device instead of the kernel.
+ * Must be called before begin().
+ *    @param  func Replacement ioctl, or nullptr for the real one
+ *    @param  context Passed back to func on every call
+ */
+void Adafruit_LinuxI2CDevice::setIoctl(busio_linux_ioctl_t func,
+                                       void *context) {
+  _ioctl = func;
+  _ioctlContext = context;
+}
+
+/*!
+ *    @brief  Read from the I2C device. The kernel always ends an I2C_RDWR
+ * call with a STOP, so the stop flag only exists for API compatibility.
+ *    @param  buffer Pointer to buffer of data to read into
+ *    @param  len Number of bytes from buffer to read.
+ *    @param  stop Ignored
+ *    @return True if read was successful, otherwise false.
+ */
+bool Adafruit_LinuxI2CDevice::read(uint8_t *buffer, size_t len, bool stop) {
+  (void)stop;
+  return rdwr(nullptr, 0, buffer, len);
+}
+
+/*!
+ *    @brief  Write a buffer, with an optional prefix, as one I2C message
+ *    @param  buffer Pointer to buffer of data to write
+ *    @param  len Number of bytes from buffer to write
+ *    @param  stop Ignored, see read()
+ *    @param  prefix_buffer Pointer to optional array of data to write before
+ * buffer.
+ *    @param  prefix_len Number of bytes from prefix buffer to write
+ *    @return True if write was successful, otherwise false.
+ */
+bool Adafruit_LinuxI2CDevice::write(const uint8_t *buffer, size_t len,
+                                    bool stop, const uint8_t *prefix_buffer,
+                                    size_t prefix_len) {
+  BusIO_WriteSegment segs[2] = {{prefix_buffer, prefix_len}, {buffer, len}};
+  return writev(segs, 2, stop);
+}
+
+/*!
+ *    @brief  Write some data, then read some data after a repeated START, in
+ * one I2C_RDWR call
+ *    @param  write_buffer Pointer to buffer of data to write from
+ *    @param  write_len Number of bytes from buffer to write.
+ *    @param  read_buffer Pointer to buffer of data to read into.
+ *    @param  read_len Number of bytes from buffer to read.
+ *    @param  stop Ignored, see read()
+ *    @return True if write & read was successful, otherwise false.
+ */
+bool Adafruit_LinuxI2CDevice::write_then_read(const uint8_t *write_buffer,
+                                              size_t write_len,
+                                              uint8_t *read_buffer,
+                                              size_t read_len, bool stop) {
+  (void)stop;
+  return rdwr(write_buffer, write_len, read_buffer, read_len);
+}
+
+/*!
+ *    @brief  Write several buffers as one I2C message. I2C cannot split a
+ * message without a new START, so the segments are gathered into the
+ * device's buffer first.
+ *    @param  segments Array of buffers to send, in order
+ *    @param  count Number of entries in segments
+ *    @param  stop Ignored, see read()
+ *    @return True if write was successful, false if it failed or was longer
+ * than maxBufferSize()
+ */
+bool Adafruit_LinuxI2CDevice::writev(const BusIO_WriteSegment *segments,
+                                     uint8_t count, bool stop) {
+  (void)stop;
+  size_t total = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    if (total + segments[i].len > sizeof(_buffer)) {
+      return false;
+    }
+    if (segments[i].len != 0) {
+      memcpy(_buffer + total, segments[i].data, segments[i].len);
+    }
+    total += segments[i].len;
+  }
+  return rdwr(_buffer, total, nullptr, 0);
+}
+
+/*!
+ *    @brief  Read one I2C message and scatter it over several buffers
+ *    @param  segments Array of buffers to fill, in order. A segment with a
+ * nullptr data pointer skips that many bytes.
+ *    @param  count Number of entries in segments
+ *    @param  stop Ignored, see read()
+ *    @return True if read was successful, false if it failed or was longer
+ * than maxBufferSize()
+ */
+bool Adafruit_LinuxI2CDevice::readv(const BusIO_ReadSegment *segments,
+                                    uint8_t count, bool stop) {
+  (void)stop;
+  size_t total = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    total += segments[i].len;
+  }
+  if (total > sizeof(_buffer)) {
+    return false;
+  }
+  if (!rdwr(nullptr, 0, _buffer, total)) {
+    return false;
+  }
+  size_t pos = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    if (segments[i].data != nullptr) {
+      memcpy(segments[i].data, _buffer + pos, segments[i].len);
+    }
+    pos += segments[i].len;
+  }
+  return true;
+}
+
+bool Adafruit_LinuxI2CDevice::rdwr(const uint8_t *wbuf, size_t wlen,
+                                   uint8_t *rbuf, size_t rlen) {
+  struct i2c_msg msgs[2];
+  struct i2c_rdwr_ioctl_data data;
+  uint8_t n = 0;
+
+  if (wlen != 0) {
+    msgs[n].addr = _addr;
+    msgs[n].flags = 0;
+    msgs[n].len = wlen;
+    msgs[n].buf = (uint8_t *)wbuf;
+    n++;
+  }
+  if (rlen != 0) {
+    msgs[n].addr = _addr;
+    msgs[n].flags = I2C_M_RD;
+    msgs[n].len = rlen;
+    msgs[n].buf = rbuf;
+    n++;
+  }
+  if (n == 0) {
+    return true;
+  }
+
+  data.msgs = msgs;
+  data.nmsgs = n;
+  return doIoctl(I2C_RDWR, &data) >= 0;
+}
+
+int Adafruit_LinuxI2CDevice::doIoctl(unsigned long request, void *arg) {
+  if (_ioctl) {
+    return _ioctl(_ioctlContext, _fd, request, arg);
+  }
+  return ioctl(_fd, request, arg);
+}
+
+#endif // __linux__ && !ARDUINO
@@ -0,0 +1,111 @@
+#ifndef Adafruit_BusIO_Linux_h
+#define Adafruit_BusIO_Linux_h
+
+// Backends for running BusIO users natively on a Linux host through the
+// kernel's spidev and i2c-dev interfaces. Only built for non-Arduino Linux
+// targets.
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include <Adafruit_BusIO_Segment.h>
+#include <linux/spi/spidev.h>
+
+/// Most spi_ioc_transfer entries batched into one SPI_IOC_MESSAGE
+#define BUSIO_LINUX_SPI_MAXXFERS 16
+/// Largest I2C transaction, also the size of the I2C gather buffer
+#define BUSIO_LINUX_I2C_BUFSIZE 512
+
+/*!
+ * @brief Signature of the ioctl() used by the Linux backends. Installing a
+ * replacement with setIoctl() routes every transfer to an in-process fake
+ * device instead of the kernel.
+ */
+typedef int (*busio_linux_ioctl_t)(void *context, int fd, unsigned long request,
+                                   void *arg);
+
+/*!
+ * @brief SPI device on /dev/spidevB.C. Each read, write or vectored call is
+ * a single SPI_IOC_MESSAGE, so a whole frame costs one system call and CS
+ * stays asserted across its segments.
+ */
+class Adafruit_LinuxSPIDevice {
+public:
+  Adafruit_LinuxSPIDevice(const char *path, uint32_t freq = 1000000,
+                          uint8_t dataMode = 0, bool lsbFirst = false);
+  ~Adafruit_LinuxSPIDevice(void);
+
+  bool begin(void);
+  void end(void);
+  void setIoctl(busio_linux_ioctl_t func, void *context);
+
+  bool read(uint8_t *buffer, size_t len, uint8_t sendvalue = 0xFF);
+  bool write(const uint8_t *buffer, size_t len,
+             const uint8_t *prefix_buffer = nullptr, size_t prefix_len = 0);
+  bool write_then_read(const uint8_t *write_buffer, size_t write_len,
+                       uint8_t *read_buffer, size_t read_len,
+                       uint8_t sendvalue = 0xFF);
+  bool writev(const BusIO_WriteSegment *segments, uint8_t count);
+  bool readv(const BusIO_ReadSegment *segments, uint8_t count,
+             uint8_t sendvalue = 0xFF);
+
+private:
+  bool addTransfer(const uint8_t *tx, uint8_t *rx, size_t len);
+  bool submit(void);
+  int doIoctl(unsigned long request, void *arg);
+
+  const char *_path;
+  int _fd;
+  uint32_t _freq;
+  uint8_t _dataMode;
+  bool _lsbFirst;
+  busio_linux_ioctl_t _ioctl;
+  void *_ioctlContext;
+
+  struct spi_ioc_transfer _xfers[BUSIO_LINUX_SPI_MAXXFERS]; ///< One ioctl
+  uint8_t _xferCount;
+  uint8_t _fill[64]; ///< sendvalue bytes for reads into discarded segments
+  uint8_t _sink[64]; ///< Receive target for discarded bytes
+};
+
+/*!
+ * @brief I2C device on /dev/i2c-N. A write followed by a read is issued as
+ * one I2C_RDWR call with a repeated START in between.
+ */
+class Adafruit_LinuxI2CDevice {
+public:
+  Adafruit_LinuxI2CDevice(const char *path, uint8_t addr);
+  ~Adafruit_LinuxI2CDevice(void);
+
+  uint8_t address(void);
+  bool begin(bool addr_detect = true);
+  void end(void);
+  void setIoctl(busio_linux_ioctl_t func, void *context);
+
+  bool read(uint8_t *buffer, size_t len, bool stop = true);
+  bool write(const uint8_t *buffer, size_t len, bool stop = true,
+             const uint8_t *prefix_buffer = nullptr, size_t prefix_len = 0);
+  bool write_then_read(const uint8_t *write_buffer, size_t write_len,
+                       uint8_t *read_buffer, size_t read_len,
+                       bool stop = false);
+  bool writev(const BusIO_WriteSegment *segments, uint8_t count,
+              bool stop = true);
+  bool readv(const BusIO_ReadSegment *segments, uint8_t count,
+             bool stop = true);
+
+  /*!   @brief  How many bytes we can move in a transaction
+   *    @return The size of the gather buffer */
+  size_t maxBufferSize() { return BUSIO_LINUX_I2C_BUFSIZE; }
+
+private:
+  bool rdwr(const uint8_t *wbuf, size_t wlen, uint8_t *rbuf, size_t rlen);
+  int doIoctl(unsigned long request, void *arg);
+
+  const char *_path;
+  int _fd;
+  uint8_t _addr;
+  busio_linux_ioctl_t _ioctl;
+  void *_ioctlContext;
+  uint8_t _buffer[BUSIO_LINUX_I2C_BUFSIZE]; ///< Gathers vectored segments
+};
+
+#endif // __linux__ && !ARDUINO
+#endif // Adafruit_BusIO_Linux_h
@@ -116,6 +116,9 @@ Adafruit_BusIO_Register::Adafruit_BusIO_Register(
  * uncheckable)
  */
 bool Adafruit_BusIO_Register::write(uint8_t *buffer, uint8_t len) {
+  if (_cache && _cache->covers(_address, len)) {
+    return _cache->write(_address, buffer, len);
+  }
   uint8_t addrbuffer[2] = {(uint8_t)(_address & 0xFF),
                            (uint8_t)(_address >> 8)};
   if (_i2cdevice) {
@@ -217,6 +220,9 @@ uint32_t Adafruit_BusIO_Register::readCached(void) { return _cached; }
    @return true on successful read, otherwise false
 */
 bool Adafruit_BusIO_Register::read(uint8_t *buffer, uint8_t len) {
+  if (_cache && _cache->covers(_address, len)) {
+    return _cache->read(_address, buffer, len);
+  }
   uint8_t addrbuffer[2] = {(uint8_t)(_address & 0xFF),
                            (uint8_t)(_address >> 8)};
   if (_i2cdevice) {
@@ -381,4 +387,202 @@ void Adafruit_BusIO_Register::setAddressWidth(uint16_t address_width) {
   _addrwidth = address_width;
 }
 
+/*!
+ *    @brief  Route reads and writes of this register through a shadow
+ * cache. Writes, including Adafruit_BusIO_RegisterBits updates, then only
+ * touch the shadow until the cache is flushed. Do not attach registers
+ * whose value the device changes on its own (status, FIFO, ...).
+ *    @param cache The cache covering this register, or nullptr to go back to
+ * direct bus access
+ */
+void Adafruit_BusIO_Register::attachCache(Adafruit_BusIO_RegisterCache *cache) {
+  _cache = cache;
+}
+
+/*!
+ *    @brief  Create a shadow cache for a span of consecutive registers
+ *    @param  window A register on the same device used for the cache's own
+ * burst transfers. Its address is moved around by the cache, so it must
+ * not be one of the registers attached to the cache.
+ *    @param  base The address of the first register in the span
+ *    @param  size The number of bytes in the span, at most
+ * BUSIO_REGCACHE_MAXSIZE
+ *    @param  autoIncrement Set only if the device advances the register
+ * address after every byte of a multi-byte read and write (check the
+ * datasheet: some parts need a bit set in the address or a control register
+ * for it). Bursts then cover runs of registers; otherwise each register is
+ * addressed and transferred on its own.
+ */
+Adafruit_BusIO_RegisterCache::Adafruit_BusIO_RegisterCache(
+    Adafruit_BusIO_Register *window, uint16_t base, uint8_t size,
+    bool autoIncrement) {
+  _window = window;
+  _base = base;
+  _size = (size > BUSIO_REGCACHE_MAXSIZE) ? BUSIO_REGCACHE_MAXSIZE : size;
+  _autoIncrement = autoIncrement;
+}
+
+/*!
+ *    @brief  Check whether a byte range lies entirely inside the span
+ *    @param  address The first register address of the range
+ *    @param  len Number of bytes in the range
+ *    @return True if the cache can serve the whole range
+ */
+bool Adafruit_BusIO_RegisterCache::covers(uint16_t address, uint8_t len) {
+  return (address >= _base) && (len != 0) &&
+         ((uint32_t)(address - _base) + len <= _size);
+}
+
+/*!
+ *    @brief  Read a byte range through the cache. Bytes that are not in the
+ * shadow yet are fetched from the device, in a single burst if the device
+ * auto-increments; bytes with pending writes keep their shadow value.
+ *    @param  address The first register address to read
+ *    @param  buffer Buffer to read data into
+ *    @param  len Number of bytes to read
+ *    @return True on success, false if the range is not covered or the bus
+ * read failed
+ */
+bool Adafruit_BusIO_RegisterCache::read(uint16_t address, uint8_t *buffer,
+                                        uint8_t len) {
+  if (!covers(address, len)) {
+    return false;
+  }
+  uint8_t offset = address - _base;
+
+  // Find the smallest span holding every byte we don't have yet
+  int16_t first = -1, last = -1;
+  for (uint8_t i = offset; i < offset + len; i++) {
+    if (!(_valid & (1UL << i))) {
+      if (first < 0) {
+        first = i;
+      }
+      last = i;
+    }
+  }
+
+  if (first >= 0) {
+    uint8_t temp[BUSIO_REGCACHE_MAXSIZE];
+    uint8_t n = last - first + 1;
+    if (!burst(false, first, temp, n)) {
+      return false;
+    }
+    for (uint8_t i = 0; i < n; i++) {
+      uint32_t bit = 1UL << (first + i);
+      if (!(_dirty & bit)) {
+        _shadow[first + i] = temp[i];
+        _valid |= bit;
+      }
+    }
+  }
+
+  memcpy(buffer, _shadow + offset, len);
+  return true;
+}
+
+/*!
+ *    @brief  Write a byte range into the shadow and mark it for the next
+ * flush(). Nothing is sent on the bus.
+ *    @param  address The first register address to write
+ *    @param  buffer Pointer to data to write
+ *    @param  len Number of bytes to write
+ *    @return True on success, false if the range is not covered
+ */
+bool Adafruit_BusIO_RegisterCache::write(uint16_t address,
+                                         const uint8_t *buffer, uint8_t len) {
+  if (!covers(address, len)) {
+    return false;
+  }
+  uint8_t offset = address - _base;
+
+  for (uint8_t i = 0; i < len; i++) {
+    uint32_t bit = 1UL << (offset + i);
+    if (!(_valid & bit) || (_shadow[offset + i] != buffer[i])) {
+      _dirty |= bit;
+    }
+    _shadow[offset + i] = buffer[i];
+    _valid |= bit;
+  }
+  return true;
+}
+
+/*!
+ *    @brief  Fill the whole shadow from the device, keeping bytes with
+ * pending writes. This is a single burst if the device auto-increments.
+ *    @return True on success, false if the bus read failed
+ */
+bool Adafruit_BusIO_RegisterCache::load(void) {
+  uint8_t temp[BUSIO_REGCACHE_MAXSIZE];
+  _valid &= _dirty;
+  return read(_base, temp, _size);
+}
+
+/*!
+ *    @brief  Write every byte with a pending write to the device. If the
+ * device auto-increments, runs of adjacent modified bytes go out as one
+ * burst each; otherwise there is one write per modified register.
+ *    @return True on success, false if a bus write failed. Bytes that were
+ * not written stay marked for the next flush.
+ */
+bool Adafruit_BusIO_RegisterCache::flush(void) {
+  uint8_t i = 0;
+  while (i < _size) {
+    if (!(_dirty & (1UL << i))) {
+      i++;
+      continue;
+    }
+    uint8_t start = i;
+    while ((i < _size) && (_dirty & (1UL << i))) {
+      i++;
+    }
+    if (!burst(true, start, _shadow + start, i - start)) {
+      return false;
+    }
+    for (uint8_t j = start; j < i; j++) {
+      _dirty &= ~(1UL << j);
+    }
+  }
+  return true;
+}
+
+/*!
+ *    @brief  Forget the shadow contents, including pending writes, so the
+ * next read comes from the device (e.g. after a device reset)
+ */
+void Adafruit_BusIO_RegisterCache::invalidate(void) {
+  _valid = 0;
+  _dirty = 0;
+}
+
+/*!
+ *    @brief  Check for writes that have not been flushed yet
+ *    @return True if flush() has something to send
+ */
+bool Adafruit_BusIO_RegisterCache::dirty(void) { return _dirty != 0; }
+
+/*!
+ *    @brief  Move the window register onto a shadow offset and transfer a
+ * burst through it, or one register at a time if the device does not
+ * auto-increment
+ *    @param  toDevice True to write to the device, false to read from it
+ *    @param  offset Offset of the first byte from the cache base
+ *    @param  buffer Data to send or buffer to receive into
+ *    @param  len Number of bytes in the burst
+ *    @return True on success
+ */
+bool Adafruit_BusIO_RegisterCache::burst(bool toDevice, uint8_t offset,
+                                         uint8_t *buffer, uint8_t len) {
+  uint8_t step = _autoIncrement ? len : 1;
+
+  for (uint8_t i = 0; i < len; i += step) {
+    _window->setAddress(_base + offset + i);
+    bool ok = toDevice ? _window->write(buffer + i, step)
+                       : _window->read(buffer + i, step);
+    if (!ok) {
+      return false;
+    }
+  }
+  return true;
+}
+
 #endif // SPI exists
@@ -37,6 +37,11 @@ typedef enum _Adafruit_BusIO_SPIRegType {
 
 } Adafruit_BusIO_SPIRegType;
 
+/// Largest register span a single Adafruit_BusIO_RegisterCache can shadow
+#define BUSIO_REGCACHE_MAXSIZE 32
+
+class Adafruit_BusIO_RegisterCache;
+
 /*!
  * @brief The class which defines a device register (a location to read/write
  * data from)
@@ -76,6 +81,7 @@ public:
   void setWidth(uint8_t width);
   void setAddress(uint16_t address);
   void setAddressWidth(uint16_t address_width);
+  void attachCache(Adafruit_BusIO_RegisterCache *cache);
 
 #if !defined(NO_GLOBAL_INSTANCES) && !defined(NO_GLOBAL_SERIAL)
   void print(Stream *s = &Serial);
@@ -95,6 +101,7 @@ private:
   uint8_t _buffer[4]; // we won't support anything larger than uint32 for
                       // non-buffered read
   uint32_t _cached = 0;
+  Adafruit_BusIO_RegisterCache *_cache = nullptr;
 };
 
 /*!
@@ -113,5 +120,37 @@ private:
   uint8_t _bits, _shift;
 };
 
+/*!
+ * @brief A shadow copy of a span of consecutive device registers. Registers
+ * attached to it are read from and written to the shadow; only flush()
+ * writes the modified bytes back. On devices that auto-increment the
+ * register address within a transfer, adjacent bytes are coalesced into one
+ * burst; otherwise every register is transferred on its own.
+ */
+class Adafruit_BusIO_RegisterCache {
+public:
+  Adafruit_BusIO_RegisterCache(Adafruit_BusIO_Register *window, uint16_t base,
+                               uint8_t size, bool autoIncrement = false);
+
+  bool covers(uint16_t address, uint8_t len);
+  bool read(uint16_t address, uint8_t *buffer, uint8_t len);
+  bool write(uint16_t address, const uint8_t *buffer, uint8_t len);
+  bool load(void);
+  bool flush(void);
+  void invalidate(void);
+  bool dirty(void);
+
+private:
+  bool burst(bool toDevice, uint8_t offset, uint8_t *buffer, uint8_t len);
+
+  Adafruit_BusIO_Register *_window;
+  uint16_t _base;
+  uint8_t _size;
+  bool _autoIncrement;
+  uint8_t _shadow[BUSIO_REGCACHE_MAXSIZE];
+  uint32_t _valid = 0; ///< One bit per byte holding the device's value
+  uint32_t _dirty = 0; ///< One bit per byte not yet written to the device
+};
+
 #endif // SPI exists
 #endif // BusIO_Register_h
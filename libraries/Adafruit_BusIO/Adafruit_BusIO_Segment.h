@@ -0,0 +1,29 @@
+#ifndef Adafruit_BusIO_Segment_h
+#define Adafruit_BusIO_Segment_h
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#else
+#include <stddef.h>
+#include <stdint.h>
+#endif
+
+/*!
+ * @brief One piece of a vectored write. The segments of a writev() call are
+ * sent back to back in a single bus transaction.
+ */
+typedef struct {
+  const uint8_t *data; ///< Bytes to send
+  size_t len;          ///< Number of bytes in this segment
+} BusIO_WriteSegment;
+
+/*!
+ * @brief One piece of a vectored read. The bytes of a readv() transaction
+ * are scattered over the segments in order.
+ */
+typedef struct {
+  uint8_t *data; ///< Destination, or nullptr to discard these bytes
+  size_t len;    ///< Number of bytes in this segment
+} BusIO_ReadSegment;
+
+#endif // Adafruit_BusIO_Segment_h
@@ -62,6 +62,41 @@ bool Adafruit_GenericDevice::read(uint8_t *buffer, size_t len) {
   return _read_func(_obj, buffer, len);
 }
 
+/*! @brief Write several buffers back to back. The generic transport has no
+   framing of its own, so each segment is handed to the write function in
+   turn; nothing is copied into a temporary packet.
+   @param segments Array of buffers to write, in order
+   @param count Number of entries in segments
+   @return true if every segment was written, otherwise false */
+bool Adafruit_GenericDevice::writev(const BusIO_WriteSegment *segments,
+                                    uint8_t count) {
+  if (!_begun)
+    return false;
+  for (uint8_t i = 0; i < count; i++) {
+    if ((segments[i].len != 0) &&
+        !_write_func(_obj, segments[i].data, segments[i].len))
+      return false;
+  }
+  return true;
+}
+
+/*! @brief Read data into several buffers, in order
+   @param segments Array of buffers to fill. Every segment needs a valid
+   data pointer since the read function has nowhere else to put the bytes.
+   @param count Number of entries in segments
+   @return true if every segment was read, otherwise false */
+bool Adafruit_GenericDevice::readv(const BusIO_ReadSegment *segments,
+                                   uint8_t count) {
+  if (!_begun)
+    return false;
+  for (uint8_t i = 0; i < count; i++) {
+    if ((segments[i].len != 0) &&
+        !_read_func(_obj, segments[i].data, segments[i].len))
+      return false;
+  }
+  return true;
+}
+
 /*! @brief Read from a register location
    @param addr_buf Buffer containing register address
    @param addrsiz Size of register address in bytes
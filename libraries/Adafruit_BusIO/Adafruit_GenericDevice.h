@@ -1,6 +1,7 @@
 #ifndef ADAFRUIT_GENERICDEVICE_H
 #define ADAFRUIT_GENERICDEVICE_H
 
+#include <Adafruit_BusIO_Segment.h>
 #include <Arduino.h>
 
 typedef bool (*busio_genericdevice_read_t)(void *obj, uint8_t *buffer,
@@ -31,6 +32,8 @@ public:
 
   bool read(uint8_t *buffer, size_t len);
   bool write(const uint8_t *buffer, size_t len);
+  bool writev(const BusIO_WriteSegment *segments, uint8_t count);
+  bool readv(const BusIO_ReadSegment *segments, uint8_t count);
   bool readRegister(uint8_t *addr_buf, uint8_t addrsiz, uint8_t *buf,
                     uint16_t bufsiz);
   bool writeRegister(uint8_t *addr_buf, uint8_t addrsiz, const uint8_t *buf,
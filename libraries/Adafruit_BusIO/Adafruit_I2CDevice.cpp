@@ -173,8 +173,9 @@ bool Adafruit_I2CDevice::write(const uint8_t *buffer, size_t len, bool stop,
 }
 
 /*!
- *    @brief  Read from I2C into a buffer from the I2C device.
- *    Cannot be more than maxBufferSize() bytes.
+ *    @brief  Read from I2C into a buffer from the I2C device. Reads longer
+ * than maxBufferSize() are split into several requests joined by repeated
+ * STARTs, each landing directly in buffer.
  *    @param  buffer Pointer to buffer of data to read into
  *    @param  len Number of bytes from buffer to read.
  *    @param  stop Whether to send an I2C STOP signal on read
@@ -194,13 +195,7 @@ bool Adafruit_I2CDevice::read(uint8_t *buffer, size_t len, bool stop) {
 }
 
 bool Adafruit_I2CDevice::_read(uint8_t *buffer, size_t len, bool stop) {
-#if defined(TinyWireM_h)
-  size_t recv = _wire->requestFrom((uint8_t)_addr, (uint8_t)len);
-#elif defined(ARDUINO_ARCH_MEGAAVR)
-  size_t recv = _wire->requestFrom(_addr, len, stop);
-#else
-  size_t recv = _wire->requestFrom((uint8_t)_addr, (uint8_t)len, (uint8_t)stop);
-#endif
+  size_t recv = _requestFrom(len, stop);
 
   if (recv != len) {
     // Not enough data available to fulfill our obligation!
@@ -233,6 +228,103 @@ bool Adafruit_I2CDevice::_read(uint8_t *buffer, size_t len, bool stop) {
   return true;
 }
 
+size_t Adafruit_I2CDevice::_requestFrom(size_t len, bool stop) {
+#if defined(TinyWireM_h)
+  return _wire->requestFrom((uint8_t)_addr, (uint8_t)len);
+#elif defined(ARDUINO_ARCH_MEGAAVR)
+  return _wire->requestFrom(_addr, len, stop);
+#else
+  return _wire->requestFrom((uint8_t)_addr, (uint8_t)len, (uint8_t)stop);
+#endif
+}
+
+/*!
+ *    @brief  Write several buffers to the I2C device as one transaction, e.g.
+ * a register address followed by data that lives elsewhere, without first
+ * copying them together. The combined length cannot be more than
+ * maxBufferSize() bytes.
+ *    @param  segments Array of buffers to send, in order
+ *    @param  count Number of entries in segments
+ *    @param  stop Whether to send an I2C STOP signal on write
+ *    @return True if write was successful, otherwise false.
+ */
+bool Adafruit_I2CDevice::writev(const BusIO_WriteSegment *segments,
+                                uint8_t count, bool stop) {
+  size_t total = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    total += segments[i].len;
+  }
+  if (total > maxBufferSize()) {
+#ifdef DEBUG_SERIAL
+    DEBUG_SERIAL.println(F("\tI2CDevice could not write such a large buffer"));
+#endif
+    return false;
+  }
+
+  _wire->beginTransmission(_addr);
+  for (uint8_t i = 0; i < count; i++) {
+    if ((segments[i].len != 0) &&
+        (_wire->write(segments[i].data, segments[i].len) != segments[i].len)) {
+#ifdef DEBUG_SERIAL
+      DEBUG_SERIAL.println(F("\tI2CDevice failed to write"));
+#endif
+      return false;
+    }
+  }
+
+  return (_wire->endTransmission(stop) == 0);
+}
+
+/*!
+ *    @brief  Read from the I2C device and scatter the bytes over several
+ * buffers, e.g. to drop a status byte or split a header from its payload
+ * without an intermediate copy. Transfers longer than maxBufferSize() are
+ * split into several reads without a STOP in between.
+ *    @param  segments Array of buffers to fill, in order. A segment with a
+ * nullptr data pointer skips that many bytes.
+ *    @param  count Number of entries in segments
+ *    @param  stop Whether to send an I2C STOP signal after the last byte
+ *    @return True if read was successful, otherwise false.
+ */
+bool Adafruit_I2CDevice::readv(const BusIO_ReadSegment *segments,
+                               uint8_t count, bool stop) {
+  size_t total = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    total += segments[i].len;
+  }
+
+  uint8_t seg = 0;
+  size_t offset = 0;
+  size_t pos = 0;
+  while (pos < total) {
+    size_t read_len =
+        ((total - pos) > maxBufferSize()) ? maxBufferSize() : (total - pos);
+    bool read_stop = (pos < (total - read_len)) ? false : stop;
+    size_t recv = _requestFrom(read_len, read_stop);
+    if (recv != read_len) {
+#ifdef DEBUG_SERIAL
+      DEBUG_SERIAL.print(F("\tI2CDevice did not receive enough data: "));
+      DEBUG_SERIAL.println(recv);
+#endif
+      return false;
+    }
+
+    for (size_t i = 0; i < read_len; i++) {
+      while (offset == segments[seg].len) {
+        seg++;
+        offset = 0;
+      }
+      uint8_t b = _wire->read();
+      if (segments[seg].data != nullptr) {
+        segments[seg].data[offset] = b;
+      }
+      offset++;
+    }
+    pos += read_len;
+  }
+  return true;
+}
+
 /*!
  *    @brief  Write some data, then read some data from I2C into another buffer.
  *    Cannot be more than maxBufferSize() bytes. The buffers can point to
@@ -2,6 +2,7 @@
 #define Adafruit_I2CDevice_h
 
 #include <Arduino.h>
+#include <Adafruit_BusIO_Segment.h>
 #include <Wire.h>
 
 ///< The class which defines how we will talk to this device over I2C
@@ -19,6 +20,10 @@ public:
   bool write_then_read(const uint8_t *write_buffer, size_t write_len,
                        uint8_t *read_buffer, size_t read_len,
                        bool stop = false);
+  bool writev(const BusIO_WriteSegment *segments, uint8_t count,
+              bool stop = true);
+  bool readv(const BusIO_ReadSegment *segments, uint8_t count,
+             bool stop = true);
   bool setSpeed(uint32_t desiredclk);
 
   /*!   @brief  How many bytes we can read in a transaction
@@ -31,6 +36,7 @@ private:
   bool _begun;
   size_t _maxBufferSize;
   bool _read(uint8_t *buffer, size_t len, bool stop);
+  size_t _requestFrom(size_t len, bool stop);
 };
 
 #endif // Adafruit_I2CDevice_h
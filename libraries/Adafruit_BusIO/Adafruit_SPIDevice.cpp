@@ -20,6 +20,21 @@
 #define BUSIO_WRITE_MOSI(value) digitalWrite(_mosi, value)
 #endif
 
+// One software SPI bit in mode 0/2 with no bit delay: set MOSI only when it
+// changes, raise the clock, sample MISO, lower the clock
+#define BUSIO_SOFT_BIT_FAST(bit)                                               \
+  do {                                                                         \
+    towrite = send & (bit);                                                    \
+    if (lastmosi != towrite) {                                                 \
+      BUSIO_WRITE_MOSI(towrite);                                               \
+      lastmosi = towrite;                                                      \
+    }                                                                          \
+    BUSIO_SET_CLOCK_HIGH();                                                    \
+    if (BUSIO_READ_MISO())                                                     \
+      reply |= (bit);                                                          \
+    BUSIO_SET_CLOCK_LOW();                                                     \
+  } while (0)
+
 /*!
  *    @brief  Create an SPI device with the given CS pin and settings
  *    @param  cspin The arduino pin number to use for chip select
@@ -41,6 +56,7 @@ Adafruit_SPIDevice::Adafruit_SPIDevice(int8_t cspin, uint32_t freq,
   _freq = freq;
   _dataOrder = dataOrder;
   _dataMode = dataMode;
+  _softFastPath = false;
 #else
   // unused, but needed to suppress compiler warns
   (void)cspin;
@@ -92,6 +108,12 @@ Adafruit_SPIDevice::Adafruit_SPIDevice(int8_t cspin, int8_t sckpin,
   _dataOrder = dataOrder;
   _dataMode = dataMode;
   _begun = false;
+
+  // Decide once whether transfer() can skip the per-bit mode, bit order and
+  // delay checks: full duplex mode 0/2 fast enough to need no bit delay
+  _softFastPath = ((dataMode == SPI_MODE0) || (dataMode == SPI_MODE2)) &&
+                  (misopin != -1) && (mosipin != -1) &&
+                  (((1000000 / freq) / 2) == 0);
 }
 
 /*!
@@ -168,8 +190,14 @@ void Adafruit_SPIDevice::transfer(uint8_t *buffer, size_t len) {
   //
   // SOFTWARE SPI
   //
+  if (_softFastPath) {
+    softTransferFast(buffer, len);
+    return;
+  }
+
   uint8_t startbit;
-  if (_dataOrder == SPI_BITORDER_LSBFIRST) {
+  bool lsbfirst = (_dataOrder == SPI_BITORDER_LSBFIRST);
+  if (lsbfirst) {
     startbit = 0x1;
   } else {
     startbit = 0x80;
@@ -189,8 +217,7 @@ void Adafruit_SPIDevice::transfer(uint8_t *buffer, size_t len) {
     */
 
     // Serial.print(send, HEX);
-    for (uint8_t b = startbit; b != 0;
-         b = (_dataOrder == SPI_BITORDER_LSBFIRST) ? b << 1 : b >> 1) {
+    for (uint8_t b = startbit; b != 0; b = lsbfirst ? b << 1 : b >> 1) {
 
       if (bitdelay_us) {
         delayMicroseconds(bitdelay_us);
@@ -268,6 +295,49 @@ void Adafruit_SPIDevice::transfer(uint8_t *buffer, size_t len) {
   return;
 }
 
+/*!
+ *    @brief  Software SPI transfer for mode 0/2 with MOSI and MISO wired and
+ * no bit delay. The bit order is checked once per call and each byte is an
+ * unrolled sequence of eight clock pulses.
+ *    @param  buffer The buffer to send and receive at the same time
+ *    @param  len    The number of bytes to transfer
+ */
+void Adafruit_SPIDevice::softTransferFast(uint8_t *buffer, size_t len) {
+  bool towrite, lastmosi;
+
+  if (_dataOrder == SPI_BITORDER_LSBFIRST) {
+    lastmosi = !(buffer[0] & 0x01);
+    for (size_t i = 0; i < len; i++) {
+      uint8_t reply = 0;
+      uint8_t send = buffer[i];
+      BUSIO_SOFT_BIT_FAST(0x01);
+      BUSIO_SOFT_BIT_FAST(0x02);
+      BUSIO_SOFT_BIT_FAST(0x04);
+      BUSIO_SOFT_BIT_FAST(0x08);
+      BUSIO_SOFT_BIT_FAST(0x10);
+      BUSIO_SOFT_BIT_FAST(0x20);
+      BUSIO_SOFT_BIT_FAST(0x40);
+      BUSIO_SOFT_BIT_FAST(0x80);
+      buffer[i] = reply;
+    }
+  } else {
+    lastmosi = !(buffer[0] & 0x80);
+    for (size_t i = 0; i < len; i++) {
+      uint8_t reply = 0;
+      uint8_t send = buffer[i];
+      BUSIO_SOFT_BIT_FAST(0x80);
+      BUSIO_SOFT_BIT_FAST(0x40);
+      BUSIO_SOFT_BIT_FAST(0x20);
+      BUSIO_SOFT_BIT_FAST(0x10);
+      BUSIO_SOFT_BIT_FAST(0x08);
+      BUSIO_SOFT_BIT_FAST(0x04);
+      BUSIO_SOFT_BIT_FAST(0x02);
+      BUSIO_SOFT_BIT_FAST(0x01);
+      buffer[i] = reply;
+    }
+  }
+}
+
 /*!
  *    @brief  Transfer (send/receive) one byte over hard/soft SPI, without
  * transaction management
@@ -510,3 +580,239 @@ bool Adafruit_SPIDevice::write_and_read(uint8_t *buffer, size_t len) {
 
   return true;
 }
+
+/*!
+ *    @brief  Write several buffers to the SPI device within one CS assertion,
+ * e.g. a command header, a payload and a trailer, without copying them into
+ * a single packet first.
+ *    @param  segments Array of buffers to send, in order
+ *    @param  count Number of entries in segments
+ *    @return Always returns true because there's no way to test success of SPI
+ * writes
+ */
+bool Adafruit_SPIDevice::writev(const BusIO_WriteSegment *segments,
+                                uint8_t count) {
+  beginTransactionWithAssertingCS();
+  for (uint8_t s = 0; s < count; s++) {
+#if defined(ARDUINO_ARCH_ESP32)
+    if (_spi) {
+      if (segments[s].len > 0) {
+        _spi->transferBytes((uint8_t *)segments[s].data, nullptr,
+                            segments[s].len);
+      }
+    } else
+#endif
+    {
+      for (size_t i = 0; i < segments[s].len; i++) {
+        transfer(segments[s].data[i]);
+      }
+    }
+  }
+  endTransactionWithDeassertingCS();
+
+  return true;
+}
+
+/*!
+ *    @brief  Read from the SPI device within one CS assertion, scattering the
+ * bytes over several buffers.
+ *    @param  segments Array of buffers to fill, in order. A segment with a
+ * nullptr data pointer clocks that many bytes and discards them.
+ *    @param  count Number of entries in segments
+ *    @param  sendvalue The 8-bits of data to write when doing the data read,
+ * defaults to 0xFF
+ *    @return Always returns true because there's no way to test success of SPI
+ * writes
+ */
+bool Adafruit_SPIDevice::readv(const BusIO_ReadSegment *segments,
+                               uint8_t count, uint8_t sendvalue) {
+  beginTransactionWithAssertingCS();
+  for (uint8_t s = 0; s < count; s++) {
+    if (segments[s].data != nullptr) {
+      memset(segments[s].data, sendvalue, segments[s].len);
+      transfer(segments[s].data, segments[s].len);
+    } else {
+      for (size_t i = 0; i < segments[s].len; i++) {
+        transfer(sendvalue);
+      }
+    }
+  }
+  endTransactionWithDeassertingCS();
+
+  return true;
+}
+
+/*!
+ *    @brief  Queue a transfer to run in the background. The transfer is
+ * started right away if the queue is idle, otherwise it runs after every
+ * transfer queued before it. Its callback runs once it has completed.
+ *    @param  xfer The transfer descriptor, which must stay valid until
+ * completion
+ *    @return True if the transfer was queued, false if it was invalid
+ */
+bool Adafruit_SPIDevice::queueTransfer(BusIO_SPITransfer *xfer) {
+  if ((xfer == nullptr) || (xfer->len == 0)) {
+    return false;
+  }
+  xfer->done = false;
+  xfer->next = nullptr;
+
+  noInterrupts();
+  if (_xferHead == nullptr) {
+    _xferHead = xfer;
+  } else {
+    _xferTail->next = xfer;
+  }
+  _xferTail = xfer;
+  interrupts();
+
+  poll();
+  return true;
+}
+
+/*!
+ *    @brief  Check whether queued transfers are still outstanding
+ *    @return True if at least one queued transfer has not completed
+ */
+bool Adafruit_SPIDevice::transferBusy(void) { return _xferHead != nullptr; }
+
+/*!
+ *    @brief  Start the next queued transfer if none is in progress. Call
+ * this from the main loop between other work. Without a backend the
+ * transfer runs to completion inside this call, one transfer per call. With
+ * a backend it is only started here; its completion interrupt finishes it
+ * and starts the next queued transfer.
+ */
+void Adafruit_SPIDevice::poll(void) {
+  BusIO_SPITransfer *xfer;
+
+  noInterrupts();
+  xfer = _xferActive ? nullptr : _xferHead;
+  if (xfer != nullptr) {
+    _xferActive = true;
+  }
+  interrupts();
+
+  if (xfer != nullptr) {
+    startTransfer(xfer);
+  }
+}
+
+/*!
+ *    @brief  Set the backend that runs queued transfers asynchronously, for
+ * example by handing the buffers to a DMA channel. Only change it while no
+ * transfer is queued.
+ *    @param  start The backend start function, or nullptr to run transfers
+ * with the portable software loop
+ *    @param  context Passed back to the start and stop functions
+ *    @param  stop Stops a running backend transfer for cancelTransfers(),
+ * or nullptr if the backend cannot be stopped
+ */
+void Adafruit_SPIDevice::setTransferBackend(busio_spi_start_t start,
+                                            void *context,
+                                            busio_spi_stop_t stop) {
+  _xferStart = start;
+  _xferStop = stop;
+  _xferStartContext = context;
+}
+
+/*!
+ *    @brief  Drop every queued transfer that has not completed and release
+ * CS, for a caller that gives up waiting on a stuck peripheral. A transfer
+ * running on the backend is stopped with the backend's stop function.
+ * Dropped transfers are not marked done and their callbacks do not run, so
+ * their descriptors can be reused as soon as this returns.
+ */
+void Adafruit_SPIDevice::cancelTransfers(void) {
+  noInterrupts();
+  BusIO_SPITransfer *running = _xferActive ? _xferHead : nullptr;
+  bool async = _xferAsync;
+  _xferHead = nullptr;
+  _xferTail = nullptr;
+  _xferActive = false;
+  _xferAsync = false;
+  if (async && (running != nullptr) && (_xferStop != nullptr)) {
+    _xferStop(_xferStartContext, this, running);
+  }
+  interrupts();
+
+  if ((running != nullptr) || _xferHoldingCS) {
+    endTransactionWithDeassertingCS();
+  }
+  _xferHoldingCS = false;
+}
+
+/*!
+ *    @brief  Start clocking a transfer. A backend that accepts the transfer
+ * returns right away and calls transferComplete() from its completion
+ * interrupt. Otherwise the transfer runs with transfer() and completes
+ * immediately.
+ *    @param  xfer The transfer at the head of the queue
+ */
+void Adafruit_SPIDevice::startTransfer(BusIO_SPITransfer *xfer) {
+  if (!_xferHoldingCS) {
+    beginTransactionWithAssertingCS();
+  }
+
+  if (_xferStart != nullptr) {
+    _xferAsync = true;
+    if (_xferStart(_xferStartContext, this, xfer)) {
+      return;
+    }
+    _xferAsync = false;
+  }
+
+  if (xfer->rx != nullptr) {
+    if (xfer->tx == nullptr) {
+      memset(xfer->rx, 0xFF, xfer->len);
+    } else if (xfer->tx != xfer->rx) {
+      memcpy(xfer->rx, xfer->tx, xfer->len);
+    }
+    transfer(xfer->rx, xfer->len);
+  } else {
+    for (size_t i = 0; i < xfer->len; i++) {
+      transfer((xfer->tx != nullptr) ? xfer->tx[i] : (uint8_t)0xFF);
+    }
+  }
+
+  transferComplete();
+}
+
+/*!
+ *    @brief  Complete the transfer at the head of the queue, release CS
+ * unless the transfer asked to hold it and run its callback. After a
+ * backend transfer the next queued one is started from here, so the queue
+ * drains from the completion interrupt; after a software transfer it is
+ * started by the following poll(). Safe to call from an interrupt handler.
+ */
+void Adafruit_SPIDevice::transferComplete(void) {
+  BusIO_SPITransfer *xfer = _xferHead;
+  if (xfer == nullptr) {
+    return;
+  }
+  bool chain = _xferAsync;
+  _xferAsync = false;
+
+  _xferHead = xfer->next;
+  if (_xferHead == nullptr) {
+    _xferTail = nullptr;
+  }
+  _xferActive = false;
+
+  _xferHoldingCS = xfer->holdCS;
+  if (!_xferHoldingCS) {
+    endTransactionWithDeassertingCS();
+  }
+
+  xfer->done = true;
+  if (xfer->callback != nullptr) {
+    xfer->callback(xfer);
+  }
+
+  // Interrupts are off in the completion handler, so nothing races with
+  // this check and the queue can be walked without poll()
+  if (chain && (_xferHead != nullptr) && !_xferActive) {
+    _xferActive = true;
+    startTransfer(_xferHead);
+  }
+}
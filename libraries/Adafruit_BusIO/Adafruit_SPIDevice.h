@@ -1,6 +1,7 @@
 #ifndef Adafruit_SPIDevice_h
 #define Adafruit_SPIDevice_h
 
+#include <Adafruit_BusIO_Segment.h>
 #include <Arduino.h>
 
 #if !defined(SPI_INTERFACES_COUNT) ||                                          \
@@ -91,6 +92,47 @@ typedef uint32_t BusIO_PortMask;
 #undef BUSIO_USE_FAST_PINIO
 #endif
 
+struct BusIO_SPITransfer;
+
+/*! @brief Completion callback for a queued SPI transfer */
+typedef void (*busio_spi_callback_t)(BusIO_SPITransfer *xfer);
+
+/*!
+ * @brief Descriptor for one queued SPI transfer. It is owned by the caller
+ * and must stay valid until its callback has run.
+ */
+struct BusIO_SPITransfer {
+  const uint8_t *tx; ///< Data to send, or nullptr to clock out 0xFF
+  uint8_t *rx;       ///< Buffer for received data, or nullptr to discard it
+  size_t len;        ///< Number of bytes to clock
+  bool holdCS; ///< Keep CS asserted so the next queued transfer continues
+               ///< the same transaction
+  busio_spi_callback_t callback; ///< Called on completion, may be nullptr
+  void *context;                 ///< Caller data for the callback
+  volatile bool done;            ///< Set once the transfer has completed
+  BusIO_SPITransfer *next;       ///< Queue link, managed by the device
+};
+
+class Adafruit_SPIDevice;
+
+/*!
+ * @brief Starts a queued transfer on an asynchronous backend such as DMA.
+ * Returns true once the peripheral owns the transfer, the backend then calls
+ * Adafruit_SPIDevice::transferComplete() from its completion interrupt.
+ * Returns false to have the transfer run by the portable software loop.
+ * CS is already asserted when it is called.
+ */
+typedef bool (*busio_spi_start_t)(void *context, Adafruit_SPIDevice *dev,
+                                  BusIO_SPITransfer *xfer);
+
+/*!
+ * @brief Stops the transfer a backend is running, called by
+ * Adafruit_SPIDevice::cancelTransfers(). Once it returns the backend must
+ * not touch the transfer's buffers or call transferComplete() for it.
+ */
+typedef void (*busio_spi_stop_t)(void *context, Adafruit_SPIDevice *dev,
+                                 BusIO_SPITransfer *xfer);
+
 /**! The class which defines how we will talk to this device over SPI **/
 class Adafruit_SPIDevice {
 public:
@@ -117,6 +159,9 @@ public:
                        uint8_t *read_buffer, size_t read_len,
                        uint8_t sendvalue = 0xFF);
   bool write_and_read(uint8_t *buffer, size_t len);
+  bool writev(const BusIO_WriteSegment *segments, uint8_t count);
+  bool readv(const BusIO_ReadSegment *segments, uint8_t count,
+             uint8_t sendvalue = 0xFF);
 
   uint8_t transfer(uint8_t send);
   void transfer(uint8_t *buffer, size_t len);
@@ -125,6 +170,14 @@ public:
   void beginTransactionWithAssertingCS();
   void endTransactionWithDeassertingCS();
 
+  bool queueTransfer(BusIO_SPITransfer *xfer);
+  bool transferBusy(void);
+  void poll(void);
+  void transferComplete(void);
+  void cancelTransfers(void);
+  void setTransferBackend(busio_spi_start_t start, void *context = nullptr,
+                          busio_spi_stop_t stop = nullptr);
+
 private:
 #ifdef BUSIO_HAS_HW_SPI
   SPIClass *_spi = nullptr;
@@ -136,7 +189,19 @@ private:
   uint32_t _freq;
   BusIOBitOrder _dataOrder;
   uint8_t _dataMode;
+  bool _softFastPath; ///< Soft SPI can use the unrolled mode 0/2 loop
   void setChipSelect(int value);
+  void softTransferFast(uint8_t *buffer, size_t len);
+  void startTransfer(BusIO_SPITransfer *xfer);
+
+  BusIO_SPITransfer *volatile _xferHead = nullptr; ///< Oldest queued transfer
+  BusIO_SPITransfer *_xferTail = nullptr;          ///< Newest queued transfer
+  volatile bool _xferActive = false; ///< Head transfer has been started
+  bool _xferHoldingCS = false;       ///< CS is held from the last transfer
+  volatile bool _xferAsync = false;  ///< Head transfer is run by the backend
+  busio_spi_start_t _xferStart = nullptr; ///< Asynchronous backend, if any
+  busio_spi_stop_t _xferStop = nullptr;   ///< Stops a backend transfer
+  void *_xferStartContext = nullptr;      ///< Context for the backend
 
   int8_t _cs, _sck, _mosi, _miso;
 #ifdef BUSIO_USE_FAST_PINIO
@@ -0,0 +1,68 @@
+#include <Adafruit_BusIO_Register.h>
+#include <Adafruit_I2CDevice.h>
+
+#define I2C_ADDRESS 0x60
+Adafruit_I2CDevice i2c_dev = Adafruit_I2CDevice(I2C_ADDRESS);
+
+// Configuration registers 0x20-0x27 are shadowed; 'window' is only used by
+// the cache itself to move bursts in and out of the device. The last
+// argument says the device auto-increments the register address during
+// multi-byte transfers: leave it out if the datasheet doesn't promise that.
+Adafruit_BusIO_Register window = Adafruit_BusIO_Register(&i2c_dev, 0x20);
+Adafruit_BusIO_RegisterCache config_cache =
+    Adafruit_BusIO_RegisterCache(&window, 0x20, 8, true);
+
+Adafruit_BusIO_Register ctrl1_reg = Adafruit_BusIO_Register(&i2c_dev, 0x20);
+Adafruit_BusIO_Register ctrl2_reg = Adafruit_BusIO_Register(&i2c_dev, 0x21);
+Adafruit_BusIO_Register ctrl5_reg = Adafruit_BusIO_Register(&i2c_dev, 0x24);
+
+void setup() {
+  while (!Serial) {
+    delay(10);
+  }
+  Serial.begin(115200);
+  Serial.println("I2C device register cache test");
+
+  if (!i2c_dev.begin()) {
+    Serial.print("Did not find device at 0x");
+    Serial.println(i2c_dev.address(), HEX);
+    while (1)
+      ;
+  }
+  Serial.print("Device found on address 0x");
+  Serial.println(i2c_dev.address(), HEX);
+
+  ctrl1_reg.attachCache(&config_cache);
+  ctrl2_reg.attachCache(&config_cache);
+  ctrl5_reg.attachCache(&config_cache);
+
+  // One burst read fills the shadow for all eight registers
+  if (!config_cache.load()) {
+    Serial.println("Failed to read configuration registers");
+    while (1)
+      ;
+  }
+
+  // These read-modify-writes only touch the shadow, no bus traffic
+  Adafruit_BusIO_RegisterBits odr =
+      Adafruit_BusIO_RegisterBits(&ctrl1_reg, 4, 4);
+  Adafruit_BusIO_RegisterBits range =
+      Adafruit_BusIO_RegisterBits(&ctrl2_reg, 2, 0);
+  Adafruit_BusIO_RegisterBits int_en =
+      Adafruit_BusIO_RegisterBits(&ctrl5_reg, 1, 7);
+  odr.write(0x5);
+  range.write(0x2);
+  int_en.write(1);
+
+  // 0x20-0x21 go out as one burst, 0x24 as another
+  uint32_t start = micros();
+  config_cache.flush();
+  Serial.print("Flushed in ");
+  Serial.print(micros() - start);
+  Serial.println(" us");
+
+  Serial.print("CTRL1 = 0x");
+  Serial.println(ctrl1_reg.read(), HEX);
+}
+
+void loop() {}
@@ -0,0 +1,160 @@
+/*!
+ * @file Arduino.cpp
+ *
+ * Linux implementation of the runtime declared in Arduino.h.
+ */
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include "Arduino.h"
+#include <errno.h>
+#include <sched.h>
+#include <stdio.h>
+#include <time.h>
+
+HardwareSerial Serial;
+
+/*!
+ *    @brief  Read the monotonic clock in microseconds since the first call,
+ * so millis() and micros() start near zero and wrap like on a board
+ *    @return Elapsed microseconds
+ */
+static uint64_t elapsedUs(void) {
+  static uint64_t startUs = 0;
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  uint64_t now = (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000U;
+  if (startUs == 0) {
+    startUs = now;
+  }
+  return now - startUs;
+}
+
+/*!
+ *    @brief  Sleep for the full interval, resuming after signals
+ *    @param  us Microseconds to sleep
+ */
+static void sleepUs(uint64_t us) {
+  struct timespec ts;
+  ts.tv_sec = (time_t)(us / 1000000ULL);
+  ts.tv_nsec = (long)(us % 1000000ULL) * 1000L;
+  while ((nanosleep(&ts, &ts) != 0) && (errno == EINTR)) {
+  }
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  (void)pin;
+  (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+  (void)pin;
+  (void)val;
+}
+
+int digitalRead(uint8_t pin) {
+  (void)pin;
+  return HIGH;
+}
+
+void delay(unsigned long ms) { sleepUs((uint64_t)ms * 1000U); }
+
+void delayMicroseconds(unsigned int us) { sleepUs(us); }
+
+unsigned long millis(void) { return (unsigned long)(elapsedUs() / 1000U); }
+
+unsigned long micros(void) { return (unsigned long)elapsedUs(); }
+
+void yield(void) { sched_yield(); }
+
+void noInterrupts(void) {}
+
+void interrupts(void) {}
+
+size_t Print::write(uint8_t c) { return fwrite(&c, 1, 1, stdout); }
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+  size_t n = 0;
+  while (size-- > 0) {
+    n += write(*buffer++);
+  }
+  return n;
+}
+
+size_t Print::printNumber(unsigned long n, int base) {
+  char buf[8 * sizeof(long) + 1];
+  char *str = &buf[sizeof(buf) - 1];
+
+  *str = '\0';
+  if (base < 2) {
+    base = 10;
+  }
+  do {
+    unsigned long digit = n % base;
+    n /= base;
+    *--str = (char)((digit < 10) ? ('0' + digit) : ('A' + digit - 10));
+  } while (n != 0);
+  return print(str);
+}
+
+size_t Print::print(const char *str) {
+  return write((const uint8_t *)str, strlen(str));
+}
+
+size_t Print::print(char c) { return write((uint8_t)c); }
+
+size_t Print::print(unsigned char n, int base) {
+  return printNumber(n, base);
+}
+
+size_t Print::print(int n, int base) { return print((long)n, base); }
+
+size_t Print::print(unsigned int n, int base) {
+  return printNumber(n, base);
+}
+
+size_t Print::print(long n, int base) {
+  if ((base == DEC) && (n < 0)) {
+    return print('-') + printNumber(0UL - (unsigned long)n, base);
+  }
+  return printNumber((unsigned long)n, base);
+}
+
+size_t Print::print(unsigned long n, int base) {
+  return printNumber(n, base);
+}
+
+size_t Print::print(double n, int digits) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%.*f", digits, n);
+  return print(buf);
+}
+
+size_t Print::println(void) { return print("\r\n"); }
+
+size_t Print::println(const char *str) { return print(str) + println(); }
+
+size_t Print::println(char c) { return print(c) + println(); }
+
+size_t Print::println(unsigned char n, int base) {
+  return print(n, base) + println();
+}
+
+size_t Print::println(int n, int base) { return print(n, base) + println(); }
+
+size_t Print::println(unsigned int n, int base) {
+  return print(n, base) + println();
+}
+
+size_t Print::println(long n, int base) { return print(n, base) + println(); }
+
+size_t Print::println(unsigned long n, int base) {
+  return print(n, base) + println();
+}
+
+size_t Print::println(double n, int digits) {
+  return print(n, digits) + println();
+}
+
+#endif // __linux__ && !ARDUINO
@@ -0,0 +1,109 @@
+/*!
+ * @file Arduino.h
+ *
+ * Minimal Arduino runtime for running BusIO users natively on Linux with
+ * the spidev and i2c-dev backends (see Adafruit_BusIO_Linux.h). Time is
+ * real: millis() and micros() follow CLOCK_MONOTONIC from the first call
+ * and delay() sleeps. There are no GPIOs: pinMode() and digitalWrite() do
+ * nothing and digitalRead() reads HIGH, so drivers must run without IRQ or
+ * reset pins (pass -1). Serial prints to stdout and never has input.
+ *
+ * Put this directory on the include path instead of an Arduino core and
+ * compile Arduino.cpp with the program. Unlike test/host, which simulates
+ * time for deterministic tests, this runtime is for talking to hardware.
+ */
+
+#ifndef BusIO_Linux_Arduino_h
+#define BusIO_Linux_Arduino_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define DEC 10
+#define HEX 16
+
+#define PROGMEM
+#define F(string_literal) (string_literal)
+
+typedef enum { LSBFIRST = 0, MSBFIRST = 1 } BitOrder;
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+unsigned long millis(void);
+unsigned long micros(void);
+void yield(void);
+
+void noInterrupts(void);
+void interrupts(void);
+
+/*! @brief Character output, written to stdout */
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c);
+  virtual size_t write(const uint8_t *buffer, size_t size);
+
+  size_t print(const char *str);
+  size_t print(char c);
+  size_t print(unsigned char n, int base = DEC);
+  size_t print(int n, int base = DEC);
+  size_t print(unsigned int n, int base = DEC);
+  size_t print(long n, int base = DEC);
+  size_t print(unsigned long n, int base = DEC);
+  size_t print(double n, int digits = 2);
+
+  size_t println(void);
+  size_t println(const char *str);
+  size_t println(char c);
+  size_t println(unsigned char n, int base = DEC);
+  size_t println(int n, int base = DEC);
+  size_t println(unsigned int n, int base = DEC);
+  size_t println(long n, int base = DEC);
+  size_t println(unsigned long n, int base = DEC);
+  size_t println(double n, int digits = 2);
+
+private:
+  size_t printNumber(unsigned long n, int base);
+};
+
+/*! @brief Input side of a serial port, without input on Linux */
+class Stream : public Print {
+public:
+  virtual int available(void) { return 0; }
+  virtual int read(void) { return -1; }
+  virtual int peek(void) { return -1; }
+  void flush(void) {}
+  void setTimeout(unsigned long timeout) { (void)timeout; }
+  size_t readBytes(uint8_t *buffer, size_t length) {
+    (void)buffer;
+    (void)length;
+    return 0;
+  }
+};
+
+/*! @brief Serial port, output goes to stdout */
+class HardwareSerial : public Stream {
+public:
+  void begin(unsigned long baud) { (void)baud; }
+  operator bool() { return true; }
+};
+
+extern HardwareSerial Serial;
+
+#endif // BusIO_Linux_Arduino_h
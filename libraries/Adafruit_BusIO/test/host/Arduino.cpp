@@ -0,0 +1,312 @@
+/*!
+ * @file Arduino.cpp
+ *
+ * Host implementation of the Arduino core declared in Arduino.h.
+ */
+
+#include "BusIO_Host.h"
+#include <SPI.h>
+#include <Wire.h>
+#include <stdio.h>
+
+HardwareSerial Serial;
+SPIClass SPI;
+TwoWire Wire;
+
+static std::vector<HostPinEvent> pinTrace;
+static uint8_t pinLevel[256];
+static host_pin_input_t pinInput = nullptr;
+static void *pinInputContext = nullptr;
+static host_pin_output_t pinOutput = nullptr;
+static void *pinOutputContext = nullptr;
+static host_spi_peer_t spiPeer = nullptr;
+static void *spiPeerContext = nullptr;
+static unsigned long randomState = 1;
+static unsigned long clockUs = 0;
+static unsigned long delayCalls = 0;
+
+/*! @brief A raised interrupt waiting for interrupts to be enabled */
+struct HostInterrupt {
+  host_isr_t isr;
+  void *context;
+};
+
+static std::vector<HostInterrupt> pendingIrqs;
+static bool irqEnabled = true;
+static bool inIrq = false;
+
+/*!
+ *    @brief  Run the interrupts raised so far, unless interrupts are off or
+ * a handler is already running. Handlers run with interrupts off and an
+ * interrupt raised by a handler waits for the next dispatch point.
+ */
+static void hostDispatch(void) {
+  if (!irqEnabled || inIrq || pendingIrqs.empty()) {
+    return;
+  }
+  std::vector<HostInterrupt> irqs;
+  irqs.swap(pendingIrqs);
+
+  inIrq = true;
+  irqEnabled = false;
+  for (const HostInterrupt &irq : irqs) {
+    irq.isr(irq.context);
+  }
+  irqEnabled = true;
+  inIrq = false;
+}
+
+/*!
+ *    @brief  Clear the pin trace, the pin levels, the pin callbacks, the SPI
+ * device and the simulated clock
+ */
+void hostReset(void) {
+  pinTrace.clear();
+  memset(pinLevel, 0, sizeof(pinLevel));
+  pinInput = nullptr;
+  pinInputContext = nullptr;
+  pinOutput = nullptr;
+  pinOutputContext = nullptr;
+  spiPeer = nullptr;
+  spiPeerContext = nullptr;
+  randomState = 1;
+  clockUs = 0;
+  delayCalls = 0;
+  pendingIrqs.clear();
+  irqEnabled = true;
+  inIrq = false;
+}
+
+/*!
+ *    @brief  Set the callback that supplies input pin levels. Without one
+ * digitalRead() returns the last level written to the pin.
+ *    @param  func The callback, or nullptr
+ *    @param  context Passed back to the callback
+ */
+void hostSetPinInput(host_pin_input_t func, void *context) {
+  pinInput = func;
+  pinInputContext = context;
+}
+
+/*!
+ *    @brief  Set the callback told about every pin write, e.g. to follow a
+ * chip select line
+ *    @param  func The callback, or nullptr
+ *    @param  context Passed back to the callback
+ */
+void hostSetPinOutput(host_pin_output_t func, void *context) {
+  pinOutput = func;
+  pinOutputContext = context;
+}
+
+/*!
+ *    @brief  Put a simulated device on the hardware SPI bus. Without one
+ * SPI transfers read back 0xFF.
+ *    @param  func Called for every byte clocked out, returns the byte
+ * clocked in, or nullptr
+ *    @param  context Passed back to the callback
+ */
+void hostSetSPIPeer(host_spi_peer_t func, void *context) {
+  spiPeer = func;
+  spiPeerContext = context;
+}
+
+/*!
+ *    @brief  Clock one byte over the hardware SPI bus, used by SPIClass
+ *    @param  data Byte to send
+ *    @return Byte from the simulated device, 0xFF without one
+ */
+uint8_t hostSPITransfer(uint8_t data) {
+  return (spiPeer != nullptr) ? spiPeer(spiPeerContext, data) : 0xFF;
+}
+
+/*!
+ *    @brief  Get every pin access since the last hostReset()
+ *    @return The trace, oldest first
+ */
+const std::vector<HostPinEvent> &hostPinTrace(void) { return pinTrace; }
+
+/*!
+ *    @brief  Count delay() and delayMicroseconds() calls
+ *    @return Calls since the last hostReset()
+ */
+unsigned long hostDelayCalls(void) { return delayCalls; }
+
+/*!
+ *    @brief  Raise a simulated interrupt. Like a peripheral interrupt it
+ * does not run inside the call that raised it but at the next point where
+ * time passes or interrupts are enabled: yield(), delay(),
+ * delayMicroseconds() or interrupts().
+ *    @param  isr The handler
+ *    @param  context Passed to the handler
+ */
+void hostRaiseInterrupt(host_isr_t isr, void *context) {
+  pendingIrqs.push_back({isr, context});
+}
+
+/*!
+ *    @brief  Check whether the caller runs inside a simulated interrupt
+ *    @return True inside a handler started by hostRaiseInterrupt()
+ */
+bool hostInInterrupt(void) { return inIrq; }
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  (void)pin;
+  (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+  pinLevel[pin] = (val != LOW) ? HIGH : LOW;
+  pinTrace.push_back({pin, pinLevel[pin], true});
+  if (pinOutput != nullptr) {
+    pinOutput(pinOutputContext, pin, pinLevel[pin]);
+  }
+}
+
+int digitalRead(uint8_t pin) {
+  uint8_t level = pinLevel[pin];
+  if (pinInput != nullptr) {
+    level = (pinInput(pinInputContext, pin) != LOW) ? HIGH : LOW;
+  }
+  pinTrace.push_back({pin, level, false});
+  return level;
+}
+
+void delay(unsigned long ms) {
+  delayCalls++;
+  clockUs += ms * 1000UL;
+  hostDispatch();
+}
+
+void delayMicroseconds(unsigned int us) {
+  delayCalls++;
+  clockUs += us;
+  hostDispatch();
+}
+
+unsigned long millis(void) { return clockUs / 1000UL; }
+
+unsigned long micros(void) { return clockUs; }
+
+// A microsecond passes per yield(), so deadlines in busy-wait loops expire
+void yield(void) {
+  clockUs++;
+  hostDispatch();
+}
+
+void noInterrupts(void) { irqEnabled = false; }
+
+void interrupts(void) {
+  if (!inIrq) {
+    irqEnabled = true;
+    hostDispatch();
+  }
+}
+
+int analogRead(uint8_t pin) {
+  (void)pin;
+  return 0;
+}
+
+// Deterministic, so a test sees the same "random" bytes on every run
+void randomSeed(unsigned long seed) { randomState = (seed != 0) ? seed : 1; }
+
+long random(long howbig) {
+  if (howbig <= 0) {
+    return 0;
+  }
+  randomState = randomState * 1103515245UL + 12345UL;
+  return (long)((randomState >> 16) & 0x7FFFUL) % howbig;
+}
+
+long random(long howsmall, long howbig) {
+  if (howsmall >= howbig) {
+    return howsmall;
+  }
+  return howsmall + random(howbig - howsmall);
+}
+
+size_t Print::write(uint8_t c) { return fwrite(&c, 1, 1, stdout); }
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+  size_t n = 0;
+  while (size-- > 0) {
+    n += write(*buffer++);
+  }
+  return n;
+}
+
+size_t Print::printNumber(unsigned long n, int base) {
+  char buf[8 * sizeof(long) + 1];
+  char *str = &buf[sizeof(buf) - 1];
+
+  *str = '\0';
+  if (base < 2) {
+    base = 10;
+  }
+  do {
+    unsigned long digit = n % base;
+    n /= base;
+    *--str = (char)((digit < 10) ? ('0' + digit) : ('A' + digit - 10));
+  } while (n != 0);
+  return print(str);
+}
+
+size_t Print::print(const char *str) {
+  return write((const uint8_t *)str, strlen(str));
+}
+
+size_t Print::print(char c) { return write((uint8_t)c); }
+
+size_t Print::print(unsigned char n, int base) {
+  return printNumber(n, base);
+}
+
+size_t Print::print(int n, int base) { return print((long)n, base); }
+
+size_t Print::print(unsigned int n, int base) {
+  return printNumber(n, base);
+}
+
+size_t Print::print(long n, int base) {
+  if ((base == DEC) && (n < 0)) {
+    return print('-') + printNumber(0UL - (unsigned long)n, base);
+  }
+  return printNumber((unsigned long)n, base);
+}
+
+size_t Print::print(unsigned long n, int base) {
+  return printNumber(n, base);
+}
+
+size_t Print::print(double n, int digits) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%.*f", digits, n);
+  return print(buf);
+}
+
+size_t Print::println(void) { return print("\r\n"); }
+
+size_t Print::println(const char *str) { return print(str) + println(); }
+
+size_t Print::println(char c) { return print(c) + println(); }
+
+size_t Print::println(unsigned char n, int base) {
+  return print(n, base) + println();
+}
+
+size_t Print::println(int n, int base) { return print(n, base) + println(); }
+
+size_t Print::println(unsigned int n, int base) {
+  return print(n, base) + println();
+}
+
+size_t Print::println(long n, int base) { return print(n, base) + println(); }
+
+size_t Print::println(unsigned long n, int base) {
+  return print(n, base) + println();
+}
+
+size_t Print::println(double n, int digits) {
+  return print(n, digits) + println();
+}
@@ -0,0 +1,48 @@
+/*!
+ * @file BusIO_Host.h
+ *
+ * Test side of the host Arduino core: the recorded pin trace, the pin
+ * callbacks, the device on the hardware SPI bus, the simulated clock and
+ * simulated interrupts.
+ */
+
+#ifndef BusIO_Host_h
+#define BusIO_Host_h
+
+#include <Arduino.h>
+#include <vector>
+
+/*! @brief One recorded pin access */
+struct HostPinEvent {
+  uint8_t pin;   ///< Pin number
+  uint8_t value; ///< Level written or returned
+  bool write;    ///< True for digitalWrite(), false for digitalRead()
+
+  bool operator==(const HostPinEvent &other) const {
+    return (pin == other.pin) && (value == other.value) &&
+           (write == other.write);
+  }
+};
+
+/*! @brief Returns the level of an input pin, called by digitalRead() */
+typedef int (*host_pin_input_t)(void *context, uint8_t pin);
+
+/*! @brief Told about every digitalWrite() */
+typedef void (*host_pin_output_t)(void *context, uint8_t pin, uint8_t value);
+
+/*! @brief Device on the hardware SPI bus, answers each byte clocked out */
+typedef uint8_t (*host_spi_peer_t)(void *context, uint8_t data);
+
+/*! @brief Simulated interrupt handler */
+typedef void (*host_isr_t)(void *context);
+
+void hostReset(void);
+void hostSetPinInput(host_pin_input_t func, void *context);
+void hostSetPinOutput(host_pin_output_t func, void *context);
+void hostSetSPIPeer(host_spi_peer_t func, void *context);
+const std::vector<HostPinEvent> &hostPinTrace(void);
+unsigned long hostDelayCalls(void);
+void hostRaiseInterrupt(host_isr_t isr, void *context);
+bool hostInInterrupt(void);
+
+#endif // BusIO_Host_h
@@ -0,0 +1,51 @@
+/*!
+ * @file SPI.h
+ *
+ * Host stand-in for the Arduino SPI library. There is no SPI peripheral on
+ * the host: transfers go to the device a test sets with hostSetSPIPeer()
+ * and read back 0xFF without one. Tests may also use the software SPI
+ * constructors or a BusIO backend.
+ */
+
+#ifndef BusIO_Host_SPI_h
+#define BusIO_Host_SPI_h
+
+#include <Arduino.h>
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x01
+#define SPI_MODE2 0x02
+#define SPI_MODE3 0x03
+
+uint8_t hostSPITransfer(uint8_t data);
+
+/*! @brief SPI bus settings, ignored on the host */
+class SPISettings {
+public:
+  SPISettings() {}
+  SPISettings(uint32_t clock, BitOrder bitOrder, uint8_t dataMode) {
+    (void)clock;
+    (void)bitOrder;
+    (void)dataMode;
+  }
+};
+
+/*! @brief SPI peripheral wired to the test's simulated device */
+class SPIClass {
+public:
+  void begin(void) {}
+  void end(void) {}
+  void beginTransaction(SPISettings settings) { (void)settings; }
+  void endTransaction(void) {}
+  uint8_t transfer(uint8_t data) { return hostSPITransfer(data); }
+  void transfer(void *buf, size_t count) {
+    uint8_t *bytes = (uint8_t *)buf;
+    for (size_t i = 0; i < count; i++) {
+      bytes[i] = hostSPITransfer(bytes[i]);
+    }
+  }
+};
+
+extern SPIClass SPI;
+
+#endif // BusIO_Host_SPI_h
@@ -0,0 +1,42 @@
+/*!
+ * @file Wire.h
+ *
+ * Host stand-in for the Arduino Wire library. No device ever acknowledges,
+ * so tests that need an I2C peer use the Linux i2c-dev backend instead.
+ */
+
+#ifndef BusIO_Host_Wire_h
+#define BusIO_Host_Wire_h
+
+#include <Arduino.h>
+
+/*! @brief I2C peripheral with an empty bus */
+class TwoWire : public Stream {
+public:
+  void begin(void) {}
+  void end(void) {}
+  void setClock(uint32_t freq) { (void)freq; }
+  void beginTransmission(uint8_t addr) { (void)addr; }
+  uint8_t endTransmission(bool stop = true) {
+    (void)stop;
+    return 2; // address NACK
+  }
+  uint8_t requestFrom(uint8_t addr, uint8_t len, uint8_t stop = true) {
+    (void)addr;
+    (void)len;
+    (void)stop;
+    return 0;
+  }
+  size_t write(uint8_t data) {
+    (void)data;
+    return 1;
+  }
+  size_t write(const uint8_t *data, size_t len) {
+    (void)data;
+    return len;
+  }
+};
+
+extern TwoWire Wire;
+
+#endif // BusIO_Host_Wire_h
@@ -0,0 +1,26 @@
+#!/usr/bin/env bash
+#
+# Builds and runs the BusIO host tests with the system compiler. The host/
+# directory stands in for the Arduino core.
+
+set -e
+cd "$(dirname "$0")"
+
+CXX=${CXX:-g++}
+CXXFLAGS="--std=c++14 -Wall -Wextra -Ihost -I.."
+OUT=$(mktemp -d)
+trap 'rm -rf "$OUT"' EXIT
+
+echo "*** Building ***"
+$CXX $CXXFLAGS -o "$OUT/test_softspi" test_softspi.cpp host/Arduino.cpp \
+  ../Adafruit_SPIDevice.cpp
+$CXX $CXXFLAGS -o "$OUT/test_spiqueue" test_spiqueue.cpp host/Arduino.cpp \
+  ../Adafruit_SPIDevice.cpp
+$CXX $CXXFLAGS -o "$OUT/test_regcache" test_regcache.cpp host/Arduino.cpp \
+  ../Adafruit_BusIO_Register.cpp ../Adafruit_GenericDevice.cpp \
+  ../Adafruit_I2CDevice.cpp ../Adafruit_SPIDevice.cpp
+
+echo "*** Running tests ***"
+"$OUT/test_softspi"
+"$OUT/test_spiqueue"
+"$OUT/test_regcache"
@@ -0,0 +1,216 @@
+/*!
+ * @file test_regcache.cpp
+ *
+ * Drives Adafruit_BusIO_RegisterCache against a fake register file behind
+ * an Adafruit_GenericDevice and counts the bus transactions of a few
+ * bit-field updates with and without the cache. Checks the contents of the
+ * coalesced bursts on a device that auto-increments the register address,
+ * and that nothing is coalesced on one that does not.
+ */
+
+#include "BusIO_Host.h"
+#include <Adafruit_BusIO_Register.h>
+#include <stdio.h>
+
+#define BASE 0x20
+#define SPAN 8
+#define MAX_LOG 16
+
+static int failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);         \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+/*! @brief One register transaction seen by the fake device */
+struct Transaction {
+  bool write;
+  uint8_t address;
+  uint8_t len;
+  uint8_t data[SPAN];
+};
+
+/*! @brief Register file with an optional address auto-increment */
+struct FakeDevice {
+  uint8_t regs[256];
+  bool autoIncrement;
+  int transactions;
+  Transaction log[MAX_LOG];
+};
+
+static void record(FakeDevice *fake, bool write, uint8_t address,
+                   const uint8_t *data, uint16_t len) {
+  if (fake->transactions < MAX_LOG) {
+    Transaction &t = fake->log[fake->transactions];
+    t.write = write;
+    t.address = address;
+    t.len = len;
+    memcpy(t.data, data, (len < SPAN) ? len : SPAN);
+  }
+  fake->transactions++;
+}
+
+// Without auto-increment every byte of a transfer hits the same register
+static uint8_t target(FakeDevice *fake, uint8_t address, uint16_t i) {
+  return fake->autoIncrement ? (uint8_t)(address + i) : address;
+}
+
+static bool fakeRead(void *obj, uint8_t *buffer, size_t len) {
+  (void)obj;
+  (void)buffer;
+  (void)len;
+  return false;
+}
+
+static bool fakeWrite(void *obj, const uint8_t *buffer, size_t len) {
+  (void)obj;
+  (void)buffer;
+  (void)len;
+  return false;
+}
+
+static bool fakeReadReg(void *obj, uint8_t *addr_buf, uint8_t addrsiz,
+                        uint8_t *data, uint16_t datalen) {
+  FakeDevice *fake = (FakeDevice *)obj;
+  (void)addrsiz;
+
+  for (uint16_t i = 0; i < datalen; i++) {
+    data[i] = fake->regs[target(fake, addr_buf[0], i)];
+  }
+  record(fake, false, addr_buf[0], data, datalen);
+  return true;
+}
+
+static bool fakeWriteReg(void *obj, uint8_t *addr_buf, uint8_t addrsiz,
+                         const uint8_t *data, uint16_t datalen) {
+  FakeDevice *fake = (FakeDevice *)obj;
+  (void)addrsiz;
+
+  for (uint16_t i = 0; i < datalen; i++) {
+    fake->regs[target(fake, addr_buf[0], i)] = data[i];
+  }
+  record(fake, true, addr_buf[0], data, datalen);
+  return true;
+}
+
+static void resetDevice(FakeDevice &fake, bool autoIncrement) {
+  for (int i = 0; i < 256; i++) {
+    fake.regs[i] = (uint8_t)(0x11 * (i & 0x0F));
+  }
+  fake.autoIncrement = autoIncrement;
+  fake.transactions = 0;
+}
+
+/*! @brief Registers of the example configuration block */
+struct Registers {
+  Adafruit_BusIO_Register ctrl1;
+  Adafruit_BusIO_Register ctrl2;
+  Adafruit_BusIO_Register ctrl5;
+
+  Registers(Adafruit_GenericDevice *dev)
+      : ctrl1(dev, BASE + 0), ctrl2(dev, BASE + 1), ctrl5(dev, BASE + 4) {}
+
+  void attach(Adafruit_BusIO_RegisterCache *cache) {
+    ctrl1.attachCache(cache);
+    ctrl2.attachCache(cache);
+    ctrl5.attachCache(cache);
+  }
+
+  // Same updates as the i2c_register_cache example
+  void update(void) {
+    Adafruit_BusIO_RegisterBits odr(&ctrl1, 4, 4);
+    Adafruit_BusIO_RegisterBits range(&ctrl2, 2, 0);
+    Adafruit_BusIO_RegisterBits int_en(&ctrl5, 1, 7);
+    CHECK(odr.write(0x5));
+    CHECK(range.write(0x2));
+    CHECK(int_en.write(1));
+  }
+};
+
+int main(void) {
+  FakeDevice fake;
+  Adafruit_GenericDevice dev(&fake, fakeRead, fakeWrite, fakeReadReg,
+                             fakeWriteReg);
+  Adafruit_BusIO_Register window(&dev, BASE);
+  Registers regs(&dev);
+  uint8_t expected[SPAN];
+
+  CHECK(dev.begin());
+
+  // Uncached: every bit-field write is a read and a write
+  resetDevice(fake, true);
+  regs.update();
+  int uncached = fake.transactions;
+  CHECK(uncached == 6);
+  memcpy(expected, fake.regs + BASE, SPAN);
+  CHECK(expected[0] == 0x50);
+  CHECK(expected[1] == 0x12);
+  CHECK(expected[4] == 0xC4);
+
+  // Cached on an auto-incrementing device: one burst in, two bursts out
+  resetDevice(fake, true);
+  Adafruit_BusIO_RegisterCache burstCache(&window, BASE, SPAN, true);
+  regs.attach(&burstCache);
+  CHECK(burstCache.load());
+  CHECK(fake.transactions == 1);
+  CHECK(!fake.log[0].write && fake.log[0].address == BASE);
+  CHECK(fake.log[0].len == SPAN);
+  regs.update();
+  CHECK(fake.transactions == 1);
+  CHECK(burstCache.dirty());
+  CHECK(burstCache.flush());
+  CHECK(!burstCache.dirty());
+  int cached = fake.transactions;
+  CHECK(cached == 3);
+  CHECK(fake.log[1].write && fake.log[1].address == BASE);
+  CHECK(fake.log[1].len == 2);
+  CHECK(fake.log[1].data[0] == 0x50 && fake.log[1].data[1] == 0x12);
+  CHECK(fake.log[2].write && fake.log[2].address == BASE + 4);
+  CHECK(fake.log[2].len == 1 && fake.log[2].data[0] == 0xC4);
+  CHECK(memcmp(fake.regs + BASE, expected, SPAN) == 0);
+
+  // Writing back the value the device already holds sends nothing
+  CHECK(regs.ctrl2.write(0x12));
+  CHECK(!burstCache.dirty());
+  CHECK(burstCache.flush());
+  CHECK(fake.transactions == cached);
+
+  // Without auto-increment every register goes on its own, and a device
+  // that doesn't auto-increment still ends up with the right values
+  resetDevice(fake, false);
+  Adafruit_BusIO_RegisterCache singleCache(&window, BASE, SPAN);
+  regs.attach(&singleCache);
+  CHECK(singleCache.load());
+  CHECK(fake.transactions == SPAN);
+  regs.update();
+  CHECK(singleCache.flush());
+  int single = fake.transactions;
+  CHECK(single == SPAN + 3);
+  for (int i = 0; i < single && i < MAX_LOG; i++) {
+    CHECK(fake.log[i].len == 1);
+  }
+  CHECK(memcmp(fake.regs + BASE, expected, SPAN) == 0);
+
+  // A lazily filled shadow only fetches what the reads need
+  resetDevice(fake, false);
+  singleCache.invalidate();
+  regs.update();
+  CHECK(singleCache.flush());
+  CHECK(fake.transactions == 6);
+  CHECK(memcmp(fake.regs + BASE, expected, SPAN) == 0);
+
+  printf("3 bit-field updates: %d transactions uncached, %d cached with "
+         "bursts, %d cached without\n",
+         uncached, cached, single);
+
+  if (failures != 0) {
+    printf("test_regcache: %d check(s) failed\n", failures);
+    return 1;
+  }
+  printf("test_regcache: OK\n");
+  return 0;
+}
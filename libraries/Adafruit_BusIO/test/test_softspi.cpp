@@ -0,0 +1,240 @@
+/*!
+ * @file test_softspi.cpp
+ *
+ * Checks that the unrolled software SPI loop used for mode 0/2 at full
+ * speed drives the pins exactly like the generic per-bit loop: same pin
+ * accesses in the same order and the same bytes received.
+ *
+ * For each bit order and mode it also prints the pin edges per byte from
+ * the trace and the time per byte of both loops. The host core records
+ * every pin access and delays are simulated, so the times compare the loop
+ * overhead of the two paths on the host, not the bit rate on a board.
+ */
+
+#include "BusIO_Host.h"
+#include <Adafruit_SPIDevice.h>
+#include <chrono>
+#include <stdio.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#define PIN_CS 10
+#define PIN_SCK 13
+#define PIN_MISO 12
+#define PIN_MOSI 11
+
+#define FAST_FREQ 1000000 // no bit delay, takes the unrolled loop
+#define SLOW_FREQ 100000  // 5us bit delay, takes the generic loop
+
+#define TIMED_LEN 255  // bytes per timed transfer
+#define TIMED_RUNS 200 // timed transfers per loop, the fastest one counts
+
+static int failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);         \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+/*! @brief MISO level generator, a fixed pseudo random bit stream */
+struct MisoSource {
+  uint32_t state;
+};
+
+static int misoInput(void *context, uint8_t pin) {
+  MisoSource *src = (MisoSource *)context;
+  if (pin != PIN_MISO) {
+    return LOW;
+  }
+  src->state = src->state * 1103515245UL + 12345UL;
+  return (src->state >> 16) & 1;
+}
+
+/*! @brief Pin trace and received bytes of one transfer() call */
+struct Run {
+  std::vector<HostPinEvent> trace;
+  std::vector<uint8_t> data;
+  unsigned long delays;
+};
+
+static Run runTransfer(uint32_t freq, BusIOBitOrder order, uint8_t mode,
+                       const uint8_t *tx, size_t len, uint32_t seed) {
+  Adafruit_SPIDevice dev(PIN_CS, PIN_SCK, PIN_MISO, PIN_MOSI, freq, order,
+                         mode);
+  MisoSource src = {seed};
+  Run run;
+
+  hostReset();
+  dev.begin();
+  hostSetPinInput(misoInput, &src);
+
+  run.data.assign(tx, tx + len);
+  dev.transfer(run.data.data(), len);
+
+  run.trace = hostPinTrace();
+  run.delays = hostDelayCalls();
+  return run;
+}
+
+/*! @brief Pin activity of one transfer, from its trace */
+struct Edges {
+  unsigned long sck;  ///< SCK level changes
+  unsigned long mosi; ///< MOSI writes
+  unsigned long miso; ///< MISO reads
+};
+
+static Edges countEdges(const std::vector<HostPinEvent> &trace) {
+  Edges edges = {0, 0, 0};
+  int sck = -1;
+
+  for (const HostPinEvent &event : trace) {
+    if (event.write && (event.pin == PIN_SCK)) {
+      if ((sck >= 0) && (event.value != sck)) {
+        edges.sck++;
+      }
+      sck = event.value;
+    } else if (event.write && (event.pin == PIN_MOSI)) {
+      edges.mosi++;
+    } else if (!event.write && (event.pin == PIN_MISO)) {
+      edges.miso++;
+    }
+  }
+  return edges;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#define TICK_UNIT "cycles"
+static unsigned long long ticks(void) { return __rdtsc(); }
+#else
+#define TICK_UNIT "ns"
+static unsigned long long ticks(void) {
+  return (unsigned long long)std::chrono::duration_cast<
+             std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+#endif
+
+/*!
+ *    @brief  Time one transfer() of TIMED_LEN bytes, best of TIMED_RUNS
+ *    @return Ticks per byte
+ */
+static double timeTransfer(uint32_t freq, BusIOBitOrder order, uint8_t mode) {
+  Adafruit_SPIDevice dev(PIN_CS, PIN_SCK, PIN_MISO, PIN_MOSI, freq, order,
+                         mode);
+  MisoSource src = {1};
+  uint8_t buf[TIMED_LEN];
+  unsigned long long best = 0;
+
+  hostReset();
+  dev.begin();
+  for (int run = 0; run < TIMED_RUNS; run++) {
+    // Keep the trace from growing across runs
+    hostReset();
+    hostSetPinInput(misoInput, &src);
+    memset(buf, 0xA5, sizeof(buf));
+
+    unsigned long long start = ticks();
+    dev.transfer(buf, sizeof(buf));
+    unsigned long long elapsed = ticks() - start;
+    if ((run == 0) || (elapsed < best)) {
+      best = elapsed;
+    }
+  }
+  return (double)best / TIMED_LEN;
+}
+
+static void compareLoops(BusIOBitOrder order, uint8_t mode, size_t len,
+                         uint32_t seed) {
+  std::vector<uint8_t> tx(len);
+  uint32_t state = seed ^ 0x5A5A5A5AUL;
+  for (size_t i = 0; i < len; i++) {
+    state = state * 1664525UL + 1013904223UL;
+    tx[i] = (uint8_t)(state >> 24);
+  }
+
+  Run fast = runTransfer(FAST_FREQ, order, mode, tx.data(), len, seed);
+  Run slow = runTransfer(SLOW_FREQ, order, mode, tx.data(), len, seed);
+
+  CHECK(fast.delays == 0);
+  CHECK(slow.delays != 0);
+  CHECK(fast.trace.size() == slow.trace.size());
+  CHECK(fast.trace == slow.trace);
+  CHECK(fast.data == slow.data);
+
+  // Every byte is 8 clock pulses and 8 MISO samples. Mode 2 pulses from
+  // the high idle level too, so its first pulse has no rising edge.
+  Edges fastEdges = countEdges(fast.trace);
+  Edges slowEdges = countEdges(slow.trace);
+  CHECK(fastEdges.sck == 16 * len - ((mode == SPI_MODE2) ? 1 : 0));
+  CHECK(fastEdges.miso == 8 * len);
+  CHECK(slowEdges.sck == fastEdges.sck);
+  CHECK(slowEdges.mosi == fastEdges.mosi);
+
+  if ((len == TIMED_LEN) && (seed == 1)) {
+    printf("%s mode %u: %.1f SCK edges, %.1f MOSI writes, %.1f MISO reads "
+           "per byte; " TICK_UNIT " per byte: fast %.0f, generic %.0f\n",
+           (order == SPI_BITORDER_MSBFIRST) ? "MSB" : "LSB", mode,
+           (double)fastEdges.sck / len, (double)fastEdges.mosi / len,
+           (double)fastEdges.miso / len,
+           timeTransfer(FAST_FREQ, order, mode),
+           timeTransfer(SLOW_FREQ, order, mode));
+  }
+}
+
+static void checkLoopback(BusIOBitOrder order, uint8_t mode) {
+  // Feed MOSI back to MISO: the received bytes must equal the sent ones
+  static const uint8_t tx[] = {0x00, 0xFF, 0xA5, 0x5A, 0x01, 0x80, 0x3C};
+  Adafruit_SPIDevice dev(PIN_CS, PIN_SCK, PIN_MISO, PIN_MOSI, FAST_FREQ, order,
+                         mode);
+  uint8_t buf[sizeof(tx)];
+
+  hostReset();
+  dev.begin();
+  hostSetPinInput(
+      [](void *context, uint8_t pin) -> int {
+        (void)context;
+        (void)pin;
+        for (auto it = hostPinTrace().rbegin(); it != hostPinTrace().rend();
+             ++it) {
+          if (it->write && (it->pin == PIN_MOSI)) {
+            return it->value;
+          }
+        }
+        return LOW;
+      },
+      nullptr);
+
+  memcpy(buf, tx, sizeof(tx));
+  dev.transfer(buf, sizeof(buf));
+  CHECK(memcmp(buf, tx, sizeof(tx)) == 0);
+}
+
+int main(void) {
+  static const BusIOBitOrder orders[] = {SPI_BITORDER_MSBFIRST,
+                                         SPI_BITORDER_LSBFIRST};
+  static const uint8_t modes[] = {SPI_MODE0, SPI_MODE2};
+  static const size_t lengths[] = {1, 2, 16, 255};
+
+  for (BusIOBitOrder order : orders) {
+    for (uint8_t mode : modes) {
+      for (size_t len : lengths) {
+        for (uint32_t seed = 1; seed <= 4; seed++) {
+          compareLoops(order, mode, len, seed);
+        }
+      }
+      checkLoopback(order, mode);
+    }
+  }
+
+  if (failures != 0) {
+    printf("test_softspi: %d check(s) failed\n", failures);
+    return 1;
+  }
+  printf("test_softspi: OK\n");
+  return 0;
+}
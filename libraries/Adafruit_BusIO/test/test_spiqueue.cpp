@@ -0,0 +1,300 @@
+/*!
+ * @file test_spiqueue.cpp
+ *
+ * Runs queued SPI transfers through a simulated DMA backend whose
+ * completion interrupt fires after the queueing call has returned, and
+ * checks ordering, chip select handling, callbacks, the fallback to the
+ * software loop when the backend declines a transfer and cancelling a
+ * transfer the backend never finishes.
+ */
+
+#include "BusIO_Host.h"
+#include <Adafruit_SPIDevice.h>
+#include <stdio.h>
+
+#define PIN_CS 10
+#define DMA_LATENCY 5 // dispatch points a transfer stays on the wire
+
+static int failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);         \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+/*! @brief Simulated DMA channel: one transfer in flight at a time */
+struct FakeDMA {
+  Adafruit_SPIDevice *dev;
+  BusIO_SPITransfer *active;
+  bool accept;
+  int ticks;
+  int starts;
+  int completions;
+  bool stall; ///< Accept transfers but never finish them
+  int stops;
+};
+
+// The peripheral answers every byte with its complement
+static void dmaInterrupt(void *context) {
+  FakeDMA *dma = (FakeDMA *)context;
+  BusIO_SPITransfer *xfer = dma->active;
+
+  if (--dma->ticks > 0) {
+    hostRaiseInterrupt(dmaInterrupt, dma); // still clocking
+    return;
+  }
+
+  CHECK(xfer != nullptr);
+  if (xfer == nullptr) {
+    return;
+  }
+  if (xfer->rx != nullptr) {
+    for (size_t i = 0; i < xfer->len; i++) {
+      xfer->rx[i] = (xfer->tx != nullptr) ? (uint8_t)~xfer->tx[i] : 0x00;
+    }
+  }
+  dma->active = nullptr;
+  dma->completions++;
+  dma->dev->transferComplete();
+}
+
+static bool dmaStart(void *context, Adafruit_SPIDevice *dev,
+                     BusIO_SPITransfer *xfer) {
+  FakeDMA *dma = (FakeDMA *)context;
+  (void)dev;
+
+  if (!dma->accept) {
+    return false;
+  }
+  CHECK(dma->active == nullptr);
+  dma->active = xfer;
+  dma->ticks = DMA_LATENCY;
+  dma->starts++;
+  if (!dma->stall) {
+    hostRaiseInterrupt(dmaInterrupt, dma);
+  }
+  return true;
+}
+
+static void dmaStop(void *context, Adafruit_SPIDevice *dev,
+                    BusIO_SPITransfer *xfer) {
+  FakeDMA *dma = (FakeDMA *)context;
+  (void)dev;
+
+  CHECK(dma->active == xfer);
+  dma->active = nullptr;
+  dma->stops++;
+}
+
+/*! @brief Completion order as seen by the callbacks */
+struct Completions {
+  char order[8];
+  int count;
+  bool allInInterrupt;
+};
+
+static void recordCompletion(BusIO_SPITransfer *xfer) {
+  Completions *c = (Completions *)xfer->context;
+  c->order[c->count++] = *(const char *)xfer->tx;
+  c->allInInterrupt = c->allInInterrupt && hostInInterrupt();
+}
+
+static int countCSWrites(uint8_t value) {
+  int n = 0;
+  for (const HostPinEvent &e : hostPinTrace()) {
+    if (e.write && (e.pin == PIN_CS) && (e.value == value)) {
+      n++;
+    }
+  }
+  return n;
+}
+
+static void testAsyncChain(void) {
+  Adafruit_SPIDevice dev(PIN_CS, 1000000, SPI_BITORDER_MSBFIRST, SPI_MODE0,
+                         &SPI);
+  FakeDMA dma = {&dev, nullptr, true, 0, 0, 0, false, 0};
+  Completions c = {{0}, 0, true};
+  static const char txA[] = "A123", txB[] = "B4", txC[] = "C56789";
+  uint8_t rxA[4], rxC[6];
+  BusIO_SPITransfer xfers[3] = {
+      {(const uint8_t *)txA, rxA, 4, true, recordCompletion, &c, false,
+       nullptr},
+      {(const uint8_t *)txB, nullptr, 2, true, recordCompletion, &c, false,
+       nullptr},
+      {(const uint8_t *)txC, rxC, 6, false, recordCompletion, &c, false,
+       nullptr}};
+
+  hostReset();
+  dev.begin();
+  dev.setTransferBackend(dmaStart, &dma);
+
+  // The first transfer is only started: its completion interrupt can fire
+  // no earlier than the next point where interrupts are enabled
+  CHECK(dev.queueTransfer(&xfers[0]));
+  CHECK(dma.starts == 1);
+  CHECK(!xfers[0].done);
+  CHECK(dev.transferBusy());
+  CHECK(countCSWrites(LOW) == 1);
+
+  CHECK(dev.queueTransfer(&xfers[1]));
+  CHECK(dev.queueTransfer(&xfers[2]));
+  CHECK(!xfers[0].done);
+
+  // Each interrupt completes one transfer and starts the next one, the
+  // main loop only waits
+  int waits = 0;
+  while (dev.transferBusy() && (waits < 100)) {
+    yield();
+    waits++;
+  }
+  CHECK(!dev.transferBusy());
+  CHECK(dma.starts == 3);
+  CHECK(dma.completions == 3);
+  CHECK(xfers[0].done && xfers[1].done && xfers[2].done);
+  CHECK((c.count == 3) && (memcmp(c.order, "ABC", 3) == 0));
+  CHECK(c.allInInterrupt);
+  for (size_t i = 0; i < sizeof(rxA); i++) {
+    CHECK(rxA[i] == (uint8_t)~txA[i]);
+  }
+  for (size_t i = 0; i < sizeof(rxC); i++) {
+    CHECK(rxC[i] == (uint8_t)~txC[i]);
+  }
+
+  // The held transfers form one transaction: a single CS low/high pair
+  // around the chain, after begin() set CS high
+  CHECK(countCSWrites(LOW) == 1);
+  CHECK(countCSWrites(HIGH) == 2);
+  CHECK(hostPinTrace().back().pin == PIN_CS);
+  CHECK(hostPinTrace().back().value == HIGH);
+}
+
+static void testDeclined(void) {
+  Adafruit_SPIDevice dev(PIN_CS, 1000000, SPI_BITORDER_MSBFIRST, SPI_MODE0,
+                         &SPI);
+  FakeDMA dma = {&dev, nullptr, false, 0, 0, 0, false, 0};
+  Completions c = {{0}, 0, true};
+  static const char tx[] = "D";
+  uint8_t rx[1];
+  BusIO_SPITransfer xfer = {(const uint8_t *)tx, rx, 1, false,
+                            recordCompletion, &c, false, nullptr};
+
+  hostReset();
+  dev.begin();
+  dev.setTransferBackend(dmaStart, &dma);
+
+  // A declined transfer runs in software and completes inside the call
+  CHECK(dev.queueTransfer(&xfer));
+  CHECK(xfer.done);
+  CHECK(!dev.transferBusy());
+  CHECK(dma.starts == 0);
+  CHECK((c.count == 1) && !c.allInInterrupt);
+  CHECK(rx[0] == 0xFF); // the host SPI peripheral reads back 0xFF
+}
+
+/*! @brief Queues one more transfer from the completion callback */
+struct Requeue {
+  Adafruit_SPIDevice *dev;
+  BusIO_SPITransfer *next;
+  Completions *c;
+};
+
+static void requeueCompletion(BusIO_SPITransfer *xfer) {
+  Requeue *r = (Requeue *)xfer->context;
+  xfer->context = r->c;
+  recordCompletion(xfer);
+  CHECK(r->dev->queueTransfer(r->next));
+}
+
+static void testQueueFromCallback(void) {
+  Adafruit_SPIDevice dev(PIN_CS, 1000000, SPI_BITORDER_MSBFIRST, SPI_MODE0,
+                         &SPI);
+  FakeDMA dma = {&dev, nullptr, true, 0, 0, 0, false, 0};
+  Completions c = {{0}, 0, true};
+  static const char txE[] = "E", txF[] = "F";
+  BusIO_SPITransfer xferF = {(const uint8_t *)txF, nullptr, 1, false,
+                             recordCompletion, &c, false, nullptr};
+  Requeue r = {&dev, &xferF, &c};
+  BusIO_SPITransfer xferE = {(const uint8_t *)txE, nullptr, 1, false,
+                             requeueCompletion, &r, false, nullptr};
+
+  hostReset();
+  dev.begin();
+  dev.setTransferBackend(dmaStart, &dma);
+
+  CHECK(dev.queueTransfer(&xferE));
+  int waits = 0;
+  while (dev.transferBusy() && (waits < 100)) {
+    yield();
+    waits++;
+  }
+  CHECK(xferE.done && xferF.done);
+  CHECK(dma.starts == 2);
+  CHECK((c.count == 2) && (memcmp(c.order, "EF", 2) == 0));
+  CHECK(c.allInInterrupt);
+}
+
+static void testCancel(void) {
+  Adafruit_SPIDevice dev(PIN_CS, 1000000, SPI_BITORDER_MSBFIRST, SPI_MODE0,
+                         &SPI);
+  FakeDMA dma = {&dev, nullptr, true, 0, 0, 0, true, 0};
+  Completions c = {{0}, 0, true};
+  static const char txG[] = "G1", txH[] = "H";
+  BusIO_SPITransfer xfers[2] = {
+      {(const uint8_t *)txG, nullptr, 2, true, recordCompletion, &c, false,
+       nullptr},
+      {(const uint8_t *)txH, nullptr, 1, false, recordCompletion, &c, false,
+       nullptr}};
+
+  hostReset();
+  dev.begin();
+  dev.setTransferBackend(dmaStart, &dma, dmaStop);
+
+  CHECK(dev.queueTransfer(&xfers[0]));
+  CHECK(dev.queueTransfer(&xfers[1]));
+  for (int i = 0; i < 100; i++) {
+    yield();
+  }
+  CHECK(dev.transferBusy());
+
+  // The stuck transfer is stopped on the backend, the queued one dropped,
+  // and CS is released without any callback running
+  dev.cancelTransfers();
+  CHECK(dma.stops == 1);
+  CHECK(dma.active == nullptr);
+  CHECK(!dev.transferBusy());
+  CHECK(!xfers[0].done && !xfers[1].done);
+  CHECK(c.count == 0);
+  CHECK(countCSWrites(LOW) == 1);
+  CHECK(hostPinTrace().back().pin == PIN_CS);
+  CHECK(hostPinTrace().back().value == HIGH);
+
+  // Nothing is left running: the descriptors go through again
+  dma.stall = false;
+  CHECK(dev.queueTransfer(&xfers[0]));
+  CHECK(dev.queueTransfer(&xfers[1]));
+  int waits = 0;
+  while (dev.transferBusy() && (waits < 100)) {
+    yield();
+    waits++;
+  }
+  CHECK(xfers[0].done && xfers[1].done);
+  CHECK((c.count == 2) && (memcmp(c.order, "GH", 2) == 0));
+  CHECK(countCSWrites(LOW) == 2);
+}
+
+int main(void) {
+  testAsyncChain();
+  testDeclined();
+  testQueueFromCallback();
+  testCancel();
+
+  if (failures != 0) {
+    printf("test_spiqueue: %d check(s) failed\n", failures);
+    return 1;
+  }
+  printf("test_spiqueue: OK\n");
+  return 0;
+}
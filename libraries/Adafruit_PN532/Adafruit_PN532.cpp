@@ -27,6 +27,30 @@
 
     @section  HISTORY
 
+    v2.3 - Added ntag2xx_ReadPages() to read a page range with FAST_READ.
+         - Added mifareclassic_ReadSector() to read a whole sector with a
+           single authentication and a MIFARE_BLOCK_* status per block.
+         - Added beginCommand(), isComplete() and finishCommand() to run
+           any command without blocking on the response.
+         - writecommand() sends the frame as vectored segments instead of
+           copying the command into a temporary packet.
+         - I2C readdata() reads straight into the caller's buffer.  Frames
+           longer than the Wire buffer are rejected with
+           PN532_XCHG_READFAIL instead of being truncated.
+         - inDataExchange() and finishCommand() verify the data checksum
+           and frame length of every response.
+         - Added powerDown() and fastWakeup() for low power idling.
+         - inDataExchange() failures can be told apart with
+           getExchangeError() and getExchangeStatus().
+         - SPI transactions go through the BusIO transfer queue, so an SPI
+           device with a DMA backend clocks frames in the background.  A
+           transaction that does not finish in PN532_SPI_TIMEOUT ms is
+           cancelled and the command fails.
+         - Builds against the Linux spidev and i2c-dev BusIO backends when
+           PN532_LINUX_BUSIO is defined.
+         - Added setTraceHook() to time sendCommandCheckAck(), waitready()
+           and readdata() calls.
+
     v2.2 - Added startPassiveTargetIDDetection() to start card detection and
             readDetectedPassiveTargetID() to read it, useful when using the
             IRQ pin.
@@ -79,6 +103,70 @@ byte pn532response_firmwarevers[] = {
 byte pn532_packetbuffer[PN532_PACKBUFFSIZ]; ///< Packet buffer used in various
                                             ///< transactions
 
+/// Frame overhead around the command or response bytes of a normal
+/// information frame (preamble, start codes, LEN, LCS, TFI, DCS, postamble)
+#define PN532_FRAME_OVERHEAD (8)
+/// Response frame overhead around the data of an InCommunicateThru reply
+/// (preamble, start codes, LEN, LCS, TFI, command, status, DCS, postamble)
+#define PN532_COMMTHRU_OVERHEAD (10)
+
+/**************************************************************************/
+/*!
+    @brief  Times one driver step for the trace hook.  Without a hook it
+            does not even read the clock.
+*/
+/**************************************************************************/
+class Adafruit_PN532::TraceSpan {
+public:
+  TraceSpan(Adafruit_PN532 *pn532, const char *step)
+      : _pn532(pn532), _step(step),
+        _start((pn532->_traceHook != NULL) ? micros() : 0) {}
+
+  ~TraceSpan() {
+    if (_pn532->_traceHook != NULL) {
+      _pn532->_traceHook(_pn532->_traceContext, _step, _start,
+                         micros() - _start);
+    }
+  }
+
+private:
+  Adafruit_PN532 *_pn532;
+  const char *_step;
+  uint32_t _start;
+};
+
+#ifdef PN532_LINUX_BUSIO
+/**************************************************************************/
+/*!
+    @brief  Instantiates a new PN532 class on a Linux spidev device.  The
+            device must be set up for SPI mode 0, LSB first; the kernel
+            drives chip select.
+
+    @param  spi       pointer to the SPI device to use
+*/
+/**************************************************************************/
+Adafruit_PN532::Adafruit_PN532(PN532_SPIDevice *spi) { spi_dev = spi; }
+
+/**************************************************************************/
+/*!
+    @brief  Instantiates a new PN532 class on a Linux i2c-dev device.
+
+    @param  i2c       pointer to the I2C device to use, at PN532_I2C_ADDRESS
+    @param  irq       Location of the IRQ pin, -1 if not wired
+    @param  reset     Location of the RSTPD_N pin, -1 if not wired
+*/
+/**************************************************************************/
+Adafruit_PN532::Adafruit_PN532(PN532_I2CDevice *i2c, int8_t irq, int8_t reset)
+    : _irq(irq), _reset(reset) {
+  if (_irq != -1) {
+    pinMode(_irq, INPUT);
+  }
+  if (_reset != -1) {
+    pinMode(_reset, OUTPUT);
+  }
+  i2c_dev = i2c;
+}
+#else
 /**************************************************************************/
 /*!
     @brief  Instantiates a new PN532 class using software SPI.
@@ -126,6 +214,22 @@ Adafruit_PN532::Adafruit_PN532(uint8_t ss, SPIClass *theSPI) {
                                    SPI_MODE0, theSPI);
 }
 
+/**************************************************************************/
+/*!
+    @brief  Instantiates a new PN532 class on an SPI device set up by the
+            caller, for example one with an asynchronous transfer backend.
+            The device must use LSB first bit order and SPI mode 0.
+
+    @param  ss        SPI chip select pin (CS/SSEL) of the device
+    @param  spi       pointer to the SPI device to use
+*/
+/**************************************************************************/
+Adafruit_PN532::Adafruit_PN532(uint8_t ss, Adafruit_SPIDevice *spi) {
+  _cs = ss;
+  spi_dev = spi;
+}
+#endif
+
 /**************************************************************************/
 /*!
     @brief  Instantiates a new PN532 class using hardware UART (HSU).
@@ -187,6 +291,8 @@ void Adafruit_PN532::reset(void) {
     digitalWrite(_reset, HIGH);
     delay(2); // max 2ms
   }
+  _samConfigured = false;
+  _poweredDown = false;
 }
 
 /**************************************************************************/
@@ -197,8 +303,13 @@ void Adafruit_PN532::reset(void) {
 void Adafruit_PN532::wakeup(void) {
   // interface specific wakeups - each one is unique!
   if (spi_dev) {
-    // hold CS low for 2ms
-    digitalWrite(_cs, LOW);
+    // hold CS low for 2ms, or let a status read make the CS edge when the
+    // chip select is not ours to drive
+    if (_cs != -1) {
+      digitalWrite(_cs, LOW);
+    } else {
+      isready();
+    }
     delay(2);
   } else if (ser_dev) {
     uint8_t w[3] = {0x55, 0x00, 0x00};
@@ -210,6 +321,88 @@ void Adafruit_PN532::wakeup(void) {
 
   // need to config SAM to stay in Normal Mode
   SAMConfig();
+  _poweredDown = false;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Puts the PN532 into PowerDown mode until one of the wake
+            sources fires. The current host interface is always added as a
+            wake source so the host can wake it with fastWakeup().
+
+    @param  wakeSources  OR of PN532_WAKESRC_* bits for extra wake
+                         sources.  PN532_WAKESRC_RF only fires on the field
+                         of another reader; a card tapped on the powered
+                         down PN532 makes no field and does not wake it
+    @param  generateIRQ  true to have the PN532 pull IRQ low when a
+                         non-host source wakes it (firmware 1.6 and later)
+
+    @returns  true if the PN532 accepted the command, false otherwise
+*/
+/**************************************************************************/
+bool Adafruit_PN532::powerDown(uint8_t wakeSources, bool generateIRQ) {
+  if (spi_dev) {
+    wakeSources |= PN532_WAKESRC_SPI;
+  } else if (i2c_dev) {
+    wakeSources |= PN532_WAKESRC_I2C;
+  } else if (ser_dev) {
+    wakeSources |= PN532_WAKESRC_HSU;
+  }
+
+  pn532_packetbuffer[0] = PN532_COMMAND_POWERDOWN;
+  pn532_packetbuffer[1] = wakeSources;
+  pn532_packetbuffer[2] = 0x01; // GenerateIRQ
+
+  if (!sendCommandCheckAck(pn532_packetbuffer, generateIRQ ? 3 : 2))
+    return false;
+
+  // read data packet, status is the byte after the response code
+  readdata(pn532_packetbuffer, 9);
+  if ((pn532_packetbuffer[6] != PN532_COMMAND_POWERDOWN + 1) ||
+      (pn532_packetbuffer[7] != 0x00)) {
+#ifdef PN532DEBUG
+    PN532DEBUGPRINT.print(F("PowerDown failed, status 0x"));
+    PN532DEBUGPRINT.println(pn532_packetbuffer[7], HEX);
+#endif
+    return false;
+  }
+
+  _poweredDown = true;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Wakes the PN532 from PowerDown through the host interface.
+            PowerDown keeps the SAM and RF configuration, so unlike
+            wakeup() this only runs SAMConfig() if the PN532 was reset
+            since it was last configured, and it waits for the oscillator
+            instead of a fixed 2ms.
+
+    @returns  true if the PN532 is ready for commands, false otherwise
+*/
+/**************************************************************************/
+bool Adafruit_PN532::fastWakeup(void) {
+  if (spi_dev) {
+    // a CS falling edge wakes it, CS is released by the next transaction
+    if (_cs != -1) {
+      digitalWrite(_cs, LOW);
+    } else {
+      isready();
+    }
+    delayMicroseconds(PN532_WAKEUP_SETTLE_US);
+  } else if (ser_dev) {
+    uint8_t w[3] = {PN532_WAKEUP, 0x00, 0x00};
+    ser_dev->write(w, 3);
+    delayMicroseconds(PN532_WAKEUP_SETTLE_US);
+  }
+  // PN532 will clock stretch I2C until it is awake
+
+  _poweredDown = false;
+  if (!_samConfigured) {
+    return SAMConfig();
+  }
+  return true;
 }
 
 /**************************************************************************/
@@ -322,6 +515,39 @@ uint32_t Adafruit_PN532::getFirmwareVersion(void) {
 // default timeout of one second
 bool Adafruit_PN532::sendCommandCheckAck(uint8_t *cmd, uint8_t cmdlen,
                                          uint16_t timeout) {
+  TraceSpan span(this, "sendCommandCheckAck");
+
+  if (!beginCommand(cmd, cmdlen, timeout)) {
+    return false;
+  }
+  // the caller reads the response itself, not through finishCommand()
+  _commandPending = false;
+
+  // Wait for chip to say its ready!
+  if (!waitready(timeout)) {
+    return false;
+  }
+
+  return true; // ack'd command
+}
+
+/**************************************************************************/
+/*!
+    @brief  Sends a command and waits for the ACK, but not for the
+            response.  The PN532 keeps processing the command while the
+            host does other work; poll isComplete() and collect the
+            response with finishCommand().
+
+    @param  cmd       Pointer to the command buffer, starting with the
+                      command code
+    @param  cmdlen    The size of the command in bytes
+    @param  timeout   timeout before giving up on the ACK
+
+    @returns  true if the command was acknowledged, false otherwise
+*/
+/**************************************************************************/
+bool Adafruit_PN532::beginCommand(uint8_t *cmd, uint8_t cmdlen,
+                                  uint16_t timeout) {
 
   // I2C works without using IRQ pin by polling for RDY byte
   // seems to work best with some delays between transactions
@@ -329,8 +555,16 @@ bool Adafruit_PN532::sendCommandCheckAck(uint8_t *cmd, uint8_t cmdlen,
   if (i2c_dev || spi_dev) // SPI and I2C need 1ms slow for page reads
     SLOWDOWN = 1;
 
+  _pendingCommand = cmd[0];
+  _commandPending = false;
+
   // write the command
-  writecommand(cmd, cmdlen);
+  if (!writecommand(cmd, cmdlen)) {
+#ifdef PN532DEBUG
+    PN532DEBUGPRINT.println(F("Command frame could not be written"));
+#endif
+    return false;
+  }
 
   // I2C TUNING
   delay(SLOWDOWN);
@@ -357,12 +591,90 @@ bool Adafruit_PN532::sendCommandCheckAck(uint8_t *cmd, uint8_t cmdlen,
   // I2C TUNING
   delay(SLOWDOWN);
 
-  // Wait for chip to say its ready!
-  if (!waitready(timeout)) {
+  _commandPending = true;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Checks, without blocking, whether the command started with
+            beginCommand() has a response waiting.
+
+    @returns  true if finishCommand() can be called, false otherwise
+*/
+/**************************************************************************/
+bool Adafruit_PN532::isComplete(void) { return isready(); }
+
+/**************************************************************************/
+/*!
+    @brief  Reads and validates the response to the command started with
+            beginCommand().  Only call once isComplete() returned true.
+
+    @param  response        Pointer to the buffer that will hold the
+                            response data following the response code
+    @param  responseLength  Input: size of the response buffer.
+                            Output: number of bytes copied into it.
+
+    @returns  true if a well formed response to the pending command was
+              received and fit in the buffer, false otherwise or if no
+              command is pending
+*/
+/**************************************************************************/
+bool Adafruit_PN532::finishCommand(uint8_t *response,
+                                   uint8_t *responseLength) {
+  if (!_commandPending) {
+#ifdef PN532DEBUG
+    PN532DEBUGPRINT.println(F("No command pending"));
+#endif
     return false;
   }
+  _commandPending = false;
 
-  return true; // ack'd command
+  // Frame: 00 00 FF LEN LCS D5 CMD+1 DATA... DCS 00
+  uint16_t n = (uint16_t)*responseLength + 9;
+  if (n > PN532_PACKBUFFSIZ)
+    n = PN532_PACKBUFFSIZ;
+
+  if (!readdata(pn532_packetbuffer, n)) {
+    return false;
+  }
+
+  int16_t length = checkResponseFrame(_pendingCommand, n);
+  if ((length < 0) || (length > *responseLength)) {
+    return false;
+  }
+
+  memcpy(response, pn532_packetbuffer + 7, length);
+  *responseLength = length;
+
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Aborts the command started with beginCommand() by sending an
+            ACK frame.  The PN532 drops the command and its response, so a
+            late answer cannot be read as the response to the next command.
+
+    @returns  true if the ACK frame was written, false otherwise
+*/
+/**************************************************************************/
+bool Adafruit_PN532::abortCommand(void) {
+  uint8_t dataWrite = PN532_SPI_DATAWRITE;
+  BusIO_WriteSegment frame[2] = {{&dataWrite, 1},
+                                 {pn532ack, sizeof(pn532ack)}};
+
+  _commandPending = false;
+
+  if (spi_dev) {
+    return spiTransfer(frame, 2);
+  } else if (i2c_dev) {
+    return i2c_dev->writev(frame + 1, 1);
+  } else if (ser_dev) {
+    ser_dev->write(pn532ack, sizeof(pn532ack));
+    return true;
+  }
+  return false;
 }
 
 /**************************************************************************/
@@ -505,7 +817,24 @@ bool Adafruit_PN532::SAMConfig(void) {
   readdata(pn532_packetbuffer, 9);
 
   int offset = 6;
-  return (pn532_packetbuffer[offset] == 0x15);
+  _samConfigured = (pn532_packetbuffer[offset] == 0x15);
+  return _samConfigured;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Sets a function told about every sendCommandCheckAck(),
+            waitready() and readdata() call with its start time and
+            duration, e.g. to record them in a trace.  Steps nest: the
+            ACK wait of a command is reported inside it.
+
+    @param  hook      Called when a step ends, NULL to stop timing
+    @param  context   Passed back to the hook
+*/
+/**************************************************************************/
+void Adafruit_PN532::setTraceHook(pn532_trace_t hook, void *context) {
+  _traceHook = hook;
+  _traceContext = context;
 }
 
 /**************************************************************************/
@@ -667,10 +996,13 @@ bool Adafruit_PN532::readDetectedPassiveTargetID(uint8_t *uid,
 bool Adafruit_PN532::inDataExchange(uint8_t *send, uint8_t sendLength,
                                     uint8_t *response,
                                     uint8_t *responseLength) {
-  if (sendLength > PN532_PACKBUFFSIZ - 2) {
+  if ((sendLength > PN532_PACKBUFFSIZ - 2) ||
+      (i2c_dev && ((size_t)sendLength + 2 + PN532_FRAME_OVERHEAD >
+                   i2c_dev->maxBufferSize()))) {
 #ifdef PN532DEBUG
     PN532DEBUGPRINT.println(F("APDU length too long for packet buffer"));
 #endif
+    _xchgError = PN532_XCHG_TOOLONG;
     return false;
   }
   uint8_t i;
@@ -681,63 +1013,62 @@ bool Adafruit_PN532::inDataExchange(uint8_t *send, uint8_t sendLength,
     pn532_packetbuffer[i + 2] = send[i];
   }
 
-  if (!sendCommandCheckAck(pn532_packetbuffer, sendLength + 2, 1000)) {
+  // Only wait for the ACK here: sendCommandCheckAck() would also wait for
+  // the response and report a slow card as a missing ACK
+  if (!beginCommand(pn532_packetbuffer, sendLength + 2, 1000)) {
 #ifdef PN532DEBUG
     PN532DEBUGPRINT.println(F("Could not send APDU"));
 #endif
+    _xchgError = PN532_XCHG_NOACK;
     return false;
   }
+  _commandPending = false;
 
   if (!waitready(1000)) {
 #ifdef PN532DEBUG
     PN532DEBUGPRINT.println(F("Response never received for APDU..."));
 #endif
+    _xchgError = PN532_XCHG_TIMEOUT;
     return false;
   }
 
-  readdata(pn532_packetbuffer, sizeof(pn532_packetbuffer));
-
-  if (pn532_packetbuffer[0] == 0 && pn532_packetbuffer[1] == 0 &&
-      pn532_packetbuffer[2] == 0xff) {
-    uint8_t length = pn532_packetbuffer[3];
-    if (pn532_packetbuffer[4] != (uint8_t)(~length + 1)) {
-#ifdef PN532DEBUG
-      PN532DEBUGPRINT.println(F("Length check invalid"));
-      PN532DEBUGPRINT.println(length, HEX);
-      PN532DEBUGPRINT.println((~length) + 1, HEX);
-#endif
-      return false;
-    }
-    if (pn532_packetbuffer[5] == PN532_PN532TOHOST &&
-        pn532_packetbuffer[6] == PN532_RESPONSE_INDATAEXCHANGE) {
-      if ((pn532_packetbuffer[7] & 0x3f) != 0) {
+  if (!readdata(pn532_packetbuffer, sizeof(pn532_packetbuffer))) {
 #ifdef PN532DEBUG
-        PN532DEBUGPRINT.println(F("Status code indicates an error"));
+    PN532DEBUGPRINT.println(F("Response frame could not be read"));
 #endif
-        return false;
-      }
-
-      length -= 3;
+    _xchgError = PN532_XCHG_READFAIL;
+    return false;
+  }
 
-      if (length > *responseLength) {
-        return false;
-      }
+  // The frame must answer InDataExchange, carry at least the status byte
+  // and pass both checksums before any of it is trusted
+  int16_t length = checkResponseFrame(PN532_COMMAND_INDATAEXCHANGE,
+                                      sizeof(pn532_packetbuffer));
+  if (length < 1) {
+    _xchgError = PN532_XCHG_BADFRAME;
+    return false;
+  }
 
-      for (i = 0; i < length; ++i) {
-        response[i] = pn532_packetbuffer[8 + i];
-      }
-      *responseLength = length;
+  _xchgStatus = pn532_packetbuffer[7];
+  if ((pn532_packetbuffer[7] & 0x3f) != 0) {
+#ifdef PN532DEBUG
+    PN532DEBUGPRINT.println(F("Status code indicates an error"));
+#endif
+    _xchgError = PN532_XCHG_STATUS;
+    return false;
+  }
 
-      return true;
-    } else {
-      PN532DEBUGPRINT.print(F("Don't know how to handle this command: "));
-      PN532DEBUGPRINT.println(pn532_packetbuffer[6], HEX);
-      return false;
-    }
-  } else {
-    PN532DEBUGPRINT.println(F("Preamble missing"));
+  length -= 1;
+  if (length > *responseLength) {
+    _xchgError = PN532_XCHG_OVERFLOW;
     return false;
   }
+
+  memcpy(response, pn532_packetbuffer + 8, length);
+  *responseLength = length;
+
+  _xchgError = PN532_XCHG_OK;
+  return true;
 }
 
 /**************************************************************************/
@@ -785,15 +1116,30 @@ bool Adafruit_PN532::inListPassiveTarget() {
       if (pn532_packetbuffer[7] != 1) {
 #ifdef PN532DEBUG
         PN532DEBUGPRINT.println(F("Unhandled number of targets inlisted"));
-#endif
         PN532DEBUGPRINT.println(F("Number of tags inlisted:"));
         PN532DEBUGPRINT.println(pn532_packetbuffer[7]);
+#endif
         return false;
       }
 
       _inListedTag = pn532_packetbuffer[8];
+
+      // Keep FWI from TB(1) of the ATS for getFrameWaitTime(), 4 if the
+      // card does not send it (ISO/IEC 14443-4 default)
+      _fwi = 4;
+      uint8_t ats = 13 + pn532_packetbuffer[12];
+      uint8_t atsLen = pn532_packetbuffer[ats]; // TL, counts itself
+      if ((atsLen >= 2) && (ats + atsLen <= 5 + length) &&
+          (pn532_packetbuffer[ats + 1] & 0x20)) {
+        uint8_t tb = ((pn532_packetbuffer[ats + 1] & 0x10) ? 3 : 2);
+        if ((tb < atsLen) && ((pn532_packetbuffer[ats + tb] >> 4) != 15)) {
+          _fwi = pn532_packetbuffer[ats + tb] >> 4;
+        }
+      }
+#ifdef PN532DEBUG
       PN532DEBUGPRINT.print(F("Tag number: "));
       PN532DEBUGPRINT.println(_inListedTag);
+#endif
 
       return true;
     } else {
@@ -812,6 +1158,19 @@ bool Adafruit_PN532::inListPassiveTarget() {
   return true;
 }
 
+/**************************************************************************/
+/*!
+    @brief   Frame waiting time the inlisted card asked for in its ATS
+             (FWT = 256 * 16 / fc * 2^FWI), i.e. how long it may take to
+             answer one frame before the reader gives up on it.
+    @return  The frame waiting time in milliseconds, rounded up.
+*/
+/**************************************************************************/
+uint16_t Adafruit_PN532::getFrameWaitTime(void) {
+  // 4096 / 13.56 MHz = 302.06 us per FWI step
+  return (uint16_t)((((uint32_t)30206 << _fwi) + 99999) / 100000);
+}
+
 /***** Mifare Classic Functions ******/
 
 /**************************************************************************/
@@ -981,6 +1340,117 @@ uint8_t Adafruit_PN532::mifareclassic_ReadDataBlock(uint8_t blockNumber,
   return 1;
 }
 
+/**************************************************************************/
+/*!
+    @brief   Returns the first block number of a sector.  Sectors 0..31
+             hold 4 blocks each, sectors 32..39 (4K cards only) hold 16.
+    @param   sectorNumber  The sector number (0..15 for 1K, 0..39 for 4K).
+    @return  The absolute number of the first block in the sector.
+*/
+/**************************************************************************/
+uint8_t Adafruit_PN532::mifareclassic_SectorFirstBlock(uint8_t sectorNumber) {
+  if (sectorNumber < 32)
+    return sectorNumber * 4;
+  else
+    return 128 + (sectorNumber - 32) * 16;
+}
+
+/**************************************************************************/
+/*!
+    @brief   Returns the number of blocks in a sector, including the
+             sector trailer.
+    @param   sectorNumber  The sector number (0..15 for 1K, 0..39 for 4K).
+    @return  4 for sectors 0..31, 16 for sectors 32..39, 0 if the sector
+             does not exist.
+*/
+/**************************************************************************/
+uint8_t Adafruit_PN532::mifareclassic_SectorBlockCount(uint8_t sectorNumber) {
+  if (sectorNumber < 32)
+    return 4;
+  else if (sectorNumber < 40)
+    return 16;
+  else
+    return 0;
+}
+
+/**************************************************************************/
+/*!
+    Authenticates a sector once and reads all of its blocks back to back,
+    including the sector trailer.
+
+    Each block still takes one InDataExchange round trip, as the PN532
+    runs one command at a time and a MIFARE READ returns a single block.
+    What this saves over the block-by-block flow is the authentication
+    per block and the MIFAREDEBUG traces of mifareclassic_ReadDataBlock().
+
+    A MIFARE Classic card drops its authentication after any failed
+    command, so once a block fails to read, the remaining blocks of the
+    sector are reported as MIFARE_BLOCK_NOAUTH without being sent to the
+    card.
+
+    @param  uid           Pointer to a byte array containing the card UID
+    @param  uidLen        The length (in bytes) of the card's UID (Should
+                          be 4 for MIFARE Classic)
+    @param  sectorNumber  The sector to read (0..15 for 1KB cards, and
+                          0..39 for 4KB cards).
+    @param  keyNumber     Which key type to use during authentication
+                          (0 = MIFARE_CMD_AUTH_A, 1 = MIFARE_CMD_AUTH_B)
+    @param  keyData       Pointer to a byte array containing the 6 byte
+                          key value
+    @param  data          Pointer to the byte array that will hold the
+                          retrieved blocks, 16 bytes per block
+                          (see mifareclassic_SectorBlockCount())
+    @param  blockStatus   Optional pointer to a byte array that will hold
+                          one MIFARE_BLOCK_* code per block
+
+    @returns The number of blocks read, 0 if authentication failed
+*/
+/**************************************************************************/
+uint8_t Adafruit_PN532::mifareclassic_ReadSector(
+    uint8_t *uid, uint8_t uidLen, uint8_t sectorNumber, uint8_t keyNumber,
+    uint8_t *keyData, uint8_t *data, uint8_t *blockStatus) {
+  uint8_t count = mifareclassic_SectorBlockCount(sectorNumber);
+  uint8_t block = mifareclassic_SectorFirstBlock(sectorNumber);
+  uint8_t blocksRead = 0;
+  bool authenticated;
+
+  if (count == 0) {
+#ifdef MIFAREDEBUG
+    PN532DEBUGPRINT.println(F("Sector value out of range"));
+#endif
+    return 0;
+  }
+
+  authenticated =
+      mifareclassic_AuthenticateBlock(uid, uidLen, block, keyNumber, keyData);
+
+  for (uint8_t i = 0; i < count; i++) {
+    uint8_t status = MIFARE_BLOCK_NOAUTH;
+    if (authenticated) {
+      pn532_packetbuffer[0] = PN532_COMMAND_INDATAEXCHANGE;
+      pn532_packetbuffer[1] = 1; /* Card number */
+      pn532_packetbuffer[2] = MIFARE_CMD_READ;
+      pn532_packetbuffer[3] = block + i;
+
+      // Response: 00 00 FF LEN LCS D5 41 status data[16] DCS 00
+      status = MIFARE_BLOCK_FAILED;
+      if (sendCommandCheckAck(pn532_packetbuffer, 4) &&
+          readdata(pn532_packetbuffer, 26) && (pn532_packetbuffer[6] == 0x41) &&
+          (pn532_packetbuffer[7] == 0x00)) {
+        memcpy(data + (i * 16), pn532_packetbuffer + 8, 16);
+        status = MIFARE_BLOCK_READ;
+        blocksRead++;
+      }
+      // The card halts on error, so stop talking to it
+      authenticated = (status == MIFARE_BLOCK_READ);
+    }
+    if (blockStatus)
+      blockStatus[i] = status;
+  }
+
+  return blocksRead;
+}
+
 /**************************************************************************/
 /*!
     Tries to write an entire 16-byte data block at the specified block
@@ -1362,6 +1832,101 @@ uint8_t Adafruit_PN532::ntag2xx_ReadPage(uint8_t page, uint8_t *buffer) {
   return 1;
 }
 
+/**************************************************************************/
+/*!
+    @brief   Reads a contiguous range of 4-byte pages using the NTAG2xx
+             FAST_READ command.
+
+             FAST_READ is sent through InCommunicateThru so the tag streams
+             the whole range back in one RF exchange, instead of one READ
+             per page.  Ranges larger than the packet buffer, or than the
+             transport can read in one transaction (the Wire buffer on
+             I2C), are split into as few FAST_READ commands as possible.
+             NTAG203 and MIFARE Ultralight tags do not implement FAST_READ
+             and will report an error; they drop back to IDLE after the
+             NAK, so select the tag again before using ntag2xx_ReadPage().
+
+    @param   startPage   The first page to read (0..230)
+    @param   pageCount   The number of pages to read
+    @param   buffer      Pointer to the byte array that will hold the
+                         retrieved data, at least pageCount * 4 bytes
+    @return  1 on success, 0 on error.
+*/
+/**************************************************************************/
+uint8_t Adafruit_PN532::ntag2xx_ReadPages(uint8_t startPage, uint8_t pageCount,
+                                          uint8_t *buffer) {
+  // TAG Type       PAGES   USER START    USER STOP
+  // --------       -----   ----------    ---------
+  // NTAG 213       45      4             39
+  // NTAG 215       135     4             129
+  // NTAG 216       231     4             225
+
+  if ((pageCount == 0) || ((uint16_t)startPage + pageCount > 231)) {
+#ifdef MIFAREDEBUG
+    PN532DEBUGPRINT.println(F("Page range out of range"));
+#endif
+    return 0;
+  }
+
+  // Largest page run whose response frame can be read in one go
+  uint8_t maxPages = (maxFrameLength() - PN532_COMMTHRU_OVERHEAD) / 4;
+
+  while (pageCount) {
+    uint8_t chunk = pageCount;
+    if (chunk > maxPages)
+      chunk = maxPages;
+    uint8_t len = chunk * 4;
+
+#ifdef MIFAREDEBUG
+    PN532DEBUGPRINT.print(F("Fast reading pages "));
+    PN532DEBUGPRINT.print(startPage);
+    PN532DEBUGPRINT.print(F(".."));
+    PN532DEBUGPRINT.println(startPage + chunk - 1);
+#endif
+
+    /* Prepare the command */
+    pn532_packetbuffer[0] = PN532_COMMAND_INCOMMUNICATETHRU;
+    pn532_packetbuffer[1] = NTAG2XX_CMD_FAST_READ; /* FAST_READ = 0x3A */
+    pn532_packetbuffer[2] = startPage;             /* Start address */
+    pn532_packetbuffer[3] = startPage + chunk - 1; /* End address */
+
+    /* Send the command */
+    if (!sendCommandCheckAck(pn532_packetbuffer, 4)) {
+#ifdef MIFAREDEBUG
+      PN532DEBUGPRINT.println(F("Failed to receive ACK for fast read"));
+#endif
+      return 0;
+    }
+
+    /* Read the response packet */
+    bool ok = readdata(pn532_packetbuffer, len + PN532_COMMTHRU_OVERHEAD);
+
+    /* The frame must pass its checksums and carry the status byte plus
+       every requested page */
+    if (!ok ||
+        (checkResponseFrame(PN532_COMMAND_INCOMMUNICATETHRU,
+                            len + PN532_COMMTHRU_OVERHEAD) != len + 1) ||
+        (pn532_packetbuffer[7] != 0x00)) {
+#ifdef MIFAREDEBUG
+      PN532DEBUGPRINT.println(F("Unexpected response to fast read: "));
+      Adafruit_PN532::PrintHexChar(pn532_packetbuffer,
+                                   len + PN532_COMMTHRU_OVERHEAD);
+#endif
+      return 0;
+    }
+
+    /* Page content starts at byte 9 of a valid response */
+    memcpy(buffer, pn532_packetbuffer + 8, len);
+
+    buffer += len;
+    startPage += chunk;
+    pageCount -= chunk;
+  }
+
+  // Return OK signal
+  return 1;
+}
+
 /**************************************************************************/
 /*!
     Tries to write an entire 4-byte page at the specified block
@@ -1532,7 +2097,10 @@ bool Adafruit_PN532::readack() {
 
   if (spi_dev) {
     uint8_t cmd = PN532_SPI_DATAREAD;
-    spi_dev->write_then_read(&cmd, 1, ackbuff, 6);
+    BusIO_WriteSegment out = {&cmd, 1};
+    if (!spiTransfer(&out, 1, ackbuff, 6)) {
+      return false;
+    }
   } else if (i2c_dev || ser_dev) {
     readdata(ackbuff, 6);
   }
@@ -1550,8 +2118,8 @@ bool Adafruit_PN532::isready() {
     // SPI ready check via Status Request
     uint8_t cmd = PN532_SPI_STATREAD;
     uint8_t reply;
-    spi_dev->write_then_read(&cmd, 1, &reply, 1);
-    return reply == PN532_SPI_READY;
+    BusIO_WriteSegment out = {&cmd, 1};
+    return spiTransfer(&out, 1, &reply, 1) && (reply == PN532_SPI_READY);
   } else if (i2c_dev) {
     // I2C ready check via reading RDY byte
     uint8_t rdy[1];
@@ -1575,6 +2143,7 @@ bool Adafruit_PN532::isready() {
 */
 /**************************************************************************/
 bool Adafruit_PN532::waitready(uint16_t timeout) {
+  TraceSpan span(this, "waitready");
   uint16_t timer = 0;
   while (!isready()) {
     if (timeout != 0) {
@@ -1597,19 +2166,45 @@ bool Adafruit_PN532::waitready(uint16_t timeout) {
 
     @param  buff      Pointer to the buffer where data will be written
     @param  n         Number of bytes to be read
+
+    @returns  false if the frame could not be read in full, in which case
+              buff is zeroed
 */
 /**************************************************************************/
-void Adafruit_PN532::readdata(uint8_t *buff, uint8_t n) {
+bool Adafruit_PN532::readdata(uint8_t *buff, uint8_t n) {
+  TraceSpan span(this, "readdata");
+  bool ok = true;
   if (spi_dev) {
     // SPI read
     uint8_t cmd = PN532_SPI_DATAREAD;
-    spi_dev->write_then_read(&cmd, 1, buff, n);
+    BusIO_WriteSegment out = {&cmd, 1};
+    ok = spiTransfer(&out, 1, buff, n);
   } else if (i2c_dev) {
-    // I2C read
-    uint8_t rbuff[n + 1]; // +1 for leading RDY byte
-    i2c_dev->read(rbuff, n + 1);
-    for (uint8_t i = 0; i < n; i++) {
-      buff[i] = rbuff[i + 1];
+    // I2C read, dropping the leading RDY byte and landing the frame directly
+    // in buff. The PN532 restarts its frame on every new read transaction, so
+    // the frame has to come in one. When n does not fit the Wire buffer, read
+    // the header first to learn the real frame length, then read the frame
+    // again from the start if that fits.
+    uint16_t len = n;
+    if ((size_t)n + 1 > i2c_dev->maxBufferSize()) {
+      BusIO_ReadSegment header[2] = {{nullptr, 1}, {buff, 5}};
+      ok = i2c_dev->readv(header, 2) && (buff[0] == 0) && (buff[1] == 0) &&
+           (buff[2] == 0xff) && (buff[4] == (uint8_t)(~buff[3] + 1));
+      len = (uint16_t)buff[3] + PN532_FRAME_OVERHEAD - 1;
+      if (ok && ((len > n) || ((size_t)len + 1 > i2c_dev->maxBufferSize()))) {
+#ifdef PN532DEBUG
+        PN532DEBUGPRINT.println(F("I2C frame larger than the Wire buffer"));
+#endif
+        ok = false;
+      }
+    }
+    if (ok) {
+      BusIO_ReadSegment frame[2] = {{nullptr, 1}, {buff, len}};
+      ok = i2c_dev->readv(frame, 2);
+    }
+    if (!ok) {
+      // Callers that only inspect the buffer must not see a stale frame
+      memset(buff, 0, n);
     }
   } else if (ser_dev) {
     // Serial read
@@ -1623,6 +2218,159 @@ void Adafruit_PN532::readdata(uint8_t *buff, uint8_t n) {
   }
   PN532DEBUGPRINT.println();
 #endif
+  return ok;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Runs one SPI transaction through the SPI device's transfer
+            queue: the write segments, then an optional read.  With a DMA
+            backend set on the device the bytes are clocked in the
+            background while this waits in yield().  A transaction that
+            has not finished after PN532_SPI_TIMEOUT ms is cancelled.  On
+            Linux spidev the transaction is a single SPI_IOC_MESSAGE
+            instead.
+
+            Each frame still blocks its caller.  Other work can overlap
+            the PN532 only between frames: beginCommand() returns once
+            the command is acknowledged, and the response is collected
+            with isComplete() and finishCommand().
+
+    @param  out       Segments to send, empty ones are skipped
+    @param  count     Number of segments, at most 3
+    @param  in        Buffer for the bytes read after the segments
+    @param  inLen     Number of bytes to read, 0 for a write only
+
+    @returns  false if the transaction could not be run or timed out, true
+              otherwise
+*/
+/**************************************************************************/
+bool Adafruit_PN532::spiTransfer(const BusIO_WriteSegment *out, uint8_t count,
+                                 uint8_t *in, uint8_t inLen) {
+  if (count > 3) {
+    return false;
+  }
+#ifdef PN532_LINUX_BUSIO
+  if (inLen == 0) {
+    return spi_dev->writev(out, count);
+  }
+  if (count != 1) {
+    return false;
+  }
+  return spi_dev->write_then_read(out[0].data, out[0].len, in, inLen);
+#else
+  BusIO_SPITransfer xfers[4];
+  uint8_t n = 0;
+
+  memset(xfers, 0, sizeof(xfers));
+  for (uint8_t i = 0; i < count; i++) {
+    if (out[i].len != 0) {
+      xfers[n].tx = out[i].data;
+      xfers[n].len = out[i].len;
+      n++;
+    }
+  }
+  if (inLen != 0) {
+    xfers[n].rx = in;
+    xfers[n].len = inLen;
+    n++;
+  }
+  if (n == 0) {
+    return true;
+  }
+
+  // Hold CS between the pieces so they form a single transaction
+  for (uint8_t i = 0; i < n; i++) {
+    xfers[i].holdCS = (i + 1 < n);
+    spi_dev->queueTransfer(&xfers[i]);
+  }
+  // Give up on a backend that never completes, and take the descriptors
+  // back from the queue before they go out of scope
+  unsigned long start = millis();
+  while (!xfers[n - 1].done) {
+    if (millis() - start > PN532_SPI_TIMEOUT) {
+#ifdef PN532DEBUG
+      PN532DEBUGPRINT.println(F("SPI transfer timeout"));
+#endif
+      spi_dev->cancelTransfers();
+      return false;
+    }
+    spi_dev->poll();
+    yield();
+  }
+  return true;
+#endif
+}
+
+/**************************************************************************/
+/*!
+    @brief  Largest frame the transport can read in one transaction.  On
+            I2C every read starts with the RDY byte and the PN532 restarts
+            the frame on each new transaction, so the Wire buffer bounds it.
+
+    @returns  Frame size in bytes, at most the packet buffer size
+*/
+/**************************************************************************/
+uint8_t Adafruit_PN532::maxFrameLength() {
+  if (i2c_dev && (i2c_dev->maxBufferSize() <= PN532_PACKBUFFSIZ)) {
+    return i2c_dev->maxBufferSize() - 1;
+  }
+  return PN532_PACKBUFFSIZ;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Validates the response frame at the start of the packet buffer:
+            preamble, length checksum, direction, response code and data
+            checksum.
+
+    @param  command   Command code the frame should answer
+    @param  n         Number of bytes read into the packet buffer
+
+    @returns  Number of data bytes following the response code, or -1 if
+              the frame is malformed, truncated or answers another command
+*/
+/**************************************************************************/
+int16_t Adafruit_PN532::checkResponseFrame(uint8_t command, uint16_t n) {
+  // Frame: 00 00 FF LEN LCS D5 CMD+1 DATA... DCS 00
+  if (pn532_packetbuffer[0] != 0 || pn532_packetbuffer[1] != 0 ||
+      pn532_packetbuffer[2] != 0xff) {
+#ifdef PN532DEBUG
+    PN532DEBUGPRINT.println(F("Preamble missing"));
+#endif
+    return -1;
+  }
+
+  uint8_t length = pn532_packetbuffer[3];
+  if ((pn532_packetbuffer[4] != (uint8_t)(~length + 1)) || (length < 2) ||
+      ((uint16_t)length + PN532_FRAME_OVERHEAD - 1 > n)) {
+#ifdef PN532DEBUG
+    PN532DEBUGPRINT.println(F("Length check invalid"));
+#endif
+    return -1;
+  }
+
+  if (pn532_packetbuffer[5] != PN532_PN532TOHOST ||
+      pn532_packetbuffer[6] != (uint8_t)(command + 1)) {
+#ifdef PN532DEBUG
+    PN532DEBUGPRINT.print(F("Unexpected response: "));
+    PN532DEBUGPRINT.println(pn532_packetbuffer[6], HEX);
+#endif
+    return -1;
+  }
+
+  uint8_t sum = 0;
+  for (uint16_t i = 0; i <= length; i++) {
+    sum += pn532_packetbuffer[5 + i];
+  }
+  if (sum != 0) {
+#ifdef PN532DEBUG
+    PN532DEBUGPRINT.println(F("Data checksum invalid"));
+#endif
+    return -1;
+  }
+
+  return length - 2;
 }
 
 /**************************************************************************/
@@ -1674,7 +2422,9 @@ uint8_t Adafruit_PN532::getDataTarget(uint8_t *cmd, uint8_t *cmdlen) {
   uint8_t length;
   pn532_packetbuffer[0] = 0x86;
   if (!sendCommandCheckAck(pn532_packetbuffer, 1, 1000)) {
+#ifdef PN532DEBUG
     PN532DEBUGPRINT.println(F("Error en ack"));
+#endif
     return false;
   }
 
@@ -1730,91 +2480,58 @@ uint8_t Adafruit_PN532::setDataTarget(uint8_t *cmd, uint8_t cmdlen) {
 
     @param  cmd       Pointer to the command buffer
     @param  cmdlen    Command length in bytes
+
+    @returns  false if the frame could not be written, e.g. because it is
+              larger than the Wire buffer (the PN532 cannot take a frame
+              split over several I2C transactions)
 */
 /**************************************************************************/
-void Adafruit_PN532::writecommand(uint8_t *cmd, uint8_t cmdlen) {
-  if (spi_dev) {
-    // SPI command write.
-    uint8_t checksum;
-    uint8_t packet[9 + cmdlen];
-    uint8_t *p = packet;
-    cmdlen++;
-
-    p[0] = PN532_SPI_DATAWRITE;
-    p++;
-
-    p[0] = PN532_PREAMBLE;
-    p++;
-    p[0] = PN532_STARTCODE1;
-    p++;
-    p[0] = PN532_STARTCODE2;
-    p++;
-    checksum = PN532_PREAMBLE + PN532_STARTCODE1 + PN532_STARTCODE2;
-
-    p[0] = cmdlen;
-    p++;
-    p[0] = ~cmdlen + 1;
-    p++;
-
-    p[0] = PN532_HOSTTOPN532;
-    p++;
-    checksum += PN532_HOSTTOPN532;
-
-    for (uint8_t i = 0; i < cmdlen - 1; i++) {
-      p[0] = cmd[i];
-      p++;
-      checksum += cmd[i];
-    }
-
-    p[0] = ~checksum;
-    p++;
-    p[0] = PN532_POSTAMBLE;
-    p++;
-
-#ifdef PN532DEBUG
-    Serial.print("Sending : ");
-    for (int i = 1; i < 8 + cmdlen; i++) {
-      Serial.print("0x");
-      Serial.print(packet[i], HEX);
-      Serial.print(", ");
-    }
-    Serial.println();
-#endif
+bool Adafruit_PN532::writecommand(uint8_t *cmd, uint8_t cmdlen) {
+  // The frame is sent as header, command and trailer segments straight from
+  // their own buffers, so the command is never copied into a packet.
+  // header[0] is the SPI data-write byte and is skipped on I2C and Serial.
+  uint8_t LEN = cmdlen + 1;
+  uint8_t header[7] = {PN532_SPI_DATAWRITE,
+                       PN532_PREAMBLE,
+                       PN532_STARTCODE1,
+                       PN532_STARTCODE2,
+                       LEN,
+                       (uint8_t)(~LEN + 1),
+                       PN532_HOSTTOPN532};
+  uint8_t sum = PN532_HOSTTOPN532;
+  for (uint8_t i = 0; i < cmdlen; i++) {
+    sum += cmd[i];
+  }
+  uint8_t trailer[2] = {(uint8_t)(~sum + 1), PN532_POSTAMBLE};
 
-    spi_dev->write(packet, 8 + cmdlen);
-  } else if (i2c_dev || ser_dev) {
-    // I2C or Serial command write.
-    uint8_t packet[8 + cmdlen];
-    uint8_t LEN = cmdlen + 1;
-
-    packet[0] = PN532_PREAMBLE;
-    packet[1] = PN532_STARTCODE1;
-    packet[2] = PN532_STARTCODE2;
-    packet[3] = LEN;
-    packet[4] = ~LEN + 1;
-    packet[5] = PN532_HOSTTOPN532;
-    uint8_t sum = 0;
-    for (uint8_t i = 0; i < cmdlen; i++) {
-      packet[6 + i] = cmd[i];
-      sum += cmd[i];
-    }
-    packet[6 + cmdlen] = ~(PN532_HOSTTOPN532 + sum) + 1;
-    packet[7 + cmdlen] = PN532_POSTAMBLE;
+  BusIO_WriteSegment frame[3] = {
+      {header, sizeof(header)}, {cmd, cmdlen}, {trailer, sizeof(trailer)}};
+  if (!spi_dev) {
+    frame[0].data++;
+    frame[0].len--;
+  }
 
 #ifdef PN532DEBUG
-    Serial.print("Sending : ");
-    for (int i = 1; i < 8 + cmdlen; i++) {
+  Serial.print("Sending : ");
+  for (uint8_t s = 0; s < 3; s++) {
+    size_t first = ((s == 0) && spi_dev) ? 1 : 0;
+    for (size_t i = first; i < frame[s].len; i++) {
       Serial.print("0x");
-      Serial.print(packet[i], HEX);
+      Serial.print(frame[s].data[i], HEX);
       Serial.print(", ");
     }
-    Serial.println();
+  }
+  Serial.println();
 #endif
 
-    if (i2c_dev) {
-      i2c_dev->write(packet, 8 + cmdlen);
-    } else {
-      ser_dev->write(packet, 8 + cmdlen);
+  if (spi_dev) {
+    return spiTransfer(frame, 3);
+  } else if (i2c_dev) {
+    return i2c_dev->writev(frame, 3);
+  } else if (ser_dev) {
+    for (uint8_t s = 0; s < 3; s++) {
+      ser_dev->write(frame[s].data, frame[s].len);
     }
   }
+  return true;
 }
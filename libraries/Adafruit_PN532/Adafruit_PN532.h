@@ -15,8 +15,18 @@
 
 #include "Arduino.h"
 
+// Define PN532_LINUX_BUSIO to run the driver natively on a Linux host
+// through the spidev and i2c-dev backends of Adafruit_BusIO
+#ifdef PN532_LINUX_BUSIO
+#include <Adafruit_BusIO_Linux.h>
+typedef Adafruit_LinuxSPIDevice PN532_SPIDevice; ///< SPI transport
+typedef Adafruit_LinuxI2CDevice PN532_I2CDevice; ///< I2C transport
+#else
 #include <Adafruit_I2CDevice.h>
 #include <Adafruit_SPIDevice.h>
+typedef Adafruit_SPIDevice PN532_SPIDevice; ///< SPI transport
+typedef Adafruit_I2CDevice PN532_I2CDevice; ///< I2C transport
+#endif
 
 #define PN532_PREAMBLE (0x00)   ///< Command sequence start, byte 1/3
 #define PN532_STARTCODE1 (0x00) ///< Command sequence start, byte 2/3
@@ -62,13 +72,40 @@
 
 #define PN532_RESPONSE_INDATAEXCHANGE (0x41)      ///< Data exchange
 #define PN532_RESPONSE_INLISTPASSIVETARGET (0x4B) ///< List passive target
+#define PN532_RESPONSE_INCOMMUNICATETHRU (0x43)   ///< Communicate through
 
 #define PN532_WAKEUP (0x55) ///< Wake
 
+// PowerDown WakeUpEnable bits
+#define PN532_WAKESRC_INT0 (0x01) ///< Wake on the P32/INT0 pin
+#define PN532_WAKESRC_INT1 (0x02) ///< Wake on the P33/INT1 pin
+#define PN532_WAKESRC_RF (0x08)   ///< Wake on another reader's RF field
+#define PN532_WAKESRC_HSU (0x10)  ///< Wake on HSU (UART) activity
+#define PN532_WAKESRC_SPI (0x20)  ///< Wake on SPI activity
+#define PN532_WAKESRC_GPIO (0x40) ///< Wake on the P34/P35 GPIO pins
+#define PN532_WAKESRC_I2C (0x80)  ///< Wake on I2C activity
+
+// inDataExchange() results, see getExchangeError()
+#define PN532_XCHG_OK (0)       ///< Response received
+#define PN532_XCHG_TOOLONG (1)  ///< Command does not fit the packet or bus buffer
+#define PN532_XCHG_NOACK (2)    ///< PN532 did not acknowledge the command
+#define PN532_XCHG_TIMEOUT (3)  ///< PN532 did not answer in time
+#define PN532_XCHG_BADFRAME (4) ///< Malformed or unexpected response frame
+#define PN532_XCHG_STATUS (5)   ///< PN532 reported an error status
+#define PN532_XCHG_OVERFLOW (6) ///< Response larger than the caller's buffer
+#define PN532_XCHG_READFAIL (7) ///< Response frame could not be read whole
+#define PN532_XCHG_COUNT (8)    ///< Number of result codes
+
+#ifndef PN532_WAKEUP_SETTLE_US
+/// Time given to the PN532 oscillator after a host-interface wake pulse
+#define PN532_WAKEUP_SETTLE_US (1000)
+#endif
+
 #define PN532_SPI_STATREAD (0x02)  ///< Stat read
 #define PN532_SPI_DATAWRITE (0x01) ///< Data write
 #define PN532_SPI_DATAREAD (0x03)  ///< Data read
 #define PN532_SPI_READY (0x01)     ///< Ready
+#define PN532_SPI_TIMEOUT (50)     ///< ms a queued SPI transaction may take
 
 #define PN532_I2C_ADDRESS (0x48 >> 1) ///< Default I2C address
 #define PN532_I2C_READBIT (0x01)      ///< Read bit
@@ -89,6 +126,14 @@
 #define MIFARE_CMD_STORE (0xC2)            ///< Store
 #define MIFARE_ULTRALIGHT_CMD_WRITE (0xA2) ///< Write (MiFare Ultralight)
 
+// mifareclassic_ReadSector() block status
+#define MIFARE_BLOCK_FAILED (0x00) ///< Card did not return the block
+#define MIFARE_BLOCK_READ (0x01)   ///< Block read into the caller's buffer
+#define MIFARE_BLOCK_NOAUTH (0x02) ///< Not sent, sector not authenticated
+
+// NTAG2xx Commands
+#define NTAG2XX_CMD_FAST_READ (0x3A) ///< Fast read (page range)
+
 // Prefixes for NDEF Records (to identify record type)
 #define NDEF_URIPREFIX_NONE (0x00)         ///< No prefix
 #define NDEF_URIPREFIX_HTTP_WWWDOT (0x01)  ///< HTTP www. prefix
@@ -135,21 +180,35 @@
 #define PN532_GPIO_P34 (4)              ///< GPIO 34
 #define PN532_GPIO_P35 (5)              ///< GPIO 35
 
+/// Receives one timed driver step, see Adafruit_PN532::setTraceHook()
+typedef void (*pn532_trace_t)(void *context, const char *step,
+                              uint32_t startUs, uint32_t durationUs);
+
 /**
  * @brief Class for working with Adafruit PN532 NFC/RFID breakout boards.
  */
 class Adafruit_PN532 {
 public:
+#ifdef PN532_LINUX_BUSIO
+  Adafruit_PN532(PN532_SPIDevice *spi); // spidev
+  Adafruit_PN532(PN532_I2CDevice *i2c, int8_t irq = -1,
+                 int8_t reset = -1); // i2c-dev
+#else
   Adafruit_PN532(uint8_t clk, uint8_t miso, uint8_t mosi,
                  uint8_t ss);                          // Software SPI
   Adafruit_PN532(uint8_t ss, SPIClass *theSPI = &SPI); // Hardware SPI
+  Adafruit_PN532(uint8_t ss, PN532_SPIDevice *spi);    // Caller's SPI device
   Adafruit_PN532(uint8_t irq, uint8_t reset,
-                 TwoWire *theWire = &Wire);              // Hardware I2C
+                 TwoWire *theWire = &Wire); // Hardware I2C
+#endif
   Adafruit_PN532(uint8_t reset, HardwareSerial *theSer); // Hardware UART
   bool begin(void);
 
   void reset(void);
   void wakeup(void);
+  bool powerDown(uint8_t wakeSources, bool generateIRQ = false);
+  bool fastWakeup(void);
+  bool isPoweredDown(void) { return _poweredDown; } ///< In PowerDown state
 
   // Generic PN532 functions
   bool SAMConfig(void);
@@ -159,6 +218,13 @@ public:
   bool writeGPIO(uint8_t pinstate);
   uint8_t readGPIO(void);
   bool setPassiveActivationRetries(uint8_t maxRetries);
+  void setTraceHook(pn532_trace_t hook, void *context = NULL);
+
+  // Asynchronous command functions
+  bool beginCommand(uint8_t *cmd, uint8_t cmdlen, uint16_t timeout = 100);
+  bool isComplete(void);
+  bool finishCommand(uint8_t *response, uint8_t *responseLength);
+  bool abortCommand(void);
 
   // ISO14443A functions
   bool readPassiveTargetID(
@@ -168,7 +234,10 @@ public:
   bool readDetectedPassiveTargetID(uint8_t *uid, uint8_t *uidLength);
   bool inDataExchange(uint8_t *send, uint8_t sendLength, uint8_t *response,
                       uint8_t *responseLength);
+  uint8_t getExchangeError(void) { return _xchgError; } ///< PN532_XCHG_*
+  uint8_t getExchangeStatus(void) { return _xchgStatus; } ///< Last status
   bool inListPassiveTarget();
+  uint16_t getFrameWaitTime(void);
   uint8_t AsTarget();
   uint8_t getDataTarget(uint8_t *cmd, uint8_t *cmdlen);
   uint8_t setDataTarget(uint8_t *cmd, uint8_t cmdlen);
@@ -180,6 +249,12 @@ public:
                                           uint32_t blockNumber,
                                           uint8_t keyNumber, uint8_t *keyData);
   uint8_t mifareclassic_ReadDataBlock(uint8_t blockNumber, uint8_t *data);
+  uint8_t mifareclassic_SectorFirstBlock(uint8_t sectorNumber);
+  uint8_t mifareclassic_SectorBlockCount(uint8_t sectorNumber);
+  uint8_t mifareclassic_ReadSector(uint8_t *uid, uint8_t uidLen,
+                                   uint8_t sectorNumber, uint8_t keyNumber,
+                                   uint8_t *keyData, uint8_t *data,
+                                   uint8_t *blockStatus);
   uint8_t mifareclassic_WriteDataBlock(uint8_t blockNumber, uint8_t *data);
   uint8_t mifareclassic_FormatNDEF(void);
   uint8_t mifareclassic_WriteNDEFURI(uint8_t sectorNumber,
@@ -191,6 +266,8 @@ public:
 
   // NTAG2xx functions
   uint8_t ntag2xx_ReadPage(uint8_t page, uint8_t *buffer);
+  uint8_t ntag2xx_ReadPages(uint8_t startPage, uint8_t pageCount,
+                            uint8_t *buffer);
   uint8_t ntag2xx_WritePage(uint8_t page, uint8_t *data);
   uint8_t ntag2xx_WriteNDEFURI(uint8_t uriIdentifier, char *url,
                                uint8_t dataLen);
@@ -205,16 +282,31 @@ private:
   int8_t _uidLen;      // uid len
   int8_t _key[6];      // Mifare Classic key
   int8_t _inListedTag; // Tg number of inlisted tag.
+  uint8_t _fwi = 4;    // Frame waiting time integer from the ATS
+  uint8_t _pendingCommand = 0;        // Command code awaiting finishCommand()
+  bool _commandPending = false;       // beginCommand() ACKed, not finished
+  bool _samConfigured = false;        // SAMConfig() done since the last reset
+  bool _poweredDown = false;          // PowerDown sent, no wakeup yet
+  uint8_t _xchgError = PN532_XCHG_OK; // Result of the last inDataExchange()
+  uint8_t _xchgStatus = 0;            // PN532 status of the last exchange
+  pn532_trace_t _traceHook = NULL;    // Told about every timed step
+  void *_traceContext = NULL;         // Passed to _traceHook
+
+  class TraceSpan;
 
   // Low level communication functions that handle both SPI and I2C.
-  void readdata(uint8_t *buff, uint8_t n);
-  void writecommand(uint8_t *cmd, uint8_t cmdlen);
+  bool readdata(uint8_t *buff, uint8_t n);
+  bool writecommand(uint8_t *cmd, uint8_t cmdlen);
+  bool spiTransfer(const BusIO_WriteSegment *out, uint8_t count,
+                   uint8_t *in = NULL, uint8_t inLen = 0);
+  uint8_t maxFrameLength();
+  int16_t checkResponseFrame(uint8_t command, uint16_t n);
   bool isready();
   bool waitready(uint16_t timeout);
   bool readack();
 
-  Adafruit_SPIDevice *spi_dev = NULL;
-  Adafruit_I2CDevice *i2c_dev = NULL;
+  PN532_SPIDevice *spi_dev = NULL;
+  PN532_I2CDevice *i2c_dev = NULL;
   HardwareSerial *ser_dev = NULL;
 };
 
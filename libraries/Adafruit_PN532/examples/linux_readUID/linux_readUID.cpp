@@ -0,0 +1,86 @@
+/**************************************************************************/
+/*!
+    @file     linux_readUID.cpp
+    @license  BSD (see license.txt)
+
+    Native Linux version of readMifare: opens a PN532 on a spidev or
+    i2c-dev device, prints its firmware version and waits for an ISO14443A
+    card to print its UID. The Arduino IDE does not build this file; build
+    it on the Linux host (e.g. a Raspberry Pi) with the runtime in
+    Adafruit_BusIO/linux:
+
+      g++ -DPN532_LINUX_BUSIO -I../../../Adafruit_BusIO/linux \
+        -I../../../Adafruit_BusIO -I../.. -o linux_readUID \
+        linux_readUID.cpp ../../../Adafruit_BusIO/linux/Arduino.cpp \
+        ../../../Adafruit_BusIO/Adafruit_BusIO_Linux.cpp \
+        ../../Adafruit_PN532.cpp
+
+      ./linux_readUID /dev/spidev0.0
+      ./linux_readUID /dev/i2c-1
+
+    The runtime does not drive GPIOs, so IRQ and RSTPD_N are not used: the
+    driver polls the PN532 status and the chip must be out of reset.
+*/
+/**************************************************************************/
+#include <Adafruit_PN532.h>
+
+#include <stdio.h>
+
+// How long to wait for a card before giving up, in ms
+#define CARD_TIMEOUT 10000
+
+static int readUID(Adafruit_PN532 &nfc) {
+  if (!nfc.begin()) {
+    Serial.println("PN532 did not answer");
+    return 1;
+  }
+
+  uint32_t versiondata = nfc.getFirmwareVersion();
+  if (!versiondata) {
+    Serial.println("Didn't find PN53x board");
+    return 1;
+  }
+  Serial.print("Found chip PN5");
+  Serial.println((versiondata >> 24) & 0xFF, HEX);
+  Serial.print("Firmware ver. ");
+  Serial.print((versiondata >> 16) & 0xFF, DEC);
+  Serial.print('.');
+  Serial.println((versiondata >> 8) & 0xFF, DEC);
+
+  nfc.SAMConfig();
+  Serial.println("Waiting for an ISO14443A card ...");
+
+  uint8_t uid[7];
+  uint8_t uidLength;
+  if (!nfc.readPassiveTargetID(PN532_MIFARE_ISO14443A, uid, &uidLength,
+                               CARD_TIMEOUT)) {
+    Serial.println("No card found");
+    return 1;
+  }
+  Serial.print("UID Value:");
+  for (uint8_t i = 0; i < uidLength; i++) {
+    Serial.print(" 0x");
+    Serial.print(uid[i], HEX);
+  }
+  Serial.println();
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  if (argc != 2) {
+    fprintf(stderr, "usage: %s /dev/spidevB.C | /dev/i2c-N\n", argv[0]);
+    return 2;
+  }
+  const char *path = argv[1];
+
+  if (strncmp(path, "/dev/i2c-", 9) == 0) {
+    Adafruit_LinuxI2CDevice i2c(path, PN532_I2C_ADDRESS);
+    Adafruit_PN532 nfc(&i2c);
+    return readUID(nfc);
+  }
+
+  // PN532 SPI is mode 0, LSB first
+  Adafruit_LinuxSPIDevice spi(path, 1000000, 0, true);
+  Adafruit_PN532 nfc(&spi);
+  return readUID(nfc);
+}
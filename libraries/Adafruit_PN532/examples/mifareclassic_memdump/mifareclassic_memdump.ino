@@ -80,9 +80,11 @@ void loop(void) {
   uint8_t success;                          // Flag to check if there was an error with the PN532
   uint8_t uid[] = { 0, 0, 0, 0, 0, 0, 0 };  // Buffer to store the returned UID
   uint8_t uidLength;                        // Length of the UID (4 or 7 bytes depending on ISO14443A card type)
-  uint8_t currentblock;                     // Counter to keep track of which block we're on
-  bool authenticated = false;               // Flag to indicate if the sector is authenticated
-  uint8_t data[16];                         // Array to store block data during reads
+  uint8_t currentsector;                    // Counter to keep track of which sector we're on
+  uint8_t data[4 * 16];                     // Array to store the sector's blocks during reads
+  uint8_t status[4];                        // Per-block read status for the current sector
+  unsigned long started;                    // Time the current sector read started
+  unsigned long elapsed = 0;                // Time spent talking to the card, in milliseconds
 
   // Keyb on NDEF and Mifare Classic should be the same
   uint8_t keyuniversal[6] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
@@ -105,55 +107,31 @@ void loop(void) {
       // We probably have a Mifare Classic card ...
       Serial.println("Seems to be a Mifare Classic card (4 byte UID)");
 
-      // Now we try to go through all 16 sectors (each having 4 blocks)
-      // authenticating each sector, and then dumping the blocks
-      for (currentblock = 0; currentblock < 64; currentblock++)
+      // Now we try to go through all 16 sectors (each having 4 blocks),
+      // authenticating each sector once, and then dumping its blocks
+      for (currentsector = 0; currentsector < 16; currentsector++)
       {
-        // Check if this is a new block so that we can reauthenticate
-        if (nfc.mifareclassic_IsFirstBlock(currentblock)) authenticated = false;
-
-        // If the sector hasn't been authenticated, do so first
-        if (!authenticated)
-        {
-          // Starting of a new sector ... try to to authenticate
-          Serial.print("------------------------Sector ");Serial.print(currentblock/4, DEC);Serial.println("-------------------------");
-          if (currentblock == 0)
-          {
-              // This will be 0xFF 0xFF 0xFF 0xFF 0xFF 0xFF for Mifare Classic (non-NDEF!)
-              // or 0xA0 0xA1 0xA2 0xA3 0xA4 0xA5 for NDEF formatted cards using key a,
-              // but keyb should be the same for both (0xFF 0xFF 0xFF 0xFF 0xFF 0xFF)
-              success = nfc.mifareclassic_AuthenticateBlock (uid, uidLength, currentblock, 1, keyuniversal);
-          }
-          else
-          {
-              // This will be 0xFF 0xFF 0xFF 0xFF 0xFF 0xFF for Mifare Classic (non-NDEF!)
-              // or 0xD3 0xF7 0xD3 0xF7 0xD3 0xF7 for NDEF formatted cards using key a,
-              // but keyb should be the same for both (0xFF 0xFF 0xFF 0xFF 0xFF 0xFF)
-              success = nfc.mifareclassic_AuthenticateBlock (uid, uidLength, currentblock, 1, keyuniversal);
-          }
-          if (success)
-          {
-            authenticated = true;
-          }
-          else
-          {
-            Serial.println("Authentication error");
-          }
-        }
-        // If we're still not authenticated just skip the block
-        if (!authenticated)
+        Serial.print("------------------------Sector ");Serial.print(currentsector, DEC);Serial.println("-------------------------");
+
+        // This will be 0xFF 0xFF 0xFF 0xFF 0xFF 0xFF for Mifare Classic (non-NDEF!)
+        // or 0xA0 0xA1 0xA2 0xA3 0xA4 0xA5 (sector 0) and 0xD3 0xF7 0xD3 0xF7 0xD3 0xF7
+        // (other sectors) for NDEF formatted cards using key a,
+        // but keyb should be the same for both (0xFF 0xFF 0xFF 0xFF 0xFF 0xFF)
+        started = millis();
+        success = nfc.mifareclassic_ReadSector(uid, uidLength, currentsector, 1, keyuniversal, data, status);
+        elapsed += millis() - started;
+        if (status[0] == MIFARE_BLOCK_NOAUTH)
         {
-          Serial.print("Block ");Serial.print(currentblock, DEC);Serial.println(" unable to authenticate");
+          Serial.println("Authentication error");
         }
-        else
+
+        for (uint8_t i = 0; i < 4; i++)
         {
-          // Authenticated ... we should be able to read the block now
-          // Dump the data into the 'data' array
-          success = nfc.mifareclassic_ReadDataBlock(currentblock, data);
-          if (success)
+          uint8_t currentblock = nfc.mifareclassic_SectorFirstBlock(currentsector) + i;
+          Serial.print("Block ");Serial.print(currentblock, DEC);
+          if (status[i] == MIFARE_BLOCK_READ)
           {
             // Read successful
-            Serial.print("Block ");Serial.print(currentblock, DEC);
             if (currentblock < 10)
             {
               Serial.print("  ");
@@ -163,16 +141,20 @@ void loop(void) {
               Serial.print(" ");
             }
             // Dump the raw data
-            nfc.PrintHexChar(data, 16);
+            nfc.PrintHexChar(data + (i * 16), 16);
+          }
+          else if (status[i] == MIFARE_BLOCK_NOAUTH)
+          {
+            Serial.println(" unable to authenticate");
           }
           else
           {
             // Oops ... something happened
-            Serial.print("Block ");Serial.print(currentblock, DEC);
             Serial.println(" unable to read this block");
           }
         }
       }
+      Serial.print("Dumped 64 blocks in ");Serial.print(elapsed, DEC);Serial.println(" ms (excluding serial output)");
     }
     else
     {
@@ -90,7 +90,7 @@ void loop(void) {
 
     if (uidLength == 7)
     {
-      uint8_t data[32];
+      uint8_t data[42 * 4];
 
       // We probably have an NTAG2xx card (though it could be Ultralight as well)
       Serial.println("Seems to be an NTAG2xx tag (7 byte UID)");
@@ -108,9 +108,17 @@ void loop(void) {
       // NTAG 215       135     4             129
       // NTAG 216       231     4             225
 
+      // Read all 42 pages with as few FAST_READs as the bus allows.
+      // NTAG203 tags do not support FAST_READ and go back to IDLE after
+      // refusing it, so select the tag again and read it one page at a time.
+      bool bulk = nfc.ntag2xx_ReadPages(0, 42, data);
+      if (!bulk) {
+        nfc.readPassiveTargetID(PN532_MIFARE_ISO14443A, uid, &uidLength);
+      }
+
       for (uint8_t i = 0; i < 42; i++)
       {
-        success = nfc.ntag2xx_ReadPage(i, data);
+        success = bulk ? 1 : nfc.ntag2xx_ReadPage(i, data + (i * 4));
 
         // Display the current page number
         Serial.print("PAGE ");
@@ -129,7 +137,7 @@ void loop(void) {
         if (success)
         {
           // Dump the page data
-          nfc.PrintHexChar(data, 4);
+          nfc.PrintHexChar(data + (i * 4), 4);
         }
         else
         {
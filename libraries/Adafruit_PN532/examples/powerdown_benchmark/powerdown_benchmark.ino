@@ -0,0 +1,174 @@
+/**************************************************************************/
+/*!
+    @file     powerdown_benchmark.ino
+    @author   Adafruit Industries
+    @license  BSD (see license.txt)
+
+    Measures the time from a given reader state to the first APDU answered
+    by an ISO14443-4 card, to show what PowerDown costs between taps:
+
+    - cold:       full begin() (reset, wakeup and SAM configuration)
+    - idle:       PN532 already awake and configured
+    - powerdown:  PN532 in PowerDown, woken with fastWakeup()
+
+    Leave an ISO14443-4 card (e.g. a bank card or phone) on the reader while
+    the benchmark runs. The APDU sent is a SELECT of the PPSE, which most
+    payment-style cards answer.
+
+This is an example sketch for the Adafruit PN532 NFC/RFID breakout boards
+This library works with the Adafruit NFC breakout
+  ----> https://www.adafruit.com/products/364
+
+Check out the links above for our tutorials and wiring diagrams
+These chips use SPI or I2C to communicate.
+
+Adafruit invests time and resources providing this open source code,
+please support Adafruit and open-source hardware by purchasing
+products from Adafruit!
+
+*/
+/**************************************************************************/
+#include <Wire.h>
+#include <SPI.h>
+#include <Adafruit_PN532.h>
+
+// If using the breakout with SPI, define the pins for SPI communication.
+#define PN532_SCK  (2)
+#define PN532_MOSI (3)
+#define PN532_SS   (4)
+#define PN532_MISO (5)
+
+// If using the breakout or shield with I2C, define just the pins connected
+// to the IRQ and reset lines.  Use the values below (2, 3) for the shield!
+#define PN532_IRQ   (2)
+#define PN532_RESET (3)  // Not connected by default on the NFC Shield
+
+// Uncomment just _one_ line below depending on how your breakout or shield
+// is connected to the Arduino:
+
+// Use this line for a breakout with a software SPI connection (recommended):
+Adafruit_PN532 nfc(PN532_SCK, PN532_MISO, PN532_MOSI, PN532_SS);
+
+// Use this line for a breakout with a hardware SPI connection.
+//Adafruit_PN532 nfc(PN532_SS);
+
+// Or use this line for a breakout or shield with an I2C connection:
+//Adafruit_PN532 nfc(PN532_IRQ, PN532_RESET);
+
+// Or use hardware Serial:
+//Adafruit_PN532 nfc(PN532_RESET, &Serial1);
+
+#define ROUNDS 10
+
+// SELECT 2PAY.SYS.DDF01
+uint8_t selectPPSE[] = {0x00, 0xA4, 0x04, 0x00, 0x0E, '2', 'P', 'A', 'Y',
+                        '.',  'S',  'Y',  'S',  '.',  'D', 'D', 'F', '0',
+                        '1',  0x00};
+
+// Returns the time in us from now until the card answers the APDU, or 0
+uint32_t firstAPDU(uint32_t start) {
+  uint8_t uid[7];
+  uint8_t uidLength;
+  uint8_t response[64];
+  uint8_t responseLength = sizeof(response);
+
+  if (!nfc.readPassiveTargetID(PN532_MIFARE_ISO14443A, uid, &uidLength, 1000))
+    return 0;
+  if (!nfc.inDataExchange(selectPPSE, sizeof(selectPPSE), response,
+                          &responseLength))
+    return 0;
+  return micros() - start;
+}
+
+void report(const char *name, uint32_t total, uint8_t ok) {
+  Serial.print(name);
+  if (ok == 0) {
+    Serial.println(F("no card answered"));
+    return;
+  }
+  Serial.print(total / ok);
+  Serial.print(F(" us average over "));
+  Serial.print(ok);
+  Serial.println(F(" taps"));
+}
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial) delay(10); // for Leonardo/Micro/Zero
+
+  Serial.println("PN532 PowerDown benchmark");
+
+  nfc.begin();
+
+  uint32_t versiondata = nfc.getFirmwareVersion();
+  if (! versiondata) {
+    Serial.print("Didn't find PN53x board");
+    while (1); // halt
+  }
+  nfc.setPassiveActivationRetries(0xFF);
+}
+
+void loop(void) {
+  uint32_t total, t;
+  uint8_t ok;
+
+  // Cold start
+  total = 0;
+  ok = 0;
+  for (uint8_t i = 0; i < ROUNDS; i++) {
+    uint32_t start = micros();
+    nfc.begin();
+    if ((t = firstAPDU(start)) != 0) {
+      total += t;
+      ok++;
+    }
+  }
+  report("cold:      ", total, ok);
+
+  // Already awake
+  total = 0;
+  ok = 0;
+  for (uint8_t i = 0; i < ROUNDS; i++) {
+    delay(100);
+    if ((t = firstAPDU(micros())) != 0) {
+      total += t;
+      ok++;
+    }
+  }
+  report("idle:      ", total, ok);
+
+  // PowerDown between taps
+  total = 0;
+  ok = 0;
+  uint32_t wake = 0;
+  uint8_t woken = 0;
+  for (uint8_t i = 0; i < ROUNDS; i++) {
+    // Only the host interface wakes it; PN532_WAKESRC_RF would need the
+    // field of another reader, a card cannot provide one
+    if (!nfc.powerDown(0)) {
+      Serial.println(F("PowerDown failed"));
+      continue;
+    }
+    delay(100);
+    uint32_t start = micros();
+    if (!nfc.fastWakeup())
+      continue;
+    wake += micros() - start;
+    woken++;
+    if ((t = firstAPDU(start)) != 0) {
+      total += t;
+      ok++;
+    }
+  }
+  report("powerdown: ", total, ok);
+  if (woken != 0) {
+    Serial.print(F("  of which wake-up: "));
+    Serial.print(wake / woken);
+    Serial.print(F(" us average over "));
+    Serial.print(woken);
+    Serial.println(F(" wake-ups"));
+  }
+
+  Serial.println();
+  delay(2000);
+}
@@ -0,0 +1,286 @@
+/*!
+ * @file FakePN532.h
+ *
+ * Frame level PN532 emulator for the host tests. It takes the host's
+ * information frames, answers with an ACK frame followed by a response
+ * frame and knows a card with an ISO/IEC 14443-4 ATS, or a MIFARE Classic
+ * 1K card when mifareClassic is set. spiByte()/spiEnd() and i2cRead() add
+ * the SPI operation byte and the I2C RDY byte on top.
+ */
+
+#ifndef FakePN532_h
+#define FakePN532_h
+
+#include <deque>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+/*! @brief Emulated PN532 with one card in the field */
+class FakePN532 {
+public:
+  /*! @brief Card application: answers one APDU, status word included */
+  typedef std::vector<uint8_t> (*ApduHandler)(void *context,
+                                              const std::vector<uint8_t> &apdu);
+
+  int commands = 0;            ///< Valid command frames received
+  int badFrames = 0;           ///< Frames with a bad preamble or checksum
+  int aborts = 0;              ///< ACK frames received from the host
+  uint8_t lastCommand = 0;     ///< Command code of the last valid frame
+  int responseDelay = 2;       ///< Not-ready polls before each response
+  std::vector<uint8_t> apduReply; ///< InDataExchange data, empty to echo
+  ApduHandler apduHandler = nullptr; ///< Answers APDUs, before apduReply
+  void *apduContext = nullptr; ///< Passed to apduHandler
+  bool corruptNextResponse = false; ///< Flip the DCS of the next response
+  bool mifareClassic = false;  ///< InDataExchange talks to a MIFARE 1K card
+  int mifareFailBlock = -1;    ///< Block whose READ fails, -1 for none
+  int mifareAuths = 0;         ///< MIFARE authentications received
+  int mifareReads = 0;         ///< MIFARE READs received
+
+  /*!
+   * @brief Content of a block of the emulated MIFARE Classic card
+   * @param block Block number
+   * @param i Byte within the block
+   * @return The byte
+   */
+  static uint8_t mifareByte(uint8_t block, uint8_t i) {
+    return (uint8_t)(block * 17 + i);
+  }
+
+  /*!
+   * @brief Take one complete frame written by the host
+   * @param data The frame, from the preamble to the postamble
+   * @param len Number of bytes
+   */
+  void write(const uint8_t *data, size_t len) {
+    static const uint8_t ack[6] = {0x00, 0x00, 0xFF, 0x00, 0xFF, 0x00};
+    if ((len == sizeof(ack)) && (memcmp(data, ack, sizeof(ack)) == 0)) {
+      aborts++;
+      _out.clear();
+      return;
+    }
+
+    // 00 00 FF LEN LCS D4 CMD DATA... DCS 00
+    if ((len < 9) || (data[0] != 0x00) || (data[1] != 0x00) ||
+        (data[2] != 0xFF) || ((uint8_t)(data[3] + data[4]) != 0) ||
+        ((size_t)data[3] + 7 != len) || (data[5] != 0xD4) ||
+        (data[len - 1] != 0x00)) {
+      badFrames++;
+      return;
+    }
+    uint8_t sum = 0;
+    for (size_t i = 5; i < len - 1; i++) {
+      sum += data[i];
+    }
+    if (sum != 0) {
+      badFrames++;
+      return;
+    }
+
+    commands++;
+    lastCommand = data[6];
+    _out.clear();
+    _out.push_back(Frame{std::vector<uint8_t>(ack, ack + sizeof(ack)), 0});
+    respond(std::vector<uint8_t>(data + 6, data + len - 2));
+  }
+
+  /*!
+   * @brief Status poll, the pending frame may need a few polls
+   * @return True if a frame can be read
+   */
+  bool ready(void) {
+    if (_out.empty()) {
+      return false;
+    }
+    if (_out.front().delay > 0) {
+      _out.front().delay--;
+      return false;
+    }
+    return true;
+  }
+
+  /*!
+   * @brief The frame a read returns, always from its first byte
+   * @return The frame, empty if there is none
+   */
+  std::vector<uint8_t> current(void) const {
+    return _out.empty() ? std::vector<uint8_t>() : _out.front().bytes;
+  }
+
+  /*! @brief Drop the current frame once the host has read all of it */
+  void consume(void) {
+    if (!_out.empty()) {
+      _out.pop_front();
+    }
+  }
+
+  /*!
+   * @brief Clock one byte of an SPI transaction. The first byte after CS
+   * falls is the operation: 01 data write, 02 status read, 03 data read.
+   * @param tx Byte from the host
+   * @return Byte to the host
+   */
+  uint8_t spiByte(uint8_t tx) {
+    if (!_spiActive) {
+      _spiActive = true;
+      _spiOp = tx;
+      _spiData.clear();
+      _spiPos = 0;
+      if (_spiOp == 0x03) {
+        _spiFrame = current();
+      }
+      return 0xFF;
+    }
+    switch (_spiOp) {
+    case 0x01:
+      _spiData.push_back(tx);
+      return 0xFF;
+    case 0x02:
+      return ready() ? 0x01 : 0x00;
+    case 0x03:
+      return (_spiPos < _spiFrame.size()) ? _spiFrame[_spiPos++] : 0x00;
+    default:
+      return 0xFF;
+    }
+  }
+
+  /*! @brief CS rises: a data write is taken as one frame, a data read that
+   * covered the whole frame consumes it */
+  void spiEnd(void) {
+    if ((_spiOp == 0x01) && !_spiData.empty()) {
+      write(_spiData.data(), _spiData.size());
+    } else if ((_spiOp == 0x03) && !_spiFrame.empty() &&
+               (_spiPos >= _spiFrame.size())) {
+      consume();
+    }
+    _spiActive = false;
+  }
+
+  /*! @brief True between the first spiByte() of a transaction and spiEnd() */
+  bool spiActive(void) const { return _spiActive; }
+
+  /*!
+   * @brief Answer an I2C read: the RDY byte, then the current frame from
+   * its first byte. Reading the whole frame consumes it.
+   * @param buf Bytes to the host
+   * @param len Length of the read
+   */
+  void i2cRead(uint8_t *buf, size_t len) {
+    memset(buf, 0, len);
+    if ((len == 0) || !ready()) {
+      return;
+    }
+    std::vector<uint8_t> frame = current();
+    buf[0] = 0x01;
+    memcpy(buf + 1, frame.data(), (len - 1 < frame.size()) ? len - 1
+                                                          : frame.size());
+    if (len - 1 >= frame.size()) {
+      consume();
+    }
+  }
+
+private:
+  /*! @brief A frame waiting to be read */
+  struct Frame {
+    std::vector<uint8_t> bytes;
+    int delay;
+  };
+
+  std::deque<Frame> _out;
+  bool _spiActive = false;
+  uint8_t _spiOp = 0;
+  std::vector<uint8_t> _spiData;
+  std::vector<uint8_t> _spiFrame;
+  size_t _spiPos = 0;
+  int _mifareSector = -1; // Authenticated sector, -1 for none
+
+  // MIFARE Classic commands carried by InDataExchange: the key is 6 x FF
+  // for every sector and any failed command drops the authentication.
+  void mifare(const std::vector<uint8_t> &cmd, std::vector<uint8_t> &data) {
+    static const uint8_t key[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    uint8_t status = 0x14; // Authentication error
+    switch (cmd[2]) {
+    case 0x60: // Authenticate with key A or B
+    case 0x61:
+      mifareAuths++;
+      _mifareSector = -1;
+      if ((cmd.size() >= 14) && (cmd[3] < 64) &&
+          (memcmp(&cmd[4], key, sizeof(key)) == 0)) {
+        _mifareSector = cmd[3] / 4;
+        status = 0x00;
+      }
+      data.push_back(status);
+      break;
+    case 0x30: // READ
+      mifareReads++;
+      if ((cmd.size() >= 4) && (cmd[3] / 4 == _mifareSector) &&
+          (cmd[3] != mifareFailBlock)) {
+        data.push_back(0x00);
+        for (uint8_t i = 0; i < 16; i++) {
+          data.push_back(mifareByte(cmd[3], i));
+        }
+        return;
+      }
+      _mifareSector = -1;
+      data.push_back(status);
+      break;
+    default:
+      _mifareSector = -1;
+      data.push_back(0x27); // Command not acceptable
+      break;
+    }
+  }
+
+  void respond(const std::vector<uint8_t> &cmd) {
+    std::vector<uint8_t> data;
+    switch (cmd[0]) {
+    case 0x02: // GetFirmwareVersion: IC, Ver, Rev, Support
+      data = {0x32, 0x01, 0x06, 0x07};
+      break;
+    case 0x40: // InDataExchange: status, then the card's answer
+      if (mifareClassic) {
+        mifare(cmd, data);
+        break;
+      }
+      data.push_back(0x00);
+      if (apduHandler != nullptr) {
+        std::vector<uint8_t> reply = apduHandler(
+            apduContext, std::vector<uint8_t>(cmd.begin() + 2, cmd.end()));
+        data.insert(data.end(), reply.begin(), reply.end());
+      } else if (!apduReply.empty()) {
+        data.insert(data.end(), apduReply.begin(), apduReply.end());
+      } else {
+        data.insert(data.end(), cmd.begin() + 2, cmd.end());
+        data.push_back(0x90);
+        data.push_back(0x00);
+      }
+      break;
+    case 0x4A: // InListPassiveTarget: one ISO/IEC 14443-4 card, FWI 7
+      data = {0x01, 0x01, 0x00, 0x04, 0x20, 0x04, 0x01, 0x02, 0x03, 0x04,
+              0x05, 0x78, 0x80, 0x70, 0x02};
+      break;
+    case 0x16: // PowerDown: status
+      data.push_back(0x00);
+      break;
+    default: // SAMConfiguration and others answer without data
+      break;
+    }
+
+    uint8_t len = (uint8_t)(data.size() + 2);
+    std::vector<uint8_t> frame = {0x00, 0x00, 0xFF, len, (uint8_t)(0 - len),
+                                  0xD5, (uint8_t)(cmd[0] + 1)};
+    frame.insert(frame.end(), data.begin(), data.end());
+    uint8_t sum = 0;
+    for (size_t i = 5; i < frame.size(); i++) {
+      sum += frame[i];
+    }
+    frame.push_back((uint8_t)(0 - sum) ^ (corruptNextResponse ? 0x01 : 0x00));
+    frame.push_back(0x00);
+    corruptNextResponse = false;
+
+    _out.push_back(Frame{frame, responseDelay});
+  }
+};
+
+#endif // FakePN532_h
@@ -0,0 +1,37 @@
+#!/usr/bin/env bash
+#
+# Builds and runs the PN532 host tests with the system compiler, on top of
+# the host Arduino core from the BusIO tests.
+
+set -e
+cd "$(dirname "$0")"
+
+BUSIO=../../Adafruit_BusIO
+CXX=${CXX:-g++}
+CXXFLAGS="--std=c++14 -Wall -Wextra -I$BUSIO/test/host -I$BUSIO -I.."
+SOURCES="$BUSIO/test/host/Arduino.cpp $BUSIO/Adafruit_SPIDevice.cpp \
+  $BUSIO/Adafruit_I2CDevice.cpp ../Adafruit_PN532.cpp"
+OUT=$(mktemp -d)
+trap 'rm -rf "$OUT"' EXIT
+
+echo "*** Building ***"
+$CXX $CXXFLAGS -o "$OUT/test_pn532_spi" test_pn532_spi.cpp $SOURCES
+$CXX $CXXFLAGS -o "$OUT/test_pn532_mifare" test_pn532_mifare.cpp $SOURCES
+$CXX $CXXFLAGS -DPN532_LINUX_BUSIO -o "$OUT/test_pn532_linux" \
+  test_pn532_linux.cpp $BUSIO/test/host/Arduino.cpp \
+  $BUSIO/Adafruit_BusIO_Linux.cpp ../Adafruit_PN532.cpp
+# Same test and the Linux example on the real-time runtime
+LINUX_FLAGS="--std=c++14 -Wall -Wextra -DPN532_LINUX_BUSIO -I$BUSIO/linux \
+  -I$BUSIO -I.."
+LINUX_SOURCES="$BUSIO/linux/Arduino.cpp $BUSIO/Adafruit_BusIO_Linux.cpp \
+  ../Adafruit_PN532.cpp"
+$CXX $LINUX_FLAGS -DLINUX_RUNTIME -o "$OUT/test_pn532_linux_rt" \
+  test_pn532_linux.cpp $LINUX_SOURCES
+$CXX $LINUX_FLAGS -o "$OUT/linux_readUID" \
+  ../examples/linux_readUID/linux_readUID.cpp $LINUX_SOURCES
+
+echo "*** Running tests ***"
+"$OUT/test_pn532_spi"
+"$OUT/test_pn532_mifare"
+"$OUT/test_pn532_linux"
+"$OUT/test_pn532_linux_rt"
@@ -0,0 +1,195 @@
+/*!
+ * @file test_pn532_linux.cpp
+ *
+ * Runs the PN532 driver on the Linux spidev and i2c-dev backends of BusIO
+ * (built with PN532_LINUX_BUSIO) against an emulated PN532 installed with
+ * setIoctl(), so the full framing goes through the same SPI_IOC_MESSAGE
+ * and I2C_RDWR calls as on real hardware.
+ *
+ * Built with LINUX_RUNTIME against Adafruit_BusIO/linux instead of the host
+ * core, the same exchange runs with the real clock and sleeps.
+ */
+
+#ifndef LINUX_RUNTIME
+#include "BusIO_Host.h"
+#endif
+#include "FakePN532.h"
+#include <Adafruit_PN532.h>
+#include <linux/i2c-dev.h>
+#include <linux/i2c.h>
+#include <stdio.h>
+
+static int failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);         \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+/*! @brief What the fake kernel saw */
+struct FakeKernel {
+  FakePN532 *pn532;
+  int messages;  ///< SPI_IOC_MESSAGE or I2C_RDWR calls
+  uint8_t mode;  ///< SPI mode set by begin()
+  uint8_t lsb;   ///< SPI bit order set by begin()
+  uint16_t addr; ///< Address of the last I2C message
+};
+
+static int spiIoctl(void *context, int fd, unsigned long request, void *arg) {
+  FakeKernel *k = (FakeKernel *)context;
+  (void)fd;
+
+  switch (request) {
+  case SPI_IOC_WR_MODE:
+    k->mode = *(uint8_t *)arg;
+    return 0;
+  case SPI_IOC_WR_LSB_FIRST:
+    k->lsb = *(uint8_t *)arg;
+    return 0;
+  case SPI_IOC_WR_BITS_PER_WORD:
+  case SPI_IOC_WR_MAX_SPEED_HZ:
+    return 0;
+  default:
+    break;
+  }
+  if ((_IOC_TYPE(request) != SPI_IOC_MAGIC) || (_IOC_NR(request) != 0)) {
+    return -1;
+  }
+
+  // One message is one CS assertion across all of its transfers
+  struct spi_ioc_transfer *xfers = (struct spi_ioc_transfer *)arg;
+  size_t count = _IOC_SIZE(request) / sizeof(struct spi_ioc_transfer);
+  for (size_t t = 0; t < count; t++) {
+    const uint8_t *tx = (const uint8_t *)(uintptr_t)xfers[t].tx_buf;
+    uint8_t *rx = (uint8_t *)(uintptr_t)xfers[t].rx_buf;
+    for (size_t i = 0; i < xfers[t].len; i++) {
+      uint8_t in = k->pn532->spiByte((tx != nullptr) ? tx[i] : 0x00);
+      if (rx != nullptr) {
+        rx[i] = in;
+      }
+    }
+  }
+  k->pn532->spiEnd();
+  k->messages++;
+  return (int)count;
+}
+
+static int i2cIoctl(void *context, int fd, unsigned long request, void *arg) {
+  FakeKernel *k = (FakeKernel *)context;
+  (void)fd;
+
+  if (request == I2C_FUNCS) {
+    *(unsigned long *)arg = I2C_FUNC_I2C;
+    return 0;
+  }
+  if (request != I2C_RDWR) {
+    return -1;
+  }
+
+  // The PN532 restarts its frame on every read message
+  struct i2c_rdwr_ioctl_data *data = (struct i2c_rdwr_ioctl_data *)arg;
+  for (uint32_t m = 0; m < data->nmsgs; m++) {
+    struct i2c_msg *msg = &data->msgs[m];
+    k->addr = msg->addr;
+    if (msg->flags & I2C_M_RD) {
+      k->pn532->i2cRead(msg->buf, msg->len);
+    } else {
+      k->pn532->write(msg->buf, msg->len);
+    }
+  }
+  k->messages++;
+  return (int)data->nmsgs;
+}
+
+static void checkExchange(Adafruit_PN532 &nfc, FakePN532 &pn532) {
+  CHECK(nfc.getFirmwareVersion() == 0x32010607UL);
+
+  CHECK(nfc.inListPassiveTarget());
+  CHECK(nfc.getFrameWaitTime() == 39); // FWI 7 from the ATS
+
+  uint8_t apdu[] = {0x00, 0xB0, 0x00, 0x00, 0x00};
+  uint8_t response[255];
+  uint8_t responseLength = sizeof(response);
+  CHECK(nfc.inDataExchange(apdu, sizeof(apdu), response, &responseLength));
+  CHECK(responseLength == sizeof(apdu) + 2);
+  CHECK(memcmp(response, apdu, sizeof(apdu)) == 0);
+
+  // A long answer arrives in one piece
+  for (int i = 0; i < 200; i++) {
+    pn532.apduReply.push_back((uint8_t)i);
+  }
+  responseLength = sizeof(response);
+  CHECK(nfc.inDataExchange(apdu, sizeof(apdu), response, &responseLength));
+  CHECK(responseLength == 200);
+  CHECK(memcmp(response, pn532.apduReply.data(), 200) == 0);
+  pn532.apduReply.clear();
+
+  pn532.corruptNextResponse = true;
+  responseLength = sizeof(response);
+  CHECK(!nfc.inDataExchange(apdu, sizeof(apdu), response, &responseLength));
+  CHECK(nfc.getExchangeError() == PN532_XCHG_BADFRAME);
+
+  uint8_t list[] = {PN532_COMMAND_INLISTPASSIVETARGET, 1, 0};
+  CHECK(nfc.beginCommand(list, sizeof(list)));
+  CHECK(nfc.abortCommand());
+  CHECK(pn532.aborts == 1);
+  CHECK(nfc.getFirmwareVersion() == 0x32010607UL);
+
+  CHECK(pn532.badFrames == 0);
+}
+
+static void testI2C(void) {
+  FakePN532 pn532;
+  FakeKernel k = {&pn532, 0, 0xFF, 0xFF, 0};
+  Adafruit_LinuxI2CDevice i2c("/dev/i2c-test", PN532_I2C_ADDRESS);
+  Adafruit_PN532 nfc(&i2c);
+
+#ifndef LINUX_RUNTIME
+  hostReset();
+#endif
+  i2c.setIoctl(i2cIoctl, &k);
+  CHECK(nfc.begin());
+  CHECK(pn532.lastCommand == 0x14); // SAMConfiguration
+  checkExchange(nfc, pn532);
+  CHECK(k.addr == PN532_I2C_ADDRESS);
+  CHECK(k.messages > 0);
+}
+
+static void testSPI(void) {
+  FakePN532 pn532;
+  FakeKernel k = {&pn532, 0, 0xFF, 0xFF, 0};
+  Adafruit_LinuxSPIDevice spi("/dev/spidev-test", 1000000, 0, true);
+  Adafruit_PN532 nfc(&spi);
+
+#ifndef LINUX_RUNTIME
+  hostReset();
+#endif
+  spi.setIoctl(spiIoctl, &k);
+  CHECK(nfc.begin());
+  CHECK((k.mode == 0) && (k.lsb == 1));
+  CHECK(pn532.lastCommand == 0x14);
+  checkExchange(nfc, pn532);
+  CHECK(!pn532.spiActive());
+  CHECK(k.messages > 0);
+}
+
+int main(void) {
+  unsigned long start = millis();
+
+  testI2C();
+  testSPI();
+
+  if (failures != 0) {
+    printf("test_pn532_linux: %d check(s) failed\n", failures);
+    return 1;
+  }
+#ifdef LINUX_RUNTIME
+  printf("test_pn532_linux: OK (real time, %lu ms)\n", millis() - start);
+#else
+  printf("test_pn532_linux: OK (simulated, %lu ms)\n", millis() - start);
+#endif
+  return 0;
+}
@@ -0,0 +1,196 @@
+/*!
+ * @file test_pn532_mifare.cpp
+ *
+ * Dumps an emulated MIFARE Classic 1K card over SPI three ways and prints
+ * what each costs: authenticating every block, authenticating every sector
+ * with mifareclassic_ReadDataBlock() (the old memdump flow), and
+ * mifareclassic_ReadSector(). Also checks the per-block status codes of
+ * the sector reader when a read or the authentication fails.
+ */
+
+#include "BusIO_Host.h"
+#include "FakePN532.h"
+#include <Adafruit_PN532.h>
+#include <stdio.h>
+
+#define PIN_CS 10
+
+static int failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);         \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+/*! @brief Transfer backend wired to the emulated PN532, one tick late */
+struct FakeBus {
+  Adafruit_SPIDevice *dev;
+  FakePN532 *pn532;
+  BusIO_SPITransfer *active;
+  unsigned long bytes;
+};
+
+static void busInterrupt(void *context) {
+  FakeBus *bus = (FakeBus *)context;
+  BusIO_SPITransfer *xfer = bus->active;
+
+  for (size_t i = 0; i < xfer->len; i++) {
+    uint8_t rx = bus->pn532->spiByte((xfer->tx != nullptr) ? xfer->tx[i]
+                                                           : 0xFF);
+    if (xfer->rx != nullptr) {
+      xfer->rx[i] = rx;
+    }
+  }
+  if (!xfer->holdCS) {
+    bus->pn532->spiEnd();
+  }
+  bus->bytes += xfer->len;
+  bus->active = nullptr;
+  bus->dev->transferComplete();
+}
+
+static bool busStart(void *context, Adafruit_SPIDevice *dev,
+                     BusIO_SPITransfer *xfer) {
+  FakeBus *bus = (FakeBus *)context;
+  (void)dev;
+
+  bus->active = xfer;
+  hostRaiseInterrupt(busInterrupt, bus);
+  return true;
+}
+
+/*! @brief Cost of one full card dump */
+struct DumpCost {
+  int commands;
+  int auths;
+  unsigned long bytes;
+  unsigned long ms;
+};
+
+static uint8_t uid[] = {0x01, 0x02, 0x03, 0x04};
+static uint8_t key[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+static uint8_t card[64 * 16];
+
+static bool cardMatches(void) {
+  for (uint8_t block = 0; block < 64; block++) {
+    for (uint8_t i = 0; i < 16; i++) {
+      if (card[block * 16 + i] != FakePN532::mifareByte(block, i)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static void dumpPerBlock(Adafruit_PN532 &nfc) {
+  for (uint8_t block = 0; block < 64; block++) {
+    CHECK(nfc.mifareclassic_AuthenticateBlock(uid, 4, block, 1, key));
+    CHECK(nfc.mifareclassic_ReadDataBlock(block, card + block * 16));
+  }
+}
+
+static void dumpPerSector(Adafruit_PN532 &nfc) {
+  for (uint8_t block = 0; block < 64; block++) {
+    if (nfc.mifareclassic_IsFirstBlock(block)) {
+      CHECK(nfc.mifareclassic_AuthenticateBlock(uid, 4, block, 1, key));
+    }
+    CHECK(nfc.mifareclassic_ReadDataBlock(block, card + block * 16));
+  }
+}
+
+static void dumpReadSector(Adafruit_PN532 &nfc) {
+  uint8_t status[4];
+  for (uint8_t sector = 0; sector < 16; sector++) {
+    CHECK(nfc.mifareclassic_ReadSector(uid, 4, sector, 1, key,
+                                       card + sector * 64, status) == 4);
+  }
+}
+
+static DumpCost measure(const char *name, void (*dump)(Adafruit_PN532 &),
+                        Adafruit_PN532 &nfc, FakePN532 &pn532, FakeBus &bus) {
+  DumpCost cost;
+  int commands = pn532.commands;
+  int auths = pn532.mifareAuths;
+  unsigned long bytes = bus.bytes;
+  unsigned long start = millis();
+
+  memset(card, 0, sizeof(card));
+  dump(nfc);
+  cost.commands = pn532.commands - commands;
+  cost.auths = pn532.mifareAuths - auths;
+  cost.bytes = bus.bytes - bytes;
+  cost.ms = millis() - start;
+  CHECK(cardMatches());
+  printf("  %-28s %3d commands, %2d auths, %5lu SPI bytes, %5lu ms\n", name,
+         cost.commands, cost.auths, cost.bytes, cost.ms);
+  return cost;
+}
+
+int main(void) {
+  FakePN532 pn532;
+  Adafruit_SPIDevice spi(PIN_CS, 1000000, SPI_BITORDER_LSBFIRST, SPI_MODE0,
+                         &SPI);
+  FakeBus bus = {&spi, &pn532, nullptr, 0};
+  Adafruit_PN532 nfc(PIN_CS, &spi);
+
+  hostReset();
+  spi.setTransferBackend(busStart, &bus);
+  pn532.mifareClassic = true;
+  CHECK(nfc.begin());
+
+  // Full 1K dump. The time is the simulated clock, so it counts the
+  // driver's own delays and polls but no RF time.
+  printf("1K card dump:\n");
+  DumpCost block = measure("auth per block", dumpPerBlock, nfc, pn532, bus);
+  DumpCost sector = measure("auth per sector", dumpPerSector, nfc, pn532, bus);
+  DumpCost reader = measure("mifareclassic_ReadSector", dumpReadSector, nfc,
+                            pn532, bus);
+  CHECK(block.commands == 128);
+  CHECK(sector.commands == 80);
+  CHECK(reader.commands == 80);
+  CHECK(reader.auths == 16);
+  CHECK(reader.bytes <= sector.bytes);
+
+  // A failed READ drops the authentication: the rest of the sector is not
+  // sent to the card
+  uint8_t data[4 * 16];
+  uint8_t status[4];
+  int reads = pn532.mifareReads;
+  pn532.mifareFailBlock = 5;
+  CHECK(nfc.mifareclassic_ReadSector(uid, 4, 1, 1, key, data, status) == 1);
+  CHECK(status[0] == MIFARE_BLOCK_READ);
+  CHECK(status[1] == MIFARE_BLOCK_FAILED);
+  CHECK(status[2] == MIFARE_BLOCK_NOAUTH);
+  CHECK(status[3] == MIFARE_BLOCK_NOAUTH);
+  CHECK(pn532.mifareReads - reads == 2);
+  CHECK(memcmp(data, card + 4 * 16, 16) == 0);
+  pn532.mifareFailBlock = -1;
+
+  // A wrong key reads nothing
+  uint8_t badKey[6] = {0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5};
+  reads = pn532.mifareReads;
+  CHECK(nfc.mifareclassic_ReadSector(uid, 4, 2, 0, badKey, data, status) == 0);
+  for (uint8_t i = 0; i < 4; i++) {
+    CHECK(status[i] == MIFARE_BLOCK_NOAUTH);
+  }
+  CHECK(pn532.mifareReads == reads);
+
+  // Sector layout of 4K cards
+  CHECK(nfc.mifareclassic_SectorFirstBlock(31) == 124);
+  CHECK(nfc.mifareclassic_SectorFirstBlock(32) == 128);
+  CHECK(nfc.mifareclassic_SectorFirstBlock(39) == 240);
+  CHECK(nfc.mifareclassic_SectorBlockCount(32) == 16);
+  CHECK(nfc.mifareclassic_SectorBlockCount(40) == 0);
+
+  CHECK(pn532.badFrames == 0);
+
+  if (failures != 0) {
+    printf("test_pn532_mifare: %d check(s) failed\n", failures);
+    return 1;
+  }
+  printf("test_pn532_mifare: OK\n");
+  return 0;
+}
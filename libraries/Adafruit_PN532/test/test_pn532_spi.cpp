@@ -0,0 +1,153 @@
+/*!
+ * @file test_pn532_spi.cpp
+ *
+ * Runs the PN532 driver over SPI through the BusIO transfer queue with a
+ * simulated DMA backend: every byte goes through a transfer whose
+ * completion interrupt fires later, so the driver has to wait for the
+ * queue instead of relying on a blocking transfer. A stalled backend must
+ * make the command fail within the transfer timeout.
+ */
+
+#include "BusIO_Host.h"
+#include "FakePN532.h"
+#include <Adafruit_PN532.h>
+#include <stdio.h>
+
+#define PIN_CS 10
+#define DMA_LATENCY 3 // dispatch points a transfer stays on the wire
+
+static int failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);         \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+/*! @brief Simulated DMA channel wired to the emulated PN532 */
+struct FakeBus {
+  Adafruit_SPIDevice *dev;
+  FakePN532 *pn532;
+  BusIO_SPITransfer *active;
+  int ticks;
+  int starts;
+  int completions;
+  bool stall; ///< Accept transfers but never finish them
+  int stops;
+};
+
+static void dmaInterrupt(void *context) {
+  FakeBus *bus = (FakeBus *)context;
+  BusIO_SPITransfer *xfer = bus->active;
+
+  if (--bus->ticks > 0) {
+    hostRaiseInterrupt(dmaInterrupt, bus);
+    return;
+  }
+  for (size_t i = 0; i < xfer->len; i++) {
+    uint8_t rx = bus->pn532->spiByte((xfer->tx != nullptr) ? xfer->tx[i]
+                                                           : 0xFF);
+    if (xfer->rx != nullptr) {
+      xfer->rx[i] = rx;
+    }
+  }
+  if (!xfer->holdCS) {
+    bus->pn532->spiEnd();
+  }
+  bus->active = nullptr;
+  bus->completions++;
+  bus->dev->transferComplete();
+}
+
+static bool dmaStart(void *context, Adafruit_SPIDevice *dev,
+                     BusIO_SPITransfer *xfer) {
+  FakeBus *bus = (FakeBus *)context;
+  (void)dev;
+
+  CHECK(bus->active == nullptr);
+  bus->active = xfer;
+  bus->ticks = DMA_LATENCY;
+  bus->starts++;
+  if (!bus->stall) {
+    hostRaiseInterrupt(dmaInterrupt, bus);
+  }
+  return true;
+}
+
+static void dmaStop(void *context, Adafruit_SPIDevice *dev,
+                    BusIO_SPITransfer *xfer) {
+  FakeBus *bus = (FakeBus *)context;
+  (void)dev;
+
+  CHECK(bus->active == xfer);
+  bus->active = nullptr;
+  bus->stops++;
+}
+
+int main(void) {
+  FakePN532 pn532;
+  Adafruit_SPIDevice spi(PIN_CS, 1000000, SPI_BITORDER_LSBFIRST, SPI_MODE0,
+                         &SPI);
+  FakeBus bus = {&spi, &pn532, nullptr, 0, 0, 0, false, 0};
+  Adafruit_PN532 nfc(PIN_CS, &spi);
+
+  hostReset();
+  spi.setTransferBackend(dmaStart, &bus, dmaStop);
+
+  // begin() wakes the PN532 and runs SAMConfiguration
+  CHECK(nfc.begin());
+  CHECK(pn532.lastCommand == 0x14);
+
+  CHECK(nfc.getFirmwareVersion() == 0x32010607UL);
+
+  CHECK(nfc.inListPassiveTarget());
+  CHECK(nfc.getFrameWaitTime() == 39); // FWI 7 from the ATS
+
+  uint8_t apdu[] = {0x00, 0xA4, 0x04, 0x00, 0x02, 0x3F, 0x00};
+  uint8_t response[32];
+  uint8_t responseLength = sizeof(response);
+  CHECK(nfc.inDataExchange(apdu, sizeof(apdu), response, &responseLength));
+  CHECK(responseLength == sizeof(apdu) + 2);
+  CHECK(memcmp(response, apdu, sizeof(apdu)) == 0);
+  CHECK((response[sizeof(apdu)] == 0x90) && (response[sizeof(apdu) + 1] == 0));
+
+  // A corrupted response is rejected, not handed to the caller
+  pn532.corruptNextResponse = true;
+  responseLength = sizeof(response);
+  CHECK(!nfc.inDataExchange(apdu, sizeof(apdu), response, &responseLength));
+  CHECK(nfc.getExchangeError() == PN532_XCHG_BADFRAME);
+
+  // An aborted command leaves no stale response behind
+  uint8_t list[] = {PN532_COMMAND_INLISTPASSIVETARGET, 1, 0};
+  CHECK(nfc.beginCommand(list, sizeof(list)));
+  CHECK(nfc.abortCommand());
+  CHECK(pn532.aborts == 1);
+  CHECK(nfc.getFirmwareVersion() == 0x32010607UL);
+
+  // A backend that never completes fails the command after the transfer
+  // timeout instead of hanging, with CS released
+  bus.stall = true;
+  unsigned long start = millis();
+  CHECK(nfc.getFirmwareVersion() == 0);
+  CHECK(millis() - start <= PN532_SPI_TIMEOUT + 1);
+  CHECK(bus.stops == 1);
+  CHECK(!spi.transferBusy());
+  CHECK(hostPinTrace().back().pin == PIN_CS);
+  CHECK(hostPinTrace().back().value == HIGH);
+  bus.stall = false;
+  CHECK(nfc.getFirmwareVersion() == 0x32010607UL);
+
+  CHECK(pn532.badFrames == 0);
+  CHECK(bus.starts > 0);
+  CHECK(bus.completions + bus.stops == bus.starts);
+  CHECK(!pn532.spiActive());
+
+  if (failures != 0) {
+    printf("test_pn532_spi: %d check(s) failed\n", failures);
+    return 1;
+  }
+  printf("test_pn532_spi: OK (%d queued transfers)\n", bus.completions);
+  return 0;
+}
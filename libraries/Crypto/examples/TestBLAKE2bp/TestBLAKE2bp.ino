@@ -0,0 +1,358 @@
+/*
+ * Copyright (C) 2026 The cryptnox-sdk-arduino contributors.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+This example runs tests on the BLAKE2bp implementation to verify correct
+behaviour, and compares its speed with plain BLAKE2b.  BLAKE2bp needs
+more than 1K of RAM per object, so this needs a board with plenty of
+memory or a host build.
+*/
+
+#include <Crypto.h>
+#include <BLAKE2bp.h>
+#include <BLAKE2b.h>
+#include <string.h>
+#if defined(ESP8266) || defined(ESP32)
+#include <pgmspace.h>
+#else
+#include <avr/pgmspace.h>
+#endif
+
+#define HASH_SIZE 64
+#define MAX_CHUNK 256
+
+struct TestHashVector
+{
+    const char *name;
+    uint16_t dataLen;
+    uint8_t keyLen;
+    uint8_t outputLength;
+    uint8_t hash[HASH_SIZE];
+};
+
+// The data and key bytes are 0, 1, 2, ... as in the known answer tests of
+// the BLAKE2 reference implementation.  The keyed vectors are entries
+// from its blake2bp-kat.txt.
+static TestHashVector const testVectorBLAKE2bp_1 PROGMEM = {
+    "BLAKE2bp #1",
+    0,
+    64,
+    64,
+    {0x9d, 0x94, 0x61, 0x07, 0x3e, 0x4e, 0xb6, 0x40,
+     0xa2, 0x55, 0x35, 0x7b, 0x83, 0x9f, 0x39, 0x4b,
+     0x83, 0x8c, 0x6f, 0xf5, 0x7c, 0x9b, 0x68, 0x6a,
+     0x3f, 0x76, 0x10, 0x7c, 0x10, 0x66, 0x72, 0x8f,
+     0x3c, 0x99, 0x56, 0xbd, 0x78, 0x5c, 0xbc, 0x3b,
+     0xf7, 0x9d, 0xc2, 0xab, 0x57, 0x8c, 0x5a, 0x0c,
+     0x06, 0x3b, 0x9d, 0x9c, 0x40, 0x58, 0x48, 0xde,
+     0x1d, 0xbe, 0x82, 0x1c, 0xd0, 0x5c, 0x94, 0x0a}
+};
+static TestHashVector const testVectorBLAKE2bp_2 PROGMEM = {
+    "BLAKE2bp #2",
+    1,
+    64,
+    64,
+    {0xff, 0x8e, 0x90, 0xa3, 0x7b, 0x94, 0x62, 0x39,
+     0x32, 0xc5, 0x9f, 0x75, 0x59, 0xf2, 0x60, 0x35,
+     0x02, 0x9c, 0x37, 0x67, 0x32, 0xcb, 0x14, 0xd4,
+     0x16, 0x02, 0x00, 0x1c, 0xbb, 0x73, 0xad, 0xb7,
+     0x92, 0x93, 0xa2, 0xdb, 0xda, 0x5f, 0x60, 0x70,
+     0x30, 0x25, 0x14, 0x4d, 0x15, 0x8e, 0x27, 0x35,
+     0x52, 0x95, 0x96, 0x25, 0x1c, 0x73, 0xc0, 0x34,
+     0x5c, 0xa6, 0xfc, 0xcb, 0x1f, 0xb1, 0xe9, 0x7e}
+};
+static TestHashVector const testVectorBLAKE2bp_3 PROGMEM = {
+    "BLAKE2bp #3",
+    64,
+    64,
+    64,
+    {0x22, 0xb8, 0x24, 0x9e, 0xaf, 0x72, 0x29, 0x64,
+     0xce, 0x42, 0x4f, 0x71, 0xa7, 0x4d, 0x03, 0x8f,
+     0xf9, 0xb6, 0x15, 0xfb, 0xa5, 0xc7, 0xc2, 0x2c,
+     0xb6, 0x27, 0x97, 0xf5, 0x39, 0x82, 0x24, 0xc3,
+     0xf0, 0x72, 0xeb, 0xc1, 0xda, 0xcb, 0xa3, 0x2f,
+     0xc6, 0xf6, 0x63, 0x60, 0xb3, 0xe1, 0x65, 0x8d,
+     0x0f, 0xa0, 0xda, 0x1e, 0xd1, 0xc1, 0xda, 0x66,
+     0x2a, 0x20, 0x37, 0xda, 0x82, 0x3a, 0x33, 0x83}
+};
+static TestHashVector const testVectorBLAKE2bp_4 PROGMEM = {
+    "BLAKE2bp #4",
+    255,
+    64,
+    64,
+    {0x96, 0xfb, 0xcb, 0xb6, 0x0b, 0xd3, 0x13, 0xb8,
+     0x84, 0x50, 0x33, 0xe5, 0xbc, 0x05, 0x8a, 0x38,
+     0x02, 0x74, 0x38, 0x57, 0x2d, 0x7e, 0x79, 0x57,
+     0xf3, 0x68, 0x4f, 0x62, 0x68, 0xaa, 0xdd, 0x3a,
+     0xd0, 0x8d, 0x21, 0x76, 0x7e, 0xd6, 0x87, 0x86,
+     0x85, 0x33, 0x1b, 0xa9, 0x85, 0x71, 0x48, 0x7e,
+     0x12, 0x47, 0x0a, 0xad, 0x66, 0x93, 0x26, 0x71,
+     0x6e, 0x46, 0x66, 0x7f, 0x69, 0xf8, 0xd7, 0xe8}
+};
+static TestHashVector const testVectorBLAKE2bp_5 PROGMEM = {
+    "BLAKE2bp #5",
+    3,
+    0,
+    20,
+    {0x55, 0xdb, 0x30, 0x12, 0xb2, 0x60, 0xb4, 0x15,
+     0xd6, 0x08, 0x0f, 0xff, 0xab, 0xa3, 0xdd, 0xd6,
+     0xf2, 0x31, 0x1e, 0x1f}
+};
+static TestHashVector const testVectorBLAKE2bp_6 PROGMEM = {
+    "BLAKE2bp #6",
+    1500,
+    0,
+    64,
+    {0x4d, 0x5e, 0x9a, 0x80, 0xbc, 0x7f, 0x73, 0xae,
+     0x9e, 0xfb, 0xf7, 0x37, 0x71, 0xff, 0xe7, 0x9b,
+     0x23, 0xea, 0xfb, 0x1a, 0x69, 0x7b, 0x54, 0x23,
+     0x39, 0x00, 0xdf, 0x22, 0x6f, 0xa5, 0x7d, 0xf7,
+     0x32, 0x31, 0xae, 0xcc, 0xdf, 0xc3, 0xd7, 0xca,
+     0xc0, 0x76, 0xbc, 0x9c, 0x24, 0x6e, 0xa9, 0x84,
+     0xca, 0x99, 0x34, 0x60, 0x3f, 0xbb, 0x9b, 0x29,
+     0x42, 0xde, 0x16, 0xbc, 0x97, 0x38, 0x89, 0xb1}
+};
+static TestHashVector const testVectorBLAKE2bp_7 PROGMEM = {
+    "BLAKE2bp #7",
+    4097,
+    0,
+    64,
+    {0x65, 0xe1, 0xdd, 0xc7, 0x2b, 0x56, 0xac, 0xc9,
+     0x24, 0xce, 0x51, 0x98, 0x5a, 0x0a, 0x35, 0x5b,
+     0x36, 0x1e, 0x87, 0x4f, 0x33, 0x28, 0xd7, 0x1a,
+     0xa4, 0x0d, 0x6f, 0xd6, 0xe2, 0x2b, 0xa7, 0xa3,
+     0xbd, 0x93, 0xc2, 0x34, 0x4b, 0xc7, 0x7a, 0xce,
+     0xa4, 0xcf, 0x4a, 0xfc, 0x58, 0xdd, 0x69, 0x1f,
+     0x50, 0x0e, 0x45, 0x98, 0x3e, 0xb9, 0x8f, 0x71,
+     0x6d, 0xe5, 0xfd, 0x17, 0x53, 0xd9, 0x0f, 0xe3}
+};
+
+static TestHashVector const *const testVectors[] = {
+    &testVectorBLAKE2bp_1,
+    &testVectorBLAKE2bp_2,
+    &testVectorBLAKE2bp_3,
+    &testVectorBLAKE2bp_4,
+    &testVectorBLAKE2bp_5,
+    &testVectorBLAKE2bp_6,
+    &testVectorBLAKE2bp_7
+};
+
+BLAKE2bp blake2bp;
+BLAKE2b blake2b;
+
+byte buffer[1024];
+TestHashVector testVector;
+
+bool testHash_N(BLAKE2bp *hash, const struct TestHashVector *test, size_t inc)
+{
+    size_t posn, len;
+    uint8_t value[HASH_SIZE];
+
+    if (test->keyLen > 0)
+        hash->reset(buffer, test->keyLen, test->outputLength);
+    else
+        hash->reset(test->outputLength);
+    for (posn = 0; posn < test->dataLen; posn += inc) {
+        len = test->dataLen - posn;
+        if (len > inc)
+            len = inc;
+        hash->update(buffer + (posn % 256), len);
+    }
+    memset(value, 0xAA, sizeof(value));
+    hash->finalize(value, sizeof(value));
+    if (memcmp(value, test->hash, test->outputLength) != 0)
+        return false;
+    if (test->outputLength < HASH_SIZE && value[test->outputLength] != 0xAA)
+        return false;
+
+    return true;
+}
+
+void testHash(BLAKE2bp *hash, const struct TestHashVector *test)
+{
+    bool ok;
+
+    memcpy_P(&testVector, test, sizeof(TestHashVector));
+    test = &testVector;
+
+    Serial.print(test->name);
+    Serial.print(" ... ");
+
+    ok  = testHash_N(hash, test, MAX_CHUNK);
+    ok &= testHash_N(hash, test, 1);
+    ok &= testHash_N(hash, test, 13);
+    ok &= testHash_N(hash, test, 128);
+    ok &= testHash_N(hash, test, 100);
+
+    if (ok)
+        Serial.println("Passed");
+    else
+        Serial.println("Failed");
+}
+
+// Hashes a long run of data in one update() call, which is the path that
+// compresses straight from the caller's buffer.
+void testOneShot(BLAKE2bp *hash)
+{
+    uint8_t expected[HASH_SIZE];
+    uint8_t value[HASH_SIZE];
+
+    Serial.print("One update ... ");
+
+    hash->reset();
+    for (size_t posn = 0; posn < sizeof(buffer); posn += 64)
+        hash->update(buffer + posn, 64);
+    hash->finalize(expected, sizeof(expected));
+
+    hash->reset();
+    hash->update(buffer, sizeof(buffer));
+    hash->finalize(value, sizeof(value));
+
+    if (memcmp(value, expected, sizeof(value)) == 0)
+        Serial.println("Passed");
+    else
+        Serial.println("Failed");
+}
+
+void perfHash(Hash *hash, const char *name)
+{
+    unsigned long start;
+    unsigned long elapsed;
+    int count;
+
+    Serial.print(name);
+    Serial.print(" hashing ... ");
+
+    hash->reset();
+    start = micros();
+    for (count = 0; count < 1000; ++count) {
+        hash->update(buffer, sizeof(buffer));
+    }
+    elapsed = micros() - start;
+
+    Serial.print(elapsed / (sizeof(buffer) * 1000.0));
+    Serial.print("us per byte, ");
+    Serial.print((sizeof(buffer) * 1000.0 * 1000000.0) / elapsed);
+    Serial.println(" bytes per second");
+}
+
+void perfFinalize(Hash *hash, const char *name)
+{
+    unsigned long start;
+    unsigned long elapsed;
+    int count;
+
+    Serial.print(name);
+    Serial.print(" finalizing ... ");
+
+    hash->reset();
+    hash->update("abc", 3);
+    start = micros();
+    for (count = 0; count < 1000; ++count) {
+        hash->finalize(buffer, hash->hashSize());
+    }
+    elapsed = micros() - start;
+
+    Serial.print(elapsed / 1000.0);
+    Serial.print("us per op, ");
+    Serial.print((1000.0 * 1000000.0) / elapsed);
+    Serial.println(" ops per second");
+
+    // Put back the data that finalize() overwrote.
+    for (size_t posn = 0; posn < sizeof(buffer); ++posn)
+        buffer[posn] = (uint8_t)posn;
+}
+
+#if defined(CRYPTO_BLAKE2P_THREADS)
+
+// Big enough for the hash object to hand the leaves out to threads.
+byte bigBuffer[65536];
+
+void perfThreads(BLAKE2bp *hash)
+{
+    unsigned long start;
+    unsigned long elapsed;
+    uint8_t value[HASH_SIZE];
+    uint8_t expected[HASH_SIZE];
+    int count;
+
+    for (uint8_t threads = 1; threads <= BLAKE2bp::LEAVES; threads *= 2) {
+        Serial.print("BLAKE2bp threads=");
+        Serial.print(threads);
+        Serial.print(" ... ");
+
+        hash->setThreads(threads);
+        hash->reset();
+        start = micros();
+        for (count = 0; count < 32; ++count) {
+            hash->update(bigBuffer, sizeof(bigBuffer));
+        }
+        elapsed = micros() - start;
+        hash->finalize(value, sizeof(value));
+        if (threads == 1)
+            memcpy(expected, value, sizeof(value));
+        else if (memcmp(value, expected, sizeof(value)) != 0)
+            Serial.print("[mismatch] ");
+
+        Serial.print(elapsed / (sizeof(bigBuffer) * 32.0));
+        Serial.print("us per byte, ");
+        Serial.print((sizeof(bigBuffer) * 32.0 * 1000000.0) / elapsed);
+        Serial.println(" bytes per second");
+    }
+    hash->setThreads(1);
+}
+
+#endif
+
+void setup()
+{
+    Serial.begin(9600);
+
+    Serial.println();
+
+    for (size_t posn = 0; posn < sizeof(buffer); ++posn)
+        buffer[posn] = (uint8_t)posn;
+
+    Serial.print("State Size ...");
+    Serial.println(sizeof(BLAKE2bp));
+    Serial.println();
+
+    Serial.println("Test Vectors:");
+    for (uint8_t index = 0; index < sizeof(testVectors) / sizeof(testVectors[0]); ++index)
+        testHash(&blake2bp, testVectors[index]);
+    testOneShot(&blake2bp);
+
+    Serial.println();
+
+    Serial.println("Performance Tests:");
+    perfHash(&blake2b, "BLAKE2b");
+    perfHash(&blake2bp, "BLAKE2bp");
+    perfFinalize(&blake2b, "BLAKE2b");
+    perfFinalize(&blake2bp, "BLAKE2bp");
+#if defined(CRYPTO_BLAKE2P_THREADS)
+    perfThreads(&blake2bp);
+#endif
+}
+
+void loop()
+{
+}
@@ -0,0 +1,334 @@
+/*
+ * Copyright (C) 2026 The cryptnox-sdk-arduino contributors.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+This example runs tests on the BLAKE2sp implementation to verify correct
+behaviour, and compares its speed with plain BLAKE2s.  BLAKE2sp needs
+more than 1K of RAM per object, so this needs a board with plenty of
+memory or a host build.
+*/
+
+#include <Crypto.h>
+#include <BLAKE2sp.h>
+#include <BLAKE2s.h>
+#include <string.h>
+#if defined(ESP8266) || defined(ESP32)
+#include <pgmspace.h>
+#else
+#include <avr/pgmspace.h>
+#endif
+
+#define HASH_SIZE 32
+#define MAX_CHUNK 256
+
+struct TestHashVector
+{
+    const char *name;
+    uint16_t dataLen;
+    uint8_t keyLen;
+    uint8_t outputLength;
+    uint8_t hash[HASH_SIZE];
+};
+
+// The data and key bytes are 0, 1, 2, ... as in the known answer tests of
+// the BLAKE2 reference implementation.  The keyed vectors are entries
+// from its blake2sp-kat.txt.
+static TestHashVector const testVectorBLAKE2sp_1 PROGMEM = {
+    "BLAKE2sp #1",
+    0,
+    32,
+    32,
+    {0x71, 0x5c, 0xb1, 0x38, 0x95, 0xae, 0xb6, 0x78,
+     0xf6, 0x12, 0x41, 0x60, 0xbf, 0xf2, 0x14, 0x65,
+     0xb3, 0x0f, 0x4f, 0x68, 0x74, 0x19, 0x3f, 0xc8,
+     0x51, 0xb4, 0x62, 0x10, 0x43, 0xf0, 0x9c, 0xc6}
+};
+static TestHashVector const testVectorBLAKE2sp_2 PROGMEM = {
+    "BLAKE2sp #2",
+    1,
+    32,
+    32,
+    {0x40, 0x57, 0x8f, 0xfa, 0x52, 0xbf, 0x51, 0xae,
+     0x18, 0x66, 0xf4, 0x28, 0x4d, 0x3a, 0x15, 0x7f,
+     0xc1, 0xbc, 0xd3, 0x6a, 0xc1, 0x3c, 0xbd, 0xcb,
+     0x03, 0x77, 0xe4, 0xd0, 0xcd, 0x0b, 0x66, 0x03}
+};
+static TestHashVector const testVectorBLAKE2sp_3 PROGMEM = {
+    "BLAKE2sp #3",
+    64,
+    32,
+    32,
+    {0x1d, 0x37, 0x01, 0xa5, 0x66, 0x1b, 0xd3, 0x1a,
+     0xb2, 0x05, 0x62, 0xbd, 0x07, 0xb7, 0x4d, 0xd1,
+     0x9a, 0xc8, 0xf3, 0x52, 0x4b, 0x73, 0xce, 0x7b,
+     0xc9, 0x96, 0xb7, 0x88, 0xaf, 0xd2, 0xf3, 0x17}
+};
+static TestHashVector const testVectorBLAKE2sp_4 PROGMEM = {
+    "BLAKE2sp #4",
+    255,
+    32,
+    32,
+    {0x0c, 0x8a, 0x36, 0x59, 0x7d, 0x74, 0x61, 0xc6,
+     0x3a, 0x94, 0x73, 0x28, 0x21, 0xc9, 0x41, 0x85,
+     0x6c, 0x66, 0x83, 0x76, 0x60, 0x6c, 0x86, 0xa5,
+     0x2d, 0xe0, 0xee, 0x41, 0x04, 0xc6, 0x15, 0xdb}
+};
+static TestHashVector const testVectorBLAKE2sp_5 PROGMEM = {
+    "BLAKE2sp #5",
+    3,
+    0,
+    20,
+    {0x57, 0xc4, 0xc4, 0x1d, 0xb5, 0x8d, 0x2b, 0x85,
+     0x70, 0x0e, 0xcf, 0xbb, 0xea, 0x26, 0x52, 0x05,
+     0xc3, 0x84, 0x49, 0x54}
+};
+static TestHashVector const testVectorBLAKE2sp_6 PROGMEM = {
+    "BLAKE2sp #6",
+    1500,
+    0,
+    32,
+    {0x28, 0xa8, 0xfc, 0xfd, 0x73, 0x52, 0xe2, 0x81,
+     0x8b, 0x17, 0xf9, 0x86, 0x9b, 0x9a, 0xca, 0x26,
+     0x9c, 0x23, 0x9b, 0x11, 0xab, 0x8d, 0x4f, 0x91,
+     0x47, 0x4a, 0xd4, 0x32, 0x26, 0x78, 0xba, 0x0e}
+};
+static TestHashVector const testVectorBLAKE2sp_7 PROGMEM = {
+    "BLAKE2sp #7",
+    4097,
+    0,
+    32,
+    {0xff, 0x56, 0xcf, 0x04, 0xd1, 0x72, 0x4a, 0x53,
+     0xf3, 0x7f, 0xfe, 0xa6, 0x82, 0xe8, 0x3b, 0xbc,
+     0xd0, 0x03, 0x3f, 0x6f, 0xc0, 0xdf, 0xef, 0x6a,
+     0x21, 0xdb, 0xf6, 0x21, 0xa7, 0x9e, 0xb6, 0x67}
+};
+
+static TestHashVector const *const testVectors[] = {
+    &testVectorBLAKE2sp_1,
+    &testVectorBLAKE2sp_2,
+    &testVectorBLAKE2sp_3,
+    &testVectorBLAKE2sp_4,
+    &testVectorBLAKE2sp_5,
+    &testVectorBLAKE2sp_6,
+    &testVectorBLAKE2sp_7
+};
+
+BLAKE2sp blake2sp;
+BLAKE2s blake2s;
+
+byte buffer[1024];
+TestHashVector testVector;
+
+bool testHash_N(BLAKE2sp *hash, const struct TestHashVector *test, size_t inc)
+{
+    size_t posn, len;
+    uint8_t value[HASH_SIZE];
+
+    if (test->keyLen > 0)
+        hash->reset(buffer, test->keyLen, test->outputLength);
+    else
+        hash->reset(test->outputLength);
+    for (posn = 0; posn < test->dataLen; posn += inc) {
+        len = test->dataLen - posn;
+        if (len > inc)
+            len = inc;
+        hash->update(buffer + (posn % 256), len);
+    }
+    memset(value, 0xAA, sizeof(value));
+    hash->finalize(value, sizeof(value));
+    if (memcmp(value, test->hash, test->outputLength) != 0)
+        return false;
+    if (test->outputLength < HASH_SIZE && value[test->outputLength] != 0xAA)
+        return false;
+
+    return true;
+}
+
+void testHash(BLAKE2sp *hash, const struct TestHashVector *test)
+{
+    bool ok;
+
+    memcpy_P(&testVector, test, sizeof(TestHashVector));
+    test = &testVector;
+
+    Serial.print(test->name);
+    Serial.print(" ... ");
+
+    ok  = testHash_N(hash, test, MAX_CHUNK);
+    ok &= testHash_N(hash, test, 1);
+    ok &= testHash_N(hash, test, 13);
+    ok &= testHash_N(hash, test, 64);
+    ok &= testHash_N(hash, test, 100);
+
+    if (ok)
+        Serial.println("Passed");
+    else
+        Serial.println("Failed");
+}
+
+// Hashes a long run of data in one update() call, which is the path that
+// compresses straight from the caller's buffer.
+void testOneShot(BLAKE2sp *hash)
+{
+    uint8_t expected[HASH_SIZE];
+    uint8_t value[HASH_SIZE];
+
+    Serial.print("One update ... ");
+
+    hash->reset();
+    for (size_t posn = 0; posn < sizeof(buffer); posn += 64)
+        hash->update(buffer + posn, 64);
+    hash->finalize(expected, sizeof(expected));
+
+    hash->reset();
+    hash->update(buffer, sizeof(buffer));
+    hash->finalize(value, sizeof(value));
+
+    if (memcmp(value, expected, sizeof(value)) == 0)
+        Serial.println("Passed");
+    else
+        Serial.println("Failed");
+}
+
+void perfHash(Hash *hash, const char *name)
+{
+    unsigned long start;
+    unsigned long elapsed;
+    int count;
+
+    Serial.print(name);
+    Serial.print(" hashing ... ");
+
+    hash->reset();
+    start = micros();
+    for (count = 0; count < 1000; ++count) {
+        hash->update(buffer, sizeof(buffer));
+    }
+    elapsed = micros() - start;
+
+    Serial.print(elapsed / (sizeof(buffer) * 1000.0));
+    Serial.print("us per byte, ");
+    Serial.print((sizeof(buffer) * 1000.0 * 1000000.0) / elapsed);
+    Serial.println(" bytes per second");
+}
+
+void perfFinalize(Hash *hash, const char *name)
+{
+    unsigned long start;
+    unsigned long elapsed;
+    int count;
+
+    Serial.print(name);
+    Serial.print(" finalizing ... ");
+
+    hash->reset();
+    hash->update("abc", 3);
+    start = micros();
+    for (count = 0; count < 1000; ++count) {
+        hash->finalize(buffer, hash->hashSize());
+    }
+    elapsed = micros() - start;
+
+    Serial.print(elapsed / 1000.0);
+    Serial.print("us per op, ");
+    Serial.print((1000.0 * 1000000.0) / elapsed);
+    Serial.println(" ops per second");
+
+    // Put back the data that finalize() overwrote.
+    for (size_t posn = 0; posn < sizeof(buffer); ++posn)
+        buffer[posn] = (uint8_t)posn;
+}
+
+#if defined(CRYPTO_BLAKE2P_THREADS)
+
+// Big enough for the hash object to hand the leaves out to threads.
+byte bigBuffer[65536];
+
+void perfThreads(BLAKE2sp *hash)
+{
+    unsigned long start;
+    unsigned long elapsed;
+    uint8_t value[HASH_SIZE];
+    uint8_t expected[HASH_SIZE];
+    int count;
+
+    for (uint8_t threads = 1; threads <= BLAKE2sp::LEAVES; threads *= 2) {
+        Serial.print("BLAKE2sp threads=");
+        Serial.print(threads);
+        Serial.print(" ... ");
+
+        hash->setThreads(threads);
+        hash->reset();
+        start = micros();
+        for (count = 0; count < 32; ++count) {
+            hash->update(bigBuffer, sizeof(bigBuffer));
+        }
+        elapsed = micros() - start;
+        hash->finalize(value, sizeof(value));
+        if (threads == 1)
+            memcpy(expected, value, sizeof(value));
+        else if (memcmp(value, expected, sizeof(value)) != 0)
+            Serial.print("[mismatch] ");
+
+        Serial.print(elapsed / (sizeof(bigBuffer) * 32.0));
+        Serial.print("us per byte, ");
+        Serial.print((sizeof(bigBuffer) * 32.0 * 1000000.0) / elapsed);
+        Serial.println(" bytes per second");
+    }
+    hash->setThreads(1);
+}
+
+#endif
+
+void setup()
+{
+    Serial.begin(9600);
+
+    Serial.println();
+
+    for (size_t posn = 0; posn < sizeof(buffer); ++posn)
+        buffer[posn] = (uint8_t)posn;
+
+    Serial.print("State Size ...");
+    Serial.println(sizeof(BLAKE2sp));
+    Serial.println();
+
+    Serial.println("Test Vectors:");
+    for (uint8_t index = 0; index < sizeof(testVectors) / sizeof(testVectors[0]); ++index)
+        testHash(&blake2sp, testVectors[index]);
+    testOneShot(&blake2sp);
+
+    Serial.println();
+
+    Serial.println("Performance Tests:");
+    perfHash(&blake2s, "BLAKE2s");
+    perfHash(&blake2sp, "BLAKE2sp");
+    perfFinalize(&blake2s, "BLAKE2s");
+    perfFinalize(&blake2sp, "BLAKE2sp");
+#if defined(CRYPTO_BLAKE2P_THREADS)
+    perfThreads(&blake2sp);
+#endif
+}
+
+void loop()
+{
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2026 The cryptnox-sdk-arduino contributors.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+This example runs tests on the HMACKey class to verify that it matches
+the hash classes' own HMAC support, and measures how much faster it is
+when many messages are authenticated under one key.
+*/
+
+#include <Crypto.h>
+#include <HMACKey.h>
+#include <SHA256.h>
+#include <SHA512.h>
+#include <BLAKE2s.h>
+#include <SHA3.h>
+#include <string.h>
+
+#define MAX_HASH_SIZE 64
+
+byte key[200];
+byte data[150];
+
+template <typename T>
+bool testKey_N(size_t keyLen, size_t dataLen)
+{
+    uint8_t expected[MAX_HASH_SIZE];
+    uint8_t actual[MAX_HASH_SIZE];
+    HMACKey<T> hmacKey(key, keyLen);
+    T hash;
+
+    hmac<T>(expected, T::HASH_SIZE, key, keyLen, data, dataLen);
+
+    hmacKey.compute(actual, T::HASH_SIZE, data, dataLen);
+    if (memcmp(actual, expected, T::HASH_SIZE) != 0)
+        return false;
+
+    // Same again incrementally, twice to check the key is reusable.
+    for (uint8_t round = 0; round < 2; ++round) {
+        memset(actual, 0xAA, sizeof(actual));
+        hmacKey.begin(hash);
+        hash.update(data, dataLen / 2);
+        hash.update(data + dataLen / 2, dataLen - dataLen / 2);
+        hmacKey.finalize(hash, actual, T::HASH_SIZE);
+        if (memcmp(actual, expected, T::HASH_SIZE) != 0)
+            return false;
+    }
+
+    return true;
+}
+
+template <typename T>
+void testKey(const char *name)
+{
+    static size_t const keyLens[] = {0, 1, 32, 64, 65, 128, 129, 200};
+    bool ok = true;
+
+    Serial.print("HMACKey<");
+    Serial.print(name);
+    Serial.print("> ... ");
+
+    for (uint8_t posn = 0; posn < sizeof(keyLens) / sizeof(keyLens[0]); ++posn) {
+        ok &= testKey_N<T>(keyLens[posn], 0);
+        ok &= testKey_N<T>(keyLens[posn], 3);
+        ok &= testKey_N<T>(keyLens[posn], sizeof(data));
+    }
+
+    if (ok)
+        Serial.println("Passed");
+    else
+        Serial.println("Failed");
+}
+
+template <typename T>
+void perfKey(const char *name)
+{
+    unsigned long start;
+    unsigned long elapsed;
+    uint8_t mac[MAX_HASH_SIZE];
+    T hash;
+    int count;
+
+    // Short messages under one key, as in a PBKDF2 or HKDF loop.
+    Serial.print(name);
+    Serial.print(" resetHMAC/finalizeHMAC ... ");
+
+    start = micros();
+    for (count = 0; count < 500; ++count) {
+        hash.resetHMAC(key, 32);
+        hash.update(data, 32);
+        hash.finalizeHMAC(key, 32, mac, T::HASH_SIZE);
+    }
+    elapsed = micros() - start;
+
+    Serial.print(elapsed / 500.0);
+    Serial.print("us per op, ");
+    Serial.print((500.0 * 1000000.0) / elapsed);
+    Serial.println(" ops per second");
+
+    Serial.print(name);
+    Serial.print(" HMACKey ... ");
+
+    HMACKey<T> hmacKey(key, 32);
+    start = micros();
+    for (count = 0; count < 500; ++count) {
+        hmacKey.compute(mac, T::HASH_SIZE, data, 32);
+    }
+    elapsed = micros() - start;
+
+    Serial.print(elapsed / 500.0);
+    Serial.print("us per op, ");
+    Serial.print((500.0 * 1000000.0) / elapsed);
+    Serial.println(" ops per second");
+}
+
+void setup()
+{
+    Serial.begin(9600);
+
+    Serial.println();
+
+    for (size_t posn = 0; posn < sizeof(key); ++posn)
+        key[posn] = (uint8_t)(posn * 3 + 1);
+    for (size_t posn = 0; posn < sizeof(data); ++posn)
+        data[posn] = (uint8_t)(posn * 7 + 5);
+
+    Serial.println("Test Vectors:");
+    testKey<SHA256>("SHA256");
+    testKey<SHA512>("SHA512");
+    testKey<BLAKE2s>("BLAKE2s");
+    testKey<SHA3_256>("SHA3_256");
+
+    Serial.println();
+
+    Serial.println("Performance Tests:");
+    perfKey<SHA256>("SHA256");
+    perfKey<SHA512>("SHA512");
+}
+
+void loop()
+{
+}
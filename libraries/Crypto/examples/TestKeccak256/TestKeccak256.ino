@@ -0,0 +1,480 @@
+/*
+ * Copyright (C) 2026 The cryptnox-sdk-arduino contributors.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+This example runs tests on the Keccak256 implementation to verify
+correct behaviour, and measures batched Ethereum address derivation.
+*/
+
+#include <Crypto.h>
+#include <Keccak256.h>
+#include <string.h>
+
+#define DATA_SIZE 136
+#define HASH_SIZE 32
+#define BLOCK_SIZE 136
+#define MAX_KEYS 8
+#define LONG_SIZE 500
+
+struct TestHashVector
+{
+    const char *name;
+    uint8_t data[DATA_SIZE];
+    uint8_t dataSize;
+    uint8_t hash[HASH_SIZE];
+};
+
+// Test vectors generated with an independent model of Keccak-256.
+// #3 and #4 are the data pattern used by testLong() below.
+static TestHashVector const testVectorKeccak256_1 = {
+    "Keccak-256 #1",
+    {0},
+    0,
+    {0xC5, 0xD2, 0x46, 0x01, 0x86, 0xF7, 0x23, 0x3C,
+     0x92, 0x7E, 0x7D, 0xB2, 0xDC, 0xC7, 0x03, 0xC0,
+     0xE5, 0x00, 0xB6, 0x53, 0xCA, 0x82, 0x27, 0x3B,
+     0x7B, 0xFA, 0xD8, 0x04, 0x5D, 0x85, 0xA4, 0x70}
+};
+static TestHashVector const testVectorKeccak256_2 = {
+    "Keccak-256 #2",
+    {0x61, 0x62, 0x63},
+    3,
+    {0x4E, 0x03, 0x65, 0x7A, 0xEA, 0x45, 0xA9, 0x4F,
+     0xC7, 0xD4, 0x7B, 0xA8, 0x26, 0xC8, 0xD6, 0x67,
+     0xC0, 0xD1, 0xE6, 0xE3, 0x3A, 0x64, 0xA0, 0x36,
+     0xEC, 0x44, 0xF5, 0x8F, 0xA1, 0x2D, 0x6C, 0x45}
+};
+static TestHashVector const testVectorKeccak256_3 = {
+    "Keccak-256 #3",
+    {0x05, 0x0C, 0x13, 0x1A, 0x21, 0x28, 0x2F, 0x36,
+     0x3D, 0x44, 0x4B, 0x52, 0x59, 0x60, 0x67, 0x6E,
+     0x75, 0x7C, 0x83, 0x8A, 0x91, 0x98, 0x9F, 0xA6,
+     0xAD, 0xB4, 0xBB, 0xC2, 0xC9, 0xD0, 0xD7, 0xDE,
+     0xE5, 0xEC, 0xF3, 0xFA, 0x01, 0x08, 0x0F, 0x16,
+     0x1D, 0x24, 0x2B, 0x32, 0x39, 0x40, 0x47, 0x4E,
+     0x55, 0x5C, 0x63, 0x6A, 0x71, 0x78, 0x7F, 0x86,
+     0x8D, 0x94, 0x9B, 0xA2, 0xA9, 0xB0, 0xB7, 0xBE,
+     0xC5, 0xCC, 0xD3, 0xDA, 0xE1, 0xE8, 0xEF, 0xF6,
+     0xFD, 0x04, 0x0B, 0x12, 0x19, 0x20, 0x27, 0x2E,
+     0x35, 0x3C, 0x43, 0x4A, 0x51, 0x58, 0x5F, 0x66,
+     0x6D, 0x74, 0x7B, 0x82, 0x89, 0x90, 0x97, 0x9E,
+     0xA5, 0xAC, 0xB3, 0xBA, 0xC1, 0xC8, 0xCF, 0xD6,
+     0xDD, 0xE4, 0xEB, 0xF2, 0xF9, 0x00, 0x07, 0x0E,
+     0x15, 0x1C, 0x23, 0x2A, 0x31, 0x38, 0x3F, 0x46,
+     0x4D, 0x54, 0x5B, 0x62, 0x69, 0x70, 0x77, 0x7E,
+     0x85, 0x8C, 0x93, 0x9A, 0xA1, 0xA8, 0xAF},
+    135,
+    {0x4E, 0xEB, 0x64, 0x34, 0x7B, 0x56, 0xEB, 0xCE,
+     0x92, 0xC0, 0x2A, 0x23, 0x14, 0x03, 0x73, 0x23,
+     0xED, 0x94, 0xD5, 0xD0, 0x8B, 0x4C, 0x7C, 0xD4,
+     0xCF, 0x29, 0xA1, 0xFF, 0x86, 0xE4, 0x8E, 0x7C}
+};
+static TestHashVector const testVectorKeccak256_4 = {
+    "Keccak-256 #4",
+    {0x05, 0x0C, 0x13, 0x1A, 0x21, 0x28, 0x2F, 0x36,
+     0x3D, 0x44, 0x4B, 0x52, 0x59, 0x60, 0x67, 0x6E,
+     0x75, 0x7C, 0x83, 0x8A, 0x91, 0x98, 0x9F, 0xA6,
+     0xAD, 0xB4, 0xBB, 0xC2, 0xC9, 0xD0, 0xD7, 0xDE,
+     0xE5, 0xEC, 0xF3, 0xFA, 0x01, 0x08, 0x0F, 0x16,
+     0x1D, 0x24, 0x2B, 0x32, 0x39, 0x40, 0x47, 0x4E,
+     0x55, 0x5C, 0x63, 0x6A, 0x71, 0x78, 0x7F, 0x86,
+     0x8D, 0x94, 0x9B, 0xA2, 0xA9, 0xB0, 0xB7, 0xBE,
+     0xC5, 0xCC, 0xD3, 0xDA, 0xE1, 0xE8, 0xEF, 0xF6,
+     0xFD, 0x04, 0x0B, 0x12, 0x19, 0x20, 0x27, 0x2E,
+     0x35, 0x3C, 0x43, 0x4A, 0x51, 0x58, 0x5F, 0x66,
+     0x6D, 0x74, 0x7B, 0x82, 0x89, 0x90, 0x97, 0x9E,
+     0xA5, 0xAC, 0xB3, 0xBA, 0xC1, 0xC8, 0xCF, 0xD6,
+     0xDD, 0xE4, 0xEB, 0xF2, 0xF9, 0x00, 0x07, 0x0E,
+     0x15, 0x1C, 0x23, 0x2A, 0x31, 0x38, 0x3F, 0x46,
+     0x4D, 0x54, 0x5B, 0x62, 0x69, 0x70, 0x77, 0x7E,
+     0x85, 0x8C, 0x93, 0x9A, 0xA1, 0xA8, 0xAF, 0xB6},
+    136,
+    {0xCA, 0x5C, 0x1D, 0x86, 0x25, 0x43, 0x86, 0xB9,
+     0x9B, 0x55, 0xC2, 0xDC, 0x7C, 0x5B, 0x1F, 0x93,
+     0x23, 0x82, 0x0D, 0x07, 0x49, 0xBB, 0xAE, 0x49,
+     0x2F, 0x9D, 0x7E, 0x7E, 0x7E, 0x47, 0xA5, 0xC9}
+};
+// Keccak-256 of the first 500 bytes of the data pattern.
+static uint8_t const longHash[HASH_SIZE] =
+    {0x31, 0x4C, 0x90, 0xF3, 0xE1, 0xAE, 0x61, 0x1E,
+     0x53, 0x59, 0x21, 0x66, 0x3B, 0x6C, 0x91, 0xA6,
+     0xDC, 0x7D, 0x3D, 0x67, 0xFD, 0x3C, 0xC5, 0x14,
+     0xAA, 0x03, 0x3C, 0xE7, 0x88, 0x7F, 0xFC, 0xC7};
+
+// secp256k1 public key for the private key 1, and its Ethereum address
+// 0x7E5F4552091A69125d5DfCb7b8C2659029395Bdf.
+static uint8_t const testPublicKey[Keccak256::PUBLIC_KEY_SIZE] = {
+    0x79, 0xBE, 0x66, 0x7E, 0xF9, 0xDC, 0xBB, 0xAC,
+    0x55, 0xA0, 0x62, 0x95, 0xCE, 0x87, 0x0B, 0x07,
+    0x02, 0x9B, 0xFC, 0xDB, 0x2D, 0xCE, 0x28, 0xD9,
+    0x59, 0xF2, 0x81, 0x5B, 0x16, 0xF8, 0x17, 0x98,
+    0x48, 0x3A, 0xDA, 0x77, 0x26, 0xA3, 0xC4, 0x65,
+    0x5D, 0xA4, 0xFB, 0xFC, 0x0E, 0x11, 0x08, 0xA8,
+    0xFD, 0x17, 0xB4, 0x48, 0xA6, 0x85, 0x54, 0x19,
+    0x9C, 0x47, 0xD0, 0x8F, 0xFB, 0x10, 0xD4, 0xB8
+};
+static uint8_t const testAddress[Keccak256::ADDRESS_SIZE] = {
+    0x7E, 0x5F, 0x45, 0x52, 0x09, 0x1A, 0x69, 0x12,
+    0x5D, 0x5D, 0xFC, 0xB7, 0xB8, 0xC2, 0x65, 0x90,
+    0x29, 0x39, 0x5B, 0xDF
+};
+
+Keccak256 keccak256;
+
+uint8_t buffer[MAX_KEYS * Keccak256::PUBLIC_KEY_SIZE + 1];
+uint8_t addresses[MAX_KEYS * Keccak256::ADDRESS_SIZE + 1];
+
+bool testHash_N(Hash *hash, const struct TestHashVector *test, size_t inc)
+{
+    size_t size = test->dataSize;
+    size_t posn, len;
+    uint8_t value[HASH_SIZE];
+
+    hash->reset();
+    for (posn = 0; posn < size; posn += inc) {
+        len = size - posn;
+        if (len > inc)
+            len = inc;
+        hash->update(test->data + posn, len);
+    }
+    hash->finalize(value, sizeof(value));
+    if (memcmp(value, test->hash, sizeof(value)) != 0)
+        return false;
+
+    return true;
+}
+
+void testHash(Hash *hash, const struct TestHashVector *test)
+{
+    bool ok;
+
+    Serial.print(test->name);
+    Serial.print(" ... ");
+
+    ok  = testHash_N(hash, test, test->dataSize);
+    ok &= testHash_N(hash, test, 1);
+    ok &= testHash_N(hash, test, 2);
+    ok &= testHash_N(hash, test, 5);
+    ok &= testHash_N(hash, test, 8);
+    ok &= testHash_N(hash, test, 13);
+    ok &= testHash_N(hash, test, 16);
+    ok &= testHash_N(hash, test, 24);
+    ok &= testHash_N(hash, test, 63);
+    ok &= testHash_N(hash, test, 64);
+
+    if (ok)
+        Serial.println("Passed");
+    else
+        Serial.println("Failed");
+}
+
+// Hashes LONG_SIZE bytes of the data pattern, starting "offset" bytes
+// into the buffer, in chunks of "inc" bytes.
+bool testLong_N(size_t offset, size_t inc)
+{
+    size_t posn, len;
+    uint8_t value[HASH_SIZE];
+
+    for (posn = 0; posn < LONG_SIZE; ++posn)
+        buffer[posn + offset] = (uint8_t)(posn * 7 + 5);
+
+    keccak256.reset();
+    for (posn = 0; posn < LONG_SIZE; posn += inc) {
+        len = LONG_SIZE - posn;
+        if (len > inc)
+            len = inc;
+        keccak256.update(buffer + offset + posn, len);
+    }
+    keccak256.finalize(value, sizeof(value));
+    return memcmp(value, longHash, sizeof(value)) == 0;
+}
+
+void testLong()
+{
+    // Chunk sizes that are aligned and misaligned with the block size,
+    // so that whole blocks are absorbed both on and off the fast path.
+    static size_t const incs[] = {LONG_SIZE, 1, 7, 135, 136, 137, 272, 300};
+    bool ok = true;
+
+    Serial.print("Keccak-256 Long ... ");
+
+    for (uint8_t posn = 0; posn < sizeof(incs) / sizeof(incs[0]); ++posn) {
+        ok &= testLong_N(0, incs[posn]);
+        ok &= testLong_N(1, incs[posn]);
+    }
+
+    if (ok)
+        Serial.println("Passed");
+    else
+        Serial.println("Failed");
+}
+
+void testAddresses()
+{
+    uint8_t hash[HASH_SIZE];
+    bool ok;
+
+    Serial.print("Addresses ... ");
+
+    memset(addresses, 0xAA, sizeof(addresses));
+    Keccak256::deriveAddresses(addresses, testPublicKey, 1);
+    ok = memcmp(addresses, testAddress, Keccak256::ADDRESS_SIZE) == 0;
+    ok &= addresses[Keccak256::ADDRESS_SIZE] == 0xAA;
+
+    // Every batch size, compared against hashing each key on its own.
+    for (size_t posn = 0; posn < sizeof(buffer); ++posn)
+        buffer[posn] = (uint8_t)(posn * 7 + 5);
+    for (size_t count = 0; count <= MAX_KEYS; ++count) {
+        memset(addresses, 0xAA, sizeof(addresses));
+        Keccak256::deriveAddresses(addresses, buffer, count);
+        for (size_t index = 0; index < count; ++index) {
+            keccak256.reset();
+            keccak256.update(buffer + index * Keccak256::PUBLIC_KEY_SIZE,
+                             Keccak256::PUBLIC_KEY_SIZE);
+            keccak256.finalize(hash, sizeof(hash));
+            ok &= memcmp(addresses + index * Keccak256::ADDRESS_SIZE,
+                         hash + HASH_SIZE - Keccak256::ADDRESS_SIZE,
+                         Keccak256::ADDRESS_SIZE) == 0;
+        }
+        ok &= addresses[count * Keccak256::ADDRESS_SIZE] == 0xAA;
+    }
+
+    if (ok)
+        Serial.println("Passed");
+    else
+        Serial.println("Failed");
+}
+
+void testHashMany()
+{
+    static TestHashVector const *const tests[] = {
+        &testVectorKeccak256_1, &testVectorKeccak256_2,
+        &testVectorKeccak256_3, &testVectorKeccak256_4,
+        &testVectorKeccak256_4, &testVectorKeccak256_4,
+        &testVectorKeccak256_4, &testVectorKeccak256_3
+    };
+    Hash::Message msgs[8];
+    uint8_t result[8 * HASH_SIZE];
+    bool ok = true;
+
+    Serial.print("Keccak-256 hashMany ... ");
+
+    for (uint8_t posn = 0; posn < 8; ++posn) {
+        msgs[posn].data = tests[posn]->data;
+        msgs[posn].len = tests[posn]->dataSize;
+    }
+    keccak256.hashMany(msgs, 8, result);
+    for (uint8_t posn = 0; posn < 8; ++posn) {
+        ok &= memcmp(result + posn * HASH_SIZE, tests[posn]->hash,
+                     HASH_SIZE) == 0;
+    }
+
+    if (ok)
+        Serial.println("Passed");
+    else
+        Serial.println("Failed");
+}
+
+// Very simple method for hashing a HMAC inner or outer key.
+void hashKey(Hash *hash, const uint8_t *key, size_t keyLen, uint8_t pad)
+{
+    size_t posn;
+    uint8_t buf;
+    uint8_t result[HASH_SIZE];
+    if (keyLen <= BLOCK_SIZE) {
+        hash->reset();
+        for (posn = 0; posn < BLOCK_SIZE; ++posn) {
+            if (posn < keyLen)
+                buf = key[posn] ^ pad;
+            else
+                buf = pad;
+            hash->update(&buf, 1);
+        }
+    } else {
+        hash->reset();
+        hash->update(key, keyLen);
+        hash->finalize(result, HASH_SIZE);
+        hash->reset();
+        for (posn = 0; posn < BLOCK_SIZE; ++posn) {
+            if (posn < HASH_SIZE)
+                buf = result[posn] ^ pad;
+            else
+                buf = pad;
+            hash->update(&buf, 1);
+        }
+    }
+}
+
+void testHMAC(Hash *hash, size_t keyLen)
+{
+    uint8_t result[HASH_SIZE];
+
+    Serial.print("HMAC-Keccak-256 keysize=");
+    Serial.print(keyLen);
+    Serial.print(" ... ");
+
+    // Construct the expected result with a simple HMAC implementation.
+    static const char message[] = "abc";
+    for (size_t posn = 0; posn < keyLen; ++posn)
+        buffer[posn] = (uint8_t)(posn * 3 + 1);
+    hashKey(hash, buffer, keyLen, 0x36);
+    hash->update(message, sizeof(message) - 1);
+    hash->finalize(result, HASH_SIZE);
+    hashKey(hash, buffer, keyLen, 0x5C);
+    hash->update(result, HASH_SIZE);
+    hash->finalize(result, HASH_SIZE);
+
+    // Now use the library to compute the HMAC.
+    hash->resetHMAC(buffer, keyLen);
+    hash->update(message, sizeof(message) - 1);
+    hash->finalizeHMAC(buffer, keyLen, buffer + keyLen, HASH_SIZE);
+
+    // Check the result.
+    if (!memcmp(result, buffer + keyLen, HASH_SIZE))
+        Serial.println("Passed");
+    else
+        Serial.println("Failed");
+}
+
+void perfHash(Hash *hash)
+{
+    unsigned long start;
+    unsigned long elapsed;
+    int count;
+
+    Serial.print("Hashing ... ");
+
+    for (size_t posn = 0; posn < BLOCK_SIZE * 2; ++posn)
+        buffer[posn] = (uint8_t)posn;
+
+    hash->reset();
+    start = micros();
+    for (count = 0; count < 250; ++count) {
+        hash->update(buffer, BLOCK_SIZE * 2);
+    }
+    elapsed = micros() - start;
+
+    Serial.print(elapsed / (BLOCK_SIZE * 2 * 250.0));
+    Serial.print("us per byte, ");
+    Serial.print((BLOCK_SIZE * 2 * 250.0 * 1000000.0) / elapsed);
+    Serial.println(" bytes per second");
+}
+
+void perfFinalize(Hash *hash)
+{
+    unsigned long start;
+    unsigned long elapsed;
+    int count;
+    uint8_t value[HASH_SIZE];
+
+    Serial.print("Finalizing ... ");
+
+    hash->reset();
+    hash->update("abc", 3);
+    start = micros();
+    for (count = 0; count < 1000; ++count) {
+        hash->finalize(value, hash->hashSize());
+    }
+    elapsed = micros() - start;
+
+    Serial.print(elapsed / 1000.0);
+    Serial.print("us per op, ");
+    Serial.print((1000.0 * 1000000.0) / elapsed);
+    Serial.println(" ops per second");
+}
+
+void perfAddresses()
+{
+    unsigned long start;
+    unsigned long elapsed;
+    uint8_t hash[HASH_SIZE];
+    int count;
+
+    for (size_t posn = 0; posn < sizeof(buffer); ++posn)
+        buffer[posn] = (uint8_t)(posn * 7 + 5);
+
+    Serial.print("Addresses one at a time ... ");
+
+    start = micros();
+    for (count = 0; count < 125; ++count) {
+        for (uint8_t index = 0; index < MAX_KEYS; ++index) {
+            keccak256.reset();
+            keccak256.update(buffer + index * Keccak256::PUBLIC_KEY_SIZE,
+                             Keccak256::PUBLIC_KEY_SIZE);
+            keccak256.finalize(hash, sizeof(hash));
+            memcpy(addresses + index * Keccak256::ADDRESS_SIZE,
+                   hash + HASH_SIZE - Keccak256::ADDRESS_SIZE,
+                   Keccak256::ADDRESS_SIZE);
+        }
+    }
+    elapsed = micros() - start;
+
+    Serial.print((1000.0 * 1000000.0) / elapsed);
+    Serial.println(" keys per second");
+
+    Serial.print("Addresses deriveAddresses ... ");
+
+    start = micros();
+    for (count = 0; count < 125; ++count) {
+        Keccak256::deriveAddresses(addresses, buffer, MAX_KEYS);
+    }
+    elapsed = micros() - start;
+
+    Serial.print((1000.0 * 1000000.0) / elapsed);
+    Serial.println(" keys per second");
+}
+
+void setup()
+{
+    Serial.begin(9600);
+
+    Serial.println();
+
+    Serial.print("State Size ...");
+    Serial.println(sizeof(Keccak256));
+    Serial.println();
+
+    Serial.println("Test Vectors:");
+    testHash(&keccak256, &testVectorKeccak256_1);
+    testHash(&keccak256, &testVectorKeccak256_2);
+    testHash(&keccak256, &testVectorKeccak256_3);
+    testHash(&keccak256, &testVectorKeccak256_4);
+    testLong();
+    testHashMany();
+    testAddresses();
+    testHMAC(&keccak256, (size_t)0);
+    testHMAC(&keccak256, 1);
+    testHMAC(&keccak256, HASH_SIZE);
+    testHMAC(&keccak256, BLOCK_SIZE);
+    testHMAC(&keccak256, BLOCK_SIZE + 1);
+
+    Serial.println();
+
+    Serial.println("Performance Tests:");
+    perfHash(&keccak256);
+    perfFinalize(&keccak256);
+    perfAddresses();
+}
+
+void loop()
+{
+}
@@ -0,0 +1,370 @@
+/*
+ * Copyright (C) 2026 The cryptnox-sdk-arduino contributors.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+This example runs tests on the RIPEMD160 implementation and the fused
+HASH160 function to verify correct behaviour, and measures how quickly
+Bitcoin public keys can be hashed in bulk.
+*/
+
+#include <Crypto.h>
+#include <RIPEMD160.h>
+#include <SHA256.h>
+#include <string.h>
+
+#define HASH_SIZE 20
+#define BLOCK_SIZE 64
+#define MAX_KEYS 16
+
+struct TestHashVector
+{
+    const char *name;
+    const char *key;
+    const char *data;
+    uint8_t hash[HASH_SIZE];
+};
+
+// Test vectors from the RIPEMD-160 home page and RFC 2286.
+static TestHashVector const testVectorRIPEMD160_1 = {
+    "RIPEMD-160 #1",
+    0,
+    "",
+    {0x9c, 0x11, 0x85, 0xa5, 0xc5, 0xe9, 0xfc, 0x54,
+     0x61, 0x28, 0x08, 0x97, 0x7e, 0xe8, 0xf5, 0x48,
+     0xb2, 0x25, 0x8d, 0x31}
+};
+static TestHashVector const testVectorRIPEMD160_2 = {
+    "RIPEMD-160 #2",
+    0,
+    "abc",
+    {0x8e, 0xb2, 0x08, 0xf7, 0xe0, 0x5d, 0x98, 0x7a,
+     0x9b, 0x04, 0x4a, 0x8e, 0x98, 0xc6, 0xb0, 0x87,
+     0xf1, 0x5a, 0x0b, 0xfc}
+};
+static TestHashVector const testVectorRIPEMD160_3 = {
+    "RIPEMD-160 #3",
+    0,
+    "message digest",
+    {0x5d, 0x06, 0x89, 0xef, 0x49, 0xd2, 0xfa, 0xe5,
+     0x72, 0xb8, 0x81, 0xb1, 0x23, 0xa8, 0x5f, 0xfa,
+     0x21, 0x59, 0x5f, 0x36}
+};
+static TestHashVector const testVectorRIPEMD160_4 = {
+    "RIPEMD-160 #4",
+    0,
+    "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+    {0x12, 0xa0, 0x53, 0x38, 0x4a, 0x9c, 0x0c, 0x88,
+     0xe4, 0x05, 0xa0, 0x6c, 0x27, 0xdc, 0xf4, 0x9a,
+     0xda, 0x62, 0xeb, 0x2b}
+};
+static TestHashVector const testVectorRIPEMD160_5 = {
+    "RIPEMD-160 #5",
+    0,
+    "12345678901234567890123456789012345678901234567890123456789012345678901234567890",
+    {0x9b, 0x75, 0x2e, 0x45, 0x57, 0x3d, 0x4b, 0x39,
+     0xf4, 0xdb, 0xd3, 0x32, 0x3c, 0xab, 0x82, 0xbf,
+     0x63, 0x32, 0x6b, 0xfb}
+};
+static TestHashVector const testVectorHMAC_RIPEMD160_1 = {
+    "HMAC-RIPEMD-160 #1",
+    "",
+    "",
+    {0x44, 0xd8, 0x6b, 0x65, 0x8a, 0x3e, 0x7c, 0xbc,
+     0x1a, 0x20, 0x10, 0x84, 0x8b, 0x53, 0xe3, 0x5c,
+     0x91, 0x77, 0x20, 0xca}
+};
+static TestHashVector const testVectorHMAC_RIPEMD160_2 = {
+    "HMAC-RIPEMD-160 #2",
+    "Jefe",
+    "what do ya want for nothing?",
+    {0xdd, 0xa6, 0xc0, 0x21, 0x3a, 0x48, 0x5a, 0x9e,
+     0x24, 0xf4, 0x74, 0x20, 0x64, 0xa7, 0xf0, 0x33,
+     0xb4, 0x3c, 0x40, 0x69}
+};
+
+// Compressed and uncompressed public keys for the secp256k1 private key 1.
+static uint8_t const compressedKey[33] = {
+    0x02, 0x79, 0xbe, 0x66, 0x7e, 0xf9, 0xdc, 0xbb,
+    0xac, 0x55, 0xa0, 0x62, 0x95, 0xce, 0x87, 0x0b,
+    0x07, 0x02, 0x9b, 0xfc, 0xdb, 0x2d, 0xce, 0x28,
+    0xd9, 0x59, 0xf2, 0x81, 0x5b, 0x16, 0xf8, 0x17,
+    0x98
+};
+static uint8_t const compressedHash160[HASH_SIZE] = {
+    0x75, 0x1e, 0x76, 0xe8, 0x19, 0x91, 0x96, 0xd4,
+    0x54, 0x94, 0x1c, 0x45, 0xd1, 0xb3, 0xa3, 0x23,
+    0xf1, 0x43, 0x3b, 0xd6
+};
+static uint8_t const uncompressedKey[65] = {
+    0x04, 0x79, 0xbe, 0x66, 0x7e, 0xf9, 0xdc, 0xbb,
+    0xac, 0x55, 0xa0, 0x62, 0x95, 0xce, 0x87, 0x0b,
+    0x07, 0x02, 0x9b, 0xfc, 0xdb, 0x2d, 0xce, 0x28,
+    0xd9, 0x59, 0xf2, 0x81, 0x5b, 0x16, 0xf8, 0x17,
+    0x98, 0x48, 0x3a, 0xda, 0x77, 0x26, 0xa3, 0xc4,
+    0x65, 0x5d, 0xa4, 0xfb, 0xfc, 0x0e, 0x11, 0x08,
+    0xa8, 0xfd, 0x17, 0xb4, 0x48, 0xa6, 0x85, 0x54,
+    0x19, 0x9c, 0x47, 0xd0, 0x8f, 0xfb, 0x10, 0xd4,
+    0xb8
+};
+static uint8_t const uncompressedHash160[HASH_SIZE] = {
+    0x91, 0xb2, 0x4b, 0xf9, 0xf5, 0x28, 0x85, 0x32,
+    0x96, 0x0a, 0xc6, 0x87, 0xab, 0xb0, 0x35, 0x12,
+    0x7b, 0x1d, 0x28, 0xa5
+};
+
+RIPEMD160 ripemd160;
+
+byte buffer[MAX_KEYS * 65];
+
+bool testHash_N(Hash *hash, const struct TestHashVector *test, size_t inc)
+{
+    size_t size = strlen(test->data);
+    size_t posn, len;
+    uint8_t value[HASH_SIZE];
+
+    hash->reset();
+    for (posn = 0; posn < size; posn += inc) {
+        len = size - posn;
+        if (len > inc)
+            len = inc;
+        hash->update(test->data + posn, len);
+    }
+    hash->finalize(value, sizeof(value));
+    if (memcmp(value, test->hash, sizeof(value)) != 0)
+        return false;
+
+    return true;
+}
+
+void testHash(Hash *hash, const struct TestHashVector *test)
+{
+    bool ok;
+
+    Serial.print(test->name);
+    Serial.print(" ... ");
+
+    ok  = testHash_N(hash, test, strlen(test->data));
+    ok &= testHash_N(hash, test, 1);
+    ok &= testHash_N(hash, test, 2);
+    ok &= testHash_N(hash, test, 5);
+    ok &= testHash_N(hash, test, 8);
+    ok &= testHash_N(hash, test, 13);
+    ok &= testHash_N(hash, test, 16);
+    ok &= testHash_N(hash, test, 24);
+    ok &= testHash_N(hash, test, 63);
+    ok &= testHash_N(hash, test, 64);
+
+    if (ok)
+        Serial.println("Passed");
+    else
+        Serial.println("Failed");
+}
+
+void testHMAC(Hash *hash, const struct TestHashVector *test)
+{
+    uint8_t result[HASH_SIZE];
+
+    Serial.print(test->name);
+    Serial.print(" ... ");
+
+    hash->resetHMAC(test->key, strlen(test->key));
+    hash->update(test->data, strlen(test->data));
+    hash->finalizeHMAC(test->key, strlen(test->key), result, sizeof(result));
+
+    // If the first test passed, then try the all-in-one function too.
+    if (!memcmp(result, test->hash, HASH_SIZE)) {
+        memset(result, 0xAA, sizeof(result));
+        hmac<RIPEMD160>(result, HASH_SIZE, test->key, strlen(test->key),
+                        test->data, strlen(test->data));
+    }
+
+    if (!memcmp(result, test->hash, HASH_SIZE))
+        Serial.println("Passed");
+    else
+        Serial.println("Failed");
+}
+
+// HASH160 the slow way, with separate SHA-256 and RIPEMD-160 passes.
+void hash160Slow(uint8_t *hash, const uint8_t *data, size_t len)
+{
+    SHA256 sha256;
+    uint8_t temp[32];
+    sha256.update(data, len);
+    sha256.finalize(temp, sizeof(temp));
+    ripemd160.reset();
+    ripemd160.update(temp, sizeof(temp));
+    ripemd160.finalize(hash, HASH_SIZE);
+}
+
+void testHash160()
+{
+    uint8_t expected[HASH_SIZE];
+    uint8_t actual[HASH_SIZE + 1];
+    bool ok;
+
+    Serial.print("HASH160 ... ");
+
+    memset(actual, 0xAA, sizeof(actual));
+    RIPEMD160::hash160(actual, compressedKey, sizeof(compressedKey));
+    ok = memcmp(actual, compressedHash160, HASH_SIZE) == 0;
+    RIPEMD160::hash160(actual, uncompressedKey, sizeof(uncompressedKey));
+    ok &= memcmp(actual, uncompressedHash160, HASH_SIZE) == 0;
+    ok &= actual[HASH_SIZE] == 0xAA;
+
+    // Every length up to two padding blocks against the slow way.
+    for (size_t posn = 0; posn < 130; ++posn)
+        buffer[posn] = (uint8_t)(posn * 7 + 5);
+    for (size_t len = 0; len <= 130; ++len) {
+        hash160Slow(expected, buffer, len);
+        RIPEMD160::hash160(actual, buffer, len);
+        ok &= memcmp(actual, expected, HASH_SIZE) == 0;
+    }
+
+    if (ok)
+        Serial.println("Passed");
+    else
+        Serial.println("Failed");
+}
+
+void perfHash(Hash *hash)
+{
+    unsigned long start;
+    unsigned long elapsed;
+    int count;
+
+    Serial.print("Hashing ... ");
+
+    for (size_t posn = 0; posn < 128; ++posn)
+        buffer[posn] = (uint8_t)posn;
+
+    hash->reset();
+    start = micros();
+    for (count = 0; count < 500; ++count) {
+        hash->update(buffer, 128);
+    }
+    elapsed = micros() - start;
+
+    Serial.print(elapsed / (128 * 500.0));
+    Serial.print("us per byte, ");
+    Serial.print((128 * 500.0 * 1000000.0) / elapsed);
+    Serial.println(" bytes per second");
+}
+
+void perfFinalize(Hash *hash)
+{
+    unsigned long start;
+    unsigned long elapsed;
+    int count;
+    uint8_t value[HASH_SIZE];
+
+    Serial.print("Finalizing ... ");
+
+    hash->reset();
+    hash->update("abc", 3);
+    start = micros();
+    for (count = 0; count < 1000; ++count) {
+        hash->finalize(value, hash->hashSize());
+    }
+    elapsed = micros() - start;
+
+    Serial.print(elapsed / 1000.0);
+    Serial.print("us per op, ");
+    Serial.print((1000.0 * 1000000.0) / elapsed);
+    Serial.println(" ops per second");
+}
+
+// Hashes a batch of MAX_KEYS public keys of "keyLen" bytes each, first
+// with separate SHA256 and RIPEMD160 objects and then with hash160().
+void perfHash160(size_t keyLen)
+{
+    unsigned long start;
+    unsigned long elapsed;
+    uint8_t hashes[MAX_KEYS][HASH_SIZE];
+    int count;
+
+    for (size_t posn = 0; posn < sizeof(buffer); ++posn)
+        buffer[posn] = (uint8_t)(posn * 7 + 5);
+
+    Serial.print("HASH160 ");
+    Serial.print(keyLen);
+    Serial.print("-byte keys, separate ... ");
+
+    start = micros();
+    for (count = 0; count < 64; ++count) {
+        for (uint8_t index = 0; index < MAX_KEYS; ++index)
+            hash160Slow(hashes[index], buffer + index * keyLen, keyLen);
+    }
+    elapsed = micros() - start;
+
+    Serial.print((64.0 * MAX_KEYS * 1000000.0) / elapsed);
+    Serial.print(" keys per second, hash160 ... ");
+
+    start = micros();
+    for (count = 0; count < 64; ++count) {
+        for (uint8_t index = 0; index < MAX_KEYS; ++index)
+            RIPEMD160::hash160(hashes[index], buffer + index * keyLen, keyLen);
+    }
+    elapsed = micros() - start;
+
+    Serial.print((64.0 * MAX_KEYS * 1000000.0) / elapsed);
+    Serial.println(" keys per second");
+}
+
+void setup()
+{
+    Serial.begin(9600);
+
+    Serial.println();
+
+    Serial.print("State Size ...");
+    Serial.println(sizeof(RIPEMD160));
+    Serial.println();
+
+    Serial.println("Test Vectors:");
+    testHash(&ripemd160, &testVectorRIPEMD160_1);
+    testHash(&ripemd160, &testVectorRIPEMD160_2);
+    testHash(&ripemd160, &testVectorRIPEMD160_3);
+    testHash(&ripemd160, &testVectorRIPEMD160_4);
+    testHash(&ripemd160, &testVectorRIPEMD160_5);
+    testHMAC(&ripemd160, &testVectorHMAC_RIPEMD160_1);
+    testHMAC(&ripemd160, &testVectorHMAC_RIPEMD160_2);
+    testHash160();
+
+    Serial.println();
+
+    Serial.println("Performance Tests:");
+    perfHash(&ripemd160);
+    perfFinalize(&ripemd160);
+    perfHash160(33);
+    perfHash160(65);
+    if (SHA256::isAccelerated()) {
+        Serial.println("Without SHA-256 instructions:");
+        SHA256::setAccelerated(false);
+        perfHash160(33);
+        perfHash160(65);
+        SHA256::setAccelerated(true);
+    }
+}
+
+void loop()
+{
+}
@@ -211,6 +211,45 @@ void testHMAC(Hash *hash, const struct TestHashVector *test)
         Serial.println("Failed");
 }
 
+void testFork(const struct TestHashVector *test)
+{
+    size_t size = strlen(test->data);
+    size_t split;
+    SHA256::State saved;
+    SHA256 fork;
+    uint8_t value[HASH_SIZE];
+    bool ok = true;
+
+    Serial.print(test->name);
+    Serial.print(" Fork ... ");
+
+    // Hash every prefix once and finish it both from a copy of the
+    // object and from a saved state restored twice.
+    for (split = 0; split <= size; ++split) {
+        sha256.reset();
+        sha256.update(test->data, split);
+        sha256.saveState(saved);
+
+        fork.copyStateFrom(sha256);
+        fork.update(test->data + split, size - split);
+        fork.finalize(value, sizeof(value));
+        ok &= (memcmp(value, test->hash, sizeof(value)) == 0);
+
+        for (uint8_t round = 0; round < 2; ++round) {
+            sha256.restoreState(saved);
+            sha256.update(test->data + split, size - split);
+            sha256.finalize(value, sizeof(value));
+            ok &= (memcmp(value, test->hash, sizeof(value)) == 0);
+        }
+    }
+    clean(saved);
+
+    if (ok)
+        Serial.println("Passed");
+    else
+        Serial.println("Failed");
+}
+
 void perfHash(Hash *hash)
 {
     unsigned long start;
@@ -232,7 +271,13 @@ void perfHash(Hash *hash)
     Serial.print(elapsed / (sizeof(buffer) * 500.0));
     Serial.print("us per byte, ");
     Serial.print((sizeof(buffer) * 500.0 * 1000000.0) / elapsed);
+#if defined(F_CPU)
+    Serial.print(" bytes per second, ");
+    Serial.print((elapsed * (F_CPU / 1000000.0)) / (sizeof(buffer) * 500.0));
+    Serial.println(" cycles per byte");
+#else
     Serial.println(" bytes per second");
+#endif
 }
 
 void perfFinalize(Hash *hash)
@@ -308,6 +353,7 @@ void setup()
     Serial.println("Test Vectors:");
     testHash(&sha256, &testVectorSHA256_1);
     testHash(&sha256, &testVectorSHA256_2);
+    testFork(&testVectorSHA256_2);
     testHMAC(&sha256, &testVectorHMAC_SHA256_1);
     testHMAC(&sha256, &testVectorHMAC_SHA256_2);
     testHMAC(&sha256, (size_t)0);
@@ -323,6 +369,23 @@ void setup()
     perfHash(&sha256);
     perfFinalize(&sha256);
     perfHMAC(&sha256);
+
+    // Compare against the portable code if the CPU's SHA-256
+    // instructions were used above.
+    if (SHA256::isAccelerated()) {
+        SHA256::setAccelerated(false);
+
+        Serial.println();
+        Serial.println("Portable Implementation:");
+        testHash(&sha256, &testVectorSHA256_1);
+        testHash(&sha256, &testVectorSHA256_2);
+        testHMAC(&sha256, &testVectorHMAC_SHA256_2);
+        perfHash(&sha256);
+        perfFinalize(&sha256);
+        perfHMAC(&sha256);
+
+        SHA256::setAccelerated(true);
+    }
 }
 
 void loop()
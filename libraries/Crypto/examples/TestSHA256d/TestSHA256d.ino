@@ -0,0 +1,279 @@
+/*
+ * Copyright (C) 2026 The cryptnox-sdk-arduino contributors.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+This example runs tests on SHA256::sha256d() and SHA256::sha256dMany()
+to verify that they match SHA-256 applied twice, and measures them
+against two passes of the SHA256 class for Bitcoin-style bulk hashing.
+*/
+
+#include <Crypto.h>
+#include <SHA256.h>
+#include <string.h>
+
+#define HASH_SIZE 32
+#define MAX_MSGS 17
+#define MAX_LEN 300
+
+struct TestHashVector
+{
+    const char *name;
+    const char *data;
+    uint8_t hash[HASH_SIZE];
+};
+
+static TestHashVector const testVectorSHA256d_1 = {
+    "SHA-256d #1",
+    "",
+    {0x5d, 0xf6, 0xe0, 0xe2, 0x76, 0x13, 0x59, 0xd3,
+     0x0a, 0x82, 0x75, 0x05, 0x8e, 0x29, 0x9f, 0xcc,
+     0x03, 0x81, 0x53, 0x45, 0x45, 0xf5, 0x5c, 0xf4,
+     0x3e, 0x41, 0x98, 0x3f, 0x5d, 0x4c, 0x94, 0x56}
+};
+static TestHashVector const testVectorSHA256d_2 = {
+    "SHA-256d #2",
+    "abc",
+    {0x4f, 0x8b, 0x42, 0xc2, 0x2d, 0xd3, 0x72, 0x9b,
+     0x51, 0x9b, 0xa6, 0xf6, 0x8d, 0x2d, 0xa7, 0xcc,
+     0x5b, 0x2d, 0x60, 0x6d, 0x05, 0xda, 0xed, 0x5a,
+     0xd5, 0x12, 0x8c, 0xc0, 0x3e, 0x6c, 0x63, 0x58}
+};
+
+// Header of the Bitcoin genesis block, whose identifier is the byte
+// reversal of the hash: 000000000019d6689c085ae165831e93...
+static uint8_t const genesisHeader[80] = {
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x3b, 0xa3, 0xed, 0xfd,
+    0x7a, 0x7b, 0x12, 0xb2, 0x7a, 0xc7, 0x2c, 0x3e,
+    0x67, 0x76, 0x8f, 0x61, 0x7f, 0xc8, 0x1b, 0xc3,
+    0x88, 0x8a, 0x51, 0x32, 0x3a, 0x9f, 0xb8, 0xaa,
+    0x4b, 0x1e, 0x5e, 0x4a, 0x29, 0xab, 0x5f, 0x49,
+    0xff, 0xff, 0x00, 0x1d, 0x1d, 0xac, 0x2b, 0x7c
+};
+static uint8_t const genesisHash[HASH_SIZE] = {
+    0x6f, 0xe2, 0x8c, 0x0a, 0xb6, 0xf1, 0xb3, 0x72,
+    0xc1, 0xa6, 0xa2, 0x46, 0xae, 0x63, 0xf7, 0x4f,
+    0x93, 0x1e, 0x83, 0x65, 0xe1, 0x5a, 0x08, 0x9c,
+    0x68, 0xd6, 0x19, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+SHA256 sha256;
+
+byte data[MAX_MSGS + MAX_LEN];
+byte expected[MAX_MSGS * HASH_SIZE];
+byte actual[MAX_MSGS * HASH_SIZE + 1];
+Hash::Message msgs[MAX_MSGS];
+
+// SHA-256d the slow way, with two full passes of the SHA256 class.
+void sha256dSlow(uint8_t *hash, const void *data, size_t len)
+{
+    sha256.reset();
+    sha256.update(data, len);
+    sha256.finalize(hash, HASH_SIZE);
+    sha256.reset();
+    sha256.update(hash, HASH_SIZE);
+    sha256.finalize(hash, HASH_SIZE);
+}
+
+void testHash(const struct TestHashVector *test)
+{
+    uint8_t value[HASH_SIZE];
+
+    Serial.print(test->name);
+    Serial.print(" ... ");
+
+    SHA256::sha256d(value, test->data, strlen(test->data));
+    if (!memcmp(value, test->hash, HASH_SIZE))
+        Serial.println("Passed");
+    else
+        Serial.println("Failed");
+}
+
+void testGenesis()
+{
+    Serial.print("Genesis block ... ");
+
+    SHA256::sha256d(actual, genesisHeader, sizeof(genesisHeader));
+    if (!memcmp(actual, genesisHash, HASH_SIZE))
+        Serial.println("Passed");
+    else
+        Serial.println("Failed");
+}
+
+bool testMany_N(size_t count)
+{
+    for (size_t posn = 0; posn < count; ++posn)
+        sha256dSlow(expected + posn * HASH_SIZE, msgs[posn].data, msgs[posn].len);
+    memset(actual, 0xAA, sizeof(actual));
+    SHA256::sha256dMany(msgs, count, actual);
+    if (memcmp(actual, expected, count * HASH_SIZE) != 0)
+        return false;
+    return actual[count * HASH_SIZE] == 0xAA;
+}
+
+void testLengths()
+{
+    uint8_t value[HASH_SIZE];
+    bool ok = true;
+
+    Serial.print("SHA-256d lengths ... ");
+
+    // Every length up to a few blocks, against two passes of SHA256.
+    for (size_t len = 0; len <= 200; ++len) {
+        sha256dSlow(expected, data, len);
+        SHA256::sha256d(value, data, len);
+        ok &= memcmp(value, expected, HASH_SIZE) == 0;
+    }
+
+    if (ok)
+        Serial.println("Passed");
+    else
+        Serial.println("Failed");
+}
+
+void testMany()
+{
+    // Lengths either side of the padding boundaries for the first pass.
+    static size_t const lens[] = {0, 32, 55, 56, 64, 80, 119, 120, MAX_LEN};
+    bool ok = true;
+
+    Serial.print("SHA-256d sha256dMany ... ");
+
+    // All messages the same length, for every batch size.
+    for (uint8_t index = 0; index < sizeof(lens) / sizeof(lens[0]); ++index) {
+        for (size_t posn = 0; posn < MAX_MSGS; ++posn) {
+            msgs[posn].data = data + posn;
+            msgs[posn].len = lens[index];
+        }
+        for (size_t count = 0; count <= MAX_MSGS; ++count)
+            ok &= testMany_N(count);
+    }
+
+    // Messages of different lengths.
+    for (size_t posn = 0; posn < MAX_MSGS; ++posn) {
+        msgs[posn].data = data + posn;
+        msgs[posn].len = (posn * 37) % MAX_LEN;
+    }
+    for (size_t count = 0; count <= MAX_MSGS; ++count)
+        ok &= testMany_N(count);
+
+    if (ok)
+        Serial.println("Passed");
+    else
+        Serial.println("Failed");
+}
+
+// Hashes MAX_MSGS - 1 messages of "len" bytes each, or of random-looking
+// lengths around "len" if "vary" is true, in three different ways.
+void perfBatch(const char *name, size_t len, bool vary)
+{
+    unsigned long start;
+    unsigned long elapsed;
+    size_t count = MAX_MSGS - 1;
+    int round;
+
+    for (size_t posn = 0; posn < count; ++posn) {
+        msgs[posn].data = data + posn;
+        msgs[posn].len = vary ? (len - 50 + (posn * 37) % 100) : len;
+    }
+
+    Serial.print(name);
+    Serial.print(" two passes ... ");
+
+    start = micros();
+    for (round = 0; round < 64; ++round) {
+        for (size_t posn = 0; posn < count; ++posn)
+            sha256dSlow(actual + posn * HASH_SIZE, msgs[posn].data, msgs[posn].len);
+    }
+    elapsed = micros() - start;
+
+    Serial.print((64.0 * count * 1000000.0) / elapsed);
+    Serial.print(" per second, sha256d ... ");
+
+    start = micros();
+    for (round = 0; round < 64; ++round) {
+        for (size_t posn = 0; posn < count; ++posn)
+            SHA256::sha256d(actual + posn * HASH_SIZE, msgs[posn].data, msgs[posn].len);
+    }
+    elapsed = micros() - start;
+
+    Serial.print((64.0 * count * 1000000.0) / elapsed);
+    Serial.print(" per second, sha256dMany ... ");
+
+    start = micros();
+    for (round = 0; round < 64; ++round)
+        SHA256::sha256dMany(msgs, count, actual);
+    elapsed = micros() - start;
+
+    Serial.print((64.0 * count * 1000000.0) / elapsed);
+    Serial.println(" per second");
+}
+
+void perfAll()
+{
+    perfBatch("Merkle nodes (64 bytes)", 64, false);
+    perfBatch("Block headers (80 bytes)", 80, false);
+    perfBatch("Transaction IDs (~250 bytes)", 250, true);
+}
+
+void setup()
+{
+    Serial.begin(9600);
+
+    Serial.println();
+
+    for (size_t posn = 0; posn < sizeof(data); ++posn)
+        data[posn] = (uint8_t)(posn * 7 + 5);
+
+    Serial.println("Test Vectors:");
+    testHash(&testVectorSHA256d_1);
+    testHash(&testVectorSHA256d_2);
+    testGenesis();
+    testLengths();
+    testMany();
+    if (SHA256::isAccelerated()) {
+        Serial.println("Without SHA-256 instructions:");
+        SHA256::setAccelerated(false);
+        testGenesis();
+        testLengths();
+        testMany();
+        SHA256::setAccelerated(true);
+    }
+
+    Serial.println();
+
+    Serial.println("Performance Tests:");
+    perfAll();
+    if (SHA256::isAccelerated()) {
+        Serial.println("Without SHA-256 instructions:");
+        SHA256::setAccelerated(false);
+        perfAll();
+        SHA256::setAccelerated(true);
+    }
+}
+
+void loop()
+{
+}
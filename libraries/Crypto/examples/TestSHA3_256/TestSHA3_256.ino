@@ -168,6 +168,40 @@ void testHash(Hash *hash, const struct TestHashVector *test)
         Serial.println("Failed");
 }
 
+void testFork(const struct TestHashVector *test)
+{
+    SHA3_256::State saved;
+    SHA3_256 fork;
+    uint8_t value[HASH_SIZE];
+    bool ok = true;
+
+    Serial.print(test->name);
+    Serial.print(" Fork ... ");
+
+    for (size_t split = 0; split <= test->dataSize; ++split) {
+        sha3_256.reset();
+        sha3_256.update(test->data, split);
+        sha3_256.saveState(saved);
+
+        fork.copyStateFrom(sha3_256);
+        fork.update(test->data + split, test->dataSize - split);
+        fork.finalize(value, sizeof(value));
+        ok &= (memcmp(value, test->hash, sizeof(value)) == 0);
+
+        sha3_256.update("junk", 4);
+        sha3_256.restoreState(saved);
+        sha3_256.update(test->data + split, test->dataSize - split);
+        sha3_256.finalize(value, sizeof(value));
+        ok &= (memcmp(value, test->hash, sizeof(value)) == 0);
+    }
+    clean(saved);
+
+    if (ok)
+        Serial.println("Passed");
+    else
+        Serial.println("Failed");
+}
+
 void perfHash(Hash *hash)
 {
     unsigned long start;
@@ -299,6 +333,7 @@ void setup()
     testHash(&sha3_256, &testVectorSHA3_256_3);
     testHash(&sha3_256, &testVectorSHA3_256_4);
     testHash(&sha3_256, &testVectorSHA3_256_5);
+    testFork(&testVectorSHA3_256_5);
     testHMAC(&sha3_256, (size_t)0);
     testHMAC(&sha3_256, 1);
     testHMAC(&sha3_256, HASH_SIZE);
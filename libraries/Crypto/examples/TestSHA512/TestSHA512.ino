@@ -233,6 +233,88 @@ void perfFinalize(Hash *hash)
     Serial.println(" ops per second");
 }
 
+#define PARALLEL_COUNT 4
+
+byte parallelHashes[PARALLEL_COUNT * HASH_SIZE];
+
+void testParallel()
+{
+    static TestHashVector const *tests[PARALLEL_COUNT] = {
+        &testVectorSHA512_1, &testVectorSHA512_2,
+        &testVectorSHA512_3, &testVectorSHA512_2
+    };
+    const void *data[PARALLEL_COUNT];
+    size_t lens[PARALLEL_COUNT];
+    bool ok = true;
+
+    Serial.print("SHA-512 Parallel ... ");
+
+    // Empty messages are passed as NULL, as an empty std::vector gives.
+    for (uint8_t posn = 0; posn < PARALLEL_COUNT; ++posn) {
+        lens[posn] = strlen(tests[posn]->data);
+        data[posn] = lens[posn] ? tests[posn]->data : 0;
+    }
+    SHA512::hashParallel(parallelHashes, data, lens, PARALLEL_COUNT);
+    for (uint8_t posn = 0; posn < PARALLEL_COUNT; ++posn) {
+        if (memcmp(parallelHashes + posn * HASH_SIZE, tests[posn]->hash,
+                   HASH_SIZE) != 0)
+            ok = false;
+    }
+
+    if (ok)
+        Serial.println("Passed");
+    else
+        Serial.println("Failed");
+}
+
+void perfParallel()
+{
+    unsigned long start;
+    unsigned long elapsed;
+    const void *data[PARALLEL_COUNT];
+    size_t lens[PARALLEL_COUNT];
+    int count;
+
+    // A batch of 64-byte messages, like the R || A || M prefixes that
+    // Ed25519 batch verification hashes.
+    Serial.print("Parallel Hashing ... ");
+
+    for (size_t posn = 0; posn < sizeof(buffer); ++posn)
+        buffer[posn] = (uint8_t)posn;
+    for (uint8_t posn = 0; posn < PARALLEL_COUNT; ++posn) {
+        data[posn] = buffer + posn;
+        lens[posn] = 64;
+    }
+
+    start = micros();
+    for (count = 0; count < 250; ++count) {
+        SHA512::hashParallel(parallelHashes, data, lens, PARALLEL_COUNT);
+    }
+    elapsed = micros() - start;
+
+    Serial.print(elapsed / (250.0 * PARALLEL_COUNT));
+    Serial.print("us per message, ");
+    Serial.print((250.0 * PARALLEL_COUNT * 1000000.0) / elapsed);
+    Serial.println(" messages per second");
+
+    Serial.print("Sequential Hashing ... ");
+
+    start = micros();
+    for (count = 0; count < 250; ++count) {
+        for (uint8_t posn = 0; posn < PARALLEL_COUNT; ++posn) {
+            sha512.reset();
+            sha512.update(data[posn], lens[posn]);
+            sha512.finalize(parallelHashes + posn * HASH_SIZE, HASH_SIZE);
+        }
+    }
+    elapsed = micros() - start;
+
+    Serial.print(elapsed / (250.0 * PARALLEL_COUNT));
+    Serial.print("us per message, ");
+    Serial.print((250.0 * PARALLEL_COUNT * 1000000.0) / elapsed);
+    Serial.println(" messages per second");
+}
+
 void setup()
 {
     Serial.begin(9600);
@@ -253,12 +335,14 @@ void setup()
     testHMAC(&sha512, BLOCK_SIZE);
     testHMAC(&sha512, BLOCK_SIZE + 1);
     testHMAC(&sha512, BLOCK_SIZE + 2);
+    testParallel();
 
     Serial.println();
 
     Serial.println("Performance Tests:");
     perfHash(&sha512);
     perfFinalize(&sha512);
+    perfParallel();
 }
 
 void loop()
@@ -0,0 +1,276 @@
+/*
+ * Copyright (C) 2026 The cryptnox-sdk-arduino contributors.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+This example runs tests on the batch interfaces of SHAKE and KeccakCore,
+which absorb and squeeze several sponges in lockstep, to verify that they
+give the same results as one instance at a time.  It also measures the
+throughput of the batch interfaces against a single instance.
+*/
+
+#include <Crypto.h>
+#include <SHAKE.h>
+#include <SHA3.h>
+#include <string.h>
+
+#define MAX_BATCH 6
+#define DATA_SIZE 400
+#define OUTPUT_SIZE 400
+
+byte data[DATA_SIZE];
+byte expected[MAX_BATCH][OUTPUT_SIZE];
+byte actual[MAX_BATCH][OUTPUT_SIZE + 1];
+
+// Lengths either side of the 136 and 168 byte SHAKE block sizes.
+static size_t const testLens[] = {0, 1, 135, 136, 137, 168, 169, 400};
+
+template <typename T>
+bool testMany_N(size_t count, size_t len, bool skew)
+{
+    T expectedXOF[MAX_BATCH];
+    T actualXOF[MAX_BATCH];
+    SHAKE *xofs[MAX_BATCH];
+    const void *inputs[MAX_BATCH];
+    uint8_t *outputs[MAX_BATCH];
+    size_t half = len / 2;
+
+    for (size_t posn = 0; posn < count; ++posn) {
+        // Skewed instances are one byte ahead, so they are not in step.
+        size_t extra = (skew && (posn & 1) != 0) ? 1 : 0;
+        expectedXOF[posn].update(data + DATA_SIZE - 1, extra);
+        expectedXOF[posn].update(data + posn, len);
+        expectedXOF[posn].extend(expected[posn], OUTPUT_SIZE);
+
+        // Leave a finalized output behind, which updateMany() must discard.
+        actualXOF[posn].update(data, 3);
+        actualXOF[posn].extend(actual[posn], 5);
+        actualXOF[posn].reset();
+        actualXOF[posn].update(data + DATA_SIZE - 1, extra);
+        actualXOF[posn].extend(actual[posn], 5);
+        actualXOF[posn].update(data + DATA_SIZE - 1, extra);
+
+        xofs[posn] = &(actualXOF[posn]);
+        inputs[posn] = data + posn;
+        outputs[posn] = actual[posn];
+        memset(actual[posn], 0xAA, OUTPUT_SIZE + 1);
+    }
+
+    // Absorb in two pieces and squeeze in two pieces.
+    SHAKE::updateMany(xofs, inputs, half, count);
+    for (size_t posn = 0; posn < count; ++posn)
+        inputs[posn] = data + posn + half;
+    SHAKE::updateMany(xofs, inputs, len - half, count);
+    SHAKE::extendMany(xofs, outputs, 100, count);
+    for (size_t posn = 0; posn < count; ++posn)
+        outputs[posn] = actual[posn] + 100;
+    SHAKE::extendMany(xofs, outputs, OUTPUT_SIZE - 100, count);
+
+    for (size_t posn = 0; posn < count; ++posn) {
+        if (memcmp(actual[posn], expected[posn], OUTPUT_SIZE) != 0)
+            return false;
+        if (actual[posn][OUTPUT_SIZE] != 0xAA)
+            return false;
+    }
+    return true;
+}
+
+template <typename T>
+void testMany(const char *name)
+{
+    bool ok = true;
+
+    Serial.print(name);
+    Serial.print(" updateMany/extendMany ... ");
+
+    for (size_t count = 0; count <= MAX_BATCH; ++count) {
+        for (uint8_t posn = 0; posn < sizeof(testLens) / sizeof(testLens[0]); ++posn) {
+            size_t len = testLens[posn];
+            if (len > DATA_SIZE - count)
+                len = DATA_SIZE - count;
+            ok &= testMany_N<T>(count, len, false);
+            ok &= testMany_N<T>(count, len, true);
+        }
+    }
+
+    if (ok)
+        Serial.println("Passed");
+    else
+        Serial.println("Failed");
+}
+
+template <typename T>
+void testHashMany(const char *name)
+{
+    Hash::Message msgs[MAX_BATCH];
+    T hash;
+    bool ok = true;
+
+    Serial.print(name);
+    Serial.print(" hashMany ... ");
+
+    // Messages of equal length, which are hashed in lockstep.
+    for (uint8_t posn = 0; posn < sizeof(testLens) / sizeof(testLens[0]); ++posn) {
+        size_t len = testLens[posn];
+        if (len > DATA_SIZE - MAX_BATCH)
+            len = DATA_SIZE - MAX_BATCH;
+        for (uint8_t index = 0; index < MAX_BATCH; ++index) {
+            msgs[index].data = data + index;
+            msgs[index].len = len;
+            hash.reset();
+            hash.update(msgs[index].data, len);
+            hash.finalize(expected[index], T::HASH_SIZE);
+        }
+        for (uint8_t count = 0; count <= MAX_BATCH; ++count) {
+            memset(actual, 0xAA, sizeof(actual));
+            hash.hashMany(msgs, count, actual[0]);
+            for (uint8_t index = 0; index < count; ++index) {
+                if (memcmp(actual[0] + index * T::HASH_SIZE, expected[index],
+                           T::HASH_SIZE) != 0)
+                    ok = false;
+            }
+            if (actual[0][count * T::HASH_SIZE] != 0xAA)
+                ok = false;
+        }
+    }
+
+    if (ok)
+        Serial.println("Passed");
+    else
+        Serial.println("Failed");
+}
+
+template <typename T>
+void perfMany(const char *name)
+{
+    static uint8_t const batchSizes[] = {1, 2, 4};
+    unsigned long start;
+    unsigned long elapsed;
+    T xof[4];
+    SHAKE *xofs[4];
+    const void *inputs[4];
+    uint8_t *outputs[4];
+    int count;
+
+    for (uint8_t posn = 0; posn < 4; ++posn) {
+        xofs[posn] = &(xof[posn]);
+        inputs[posn] = data;
+        outputs[posn] = actual[posn];
+    }
+
+    for (uint8_t size = 0; size < sizeof(batchSizes); ++size) {
+        uint8_t lanes = batchSizes[size];
+
+        Serial.print(name);
+        Serial.print(" x");
+        Serial.print(lanes);
+        Serial.print(" updateMany ... ");
+
+        for (uint8_t posn = 0; posn < lanes; ++posn)
+            xof[posn].reset();
+        start = micros();
+        for (count = 0; count < 500; ++count)
+            SHAKE::updateMany(xofs, inputs, DATA_SIZE, lanes);
+        elapsed = micros() - start;
+
+        Serial.print((500.0 * DATA_SIZE * lanes * 1000000.0) / elapsed);
+        Serial.println(" bytes per second");
+
+        Serial.print(name);
+        Serial.print(" x");
+        Serial.print(lanes);
+        Serial.print(" extendMany ... ");
+
+        start = micros();
+        for (count = 0; count < 500; ++count)
+            SHAKE::extendMany(xofs, outputs, OUTPUT_SIZE, lanes);
+        elapsed = micros() - start;
+
+        Serial.print((500.0 * OUTPUT_SIZE * lanes * 1000000.0) / elapsed);
+        Serial.println(" bytes per second");
+    }
+}
+
+template <typename T>
+void perfHashMany(const char *name)
+{
+    Hash::Message msgs[4];
+    unsigned long start;
+    unsigned long elapsed;
+    T hash;
+    int count;
+
+    for (uint8_t posn = 0; posn < 4; ++posn) {
+        msgs[posn].data = data + posn * 32;
+        msgs[posn].len = 32;
+    }
+
+    Serial.print(name);
+    Serial.print(" loop ... ");
+
+    start = micros();
+    for (count = 0; count < 250; ++count) {
+        for (uint8_t posn = 0; posn < 4; ++posn) {
+            hash.reset();
+            hash.update(msgs[posn].data, msgs[posn].len);
+            hash.finalize(actual[posn], T::HASH_SIZE);
+        }
+    }
+    elapsed = micros() - start;
+
+    Serial.print((1000.0 * 1000000.0) / elapsed);
+    Serial.print(" msgs per second, hashMany x4 ... ");
+
+    start = micros();
+    for (count = 0; count < 250; ++count)
+        hash.hashMany(msgs, 4, actual[0]);
+    elapsed = micros() - start;
+
+    Serial.print((1000.0 * 1000000.0) / elapsed);
+    Serial.println(" msgs per second");
+}
+
+void setup()
+{
+    Serial.begin(9600);
+
+    Serial.println();
+
+    for (size_t posn = 0; posn < sizeof(data); ++posn)
+        data[posn] = (uint8_t)(posn * 7 + 5);
+
+    Serial.println("Test Vectors:");
+    testMany<SHAKE128>("SHAKE128");
+    testMany<SHAKE256>("SHAKE256");
+    testHashMany<SHA3_256>("SHA3_256");
+    testHashMany<SHA3_512>("SHA3_512");
+
+    Serial.println();
+
+    Serial.println("Performance Tests:");
+    perfMany<SHAKE128>("SHAKE128");
+    perfMany<SHAKE256>("SHAKE256");
+    perfHashMany<SHA3_256>("SHA3_256");
+}
+
+void loop()
+{
+}
@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2026 The cryptnox-sdk-arduino contributors.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "utility/BLAKE2Lanes.h"
+
+// Multi-lane BLAKE2 compression.  See utility/BLAKE2Lanes.h.
+
+#if defined(CRYPTO_BLAKE2_LANES_AVX2)
+
+#include <immintrin.h>
+
+// Permutation on the message input state, shared by BLAKE2s and BLAKE2b.
+static const uint8_t sigma[12][16] = {
+    { 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15},
+    {14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3},
+    {11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4},
+    { 7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8},
+    { 9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13},
+    { 2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9},
+    {12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11},
+    {13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10},
+    { 6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5},
+    {10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13 , 0},
+    { 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15},
+    {14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3},
+};
+
+// Quarter round on all lanes at once, with the rotations passed in.
+#define blake2xQuarterRound(a, b, c, d, i, add, ror1, ror2, ror3, ror4) \
+    do { \
+        (a) = add(add((a), (b)), m[sigma[round][2 * (i)]]); \
+        (d) = ror1(_mm256_xor_si256((d), (a))); \
+        (c) = add((c), (d)); \
+        (b) = ror2(_mm256_xor_si256((b), (c))); \
+        (a) = add(add((a), (b)), m[sigma[round][2 * (i) + 1]]); \
+        (d) = ror3(_mm256_xor_si256((d), (a))); \
+        (c) = add((c), (d)); \
+        (b) = ror4(_mm256_xor_si256((b), (c))); \
+    } while (0)
+
+#define blake2xRound(add, ror1, ror2, ror3, ror4) \
+    do { \
+        blake2xQuarterRound(v[0], v[4], v[8],  v[12], 0, add, ror1, ror2, ror3, ror4); \
+        blake2xQuarterRound(v[1], v[5], v[9],  v[13], 1, add, ror1, ror2, ror3, ror4); \
+        blake2xQuarterRound(v[2], v[6], v[10], v[14], 2, add, ror1, ror2, ror3, ror4); \
+        blake2xQuarterRound(v[3], v[7], v[11], v[15], 3, add, ror1, ror2, ror3, ror4); \
+        blake2xQuarterRound(v[0], v[5], v[10], v[15], 4, add, ror1, ror2, ror3, ror4); \
+        blake2xQuarterRound(v[1], v[6], v[11], v[12], 5, add, ror1, ror2, ror3, ror4); \
+        blake2xQuarterRound(v[2], v[7], v[8],  v[13], 6, add, ror1, ror2, ror3, ror4); \
+        blake2xQuarterRound(v[3], v[4], v[9],  v[14], 7, add, ror1, ror2, ror3, ror4); \
+    } while (0)
+
+#define blake2s8Add(a, b)   (_mm256_add_epi32((a), (b)))
+#define blake2s8Ror16(a)    (_mm256_shuffle_epi8((a), rot16))
+#define blake2s8Ror12(a)    \
+    (_mm256_or_si256(_mm256_srli_epi32((a), 12), _mm256_slli_epi32((a), 20)))
+#define blake2s8Ror8(a)     (_mm256_shuffle_epi8((a), rot8))
+#define blake2s8Ror7(a)     \
+    (_mm256_or_si256(_mm256_srli_epi32((a), 7), _mm256_slli_epi32((a), 25)))
+
+__attribute__((target("avx2")))
+void blake2sCompressLanes(uint32_t h[8][8], const uint8_t *data,
+                          size_t stripes, uint64_t t)
+{
+    const __m256i rot16 = _mm256_set_epi8
+        (13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2,
+         13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2);
+    const __m256i rot8 = _mm256_set_epi8
+        (12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1,
+         12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1);
+    __m256i hv[8];
+    __m256i m[16];
+    __m256i v[16];
+    uint8_t index, round;
+
+    for (index = 0; index < 8; ++index)
+        hv[index] = _mm256_loadu_si256((const __m256i *)h[index]);
+
+    while (stripes-- > 0) {
+        // Load the blocks with word i of every leaf in m[i], transposing
+        // eight words of each leaf at a time.
+        for (index = 0; index < 16; index += 8) {
+            __m256i r0 = _mm256_loadu_si256((const __m256i *)(data + 0 * 64 + index * 4));
+            __m256i r1 = _mm256_loadu_si256((const __m256i *)(data + 1 * 64 + index * 4));
+            __m256i r2 = _mm256_loadu_si256((const __m256i *)(data + 2 * 64 + index * 4));
+            __m256i r3 = _mm256_loadu_si256((const __m256i *)(data + 3 * 64 + index * 4));
+            __m256i r4 = _mm256_loadu_si256((const __m256i *)(data + 4 * 64 + index * 4));
+            __m256i r5 = _mm256_loadu_si256((const __m256i *)(data + 5 * 64 + index * 4));
+            __m256i r6 = _mm256_loadu_si256((const __m256i *)(data + 6 * 64 + index * 4));
+            __m256i r7 = _mm256_loadu_si256((const __m256i *)(data + 7 * 64 + index * 4));
+            __m256i t0 = _mm256_unpacklo_epi32(r0, r1);
+            __m256i t1 = _mm256_unpackhi_epi32(r0, r1);
+            __m256i t2 = _mm256_unpacklo_epi32(r2, r3);
+            __m256i t3 = _mm256_unpackhi_epi32(r2, r3);
+            __m256i t4 = _mm256_unpacklo_epi32(r4, r5);
+            __m256i t5 = _mm256_unpackhi_epi32(r4, r5);
+            __m256i t6 = _mm256_unpacklo_epi32(r6, r7);
+            __m256i t7 = _mm256_unpackhi_epi32(r6, r7);
+            r0 = _mm256_unpacklo_epi64(t0, t2);
+            r1 = _mm256_unpackhi_epi64(t0, t2);
+            r2 = _mm256_unpacklo_epi64(t1, t3);
+            r3 = _mm256_unpackhi_epi64(t1, t3);
+            r4 = _mm256_unpacklo_epi64(t4, t6);
+            r5 = _mm256_unpackhi_epi64(t4, t6);
+            r6 = _mm256_unpacklo_epi64(t5, t7);
+            r7 = _mm256_unpackhi_epi64(t5, t7);
+            m[index]     = _mm256_permute2x128_si256(r0, r4, 0x20);
+            m[index + 1] = _mm256_permute2x128_si256(r1, r5, 0x20);
+            m[index + 2] = _mm256_permute2x128_si256(r2, r6, 0x20);
+            m[index + 3] = _mm256_permute2x128_si256(r3, r7, 0x20);
+            m[index + 4] = _mm256_permute2x128_si256(r0, r4, 0x31);
+            m[index + 5] = _mm256_permute2x128_si256(r1, r5, 0x31);
+            m[index + 6] = _mm256_permute2x128_si256(r2, r6, 0x31);
+            m[index + 7] = _mm256_permute2x128_si256(r3, r7, 0x31);
+        }
+        data += 8 * 64;
+        t += 64;
+
+        for (index = 0; index < 8; ++index)
+            v[index] = hv[index];
+        v[8]  = _mm256_set1_epi32(0x6A09E667);
+        v[9]  = _mm256_set1_epi32(0xBB67AE85);
+        v[10] = _mm256_set1_epi32(0x3C6EF372);
+        v[11] = _mm256_set1_epi32(0xA54FF53A);
+        v[12] = _mm256_set1_epi32(0x510E527F ^ (uint32_t)t);
+        v[13] = _mm256_set1_epi32(0x9B05688C ^ (uint32_t)(t >> 32));
+        v[14] = _mm256_set1_epi32(0x1F83D9AB);
+        v[15] = _mm256_set1_epi32(0x5BE0CD19);
+
+        for (round = 0; round < 10; ++round) {
+            blake2xRound(blake2s8Add, blake2s8Ror16, blake2s8Ror12,
+                         blake2s8Ror8, blake2s8Ror7);
+        }
+
+        for (index = 0; index < 8; ++index) {
+            hv[index] = _mm256_xor_si256
+                (hv[index], _mm256_xor_si256(v[index], v[index + 8]));
+        }
+    }
+
+    for (index = 0; index < 8; ++index)
+        _mm256_storeu_si256((__m256i *)h[index], hv[index]);
+}
+
+#define blake2b4Add(a, b)   (_mm256_add_epi64((a), (b)))
+#define blake2b4Ror32(a)    (_mm256_shuffle_epi32((a), 0xB1))
+#define blake2b4Ror24(a)    (_mm256_shuffle_epi8((a), rot24))
+#define blake2b4Ror16(a)    (_mm256_shuffle_epi8((a), rot16))
+#define blake2b4Ror63(a)    \
+    (_mm256_or_si256(_mm256_srli_epi64((a), 63), _mm256_add_epi64((a), (a))))
+
+__attribute__((target("avx2")))
+void blake2bCompressLanes(uint64_t h[8][4], const uint8_t *data,
+                          size_t stripes, uint64_t t)
+{
+    const __m256i rot24 = _mm256_set_epi8
+        (10, 9, 8, 15, 14, 13, 12, 11, 2, 1, 0, 7, 6, 5, 4, 3,
+         10, 9, 8, 15, 14, 13, 12, 11, 2, 1, 0, 7, 6, 5, 4, 3);
+    const __m256i rot16 = _mm256_set_epi8
+        (9, 8, 15, 14, 13, 12, 11, 10, 1, 0, 7, 6, 5, 4, 3, 2,
+         9, 8, 15, 14, 13, 12, 11, 10, 1, 0, 7, 6, 5, 4, 3, 2);
+    __m256i hv[8];
+    __m256i m[16];
+    __m256i v[16];
+    uint8_t index, round;
+
+    for (index = 0; index < 8; ++index)
+        hv[index] = _mm256_loadu_si256((const __m256i *)h[index]);
+
+    while (stripes-- > 0) {
+        // Load the blocks with word i of every leaf in m[i], transposing
+        // four words of each leaf at a time.
+        for (index = 0; index < 16; index += 4) {
+            __m256i r0 = _mm256_loadu_si256((const __m256i *)(data + 0 * 128 + index * 8));
+            __m256i r1 = _mm256_loadu_si256((const __m256i *)(data + 1 * 128 + index * 8));
+            __m256i r2 = _mm256_loadu_si256((const __m256i *)(data + 2 * 128 + index * 8));
+            __m256i r3 = _mm256_loadu_si256((const __m256i *)(data + 3 * 128 + index * 8));
+            __m256i t0 = _mm256_unpacklo_epi64(r0, r1);
+            __m256i t1 = _mm256_unpackhi_epi64(r0, r1);
+            __m256i t2 = _mm256_unpacklo_epi64(r2, r3);
+            __m256i t3 = _mm256_unpackhi_epi64(r2, r3);
+            m[index]     = _mm256_permute2x128_si256(t0, t2, 0x20);
+            m[index + 1] = _mm256_permute2x128_si256(t1, t3, 0x20);
+            m[index + 2] = _mm256_permute2x128_si256(t0, t2, 0x31);
+            m[index + 3] = _mm256_permute2x128_si256(t1, t3, 0x31);
+        }
+        data += 4 * 128;
+        t += 128;
+
+        for (index = 0; index < 8; ++index)
+            v[index] = hv[index];
+        v[8]  = _mm256_set1_epi64x((long long)0x6a09e667f3bcc908ULL);
+        v[9]  = _mm256_set1_epi64x((long long)0xbb67ae8584caa73bULL);
+        v[10] = _mm256_set1_epi64x((long long)0x3c6ef372fe94f82bULL);
+        v[11] = _mm256_set1_epi64x((long long)0xa54ff53a5f1d36f1ULL);
+        v[12] = _mm256_set1_epi64x((long long)(0x510e527fade682d1ULL ^ t));
+        v[13] = _mm256_set1_epi64x((long long)0x9b05688c2b3e6c1fULL);
+        v[14] = _mm256_set1_epi64x((long long)0x1f83d9abfb41bd6bULL);
+        v[15] = _mm256_set1_epi64x((long long)0x5be0cd19137e2179ULL);
+
+        for (round = 0; round < 12; ++round) {
+            blake2xRound(blake2b4Add, blake2b4Ror32, blake2b4Ror24,
+                         blake2b4Ror16, blake2b4Ror63);
+        }
+
+        for (index = 0; index < 8; ++index) {
+            hv[index] = _mm256_xor_si256
+                (hv[index], _mm256_xor_si256(v[index], v[index + 8]));
+        }
+    }
+
+    for (index = 0; index < 8; ++index)
+        _mm256_storeu_si256((__m256i *)h[index], hv[index]);
+}
+
+#endif // CRYPTO_BLAKE2_LANES_AVX2
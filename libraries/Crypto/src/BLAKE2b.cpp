@@ -265,6 +265,58 @@ void BLAKE2b::finalizeHMAC(const void *key, size_t keyLen, void *hash, size_t ha
     clean(temp);
 }
 
+void BLAKE2b::hashMany(const Message *msgs, size_t count, uint8_t *out)
+{
+    hashEach<BLAKE2b>(*this, msgs, count, out);
+}
+
+/**
+ * \struct BLAKE2b::State
+ * \brief Saved copy of the internal state of a BLAKE2b object.
+ *
+ * \sa saveState(), restoreState()
+ */
+
+/**
+ * \brief Copies the hashing state of another BLAKE2b object into this one.
+ *
+ * \param other The object to copy the state from.
+ *
+ * The copy includes the output length and any key given to reset(), so
+ * a keyed prefix can be set up once and forked for every message.
+ *
+ * \sa saveState(), restoreState()
+ */
+void BLAKE2b::copyStateFrom(const BLAKE2b &other)
+{
+    state = other.state;
+}
+
+/**
+ * \brief Saves the hashing state of this object.
+ *
+ * \param saved Receives the state.  If the hash is keyed, the state
+ * depends on the key, so clean() it once it is no longer needed.
+ *
+ * \sa restoreState(), copyStateFrom()
+ */
+void BLAKE2b::saveState(State &saved) const
+{
+    saved = state;
+}
+
+/**
+ * \brief Restores a hashing state saved by saveState().
+ *
+ * \param saved The saved state, which may be restored any number of times.
+ *
+ * \sa saveState(), copyStateFrom()
+ */
+void BLAKE2b::restoreState(const State &saved)
+{
+    state = saved;
+}
+
 // Permutation on the message input state for BLAKE2b.
 static const uint8_t sigma[12][16] PROGMEM = {
     { 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15},
@@ -0,0 +1,549 @@
+/*
+ * Copyright (C) 2026 The cryptnox-sdk-arduino contributors.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "BLAKE2bp.h"
+#include "Crypto.h"
+#include "utility/BLAKE2Lanes.h"
+#include "utility/CPUFeatures.h"
+#include "utility/EndianUtil.h"
+#include "utility/RotateUtil.h"
+#include "utility/ProgMemUtil.h"
+#include <string.h>
+#if defined(CRYPTO_BLAKE2P_THREADS)
+#include <pthread.h>
+#endif
+
+/**
+ * \class BLAKE2bp BLAKE2bp.h <BLAKE2bp.h>
+ * \brief BLAKE2bp hash algorithm, the 4-way parallel tree mode of BLAKE2b.
+ *
+ * BLAKE2bp splits the input into 128-byte blocks and deals them out in
+ * turn to four BLAKE2b leaf hashes.  A fifth BLAKE2b hash over the four
+ * leaf hashes gives the final result.  Because the leaves are
+ * independent, they can be computed side by side: on x86 CPUs with AVX2
+ * each leaf runs in one 64-bit lane of a vector register.  The output is
+ * different from BLAKE2b, so both ends must agree on the mode.
+ *
+ * The leaf and root hashes use the tree parameters given in the BLAKE2
+ * specification, so the results match the reference implementation and
+ * its BLAKE2bp test vectors.  Keyed hashing works the same way as for
+ * BLAKE2b, with the key fed to every leaf:
+ *
+ * \code
+ * BLAKE2bp blake;
+ * blake.reset(key, sizeof(key), outputLength);
+ * blake.update(data, sizeof(data));
+ * blake.finalize(hash, outputLength);
+ * \endcode
+ *
+ * The object buffers up to two rounds of four blocks, so it needs a
+ * little over 1K of memory.  It is intended for hashing large images and
+ * files on larger platforms.  On small inputs it is slower than BLAKE2b
+ * because it always finalizes five hashes.
+ *
+ * If the library is compiled with CRYPTO_BLAKE2P_THREADS defined, then
+ * setThreads() can spread the leaves over several POSIX threads when
+ * large amounts of data are passed to update() at once.
+ *
+ * Reference: https://blake2.net/
+ *
+ * \sa BLAKE2b, BLAKE2bp
+ */
+
+/**
+ * \var BLAKE2bp::HASH_SIZE
+ * \brief Constant for the size of the hash output of BLAKE2bp.
+ */
+
+/**
+ * \var BLAKE2bp::BLOCK_SIZE
+ * \brief Constant for the block size of BLAKE2bp.
+ */
+
+/**
+ * \var BLAKE2bp::LEAVES
+ * \brief Number of leaf hashes in the BLAKE2bp tree.
+ */
+
+// Bytes of input that make up one block for every leaf.
+#define BLAKE2BP_STRIPE     (BLAKE2bp::LEAVES * BLAKE2bp::BLOCK_SIZE)
+
+// A leaf only compresses a block once it knows that it is not the leaf's
+// last block.  So a stripe can be compressed when more than this many
+// bytes follow it, and each leaf has seen the start of its next block.
+#define BLAKE2BP_HOLD       ((BLAKE2bp::LEAVES - 1) * BLAKE2bp::BLOCK_SIZE)
+
+// Minimum number of stripes in one update() before threads are used.
+#define BLAKE2BP_THREAD_STRIPES 64
+
+/**
+ * \brief Constructs a BLAKE2bp hash object.
+ */
+BLAKE2bp::BLAKE2bp()
+    : threads(1)
+{
+    reset();
+}
+
+/**
+ * \brief Destroys this BLAKE2bp hash object after clearing
+ * sensitive information.
+ */
+BLAKE2bp::~BLAKE2bp()
+{
+    clean(state);
+}
+
+size_t BLAKE2bp::hashSize() const
+{
+    return 64;
+}
+
+size_t BLAKE2bp::blockSize() const
+{
+    return 128;
+}
+
+// Initialization vectors for BLAKE2b.
+#define BLAKE2b_IV0 0x6a09e667f3bcc908ULL
+#define BLAKE2b_IV1 0xbb67ae8584caa73bULL
+#define BLAKE2b_IV2 0x3c6ef372fe94f82bULL
+#define BLAKE2b_IV3 0xa54ff53a5f1d36f1ULL
+#define BLAKE2b_IV4 0x510e527fade682d1ULL
+#define BLAKE2b_IV5 0x9b05688c2b3e6c1fULL
+#define BLAKE2b_IV6 0x1f83d9abfb41bd6bULL
+#define BLAKE2b_IV7 0x5be0cd19137e2179ULL
+
+// Parameter block words for the tree: fanout 4, depth 2, inner length 64.
+#define BLAKE2BP_PARAM0     0x02040000ULL
+#define BLAKE2BP_PARAM2     0x4000ULL
+#define BLAKE2BP_ROOT_DEPTH 0x01ULL
+
+// Initializes "h" with the BLAKE2b IV, without any tree parameters.
+static void blake2bpInitIV(uint64_t h[8])
+{
+    h[0] = BLAKE2b_IV0;
+    h[1] = BLAKE2b_IV1;
+    h[2] = BLAKE2b_IV2;
+    h[3] = BLAKE2b_IV3;
+    h[4] = BLAKE2b_IV4;
+    h[5] = BLAKE2b_IV5;
+    h[6] = BLAKE2b_IV6;
+    h[7] = BLAKE2b_IV7;
+}
+
+void BLAKE2bp::reset()
+{
+    reset((const void *)0, 0, 64);
+}
+
+/**
+ * \brief Resets the hash ready for a new hashing process with a specified
+ * output length.
+ *
+ * \param outputLength The output length to use for the final hash in bytes,
+ * between 1 and 64.
+ */
+void BLAKE2bp::reset(uint8_t outputLength)
+{
+    reset((const void *)0, 0, outputLength);
+}
+
+/**
+ * \brief Resets the hash ready for a new hashing process with a specified
+ * key and output length.
+ *
+ * \param key Points to the key.
+ * \param keyLen The length of the key in bytes, between 0 and 64.
+ * \param outputLength The output length to use for the final hash in bytes,
+ * between 1 and 64.
+ *
+ * If \a keyLen is greater than 64, then the \a key will be truncated to
+ * the first 64 bytes.
+ */
+void BLAKE2bp::reset(const void *key, size_t keyLen, uint8_t outputLength)
+{
+    uint64_t h[8];
+    uint8_t leaf, index;
+
+    if (keyLen > 64)
+        keyLen = 64;
+    if (outputLength < 1)
+        outputLength = 1;
+    else if (outputLength > 64)
+        outputLength = 64;
+    state.outputLength = outputLength;
+    state.keyLength = (uint8_t)keyLen;
+
+    // Leaf i has node offset i.  The digest length in the parameter block
+    // is the final output length, even though every leaf outputs 64 bytes.
+    blake2bpInitIV(h);
+    h[0] ^= BLAKE2BP_PARAM0 ^ (keyLen << 8) ^ outputLength;
+    h[2] ^= BLAKE2BP_PARAM2;
+    for (leaf = 0; leaf < LEAVES; ++leaf) {
+        for (index = 0; index < 8; ++index)
+            state.h[index][leaf] = h[index];
+        state.h[1][leaf] ^= leaf;
+    }
+    state.length = 0;
+
+    if (keyLen > 0) {
+        // Every leaf starts with the key padded out to a block.  A full
+        // stripe of key blocks gives exactly that.
+        memcpy(state.buf, key, keyLen);
+        memset(state.buf + keyLen, 0, BLOCK_SIZE - keyLen);
+        for (leaf = 1; leaf < LEAVES; ++leaf)
+            memcpy(state.buf + leaf * BLOCK_SIZE, state.buf, BLOCK_SIZE);
+        state.bufLen = BLAKE2BP_STRIPE;
+    } else {
+        state.bufLen = 0;
+    }
+}
+
+void BLAKE2bp::update(const void *data, size_t len)
+{
+    const uint8_t *d = (const uint8_t *)data;
+
+    // Nothing to add, and "data" may be NULL, which memcpy() must not see.
+    if (len == 0)
+        return;
+
+    // Top up the buffer from a previous call first.
+    if (state.bufLen > 0) {
+        size_t size = sizeof(state.buf) - state.bufLen;
+        if (size > len)
+            size = len;
+        memcpy(state.buf + state.bufLen, d, size);
+        state.bufLen += size;
+        d += size;
+        len -= size;
+        if (state.bufLen <= (BLAKE2BP_STRIPE + BLAKE2BP_HOLD))
+            return;
+        compressStripes(state.buf, 1);
+        state.bufLen -= BLAKE2BP_STRIPE;
+        if (len <= BLAKE2BP_HOLD) {
+            memmove(state.buf, state.buf + BLAKE2BP_STRIPE, state.bufLen);
+            memcpy(state.buf + state.bufLen, d, len);
+            state.bufLen += len;
+            return;
+        }
+
+        // The buffer was full, so its second stripe can go as well.
+        compressStripes(state.buf + BLAKE2BP_STRIPE, 1);
+        state.bufLen = 0;
+    }
+
+    // Compress whole stripes straight from the caller's data.
+    if (len > (BLAKE2BP_STRIPE + BLAKE2BP_HOLD)) {
+        size_t stripes = (len - BLAKE2BP_HOLD - 1) / BLAKE2BP_STRIPE;
+        compressStripes(d, stripes);
+        d += stripes * BLAKE2BP_STRIPE;
+        len -= stripes * BLAKE2BP_STRIPE;
+    }
+    memcpy(state.buf, d, len);
+    state.bufLen = len;
+}
+
+// Compresses one block into a BLAKE2b state with the finalization flags
+// f0 (last block) and f1 (last node of the tree level).
+static void blake2bpCompress(uint64_t h[8], const uint8_t *block,
+                             uint64_t t, uint64_t f0, uint64_t f1);
+
+void BLAKE2bp::finalize(void *hash, size_t len)
+{
+    uint64_t h[8];
+    uint64_t leafHashes[LEAVES][8];
+    uint8_t block[BLOCK_SIZE];
+    uint8_t leaf, index;
+
+    // Finish each leaf with what is left of its blocks in the buffer.
+    // A leaf may have an earlier block there as well as its last one.
+    for (leaf = 0; leaf < LEAVES; ++leaf) {
+        size_t posn = leaf * BLOCK_SIZE;
+        size_t size = 0;
+        uint64_t t = state.length;
+        for (index = 0; index < 8; ++index)
+            h[index] = state.h[index][leaf];
+        while ((posn + BLAKE2BP_STRIPE) < state.bufLen) {
+            t += BLOCK_SIZE;
+            blake2bpCompress(h, state.buf + posn, t, 0, 0);
+            posn += BLAKE2BP_STRIPE;
+        }
+        if (state.bufLen > posn) {
+            size = state.bufLen - posn;
+            if (size > BLOCK_SIZE)
+                size = BLOCK_SIZE;
+        }
+        memcpy(block, state.buf + posn, size);
+        memset(block + size, 0, BLOCK_SIZE - size);
+        blake2bpCompress(h, block, t + size, 0xFFFFFFFFFFFFFFFFULL,
+                         (leaf == (LEAVES - 1)) ? 0xFFFFFFFFFFFFFFFFULL : 0);
+        for (index = 0; index < 8; ++index)
+            leafHashes[leaf][index] = htole64(h[index]);
+    }
+
+    // The root hashes the leaf hashes in order, and is the last node.
+    blake2bpInitIV(h);
+    h[0] ^= BLAKE2BP_PARAM0 ^ (((uint64_t)state.keyLength) << 8) ^
+            state.outputLength;
+    h[2] ^= BLAKE2BP_PARAM2 ^ BLAKE2BP_ROOT_DEPTH;
+    const uint8_t *leafData = (const uint8_t *)leafHashes;
+    for (index = 0; index < ((LEAVES * 64) / BLOCK_SIZE); ++index) {
+        uint64_t last = (index == ((LEAVES * 64) / BLOCK_SIZE - 1))
+                      ? 0xFFFFFFFFFFFFFFFFULL : 0;
+        blake2bpCompress(h, leafData + index * BLOCK_SIZE,
+                         (index + 1) * BLOCK_SIZE, last, last);
+    }
+
+    // Convert the hash into little-endian and copy it to the caller.
+    for (index = 0; index < 8; ++index)
+        h[index] = htole64(h[index]);
+    if (len > state.outputLength)
+        len = state.outputLength;
+    memcpy(hash, h, len);
+    clean(h);
+    clean(leafHashes);
+    clean(block);
+}
+
+void BLAKE2bp::clear()
+{
+    clean(state);
+    reset();
+}
+
+void BLAKE2bp::resetHMAC(const void *key, size_t keyLen)
+{
+    uint8_t block[BLOCK_SIZE];
+    formatHMACKey(block, key, keyLen, 0x36);
+    update(block, sizeof(block));
+    clean(block);
+}
+
+void BLAKE2bp::finalizeHMAC(const void *key, size_t keyLen, void *hash, size_t hashLen)
+{
+    uint8_t block[BLOCK_SIZE];
+    uint8_t temp[64];
+    finalize(temp, sizeof(temp));
+    formatHMACKey(block, key, keyLen, 0x5C);
+    update(block, sizeof(block));
+    update(temp, sizeof(temp));
+    finalize(hash, hashLen);
+    clean(block);
+    clean(temp);
+}
+
+void BLAKE2bp::hashMany(const Message *msgs, size_t count, uint8_t *out)
+{
+    hashEach<BLAKE2bp>(*this, msgs, count, out);
+}
+
+/**
+ * \brief Sets the number of threads to use for large updates.
+ *
+ * \param count The number of threads, between 1 and LEAVES.  The default
+ * is 1, which hashes on the calling thread only.
+ *
+ * Threads are only started when a single update() call has at least
+ * 32K of data, and each thread hashes its share of the four leaves.
+ * The threads use the portable code rather than the vector lanes, so on
+ * CPUs with AVX2 they only pay off when there are plenty of idle cores.
+ * This has no effect unless the library is compiled with
+ * CRYPTO_BLAKE2P_THREADS defined.
+ */
+void BLAKE2bp::setThreads(uint8_t count)
+{
+    if (count < 1)
+        count = 1;
+    else if (count > LEAVES)
+        count = LEAVES;
+    threads = count;
+}
+
+// Permutation on the message input state for BLAKE2b.
+static const uint8_t sigma[12][16] PROGMEM = {
+    { 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15},
+    {14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3},
+    {11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4},
+    { 7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8},
+    { 9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13},
+    { 2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9},
+    {12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11},
+    {13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10},
+    { 6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5},
+    {10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13 , 0},
+    { 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15},
+    {14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3},
+};
+
+// Perform a BLAKE2b quarter round operation.
+#define quarterRound(a, b, c, d, i)    \
+    do { \
+        uint64_t _b = (b); \
+        uint64_t _a = (a) + _b + m[pgm_read_byte(&(sigma[index][2 * (i)]))]; \
+        uint64_t _d = rightRotate32_64((d) ^ _a); \
+        uint64_t _c = (c) + _d; \
+        _b = rightRotate24_64(_b ^ _c); \
+        _a += _b + m[pgm_read_byte(&(sigma[index][2 * (i) + 1]))]; \
+        (d) = _d = rightRotate16_64(_d ^ _a); \
+        _c += _d; \
+        (a) = _a; \
+        (b) = rightRotate63_64(_b ^ _c); \
+        (c) = _c; \
+    } while (0)
+
+static void blake2bpCompress(uint64_t h[8], const uint8_t *block,
+                             uint64_t t, uint64_t f0, uint64_t f1)
+{
+    uint8_t index;
+    uint64_t m[16];
+    uint64_t v[16];
+
+    // Load the message block in little-endian.
+    memcpy(m, block, sizeof(m));
+#if !defined(CRYPTO_LITTLE_ENDIAN)
+    for (index = 0; index < 16; ++index)
+        m[index] = le64toh(m[index]);
+#endif
+
+    // Format the block to be hashed.  The leaves never get near 2^64
+    // bytes, so the high word of the counter is always zero.
+    memcpy(v, h, 8 * sizeof(uint64_t));
+    v[8]  = BLAKE2b_IV0;
+    v[9]  = BLAKE2b_IV1;
+    v[10] = BLAKE2b_IV2;
+    v[11] = BLAKE2b_IV3;
+    v[12] = BLAKE2b_IV4 ^ t;
+    v[13] = BLAKE2b_IV5;
+    v[14] = BLAKE2b_IV6 ^ f0;
+    v[15] = BLAKE2b_IV7 ^ f1;
+
+    // Perform the 12 BLAKE2b rounds.
+    for (index = 0; index < 12; ++index) {
+        // Column round.
+        quarterRound(v[0], v[4], v[8],  v[12], 0);
+        quarterRound(v[1], v[5], v[9],  v[13], 1);
+        quarterRound(v[2], v[6], v[10], v[14], 2);
+        quarterRound(v[3], v[7], v[11], v[15], 3);
+
+        // Diagonal round.
+        quarterRound(v[0], v[5], v[10], v[15], 4);
+        quarterRound(v[1], v[6], v[11], v[12], 5);
+        quarterRound(v[2], v[7], v[8],  v[13], 6);
+        quarterRound(v[3], v[4], v[9],  v[14], 7);
+    }
+
+    // Combine the new and old hash values.
+    for (index = 0; index < 8; ++index)
+        h[index] ^= (v[index] ^ v[index + 8]);
+}
+
+// Compresses one leaf's block from each of "stripes" stripes, where "t"
+// is the leaf's byte count before the first one.
+static void blake2bpCompressLeaf(uint64_t h[8][BLAKE2bp::LEAVES], uint8_t leaf,
+                                 const uint8_t *data, size_t stripes,
+                                 uint64_t t)
+{
+    uint64_t leafH[8];
+    uint8_t index;
+
+    for (index = 0; index < 8; ++index)
+        leafH[index] = h[index][leaf];
+    data += leaf * BLAKE2bp::BLOCK_SIZE;
+    while (stripes-- > 0) {
+        t += BLAKE2bp::BLOCK_SIZE;
+        blake2bpCompress(leafH, data, t, 0, 0);
+        data += BLAKE2BP_STRIPE;
+    }
+    for (index = 0; index < 8; ++index)
+        h[index][leaf] = leafH[index];
+}
+
+#if defined(CRYPTO_BLAKE2P_THREADS)
+
+// The leaves that one thread compresses: every "step"'th one from "first".
+struct BLAKE2bpJob
+{
+    uint64_t (*h)[BLAKE2bp::LEAVES];
+    const uint8_t *data;
+    size_t stripes;
+    uint64_t t;
+    uint8_t first;
+    uint8_t step;
+};
+
+static void *blake2bpRunJob(void *arg)
+{
+    BLAKE2bpJob *job = (BLAKE2bpJob *)arg;
+    for (uint8_t leaf = job->first; leaf < BLAKE2bp::LEAVES; leaf += job->step)
+        blake2bpCompressLeaf(job->h, leaf, job->data, job->stripes, job->t);
+    return 0;
+}
+
+#endif
+
+void BLAKE2bp::compressStripes(const uint8_t *data, size_t stripes)
+{
+#if defined(CRYPTO_BLAKE2P_THREADS)
+    if (threads > 1 && stripes >= BLAKE2BP_THREAD_STRIPES) {
+        BLAKE2bpJob jobs[LEAVES];
+        pthread_t ids[LEAVES];
+        bool started[LEAVES];
+        uint8_t posn;
+        for (posn = 0; posn < threads; ++posn) {
+            jobs[posn].h = state.h;
+            jobs[posn].data = data;
+            jobs[posn].stripes = stripes;
+            jobs[posn].t = state.length;
+            jobs[posn].first = posn;
+            jobs[posn].step = threads;
+            started[posn] = false;
+        }
+
+        // Run the first share here.  If a thread cannot be started,
+        // its share is also run here.
+        for (posn = 1; posn < threads; ++posn) {
+            started[posn] = (pthread_create(&(ids[posn]), 0, blake2bpRunJob,
+                                            &(jobs[posn])) == 0);
+        }
+        blake2bpRunJob(&(jobs[0]));
+        for (posn = 1; posn < threads; ++posn) {
+            if (started[posn])
+                pthread_join(ids[posn], 0);
+            else
+                blake2bpRunJob(&(jobs[posn]));
+        }
+        state.length += stripes * BLOCK_SIZE;
+        return;
+    }
+#endif
+#if defined(CRYPTO_BLAKE2_LANES_AVX2)
+    if (cpuHasFeatures(CRYPTO_CPU_AVX2)) {
+        blake2bCompressLanes(state.h, data, stripes, state.length);
+        state.length += stripes * BLOCK_SIZE;
+        return;
+    }
+#endif
+    for (uint8_t leaf = 0; leaf < LEAVES; ++leaf)
+        blake2bpCompressLeaf(state.h, leaf, data, stripes, state.length);
+    state.length += stripes * BLOCK_SIZE;
+}
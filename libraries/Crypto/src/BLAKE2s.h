@@ -46,16 +46,24 @@ public:
     void resetHMAC(const void *key, size_t keyLen);
     void finalizeHMAC(const void *key, size_t keyLen, void *hash, size_t hashLen);
 
+    void hashMany(const Message *msgs, size_t count, uint8_t *out);
+
     static const size_t HASH_SIZE  = 32;
     static const size_t BLOCK_SIZE = 64;
 
-private:
-    struct {
+    struct State {
         uint32_t h[8];
         uint32_t m[16];
         uint64_t length;
         uint8_t chunkSize;
-    } state;
+    };
+
+    void copyStateFrom(const BLAKE2s &other);
+    void saveState(State &saved) const;
+    void restoreState(const State &saved);
+
+private:
+    State state;
 
     void processChunk(uint32_t f0);
 };
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2026 The cryptnox-sdk-arduino contributors.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef CRYPTO_BLAKE2SP_H
+#define CRYPTO_BLAKE2SP_H
+
+#include "Hash.h"
+
+class BLAKE2sp : public Hash
+{
+public:
+    BLAKE2sp();
+    virtual ~BLAKE2sp();
+
+    size_t hashSize() const;
+    size_t blockSize() const;
+
+    void reset();
+    void reset(uint8_t outputLength);
+    void reset(const void *key, size_t keyLen, uint8_t outputLength = 32);
+
+    void update(const void *data, size_t len);
+    void finalize(void *hash, size_t len);
+
+    void clear();
+
+    void resetHMAC(const void *key, size_t keyLen);
+    void finalizeHMAC(const void *key, size_t keyLen, void *hash, size_t hashLen);
+
+    void hashMany(const Message *msgs, size_t count, uint8_t *out);
+
+    void setThreads(uint8_t count);
+
+    static const size_t HASH_SIZE  = 32;
+    static const size_t BLOCK_SIZE = 64;
+    static const uint8_t LEAVES    = 8;
+
+private:
+    struct {
+        uint32_t h[8][LEAVES];
+        uint8_t buf[2 * LEAVES * BLOCK_SIZE];
+        uint64_t length;
+        uint16_t bufLen;
+        uint8_t outputLength;
+        uint8_t keyLength;
+    } state;
+    uint8_t threads;
+
+    void compressStripes(const uint8_t *data, size_t stripes);
+};
+
+#endif
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2026 The cryptnox-sdk-arduino contributors.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "utility/CPUFeatures.h"
+
+#if defined(CRYPTO_CPU_X86)
+
+#include <cpuid.h>
+#include <atomic>
+
+#define CRYPTO_CPU_PROBED   0x80
+
+// CRYPTO_CPU_* bits of the running CPU, plus CRYPTO_CPU_PROBED once known.
+// Threads that race on the first call all probe and store the same value,
+// so relaxed ordering is enough.
+static std::atomic<uint8_t> cpuFeatures(0);
+
+static uint8_t cpuProbe()
+{
+    unsigned int eax, ebx, ecx, edx;
+    unsigned int ecx1, xcr0, xcr0High;
+    uint8_t features = 0;
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx1, &edx))
+        return 0;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+        return 0;
+
+    // AVX2 is only usable if the OS saves the YMM registers (XCR0 bits 1-2).
+    if ((ecx1 & (1U << 27)) != 0 && (ecx1 & (1U << 28)) != 0) {
+        __asm__ __volatile__ ("xgetbv" : "=a"(xcr0), "=d"(xcr0High) : "c"(0));
+        if ((xcr0 & 0x06) == 0x06 && (ebx & (1U << 5)) != 0)
+            features |= CRYPTO_CPU_AVX2;
+    }
+
+    // SSSE3 and SSE4.1 for the byte shuffle and blend, SHA for the rounds.
+    if ((ecx1 & (1U << 9)) != 0 && (ecx1 & (1U << 19)) != 0 &&
+            (ebx & (1U << 29)) != 0)
+        features |= CRYPTO_CPU_SHA;
+
+    return features;
+}
+
+bool cpuHasFeatures(uint8_t features)
+{
+    uint8_t known = cpuFeatures.load(std::memory_order_relaxed);
+    if (known == 0) {
+        known = cpuProbe() | CRYPTO_CPU_PROBED;
+        cpuFeatures.store(known, std::memory_order_relaxed);
+    }
+    return (known & features) == features;
+}
+
+#endif
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2026 The cryptnox-sdk-arduino contributors.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "HMACKey.h"
+
+/**
+ * \class HMACKey HMACKey.h <HMACKey.h>
+ * \brief HMAC key with its inner and outer hash states precomputed.
+ *
+ * Hash::resetHMAC() and Hash::finalizeHMAC() format the key and hash it
+ * with the inner and outer pads on every message, which costs two
+ * compression function calls per HMAC before any data is hashed.
+ * HMACKey does that once in setKey() and keeps the two resulting hash
+ * states, so each later HMAC under the same key only hashes the message
+ * and the inner digest.  This pays off when many HMACs share a key, as in
+ * PBKDF2, HKDF expansion or RFC 6979 nonce generation.
+ *
+ * The template parameter T is a hash class with saveState() and
+ * restoreState(): SHA224, SHA256, SHA384, SHA512, BLAKE2s, BLAKE2b,
+ * SHA3_256 or SHA3_512.  The result is identical to T::resetHMAC()
+ * followed by T::finalizeHMAC().
+ *
+ * \code
+ * HMACKey<SHA256> key(secret, sizeof(secret));
+ * key.compute(mac, sizeof(mac), message, messageLen);
+ *
+ * // Or incrementally:
+ * SHA256 hash;
+ * key.begin(hash);
+ * hash.update(part1, part1Len);
+ * hash.update(part2, part2Len);
+ * key.finalize(hash, mac, sizeof(mac));
+ * \endcode
+ *
+ * The object holds secret key material; it is cleaned by its destructor
+ * or by clear().
+ *
+ * Reference: https://datatracker.ietf.org/doc/html/rfc2104
+ *
+ * \sa hmac(), Hash::resetHMAC()
+ */
+
+/**
+ * \fn HMACKey::HMACKey()
+ * \brief Constructs an HMAC key object without a key.
+ *
+ * setKey() must be called before the object is used.
+ */
+
+/**
+ * \fn HMACKey::HMACKey(const void *key, size_t keyLen)
+ * \brief Constructs an HMAC key object and sets its key.
+ *
+ * \param key Points to the HMAC key.
+ * \param keyLen Length of the \a key in bytes.
+ */
+
+/**
+ * \fn HMACKey::~HMACKey()
+ * \brief Destroys this HMAC key object after clearing the key material.
+ */
+
+/**
+ * \fn void HMACKey::setKey(const void *key, size_t keyLen)
+ * \brief Sets the HMAC key and precomputes the inner and outer states.
+ *
+ * \param key Points to the HMAC key.
+ * \param keyLen Length of the \a key in bytes.  Keys longer than the
+ * block size of T are hashed first, as HMAC requires.
+ */
+
+/**
+ * \fn void HMACKey::begin(T &hash) const
+ * \brief Starts an HMAC computation in \a hash.
+ *
+ * \param hash The hash object, which is reset to the inner state.
+ * Feed the message to it with update() and then call finalize().
+ *
+ * \sa finalize(), compute()
+ */
+
+/**
+ * \fn void HMACKey::finalize(T &hash, void *mac, size_t macLen) const
+ * \brief Finishes an HMAC computation started with begin().
+ *
+ * \param hash The hash object passed to begin().
+ * \param mac Points to the buffer to receive the HMAC value.
+ * \param macLen Length of the \a mac buffer, which may be less than
+ * T::HASH_SIZE to truncate the result.
+ *
+ * \sa begin()
+ */
+
+/**
+ * \fn void HMACKey::compute(void *mac, size_t macLen, const void *data, size_t dataLen) const
+ * \brief Computes the HMAC of a single buffer.
+ *
+ * \param mac Points to the buffer to receive the HMAC value.
+ * \param macLen Length of the \a mac buffer.
+ * \param data Points to the message to authenticate.
+ * \param dataLen Length of the \a data in bytes.
+ */
+
+/**
+ * \fn void HMACKey::clear()
+ * \brief Clears the precomputed key states.
+ *
+ * setKey() must be called again before the object is reused.
+ */
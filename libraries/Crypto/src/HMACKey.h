@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 The cryptnox-sdk-arduino contributors.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef CRYPTO_HMACKEY_h
+#define CRYPTO_HMACKEY_h
+
+#include "Hash.h"
+#include "Crypto.h"
+#include <string.h>
+
+template <typename T>
+class HMACKey
+{
+public:
+    HMACKey() {}
+    HMACKey(const void *key, size_t keyLen) { setKey(key, keyLen); }
+    ~HMACKey() { clear(); }
+
+    void setKey(const void *key, size_t keyLen);
+
+    void begin(T &hash) const { hash.restoreState(inner); }
+    void finalize(T &hash, void *mac, size_t macLen) const;
+
+    void compute(void *mac, size_t macLen, const void *data, size_t dataLen) const;
+
+    void clear() { ::clean(inner); ::clean(outer); }
+
+private:
+    typename T::State inner;
+    typename T::State outer;
+};
+
+template <typename T>
+void HMACKey<T>::setKey(const void *key, size_t keyLen)
+{
+    uint8_t block[T::BLOCK_SIZE];
+    T hash;
+    if (keyLen > T::BLOCK_SIZE) {
+        hash.update(key, keyLen);
+        hash.finalize(block, T::HASH_SIZE);
+        keyLen = T::HASH_SIZE;
+    } else {
+        memcpy(block, key, keyLen);
+    }
+    memset(block + keyLen, 0, T::BLOCK_SIZE - keyLen);
+    for (size_t posn = 0; posn < T::BLOCK_SIZE; ++posn)
+        block[posn] ^= 0x36;
+    hash.reset();
+    hash.update(block, T::BLOCK_SIZE);
+    hash.saveState(inner);
+    for (size_t posn = 0; posn < T::BLOCK_SIZE; ++posn)
+        block[posn] ^= (0x36 ^ 0x5C);
+    hash.reset();
+    hash.update(block, T::BLOCK_SIZE);
+    hash.saveState(outer);
+    ::clean(block, sizeof(block));
+}
+
+template <typename T>
+void HMACKey<T>::finalize(T &hash, void *mac, size_t macLen) const
+{
+    uint8_t temp[T::HASH_SIZE];
+    hash.finalize(temp, T::HASH_SIZE);
+    hash.restoreState(outer);
+    hash.update(temp, T::HASH_SIZE);
+    hash.finalize(mac, macLen);
+    ::clean(temp, sizeof(temp));
+}
+
+template <typename T>
+void HMACKey<T>::compute(void *mac, size_t macLen, const void *data, size_t dataLen) const
+{
+    T hash;
+    hash.restoreState(inner);
+    hash.update(data, dataLen);
+    finalize(hash, mac, macLen);
+}
+
+#endif
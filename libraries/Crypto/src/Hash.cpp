@@ -100,6 +100,62 @@ Hash::~Hash()
  * \sa reset(), update(), finalizeHMAC()
  */
 
+/**
+ * \brief Hashes a batch of independent messages.
+ *
+ * \param msgs Array of \a count messages to hash.
+ * \param count Number of messages in the batch.
+ * \param out Buffer that receives the hashes, hashSize() bytes per
+ * message, one after the other.
+ *
+ * Each result is the same as reset(), update() and finalize() on that
+ * message alone, with reset()'s default parameters.  The hash object is
+ * used as scratch space, so any hash in progress is lost.
+ *
+ * This default implementation just makes those three calls per message.
+ * The subclasses override it with a loop that calls their own methods
+ * directly rather than through the vtable.  SHA512, SHA3_256 and SHA3_512
+ * hash several messages at once in vector lanes where the CPU allows it.
+ *
+ * \sa Message
+ */
+void Hash::hashMany(const Message *msgs, size_t count, uint8_t *out)
+{
+    size_t size = hashSize();
+    for (size_t posn = 0; posn < count; ++posn) {
+        reset();
+        update(msgs[posn].data, msgs[posn].len);
+        finalize(out, size);
+        out += size;
+    }
+}
+
+/**
+ * \struct Hash::Message
+ * \brief One message in a batch for hashMany().
+ */
+
+/**
+ * \var Hash::Message::data
+ * \brief Points to the message.
+ */
+
+/**
+ * \var Hash::Message::len
+ * \brief Length of the message in bytes.
+ */
+
+/**
+ * \fn void Hash::hashEach(T &hash, const Message *msgs, size_t count, uint8_t *out)
+ * \brief Helper for subclasses that implements hashMany() without
+ * virtual calls.
+ *
+ * \param hash The hash object to use, with concrete type \a T.
+ * \param msgs Array of \a count messages to hash.
+ * \param count Number of messages in the batch.
+ * \param out Buffer that receives T::HASH_SIZE bytes per message.
+ */
+
 /**
  * \fn void Hash::clear()
  * \brief Clears the hash state, removing all sensitive data, and then
@@ -29,6 +29,12 @@
 class Hash
 {
 public:
+    struct Message
+    {
+        const void *data;
+        size_t len;
+    };
+
     Hash();
     virtual ~Hash();
 
@@ -44,8 +50,22 @@ public:
     virtual void resetHMAC(const void *key, size_t keyLen) = 0;
     virtual void finalizeHMAC(const void *key, size_t keyLen, void *hash, size_t hashLen) = 0;
 
+    virtual void hashMany(const Message *msgs, size_t count, uint8_t *out);
+
 protected:
     void formatHMACKey(void *block, const void *key, size_t len, uint8_t pad);
+
+    template <typename T> static void hashEach
+        (T &hash, const Message *msgs, size_t count, uint8_t *out)
+    {
+        // Qualified calls so that the compiler does not go through the vtable.
+        for (size_t posn = 0; posn < count; ++posn) {
+            hash.T::reset();
+            hash.T::update(msgs[posn].data, msgs[posn].len);
+            hash.T::finalize(out, T::HASH_SIZE);
+            out += T::HASH_SIZE;
+        }
+    }
 };
 
 template <typename T> void hmac
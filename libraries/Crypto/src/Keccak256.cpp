@@ -0,0 +1,271 @@
+/*
+ * Copyright (C) 2026 The cryptnox-sdk-arduino contributors.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "Keccak256.h"
+#include "Crypto.h"
+#include "utility/KeccakLanes.h"
+#include <string.h>
+
+/**
+ * \class Keccak256 Keccak256.h <Keccak256.h>
+ * \brief Keccak-256 hash algorithm, as used by Ethereum.
+ *
+ * This is the original Keccak submission with a 256-bit output, before
+ * NIST changed the padding for SHA-3.  It uses the same sponge function
+ * as SHA3_256 but pads the input with 0x01 rather than 0x06, so the two
+ * produce different hash values for the same input.
+ *
+ * Whole 136-byte blocks of input are absorbed a 64-bit word at a time,
+ * which speeds up hashing of long transactions.  The deriveAddresses()
+ * function computes Ethereum addresses for a batch of public keys,
+ * several keys at a time on CPU's with a suitable vector unit.
+ *
+ * Reference: https://keccak.team/keccak.html
+ *
+ * \sa SHA3_256, KeccakCore
+ */
+
+/**
+ * \var Keccak256::HASH_SIZE
+ * \brief Constant for the size of the hash output of Keccak-256.
+ */
+
+/**
+ * \var Keccak256::BLOCK_SIZE
+ * \brief Constant for the block size of Keccak-256.
+ */
+
+/**
+ * \var Keccak256::PUBLIC_KEY_SIZE
+ * \brief Constant for the size of an uncompressed secp256k1 public key
+ * without its 0x04 prefix byte, as passed to deriveAddresses().
+ */
+
+/**
+ * \var Keccak256::ADDRESS_SIZE
+ * \brief Constant for the size of an Ethereum address.
+ */
+
+#if defined(CRYPTO_KECCAK_LANES)
+// Number of equal-length messages that are hashed in lockstep.
+#define KECCAK256_LANES 4
+#else
+#define KECCAK256_LANES 1
+#endif
+
+// Hashes "count" messages of "len" bytes each, in lockstep if possible.
+// The sponge functions must already have a capacity of 512 bits.
+static void keccak256Many(KeccakCore *const *cores, const void *const *data,
+                          size_t len, void *const *hashes, size_t count)
+{
+    for (size_t index = 0; index < count; ++index)
+        cores[index]->reset();
+    KeccakCore::updateMany(cores, data, len, count);
+    KeccakCore::padMany(cores, 0x01, count);
+    KeccakCore::extractMany(cores, hashes, 32, count);
+}
+
+/**
+ * \brief Constructs a new Keccak-256 hash object.
+ */
+Keccak256::Keccak256()
+{
+    core.setCapacity(512);
+}
+
+/**
+ * \brief Destroys this hash object after clearing sensitive information.
+ */
+Keccak256::~Keccak256()
+{
+    // The destructor for the KeccakCore object will do most of the work.
+}
+
+size_t Keccak256::hashSize() const
+{
+    return 32;
+}
+
+size_t Keccak256::blockSize() const
+{
+    return core.blockSize();
+}
+
+void Keccak256::reset()
+{
+    core.reset();
+}
+
+void Keccak256::update(const void *data, size_t len)
+{
+    // Absorb whole blocks a word at a time, and the rest byte by byte.
+    size_t done = core.absorbBlocks(data, len);
+    core.update(((const uint8_t *)data) + done, len - done);
+}
+
+void Keccak256::finalize(void *hash, size_t len)
+{
+    // Pad the final block with the original Keccak padding and then
+    // extract the hash value.
+    core.pad(0x01);
+    core.extract(hash, len);
+}
+
+void Keccak256::clear()
+{
+    core.clear();
+}
+
+void Keccak256::resetHMAC(const void *key, size_t keyLen)
+{
+    core.setHMACKey(key, keyLen, 0x36, 32, 0x01);
+}
+
+void Keccak256::finalizeHMAC(const void *key, size_t keyLen, void *hash, size_t hashLen)
+{
+    uint8_t temp[32];
+    finalize(temp, sizeof(temp));
+    core.setHMACKey(key, keyLen, 0x5C, 32, 0x01);
+    core.update(temp, sizeof(temp));
+    finalize(hash, hashLen);
+    clean(temp);
+}
+
+void Keccak256::hashMany(const Message *msgs, size_t count, uint8_t *out)
+{
+#if defined(CRYPTO_KECCAK_LANES)
+    // Consecutive messages of the same length are hashed in lockstep,
+    // with this object's sponge as the first lane.
+    KeccakCore extra[KECCAK256_LANES - 1];
+    KeccakCore *cores[KECCAK256_LANES];
+    const void *data[KECCAK256_LANES];
+    void *hashes[KECCAK256_LANES];
+    cores[0] = &core;
+    for (uint8_t index = 1; index < KECCAK256_LANES; ++index) {
+        extra[index - 1].setCapacity(512);
+        cores[index] = &(extra[index - 1]);
+    }
+    while (count > 0) {
+        size_t n = 1;
+        while (n < KECCAK256_LANES && n < count && msgs[n].len == msgs[0].len)
+            ++n;
+        for (size_t index = 0; index < n; ++index) {
+            data[index] = msgs[index].data;
+            hashes[index] = out + index * 32;
+        }
+        keccak256Many(cores, data, msgs[0].len, hashes, n);
+        msgs += n;
+        out += n * 32;
+        count -= n;
+    }
+#else
+    hashEach<Keccak256>(*this, msgs, count, out);
+#endif
+}
+
+/**
+ * \typedef Keccak256::State
+ * \brief Saved copy of the internal state of a Keccak256 object.
+ *
+ * \sa saveState(), restoreState()
+ */
+
+/**
+ * \brief Copies the hashing state of another Keccak-256 object into this one.
+ *
+ * \param other The object to copy the state from.
+ *
+ * \sa saveState(), restoreState(), KeccakCore::copyStateFrom()
+ */
+void Keccak256::copyStateFrom(const Keccak256 &other)
+{
+    core.copyStateFrom(other.core);
+}
+
+/**
+ * \brief Saves the hashing state of this object.
+ *
+ * \param saved Receives the state; clean() it once it is no longer needed.
+ *
+ * \sa restoreState(), copyStateFrom()
+ */
+void Keccak256::saveState(State &saved) const
+{
+    core.saveState(saved);
+}
+
+/**
+ * \brief Restores a hashing state saved by saveState().
+ *
+ * \param saved The saved state.
+ *
+ * \sa saveState(), copyStateFrom()
+ */
+void Keccak256::restoreState(const State &saved)
+{
+    core.restoreState(saved);
+}
+
+/**
+ * \brief Derives the Ethereum addresses for a batch of public keys.
+ *
+ * \param addresses Buffer that receives the addresses, ADDRESS_SIZE
+ * bytes per public key, one after the other.
+ * \param publicKeys The public keys, PUBLIC_KEY_SIZE bytes each, one
+ * after the other.
+ * \param count The number of public keys.
+ *
+ * Each public key is an uncompressed secp256k1 point, the 32-byte big-endian
+ * x co-ordinate followed by the 32-byte big-endian y co-ordinate, without
+ * the 0x04 prefix byte of the SEC1 encoding.  Its address is the last 20
+ * bytes of the Keccak-256 hash of those 64 bytes.
+ *
+ * Since the keys all have the same length, they are hashed in lockstep
+ * on CPU's with a suitable vector unit.
+ */
+void Keccak256::deriveAddresses(uint8_t *addresses, const uint8_t *publicKeys,
+                                size_t count)
+{
+    KeccakCore cores[KECCAK256_LANES];
+    KeccakCore *corePtrs[KECCAK256_LANES];
+    const void *data[KECCAK256_LANES];
+    uint8_t hashes[KECCAK256_LANES][32];
+    void *hashPtrs[KECCAK256_LANES];
+    for (uint8_t index = 0; index < KECCAK256_LANES; ++index) {
+        cores[index].setCapacity(512);
+        corePtrs[index] = &(cores[index]);
+        hashPtrs[index] = hashes[index];
+    }
+    while (count > 0) {
+        size_t n = count < KECCAK256_LANES ? count : KECCAK256_LANES;
+        for (size_t index = 0; index < n; ++index)
+            data[index] = publicKeys + index * PUBLIC_KEY_SIZE;
+        keccak256Many(corePtrs, data, PUBLIC_KEY_SIZE, hashPtrs, n);
+        for (size_t index = 0; index < n; ++index) {
+            memcpy(addresses + index * ADDRESS_SIZE,
+                   hashes[index] + 32 - ADDRESS_SIZE, ADDRESS_SIZE);
+        }
+        publicKeys += n * PUBLIC_KEY_SIZE;
+        addresses += n * ADDRESS_SIZE;
+        count -= n;
+    }
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2026 The cryptnox-sdk-arduino contributors.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef CRYPTO_KECCAK256_h
+#define CRYPTO_KECCAK256_h
+
+#include "KeccakCore.h"
+#include "Hash.h"
+
+class Keccak256 : public Hash
+{
+public:
+    Keccak256();
+    virtual ~Keccak256();
+
+    size_t hashSize() const;
+    size_t blockSize() const;
+
+    void reset();
+    void update(const void *data, size_t len);
+    void finalize(void *hash, size_t len);
+
+    void clear();
+
+    void resetHMAC(const void *key, size_t keyLen);
+    void finalizeHMAC(const void *key, size_t keyLen, void *hash, size_t hashLen);
+
+    void hashMany(const Message *msgs, size_t count, uint8_t *out);
+
+    static const size_t HASH_SIZE  = 32;
+    static const size_t BLOCK_SIZE = 136;
+
+    typedef KeccakCore::State State;
+
+    void copyStateFrom(const Keccak256 &other);
+    void saveState(State &saved) const;
+    void restoreState(const State &saved);
+
+    static const size_t PUBLIC_KEY_SIZE = 64;
+    static const size_t ADDRESS_SIZE = 20;
+
+    static void deriveAddresses(uint8_t *addresses, const uint8_t *publicKeys,
+                                size_t count);
+
+private:
+    KeccakCore core;
+};
+
+#endif
@@ -25,6 +25,7 @@
 #include "utility/EndianUtil.h"
 #include "utility/RotateUtil.h"
 #include "utility/ProgMemUtil.h"
+#include "utility/KeccakLanes.h"
 #include <string.h>
 
 /**
@@ -154,6 +155,51 @@ void KeccakCore::update(const void *data, size_t size)
     }
 }
 
+/**
+ * \brief Absorbs whole blocks of input data a word at a time.
+ *
+ * \param data The input data to be absorbed.
+ * \param size The number of bytes of input data available.
+ * \return The number of bytes that were absorbed, which is a multiple
+ * of blockSize().
+ *
+ * This is a faster path for update() when the sponge function is on a
+ * block boundary and the caller has at least one whole block of input.
+ * Each block is XOR'ed into the state as 64-bit words rather than bytes.
+ * If the sponge function is part-way through a block, then nothing is
+ * absorbed and the caller should pass the data to update() instead.
+ *
+ * The rest of the input, if any, should be passed to update():
+ *
+ * \code
+ * size_t done = core.absorbBlocks(data, size);
+ * core.update(data + done, size - done);
+ * \endcode
+ *
+ * \sa update()
+ */
+size_t KeccakCore::absorbBlocks(const void *data, size_t size)
+{
+    if (state.inputSize != 0)
+        return 0;
+    state.outputSize = 0;
+    const uint8_t *d = (const uint8_t *)data;
+    uint64_t *Awords = &(state.A[0][0]);
+    uint8_t words = _blockSize / 8;
+    size_t done = 0;
+    while ((size - done) >= _blockSize) {
+        for (uint8_t index = 0; index < words; ++index) {
+            uint64_t word;
+            memcpy(&word, d + index * 8, 8);
+            Awords[index] ^= word;
+        }
+        keccakp();
+        d += _blockSize;
+        done += _blockSize;
+    }
+    return done;
+}
+
 /**
  * \brief Pads the last block of input data to blockSize().
  *
@@ -171,13 +217,8 @@ void KeccakCore::pad(uint8_t tag)
     // SHAKE appends "1111" first instead of "01".  Note that SHA-3 numbers
     // bits from the least significant, so appending "01" is equivalent
     // to 0x02 for byte-aligned data, not 0x40.
-    uint8_t size = state.inputSize;
-    uint64_t *Awords = &(state.A[0][0]);
-    Awords[size / 8] ^= (((uint64_t)tag) << ((size % 8) * 8));
-    Awords[(_blockSize - 1) / 8] ^= 0x8000000000000000ULL;
+    addPadding(tag);
     keccakp();
-    state.inputSize = 0;
-    state.outputSize = 0;
 }
 
 /**
@@ -285,12 +326,15 @@ void KeccakCore::clear()
  * \param pad Inner (0x36) or outer (0x5C) padding value to XOR with
  * the formatted HMAC key.
  * \param hashSize The size of the output from the hash algorithm.
+ * \param tag The padding tag byte to use when hashing a long key down;
+ * 0x06 for SHA3 or 0x01 for the original Keccak.
  *
  * This function is intended to help classes implement Hash::resetHMAC() and
  * Hash::finalizeHMAC() by directly formatting the HMAC key into the
  * internal block buffer and resetting the hash.
  */
-void KeccakCore::setHMACKey(const void *key, size_t len, uint8_t pad, size_t hashSize)
+void KeccakCore::setHMACKey(const void *key, size_t len, uint8_t pad,
+                            size_t hashSize, uint8_t tag)
 {
     uint8_t *Abytes = (uint8_t *)state.A;
     size_t size = blockSize();
@@ -306,7 +350,7 @@ void KeccakCore::setHMACKey(const void *key, size_t len, uint8_t pad, size_t has
         // to be extracted.  We truncate it to the first "hashSize"
         // bytes and XOR with the padding.
         update(key, len);
-        this->pad(0x06);
+        this->pad(tag);
         memset(Abytes + hashSize, pad, size - hashSize);
         memset(Abytes + size, 0, sizeof(state.A) - size);
         size = hashSize;
@@ -318,6 +362,375 @@ void KeccakCore::setHMACKey(const void *key, size_t len, uint8_t pad, size_t has
     keccakp();
 }
 
+/**
+ * \struct KeccakCore::State
+ * \brief Saved copy of the sponge state of a KeccakCore object.
+ *
+ * \sa saveState(), restoreState()
+ */
+
+/**
+ * \brief Copies the sponge state of another KeccakCore object into this one.
+ *
+ * \param other The object to copy the state from.  It must have the same
+ * capacity as this object.
+ *
+ * This object then carries on absorbing or squeezing from wherever
+ * \a other had got to.
+ *
+ * \sa saveState(), restoreState()
+ */
+void KeccakCore::copyStateFrom(const KeccakCore &other)
+{
+    state = other.state;
+}
+
+/**
+ * \brief Saves the sponge state of this object.
+ *
+ * \param saved Receives the state.  The block size is not included; the
+ * state must be restored into an object with the same capacity.
+ *
+ * \sa restoreState(), copyStateFrom()
+ */
+void KeccakCore::saveState(State &saved) const
+{
+    saved = state;
+}
+
+/**
+ * \brief Restores a sponge state saved by saveState().
+ *
+ * \param saved The saved state.
+ *
+ * \sa saveState(), copyStateFrom()
+ */
+void KeccakCore::restoreState(const State &saved)
+{
+    state = saved;
+}
+
+#if defined(CRYPTO_KECCAK_LANES)
+
+// Copies sponge states into the lanes of an interleaved state.  Lanes
+// past "count" are zeroed and permuted for nothing.
+template <size_t Lanes>
+static void keccakGather(uint64_t A[25][Lanes],
+                         KeccakCore::State *const *states, size_t count)
+{
+    for (size_t lane = 0; lane < Lanes; ++lane) {
+        const uint64_t *words = &(states[lane < count ? lane : 0]->A[0][0]);
+        for (uint8_t index = 0; index < 25; ++index)
+            A[index][lane] = (lane < count) ? words[index] : 0;
+    }
+}
+
+// Copies the lanes of an interleaved state back into the sponge states.
+template <size_t Lanes>
+static void keccakScatter(KeccakCore::State *const *states,
+                          const uint64_t A[25][Lanes], size_t count)
+{
+    for (size_t lane = 0; lane < count; ++lane) {
+        uint64_t *words = &(states[lane]->A[0][0]);
+        for (uint8_t index = 0; index < 25; ++index)
+            words[index] = A[index][lane];
+    }
+}
+
+// XOR's "len" bytes of input into one lane, starting at byte "offset".
+template <size_t Lanes>
+static void keccakLaneXor(uint64_t A[25][Lanes], size_t lane, uint8_t offset,
+                          const uint8_t *in, uint8_t len)
+{
+    while (len > 0) {
+        uint8_t posn = offset % 8;
+        uint8_t chunk = 8 - posn;
+        if (chunk > len)
+            chunk = len;
+        if (chunk == 8) {
+            uint64_t word;
+            memcpy(&word, in, 8);
+            A[offset / 8][lane] ^= word;
+        } else {
+            uint8_t *bytes = ((uint8_t *)&(A[offset / 8][lane])) + posn;
+            for (uint8_t index = 0; index < chunk; ++index)
+                bytes[index] ^= in[index];
+        }
+        offset += chunk;
+        in += chunk;
+        len -= chunk;
+    }
+}
+
+// Copies "len" bytes of output out of one lane, starting at byte "offset".
+template <size_t Lanes>
+static void keccakLaneRead(uint8_t *out, const uint64_t A[25][Lanes],
+                           size_t lane, uint8_t offset, uint8_t len)
+{
+    while (len > 0) {
+        uint8_t posn = offset % 8;
+        uint8_t chunk = 8 - posn;
+        if (chunk > len)
+            chunk = len;
+        memcpy(out, ((const uint8_t *)&(A[offset / 8][lane])) + posn, chunk);
+        offset += chunk;
+        out += chunk;
+        len -= chunk;
+    }
+}
+
+template <size_t Lanes>
+static void keccakUpdateLanes(KeccakCore::State *const *states, size_t count,
+                              uint8_t blockSize, const void *const *data,
+                              size_t size)
+{
+    uint64_t A[25][Lanes];
+    uint8_t offset = states[0]->inputSize;
+    size_t posn = 0;
+    keccakGather<Lanes>(A, states, count);
+    while (size > 0) {
+        uint8_t len = blockSize - offset;
+        if (len > size)
+            len = size;
+        for (size_t lane = 0; lane < count; ++lane) {
+            keccakLaneXor<Lanes>(A, lane, offset,
+                                 ((const uint8_t *)(data[lane])) + posn, len);
+        }
+        offset += len;
+        posn += len;
+        size -= len;
+        if (offset == blockSize) {
+            keccakpLanes(A);
+            offset = 0;
+        }
+    }
+    keccakScatter<Lanes>(states, A, count);
+    for (size_t lane = 0; lane < count; ++lane) {
+        states[lane]->inputSize = offset;
+        states[lane]->outputSize = 0;
+    }
+    clean(A);
+}
+
+template <size_t Lanes>
+static void keccakPermuteLanes(KeccakCore::State *const *states, size_t count)
+{
+    uint64_t A[25][Lanes];
+    keccakGather<Lanes>(A, states, count);
+    keccakpLanes(A);
+    keccakScatter<Lanes>(states, A, count);
+    clean(A);
+}
+
+template <size_t Lanes>
+static void keccakExtractLanes(KeccakCore::State *const *states, size_t count,
+                               uint8_t blockSize, void *const *data,
+                               size_t size)
+{
+    uint64_t A[25][Lanes];
+    uint8_t offset = states[0]->outputSize;
+    size_t posn = 0;
+    keccakGather<Lanes>(A, states, count);
+    while (size > 0) {
+        if (offset >= blockSize) {
+            keccakpLanes(A);
+            offset = 0;
+        }
+        uint8_t len = blockSize - offset;
+        if (len > size)
+            len = size;
+        for (size_t lane = 0; lane < count; ++lane) {
+            keccakLaneRead<Lanes>(((uint8_t *)(data[lane])) + posn, A, lane,
+                                  offset, len);
+        }
+        offset += len;
+        posn += len;
+        size -= len;
+    }
+    keccakScatter<Lanes>(states, A, count);
+    for (size_t lane = 0; lane < count; ++lane) {
+        states[lane]->inputSize = 0;
+        states[lane]->outputSize = offset;
+    }
+    clean(A);
+}
+
+#endif // CRYPTO_KECCAK_LANES
+
+// Maximum number of sponges that are permuted together.
+#define KECCAK_MAX_LANES 4
+
+/**
+ * \brief Updates several Keccak sponge functions with the same amount of
+ * input data each.
+ *
+ * \param cores Array of \a count sponge functions.
+ * \param data Array of \a count pointers to the input data for each
+ * sponge function.
+ * \param size The number of bytes of input for each sponge function.
+ * \param count The number of sponge functions.
+ *
+ * The result is the same as calling update() on each sponge function in
+ * turn.  Where the CPU has a vector unit, sponge functions that have the
+ * same capacity and have absorbed the same amount of data so far are
+ * permuted two or four at a time in interleaved form.
+ *
+ * \sa padMany(), extractMany()
+ */
+void KeccakCore::updateMany(KeccakCore *const *cores, const void *const *data,
+                            size_t size, size_t count)
+{
+    size_t posn = 0;
+#if defined(CRYPTO_KECCAK_LANES)
+    State *states[KECCAK_MAX_LANES];
+    while ((count - posn) >= 2) {
+        size_t n = count - posn;
+        if (n > KECCAK_MAX_LANES)
+            n = KECCAK_MAX_LANES;
+        KeccakCore *const *group = cores + posn;
+
+        // Interleaving is only worth it if a permutation is coming.
+        if (inStep(group, n) &&
+                (group[0]->state.inputSize + size) >= group[0]->_blockSize) {
+            for (size_t index = 0; index < n; ++index)
+                states[index] = &(group[index]->state);
+            if (n == 2) {
+                keccakUpdateLanes<2>(states, n, group[0]->_blockSize,
+                                     data + posn, size);
+            } else {
+                keccakUpdateLanes<4>(states, n, group[0]->_blockSize,
+                                     data + posn, size);
+            }
+        } else {
+            for (size_t index = 0; index < n; ++index)
+                group[index]->update(data[posn + index], size);
+        }
+        posn += n;
+    }
+#endif
+    for (; posn < count; ++posn)
+        cores[posn]->update(data[posn], size);
+}
+
+/**
+ * \brief Pads the last block of input data for several Keccak sponge
+ * functions.
+ *
+ * \param cores Array of \a count sponge functions.
+ * \param tag The tag byte to add to the padding.
+ * \param count The number of sponge functions.
+ *
+ * The result is the same as calling pad() on each sponge function in turn.
+ *
+ * \sa updateMany(), extractMany()
+ */
+void KeccakCore::padMany(KeccakCore *const *cores, uint8_t tag, size_t count)
+{
+    size_t posn = 0;
+#if defined(CRYPTO_KECCAK_LANES)
+    State *states[KECCAK_MAX_LANES];
+    while ((count - posn) >= 2) {
+        size_t n = count - posn;
+        if (n > KECCAK_MAX_LANES)
+            n = KECCAK_MAX_LANES;
+        KeccakCore *const *group = cores + posn;
+        for (size_t index = 0; index < n; ++index) {
+            group[index]->addPadding(tag);
+            states[index] = &(group[index]->state);
+        }
+        if (n == 2)
+            keccakPermuteLanes<2>(states, n);
+        else
+            keccakPermuteLanes<4>(states, n);
+        posn += n;
+    }
+#endif
+    for (; posn < count; ++posn)
+        cores[posn]->pad(tag);
+}
+
+/**
+ * \brief Extracts the same amount of data from several Keccak sponge
+ * functions.
+ *
+ * \param cores Array of \a count sponge functions.
+ * \param data Array of \a count pointers to the buffers to fill with
+ * the data from each sponge function.
+ * \param size The number of bytes to extract from each sponge function.
+ * \param count The number of sponge functions.
+ *
+ * The result is the same as calling extract() on each sponge function in
+ * turn.  Sponge functions that are in step are permuted together, as for
+ * updateMany().
+ *
+ * \sa updateMany(), padMany()
+ */
+void KeccakCore::extractMany(KeccakCore *const *cores, void *const *data,
+                             size_t size, size_t count)
+{
+    size_t posn = 0;
+#if defined(CRYPTO_KECCAK_LANES)
+    State *states[KECCAK_MAX_LANES];
+    while ((count - posn) >= 2) {
+        size_t n = count - posn;
+        if (n > KECCAK_MAX_LANES)
+            n = KECCAK_MAX_LANES;
+        KeccakCore *const *group = cores + posn;
+
+        // Interleaving is only worth it if a permutation is coming.
+        if (inStep(group, n) &&
+                (group[0]->state.outputSize + size) > group[0]->_blockSize) {
+            for (size_t index = 0; index < n; ++index)
+                states[index] = &(group[index]->state);
+            if (n == 2) {
+                keccakExtractLanes<2>(states, n, group[0]->_blockSize,
+                                      data + posn, size);
+            } else {
+                keccakExtractLanes<4>(states, n, group[0]->_blockSize,
+                                      data + posn, size);
+            }
+        } else {
+            for (size_t index = 0; index < n; ++index)
+                group[index]->extract(data[posn + index], size);
+        }
+        posn += n;
+    }
+#endif
+    for (; posn < count; ++posn)
+        cores[posn]->extract(data[posn], size);
+}
+
+/**
+ * \brief XOR's the padding into the last block of input, leaving the
+ * state ready for the final permutation.
+ *
+ * \param tag The tag byte to add to the padding.
+ */
+void KeccakCore::addPadding(uint8_t tag)
+{
+    uint8_t size = state.inputSize;
+    uint64_t *Awords = &(state.A[0][0]);
+    Awords[size / 8] ^= (((uint64_t)tag) << ((size % 8) * 8));
+    Awords[(_blockSize - 1) / 8] ^= 0x8000000000000000ULL;
+    state.inputSize = 0;
+    state.outputSize = 0;
+}
+
+/**
+ * \brief Determines if several sponge functions can be permuted in
+ * lockstep: same block size and same position within the block.
+ */
+bool KeccakCore::inStep(KeccakCore *const *cores, size_t count)
+{
+    for (size_t index = 1; index < count; ++index) {
+        if (cores[index]->_blockSize != cores[0]->_blockSize ||
+                cores[index]->state.inputSize != cores[0]->state.inputSize ||
+                cores[index]->state.outputSize != cores[0]->state.outputSize)
+            return false;
+    }
+    return true;
+}
+
 /**
  * \brief Transform the state with the KECCAK-p sponge function with b = 1600.
  */
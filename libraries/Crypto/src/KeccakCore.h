@@ -40,6 +40,7 @@ public:
     void reset();
 
     void update(const void *data, size_t size);
+    size_t absorbBlocks(const void *data, size_t size);
     void pad(uint8_t tag);
 
     void extract(void *data, size_t size);
@@ -47,17 +48,33 @@ public:
 
     void clear();
 
-    void setHMACKey(const void *key, size_t len, uint8_t pad, size_t hashSize);
+    void setHMACKey(const void *key, size_t len, uint8_t pad,
+                    size_t hashSize, uint8_t tag = 0x06);
 
-private:
-    struct {
+    struct State {
         uint64_t A[5][5];
         uint8_t inputSize;
         uint8_t outputSize;
-    } state;
+    };
+
+    void copyStateFrom(const KeccakCore &other);
+    void saveState(State &saved) const;
+    void restoreState(const State &saved);
+
+    static void updateMany(KeccakCore *const *cores, const void *const *data,
+                           size_t size, size_t count);
+    static void padMany(KeccakCore *const *cores, uint8_t tag, size_t count);
+    static void extractMany(KeccakCore *const *cores, void *const *data,
+                            size_t size, size_t count);
+
+private:
+    State state;
     uint8_t _blockSize;
 
     void keccakp();
+    void addPadding(uint8_t tag);
+
+    static bool inStep(KeccakCore *const *cores, size_t count);
 };
 
 #endif
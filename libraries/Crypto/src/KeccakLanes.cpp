@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2026 The cryptnox-sdk-arduino contributors.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "utility/KeccakLanes.h"
+#include "utility/CPUFeatures.h"
+
+// Interleaved Keccak-f[1600].  See utility/KeccakLanes.h.
+
+#if defined(CRYPTO_KECCAK_LANES)
+
+// Round constants for the iota step.
+static uint64_t const RC[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808AULL,
+    0x8000000080008000ULL, 0x000000000000808BULL, 0x0000000080000001ULL,
+    0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008AULL,
+    0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000AULL,
+    0x000000008000808BULL, 0x800000000000008BULL, 0x8000000000008089ULL,
+    0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+    0x000000000000800AULL, 0x800000008000000AULL, 0x8000000080008081ULL,
+    0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+// Steps theta, rho, pi and chi of one round on the words in a[], for any
+// vector type.  ANDN(x, y) is (~x & y) and ROL() rotates each 64-bit
+// element left.  The rho and pi offsets are the ones KeccakCore uses.
+#define keccakxRound(XOR, ANDN, ROL) \
+    do { \
+        c[0] = XOR(XOR(XOR(a[0], a[5]), XOR(a[10], a[15])), a[20]); \
+        c[1] = XOR(XOR(XOR(a[1], a[6]), XOR(a[11], a[16])), a[21]); \
+        c[2] = XOR(XOR(XOR(a[2], a[7]), XOR(a[12], a[17])), a[22]); \
+        c[3] = XOR(XOR(XOR(a[3], a[8]), XOR(a[13], a[18])), a[23]); \
+        c[4] = XOR(XOR(XOR(a[4], a[9]), XOR(a[14], a[19])), a[24]); \
+        d = XOR(c[4], ROL(c[1], 1)); \
+        a[0] = XOR(a[0], d); a[5] = XOR(a[5], d); a[10] = XOR(a[10], d); \
+        a[15] = XOR(a[15], d); a[20] = XOR(a[20], d); \
+        d = XOR(c[0], ROL(c[2], 1)); \
+        a[1] = XOR(a[1], d); a[6] = XOR(a[6], d); a[11] = XOR(a[11], d); \
+        a[16] = XOR(a[16], d); a[21] = XOR(a[21], d); \
+        d = XOR(c[1], ROL(c[3], 1)); \
+        a[2] = XOR(a[2], d); a[7] = XOR(a[7], d); a[12] = XOR(a[12], d); \
+        a[17] = XOR(a[17], d); a[22] = XOR(a[22], d); \
+        d = XOR(c[2], ROL(c[4], 1)); \
+        a[3] = XOR(a[3], d); a[8] = XOR(a[8], d); a[13] = XOR(a[13], d); \
+        a[18] = XOR(a[18], d); a[23] = XOR(a[23], d); \
+        d = XOR(c[3], ROL(c[0], 1)); \
+        a[4] = XOR(a[4], d); a[9] = XOR(a[9], d); a[14] = XOR(a[14], d); \
+        a[19] = XOR(a[19], d); a[24] = XOR(a[24], d); \
+        b[0] = a[0]; \
+        b[5] = ROL(a[3], 28); \
+        b[10] = ROL(a[1], 1); \
+        b[15] = ROL(a[4], 27); \
+        b[20] = ROL(a[2], 62); \
+        b[1] = ROL(a[6], 44); \
+        b[6] = ROL(a[9], 20); \
+        b[11] = ROL(a[7], 6); \
+        b[16] = ROL(a[5], 36); \
+        b[21] = ROL(a[8], 55); \
+        b[2] = ROL(a[12], 43); \
+        b[7] = ROL(a[10], 3); \
+        b[12] = ROL(a[13], 25); \
+        b[17] = ROL(a[11], 10); \
+        b[22] = ROL(a[14], 39); \
+        b[3] = ROL(a[18], 21); \
+        b[8] = ROL(a[16], 45); \
+        b[13] = ROL(a[19], 8); \
+        b[18] = ROL(a[17], 15); \
+        b[23] = ROL(a[15], 41); \
+        b[4] = ROL(a[24], 14); \
+        b[9] = ROL(a[22], 61); \
+        b[14] = ROL(a[20], 18); \
+        b[19] = ROL(a[23], 56); \
+        b[24] = ROL(a[21], 2); \
+        a[0] = XOR(b[0], ANDN(b[1], b[2])); \
+        a[1] = XOR(b[1], ANDN(b[2], b[3])); \
+        a[2] = XOR(b[2], ANDN(b[3], b[4])); \
+        a[3] = XOR(b[3], ANDN(b[4], b[0])); \
+        a[4] = XOR(b[4], ANDN(b[0], b[1])); \
+        a[5] = XOR(b[5], ANDN(b[6], b[7])); \
+        a[6] = XOR(b[6], ANDN(b[7], b[8])); \
+        a[7] = XOR(b[7], ANDN(b[8], b[9])); \
+        a[8] = XOR(b[8], ANDN(b[9], b[5])); \
+        a[9] = XOR(b[9], ANDN(b[5], b[6])); \
+        a[10] = XOR(b[10], ANDN(b[11], b[12])); \
+        a[11] = XOR(b[11], ANDN(b[12], b[13])); \
+        a[12] = XOR(b[12], ANDN(b[13], b[14])); \
+        a[13] = XOR(b[13], ANDN(b[14], b[10])); \
+        a[14] = XOR(b[14], ANDN(b[10], b[11])); \
+        a[15] = XOR(b[15], ANDN(b[16], b[17])); \
+        a[16] = XOR(b[16], ANDN(b[17], b[18])); \
+        a[17] = XOR(b[17], ANDN(b[18], b[19])); \
+        a[18] = XOR(b[18], ANDN(b[19], b[15])); \
+        a[19] = XOR(b[19], ANDN(b[15], b[16])); \
+        a[20] = XOR(b[20], ANDN(b[21], b[22])); \
+        a[21] = XOR(b[21], ANDN(b[22], b[23])); \
+        a[22] = XOR(b[22], ANDN(b[23], b[24])); \
+        a[23] = XOR(b[23], ANDN(b[24], b[20])); \
+        a[24] = XOR(b[24], ANDN(b[20], b[21])); \
+    } while (0)
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <emmintrin.h>
+
+typedef __m128i keccakx2_t;
+
+#define keccakx2Load(p)         (_mm_loadu_si128((const __m128i *)(p)))
+#define keccakx2Store(p, x)     (_mm_storeu_si128((__m128i *)(p), (x)))
+#define keccakx2Const(x)        (_mm_set1_epi64x((long long)(x)))
+#define keccakx2Xor(x, y)       (_mm_xor_si128((x), (y)))
+#define keccakx2AndNot(x, y)    (_mm_andnot_si128((x), (y)))
+#define keccakx2Rol(x, n)       \
+    (_mm_or_si128(_mm_slli_epi64((x), (n)), _mm_srli_epi64((x), 64 - (n))))
+
+#else // __aarch64__
+
+#include <arm_neon.h>
+
+typedef uint64x2_t keccakx2_t;
+
+#define keccakx2Load(p)         (vld1q_u64((p)))
+#define keccakx2Store(p, x)     (vst1q_u64((p), (x)))
+#define keccakx2Const(x)        (vdupq_n_u64((x)))
+#define keccakx2Xor(x, y)       (veorq_u64((x), (y)))
+#define keccakx2AndNot(x, y)    (vbicq_u64((y), (x)))
+#define keccakx2Rol(x, n)       \
+    (vsriq_n_u64(vshlq_n_u64((x), (n)), (x), 64 - (n)))
+
+#endif
+
+// Permutes two states whose words are "stride" words apart in A.
+static void keccakx2(uint64_t *A, size_t stride)
+{
+    keccakx2_t a[25];
+    keccakx2_t b[25];
+    keccakx2_t c[5];
+    keccakx2_t d;
+    uint8_t index;
+
+    for (index = 0; index < 25; ++index)
+        a[index] = keccakx2Load(A + index * stride);
+    for (index = 0; index < 24; ++index) {
+        keccakxRound(keccakx2Xor, keccakx2AndNot, keccakx2Rol);
+        a[0] = keccakx2Xor(a[0], keccakx2Const(RC[index]));
+    }
+    for (index = 0; index < 25; ++index)
+        keccakx2Store(A + index * stride, a[index]);
+}
+
+void keccakpLanes(uint64_t A[25][2])
+{
+    keccakx2(&(A[0][0]), 2);
+}
+
+#if defined(CRYPTO_CPU_X86)
+
+#include <immintrin.h>
+
+#define keccakx4Xor(x, y)       (_mm256_xor_si256((x), (y)))
+#define keccakx4AndNot(x, y)    (_mm256_andnot_si256((x), (y)))
+#define keccakx4Rol(x, n)       \
+    (_mm256_or_si256(_mm256_slli_epi64((x), (n)), _mm256_srli_epi64((x), 64 - (n))))
+
+__attribute__((target("avx2")))
+static void keccakx4(uint64_t A[25][4])
+{
+    __m256i a[25];
+    __m256i b[25];
+    __m256i c[5];
+    __m256i d;
+    uint8_t index;
+
+    for (index = 0; index < 25; ++index)
+        a[index] = _mm256_loadu_si256((const __m256i *)(A[index]));
+    for (index = 0; index < 24; ++index) {
+        keccakxRound(keccakx4Xor, keccakx4AndNot, keccakx4Rol);
+        a[0] = keccakx4Xor(a[0], _mm256_set1_epi64x((long long)(RC[index])));
+    }
+    for (index = 0; index < 25; ++index)
+        _mm256_storeu_si256((__m256i *)(A[index]), a[index]);
+}
+
+#endif
+
+void keccakpLanes(uint64_t A[25][4])
+{
+#if defined(CRYPTO_CPU_X86)
+    if (cpuHasFeatures(CRYPTO_CPU_AVX2)) {
+        keccakx4(A);
+        return;
+    }
+#endif
+    keccakx2(&(A[0][0]), 4);
+    keccakx2(&(A[0][2]), 4);
+}
+
+#endif // CRYPTO_KECCAK_LANES
@@ -0,0 +1,368 @@
+/*
+ * Copyright (C) 2026 The cryptnox-sdk-arduino contributors.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "RIPEMD160.h"
+#include "SHA256.h"
+#include "Crypto.h"
+#include "utility/RotateUtil.h"
+#include "utility/EndianUtil.h"
+#include "utility/ProgMemUtil.h"
+#include <string.h>
+
+/**
+ * \class RIPEMD160 RIPEMD160.h <RIPEMD160.h>
+ * \brief RIPEMD-160 hash algorithm.
+ *
+ * RIPEMD-160 is mainly of interest today because Bitcoin identifies
+ * public keys by their HASH160, which is RIPEMD-160 applied to the
+ * SHA-256 hash of the key.  The hash160() function computes this in
+ * one call, handing the SHA-256 result straight to RIPEMD-160.
+ *
+ * Reference: https://homes.esat.kuleuven.be/~bosselae/ripemd160.html
+ *
+ * \sa SHA256
+ */
+
+/**
+ * \var RIPEMD160::HASH_SIZE
+ * \brief Constant for the size of the hash output of RIPEMD160.
+ */
+
+/**
+ * \var RIPEMD160::BLOCK_SIZE
+ * \brief Constant for the block size of RIPEMD160.
+ */
+
+/**
+ * \brief Constructs a RIPEMD-160 hash object.
+ */
+RIPEMD160::RIPEMD160()
+{
+    reset();
+}
+
+/**
+ * \brief Destroys this RIPEMD-160 hash object after clearing
+ * sensitive information.
+ */
+RIPEMD160::~RIPEMD160()
+{
+    clean(state);
+}
+
+size_t RIPEMD160::hashSize() const
+{
+    return 20;
+}
+
+size_t RIPEMD160::blockSize() const
+{
+    return 64;
+}
+
+void RIPEMD160::reset()
+{
+    state.h[0] = 0x67452301;
+    state.h[1] = 0xefcdab89;
+    state.h[2] = 0x98badcfe;
+    state.h[3] = 0x10325476;
+    state.h[4] = 0xc3d2e1f0;
+    state.chunkSize = 0;
+    state.length = 0;
+}
+
+void RIPEMD160::update(const void *data, size_t len)
+{
+    // Update the total length (in bits, not bytes).
+    state.length += ((uint64_t)len) << 3;
+
+    // Break the input up into 512-bit chunks and process each in turn.
+    const uint8_t *d = (const uint8_t *)data;
+    while (len > 0) {
+        uint8_t size = 64 - state.chunkSize;
+        if (size > len)
+            size = len;
+        memcpy(((uint8_t *)state.w) + state.chunkSize, d, size);
+        state.chunkSize += size;
+        len -= size;
+        d += size;
+        if (state.chunkSize == 64) {
+            processChunk();
+            state.chunkSize = 0;
+        }
+    }
+}
+
+void RIPEMD160::finalize(void *hash, size_t len)
+{
+    // Pad the last chunk.  We may need two padding chunks if there
+    // isn't enough room in the first for the padding and length.
+    // The length is little endian, unlike SHA-256.
+    uint8_t *wbytes = (uint8_t *)state.w;
+    if (state.chunkSize <= (64 - 9)) {
+        wbytes[state.chunkSize] = 0x80;
+        memset(wbytes + state.chunkSize + 1, 0x00, 64 - 8 - (state.chunkSize + 1));
+        state.w[14] = htole32((uint32_t)state.length);
+        state.w[15] = htole32((uint32_t)(state.length >> 32));
+        processChunk();
+    } else {
+        wbytes[state.chunkSize] = 0x80;
+        memset(wbytes + state.chunkSize + 1, 0x00, 64 - (state.chunkSize + 1));
+        processChunk();
+        memset(wbytes, 0x00, 64 - 8);
+        state.w[14] = htole32((uint32_t)state.length);
+        state.w[15] = htole32((uint32_t)(state.length >> 32));
+        processChunk();
+    }
+
+    // Convert the result into little endian and return it.
+    for (uint8_t posn = 0; posn < 5; ++posn)
+        state.w[posn] = htole32(state.h[posn]);
+
+    // Copy the hash to the caller's return buffer.
+    if (len > 20)
+        len = 20;
+    memcpy(hash, state.w, len);
+}
+
+void RIPEMD160::clear()
+{
+    clean(state);
+    reset();
+}
+
+void RIPEMD160::resetHMAC(const void *key, size_t keyLen)
+{
+    formatHMACKey(state.w, key, keyLen, 0x36);
+    state.length += 64 * 8;
+    processChunk();
+}
+
+void RIPEMD160::finalizeHMAC(const void *key, size_t keyLen, void *hash, size_t hashLen)
+{
+    uint8_t temp[20];
+    finalize(temp, sizeof(temp));
+    formatHMACKey(state.w, key, keyLen, 0x5C);
+    state.length += 64 * 8;
+    processChunk();
+    update(temp, sizeof(temp));
+    finalize(hash, hashLen);
+    clean(temp);
+}
+
+void RIPEMD160::hashMany(const Message *msgs, size_t count, uint8_t *out)
+{
+    hashEach<RIPEMD160>(*this, msgs, count, out);
+}
+
+/**
+ * \struct RIPEMD160::State
+ * \brief Saved copy of the internal state of a RIPEMD160 object.
+ *
+ * \sa saveState(), restoreState()
+ */
+
+/**
+ * \brief Copies the hashing state of another RIPEMD160 object into this one.
+ *
+ * \param other The object to copy the state from.
+ *
+ * \sa saveState(), restoreState()
+ */
+void RIPEMD160::copyStateFrom(const RIPEMD160 &other)
+{
+    state = other.state;
+}
+
+/**
+ * \brief Saves the hashing state of this object.
+ *
+ * \param saved Receives the state; clean() it once it is no longer needed.
+ *
+ * \sa restoreState(), copyStateFrom()
+ */
+void RIPEMD160::saveState(State &saved) const
+{
+    saved = state;
+}
+
+/**
+ * \brief Restores a hashing state saved by saveState().
+ *
+ * \param saved The saved state.
+ *
+ * \sa saveState(), copyStateFrom()
+ */
+void RIPEMD160::restoreState(const State &saved)
+{
+    state = saved;
+}
+
+/**
+ * \brief Computes the HASH160 of some data: RIPEMD-160 of its SHA-256 hash.
+ *
+ * \param hash The 20-byte buffer to receive the result.
+ * \param data Points to the data to hash, normally a 33-byte compressed
+ * or 65-byte uncompressed public key.
+ * \param len Length of the \a data in bytes.
+ *
+ * This gives the same result as hashing \a data with SHA256 and then
+ * hashing the 32-byte result with RIPEMD160, but is quicker.  The SHA-256
+ * hash value is written straight into the single RIPEMD-160 block in the
+ * right byte order, with the padding for a 32-byte message already in
+ * place, rather than being serialized and then buffered by update().
+ *
+ * The SHA-256 step uses the CPU's SHA-256 instructions when it has them;
+ * see SHA256::isAccelerated().
+ */
+void RIPEMD160::hash160(void *hash, const void *data, size_t len)
+{
+    SHA256 sha256;
+    RIPEMD160 ripemd;
+
+    // A 33-byte key fits in one SHA-256 block and a 65-byte key in two.
+    sha256.update(data, len);
+    sha256.padChunk();
+
+    // The bytes of the SHA-256 hash are big endian words, which become
+    // the first eight words of the RIPEMD-160 block.  Then the padding
+    // and the bit length of a 32-byte message.
+    for (uint8_t posn = 0; posn < 8; ++posn)
+        ripemd.state.w[posn] = htobe32(sha256.state.h[posn]);
+    ripemd.state.w[8] = htole32(0x00000080);
+    memset(ripemd.state.w + 9, 0, 5 * sizeof(uint32_t));
+    ripemd.state.w[14] = htole32(32 * 8);
+    ripemd.state.w[15] = 0;
+    ripemd.processChunk();
+
+    // Return the RIPEMD-160 hash value in little endian.
+    for (uint8_t posn = 0; posn < 5; ++posn)
+        ripemd.state.h[posn] = htole32(ripemd.state.h[posn]);
+    memcpy(hash, ripemd.state.h, 20);
+}
+
+// Boolean functions for the five rounds.
+#define ripemdF1(x, y, z)   ((x) ^ (y) ^ (z))
+#define ripemdF2(x, y, z)   ((z) ^ ((x) & ((y) ^ (z))))
+#define ripemdF3(x, y, z)   (((x) | ~(y)) ^ (z))
+#define ripemdF4(x, y, z)   ((y) ^ ((z) & ((x) ^ (y))))
+#define ripemdF5(x, y, z)   ((x) ^ ((y) | ~(z)))
+
+// Performs 16 steps of the left and right lines, using the boolean
+// functions "fl" and "fr" and the additive constants "kl" and "kr".
+#define ripemdRound(fl, fr, kl, kr) \
+    do { \
+        for (index = 0; index < 16; ++index, ++step) { \
+            temp = al + fl(bl, cl, dl) + \
+                   state.w[pgm_read_byte(ripemdWordL + step)] + (kl); \
+            temp = leftRotate(temp, pgm_read_byte(ripemdShiftL + step)) + el; \
+            al = el; \
+            el = dl; \
+            dl = leftRotate10(cl); \
+            cl = bl; \
+            bl = temp; \
+            temp = ar + fr(br, cr, dr) + \
+                   state.w[pgm_read_byte(ripemdWordR + step)] + (kr); \
+            temp = leftRotate(temp, pgm_read_byte(ripemdShiftR + step)) + er; \
+            ar = er; \
+            er = dr; \
+            dr = leftRotate10(cr); \
+            cr = br; \
+            br = temp; \
+        } \
+    } while (0)
+
+/**
+ * \brief Processes a single 512-bit chunk with the core RIPEMD-160 algorithm.
+ *
+ * Reference: https://homes.esat.kuleuven.be/~bosselae/ripemd160.html
+ */
+void RIPEMD160::processChunk()
+{
+    // Message word selection and rotation amounts for the left and
+    // right lines, one entry per step.
+    static uint8_t const ripemdWordL[80] PROGMEM = {
+         0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15,
+         7,  4, 13,  1, 10,  6, 15,  3, 12,  0,  9,  5,  2, 14, 11,  8,
+         3, 10, 14,  4,  9, 15,  8,  1,  2,  7,  0,  6, 13, 11,  5, 12,
+         1,  9, 11, 10,  0,  8, 12,  4, 13,  3,  7, 15, 14,  5,  6,  2,
+         4,  0,  5,  9,  7, 12,  2, 10, 14,  1,  3,  8, 11,  6, 15, 13
+    };
+    static uint8_t const ripemdWordR[80] PROGMEM = {
+         5, 14,  7,  0,  9,  2, 11,  4, 13,  6, 15,  8,  1, 10,  3, 12,
+         6, 11,  3,  7,  0, 13,  5, 10, 14, 15,  8, 12,  4,  9,  1,  2,
+        15,  5,  1,  3,  7, 14,  6,  9, 11,  8, 12,  2, 10,  0,  4, 13,
+         8,  6,  4,  1,  3, 11, 15,  0,  5, 12,  2, 13,  9,  7, 10, 14,
+        12, 15, 10,  4,  1,  5,  8,  7,  6,  2, 13, 14,  0,  3,  9, 11
+    };
+    static uint8_t const ripemdShiftL[80] PROGMEM = {
+        11, 14, 15, 12,  5,  8,  7,  9, 11, 13, 14, 15,  6,  7,  9,  8,
+         7,  6,  8, 13, 11,  9,  7, 15,  7, 12, 15,  9, 11,  7, 13, 12,
+        11, 13,  6,  7, 14,  9, 13, 15, 14,  8, 13,  6,  5, 12,  7,  5,
+        11, 12, 14, 15, 14, 15,  9,  8,  9, 14,  5,  6,  8,  6,  5, 12,
+         9, 15,  5, 11,  6,  8, 13, 12,  5, 12, 13, 14, 11,  8,  5,  6
+    };
+    static uint8_t const ripemdShiftR[80] PROGMEM = {
+         8,  9,  9, 11, 13, 15, 15,  5,  7,  7,  8, 11, 14, 14, 12,  6,
+         9, 13, 15,  7, 12,  8,  9, 11,  7,  7, 12,  7,  6, 15, 13, 11,
+         9,  7, 15, 11,  8,  6,  6, 14, 12, 13,  5, 14, 13, 13,  7,  5,
+        15,  5,  8, 11, 14, 14,  6, 14,  6,  9, 12,  9, 12,  5, 15,  8,
+         8,  5, 12,  9, 12,  5, 14,  6,  8, 13,  6,  5, 15, 13, 11, 11
+    };
+
+    // Convert the words from little endian to host byte order.
+    uint8_t index;
+    for (index = 0; index < 16; ++index)
+        state.w[index] = le32toh(state.w[index]);
+
+    // Both lines start from the current hash value.
+    uint32_t al = state.h[0];
+    uint32_t bl = state.h[1];
+    uint32_t cl = state.h[2];
+    uint32_t dl = state.h[3];
+    uint32_t el = state.h[4];
+    uint32_t ar = al;
+    uint32_t br = bl;
+    uint32_t cr = cl;
+    uint32_t dr = dl;
+    uint32_t er = el;
+
+    // Perform the 80 steps of both lines.
+    uint32_t temp;
+    uint8_t step = 0;
+    ripemdRound(ripemdF1, ripemdF5, 0x00000000, 0x50a28be6);
+    ripemdRound(ripemdF2, ripemdF4, 0x5a827999, 0x5c4dd124);
+    ripemdRound(ripemdF3, ripemdF3, 0x6ed9eba1, 0x6d703ef3);
+    ripemdRound(ripemdF4, ripemdF2, 0x8f1bbcdc, 0x7a6d76e9);
+    ripemdRound(ripemdF5, ripemdF1, 0xa953fd4e, 0x00000000);
+
+    // Combine the two lines into the new hash value.
+    temp = state.h[1] + cl + dr;
+    state.h[1] = state.h[2] + dl + er;
+    state.h[2] = state.h[3] + el + ar;
+    state.h[3] = state.h[4] + al + br;
+    state.h[4] = state.h[0] + bl + cr;
+    state.h[0] = temp;
+
+    // Attempt to clean up the stack.
+    al = bl = cl = dl = el = ar = br = cr = dr = er = temp = 0;
+}
@@ -68,3 +68,8 @@ void SHA224::reset()
     state.chunkSize = 0;
     state.length = 0;
 }
+
+void SHA224::hashMany(const Message *msgs, size_t count, uint8_t *out)
+{
+    hashEach<SHA224>(*this, msgs, count, out);
+}
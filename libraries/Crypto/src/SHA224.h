@@ -34,6 +34,8 @@ public:
 
     void reset();
 
+    void hashMany(const Message *msgs, size_t count, uint8_t *out);
+
     static const size_t HASH_SIZE = 28;
 };
 
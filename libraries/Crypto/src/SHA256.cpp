@@ -25,6 +25,9 @@
 #include "utility/RotateUtil.h"
 #include "utility/EndianUtil.h"
 #include "utility/ProgMemUtil.h"
+#include "utility/SHA256Accel.h"
+#include "utility/SHA256Lanes.h"
+#include "utility/CPUFeatures.h"
 #include <string.h>
 
 /**
@@ -33,9 +36,88 @@
  *
  * Reference: http://en.wikipedia.org/wiki/SHA-2
  *
+ * On native x86 and AArch64 builds the compression function uses the
+ * CPU's SHA-256 instructions (Intel SHA extensions or the ARMv8 crypto
+ * extension) when the running CPU has them, and falls back to the
+ * portable implementation otherwise.  The choice is made at runtime,
+ * so one binary works on any CPU of the architecture.
+ *
+ * For Bitcoin-style double hashing, sha256d() and sha256dMany() compute
+ * SHA-256(SHA-256(data)) with a specialized second pass; see sha256d().
+ *
  * \sa SHA224, SHA384, SHA512, SHA3_256, BLAKE2s
  */
 
+#if defined(CRYPTO_SHA256_ACCEL)
+
+// -1 until the CPU has been probed, then 1 if the hardware backend is
+// in use and 0 if not.
+static int8_t sha256Accel = -1;
+
+static inline bool sha256UseAccel()
+{
+    if (sha256Accel < 0)
+        sha256Accel = sha256AccelSupported() ? 1 : 0;
+    return sha256Accel != 0;
+}
+
+#endif
+
+#if defined(CRYPTO_SHA256_LANES_AVX2)
+
+// Multi-buffer hashing only pays off when the SHA-256 instructions
+// are not available to hash each buffer on its own.
+static inline bool sha256UseLanes()
+{
+    return cpuHasFeatures(CRYPTO_CPU_AVX2) && !sha256UseAccel();
+}
+
+#endif
+
+// Round constants for SHA-256, shared with the native backends.  They are
+// read with the SSE and NEON aligned loads when hardware SHA-256 is built.
+#if defined(CRYPTO_SHA256_ACCEL)
+uint32_t const sha256K[64] PROGMEM __attribute__((aligned(16))) = {
+#else
+uint32_t const sha256K[64] PROGMEM = {
+#endif
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+// Initial hash value for SHA-256.
+static uint32_t const sha256IV[8] PROGMEM = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+// Words 8 to 15 of the second block of SHA-256d, which always hashes a
+// 32-byte message: the 0x80 padding marker and a length of 256 bits.
+static uint32_t const sha256dPad[8] PROGMEM = {
+    0x80000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000100
+};
+
+// Round constants plus the padding words for rounds 8 to 15.
+static uint32_t const sha256dPadKW[8] PROGMEM = {
+    0x5807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf274
+};
+
 /**
  * \var SHA256::HASH_SIZE
  * \brief Constant for the size of the hash output of SHA256.
@@ -95,6 +177,16 @@ void SHA256::update(const void *data, size_t len)
     // Break the input up into 512-bit chunks and process each in turn.
     const uint8_t *d = (const uint8_t *)data;
     while (len > 0) {
+#if defined(CRYPTO_SHA256_ACCEL)
+        // Compress whole blocks straight from the caller's buffer.
+        if (state.chunkSize == 0 && len >= 64 && sha256UseAccel()) {
+            size_t blocks = len / 64;
+            sha256AccelCompress(state.h, d, blocks);
+            d += blocks * 64;
+            len -= blocks * 64;
+            continue;
+        }
+#endif
         uint8_t size = 64 - state.chunkSize;
         if (size > len)
             size = len;
@@ -111,24 +203,8 @@ void SHA256::update(const void *data, size_t len)
 
 void SHA256::finalize(void *hash, size_t len)
 {
-    // Pad the last chunk.  We may need two padding chunks if there
-    // isn't enough room in the first for the padding and length.
-    uint8_t *wbytes = (uint8_t *)state.w;
-    if (state.chunkSize <= (64 - 9)) {
-        wbytes[state.chunkSize] = 0x80;
-        memset(wbytes + state.chunkSize + 1, 0x00, 64 - 8 - (state.chunkSize + 1));
-        state.w[14] = htobe32((uint32_t)(state.length >> 32));
-        state.w[15] = htobe32((uint32_t)state.length);
-        processChunk();
-    } else {
-        wbytes[state.chunkSize] = 0x80;
-        memset(wbytes + state.chunkSize + 1, 0x00, 64 - (state.chunkSize + 1));
-        processChunk();
-        memset(wbytes, 0x00, 64 - 8);
-        state.w[14] = htobe32((uint32_t)(state.length >> 32));
-        state.w[15] = htobe32((uint32_t)state.length);
-        processChunk();
-    }
+    // Pad and process the last chunk.
+    padChunk();
 
     // Convert the result into big endian and return it.
     for (uint8_t posn = 0; posn < 8; ++posn)
@@ -166,6 +242,437 @@ void SHA256::finalizeHMAC(const void *key, size_t keyLen, void *hash, size_t has
     clean(temp);
 }
 
+void SHA256::hashMany(const Message *msgs, size_t count, uint8_t *out)
+{
+    hashEach<SHA256>(*this, msgs, count, out);
+}
+
+/**
+ * \struct SHA256::State
+ * \brief Saved copy of the internal state of a SHA256 object.
+ *
+ * \sa saveState(), restoreState()
+ */
+
+/**
+ * \brief Copies the hashing state of another SHA256 object into this one.
+ *
+ * \param other The object to copy the state from.
+ *
+ * This object then carries on from wherever \a other had got to, without
+ * hashing the data again.  Hashing a common prefix once and then copying
+ * it into each message that starts with it saves one compression per
+ * 64 bytes of prefix per message:
+ *
+ * \code
+ * SHA256 prefix;
+ * prefix.update(label, labelLen);
+ *
+ * SHA256 hash;
+ * hash.copyStateFrom(prefix);
+ * hash.update(data, dataLen);
+ * hash.finalize(result, sizeof(result));
+ * \endcode
+ *
+ * \sa saveState(), restoreState()
+ */
+void SHA256::copyStateFrom(const SHA256 &other)
+{
+    state = other.state;
+}
+
+/**
+ * \brief Saves the hashing state of this object.
+ *
+ * \param saved Receives the state.
+ *
+ * Unlike copyStateFrom(), this does not need a second SHA256 object,
+ * only the much smaller State.  The saved state is derived from the data
+ * hashed so far; clean() it once it is no longer needed.
+ *
+ * \sa restoreState(), copyStateFrom()
+ */
+void SHA256::saveState(State &saved) const
+{
+    saved = state;
+}
+
+/**
+ * \brief Restores a hashing state saved by saveState().
+ *
+ * \param saved The saved state.  The same state can be restored any
+ * number of times.
+ *
+ * \sa saveState(), copyStateFrom()
+ */
+void SHA256::restoreState(const State &saved)
+{
+    state = saved;
+}
+
+#define sha256Sigma0(x)  (rightRotate7((x)) ^ rightRotate18((x)) ^ ((x) >> 3))
+#define sha256Sigma1(x)  (rightRotate17((x)) ^ rightRotate19((x)) ^ ((x) >> 10))
+
+// Performs one round of the compression function, with "kw" the round
+// constant plus the message word.
+#define sha256Round(kw) \
+    do { \
+        temp1 = h + (kw) + \
+                (rightRotate6(e) ^ rightRotate11(e) ^ rightRotate25(e)) + \
+                ((e & f) ^ ((~e) & g)); \
+        temp2 = (rightRotate2(a) ^ rightRotate13(a) ^ rightRotate22(a)) + \
+                ((a & b) ^ (a & c) ^ (b & c)); \
+        h = g; \
+        g = f; \
+        f = e; \
+        e = d + temp1; \
+        d = c; \
+        c = b; \
+        b = a; \
+        a = temp1 + temp2; \
+    } while (0)
+
+// Second pass of SHA-256d.  On entry "hash" is the SHA-256 hash of the
+// data in host byte order, and on exit it is the hash of that hash.
+// "w" is scratch space for the message schedule that the caller cleans.
+// Because the message is always 32 bytes, the second half of the block
+// is fixed padding: rounds 8 to 15 use precomputed constants, and the
+// terms of message words 16 to 31 that only depend on padding are folded.
+static void sha256dSecondPass(uint32_t hash[8], uint32_t w[16])
+{
+    uint8_t index;
+
+    for (index = 0; index < 8; ++index)
+        w[index] = hash[index];
+
+    uint32_t a = pgm_read_dword(sha256IV);
+    uint32_t b = pgm_read_dword(sha256IV + 1);
+    uint32_t c = pgm_read_dword(sha256IV + 2);
+    uint32_t d = pgm_read_dword(sha256IV + 3);
+    uint32_t e = pgm_read_dword(sha256IV + 4);
+    uint32_t f = pgm_read_dword(sha256IV + 5);
+    uint32_t g = pgm_read_dword(sha256IV + 6);
+    uint32_t h = pgm_read_dword(sha256IV + 7);
+    uint32_t temp1, temp2;
+
+    // Rounds 0 to 7 on the hash words and 8 to 15 on the padding.
+    for (index = 0; index < 8; ++index)
+        sha256Round(pgm_read_dword(sha256K + index) + w[index]);
+    for (; index < 16; ++index)
+        sha256Round(pgm_read_dword(sha256dPadKW + index - 8));
+
+    // Expand words 16 to 31 in place, leaving out the terms that are zero
+    // and using constants for sigma0(w[8]), sigma0(w[15]) and sigma1(w[15]).
+    w[0] += sha256Sigma0(w[1]);
+    w[1] += sha256Sigma0(w[2]) + 0x00a00000;
+    w[2] += sha256Sigma0(w[3]) + sha256Sigma1(w[0]);
+    w[3] += sha256Sigma0(w[4]) + sha256Sigma1(w[1]);
+    w[4] += sha256Sigma0(w[5]) + sha256Sigma1(w[2]);
+    w[5] += sha256Sigma0(w[6]) + sha256Sigma1(w[3]);
+    w[6] += sha256Sigma0(w[7]) + sha256Sigma1(w[4]) + 0x00000100;
+    w[7] += 0x11002000 + w[0] + sha256Sigma1(w[5]);
+    w[8] = 0x80000000 + w[1] + sha256Sigma1(w[6]);
+    w[9] = w[2] + sha256Sigma1(w[7]);
+    w[10] = w[3] + sha256Sigma1(w[8]);
+    w[11] = w[4] + sha256Sigma1(w[9]);
+    w[12] = w[5] + sha256Sigma1(w[10]);
+    w[13] = w[6] + sha256Sigma1(w[11]);
+    w[14] = 0x00400022 + w[7] + sha256Sigma1(w[12]);
+    w[15] = 0x00000100 + sha256Sigma0(w[0]) + w[8] + sha256Sigma1(w[13]);
+    for (; index < 32; ++index)
+        sha256Round(pgm_read_dword(sha256K + index) + w[index & 0x0F]);
+
+    // The remaining rounds expand the message as usual.
+    for (; index < 64; ++index) {
+        temp1 = w[index & 0x0F] += sha256Sigma0(w[(index - 15) & 0x0F]) +
+                                   w[(index - 7) & 0x0F] +
+                                   sha256Sigma1(w[(index - 2) & 0x0F]);
+        sha256Round(pgm_read_dword(sha256K + index) + temp1);
+    }
+
+    hash[0] = pgm_read_dword(sha256IV) + a;
+    hash[1] = pgm_read_dword(sha256IV + 1) + b;
+    hash[2] = pgm_read_dword(sha256IV + 2) + c;
+    hash[3] = pgm_read_dword(sha256IV + 3) + d;
+    hash[4] = pgm_read_dword(sha256IV + 4) + e;
+    hash[5] = pgm_read_dword(sha256IV + 5) + f;
+    hash[6] = pgm_read_dword(sha256IV + 6) + g;
+    hash[7] = pgm_read_dword(sha256IV + 7) + h;
+
+    // Attempt to clean up the stack.
+    a = b = c = d = e = f = g = h = temp1 = temp2 = 0;
+}
+
+#if defined(CRYPTO_SHA256_ACCEL)
+
+// SHA-256d with the hardware backend.  Both passes compress straight into
+// a local state, so no SHA256 object is set up or cleaned per call.
+static void sha256dAccel(uint8_t *hash, const uint8_t *data, size_t len)
+{
+    uint32_t h[8];
+    uint32_t w[32];
+    size_t blocks = len / 64;
+    size_t tail = len % 64;
+    size_t words = (tail < 56) ? 16 : 32;
+    uint64_t bits = ((uint64_t)len) << 3;
+    uint8_t index;
+
+    // First pass: whole blocks from the caller's buffer, then the padded
+    // tail, which needs a second block if the length does not fit.
+    for (index = 0; index < 8; ++index)
+        h[index] = pgm_read_dword(sha256IV + index);
+    sha256AccelCompress(h, data, blocks);
+    if (tail != 0)
+        memcpy(w, data + blocks * 64, tail);
+    ((uint8_t *)w)[tail] = 0x80;
+    memset(((uint8_t *)w) + tail + 1, 0, words * 4 - 8 - (tail + 1));
+    w[words - 2] = htobe32((uint32_t)(bits >> 32));
+    w[words - 1] = htobe32((uint32_t)bits);
+    sha256AccelCompress(h, (const uint8_t *)w, words / 16);
+
+    // Second pass over the 32-byte hash and its fixed padding.
+    for (index = 0; index < 8; ++index) {
+        w[index] = htobe32(h[index]);
+        w[index + 8] = htobe32(pgm_read_dword(sha256dPad + index));
+        h[index] = pgm_read_dword(sha256IV + index);
+    }
+    sha256AccelCompress(h, (const uint8_t *)w, 1);
+    for (index = 0; index < 8; ++index)
+        w[index] = htobe32(h[index]);
+    memcpy(hash, w, 32);
+
+    clean(h);
+    clean(w, words * 4);
+}
+
+#endif
+
+/**
+ * \brief Computes SHA-256d, the SHA-256 hash of the SHA-256 hash of
+ * some data, as used for Bitcoin transaction and block identifiers.
+ *
+ * \param hash The 32-byte buffer to receive the result.
+ * \param data Points to the data to hash.
+ * \param len Length of the \a data in bytes.
+ *
+ * This gives the same result as two rounds of reset(), update() and
+ * finalize(), but the first hash value is never serialized or buffered.
+ * Its words become the first half of the second block directly, and the
+ * second half of that block is always the same padding for a 32-byte
+ * message.  The portable implementation uses that to precompute rounds
+ * 8 to 15 and part of the message expansion.  With hardware SHA-256,
+ * both passes compress into a local state without a SHA256 object.
+ *
+ * Note that Bitcoin displays transaction and block identifiers with the
+ * bytes of \a hash in reverse order.
+ *
+ * \sa sha256dMany()
+ */
+void SHA256::sha256d(void *hash, const void *data, size_t len)
+{
+#if defined(CRYPTO_SHA256_ACCEL)
+    if (sha256UseAccel()) {
+        sha256dAccel((uint8_t *)hash, (const uint8_t *)data, len);
+        return;
+    }
+#endif
+    SHA256 first;
+    first.update(data, len);
+    first.padChunk();
+    sha256dSecondPass(first.state.h, first.state.w);
+    for (uint8_t posn = 0; posn < 8; ++posn)
+        first.state.w[posn] = htobe32(first.state.h[posn]);
+    memcpy(hash, first.state.w, 32);
+}
+
+#if defined(CRYPTO_SHA256_LANES_AVX2)
+
+// Computes SHA-256d for up to eight messages at once, one per vector lane.
+// Lanes past "count" hash copies of the first message.
+static void sha256dLanes(const Hash::Message *msgs, size_t count, uint8_t *out)
+{
+    uint32_t h[8][8];
+    uint32_t w[16][8];
+    uint8_t tail[8][128];
+    uint8_t lane, index;
+
+    // The first pass hashes the messages side by side if they all have
+    // the same length, which is common for block headers and the nodes
+    // of a Merkle tree.  Otherwise each one is hashed on its own.
+    bool sameLength = true;
+    for (lane = 1; lane < count; ++lane) {
+        if (msgs[lane].len != msgs[0].len)
+            sameLength = false;
+    }
+    if (sameLength) {
+        size_t len = msgs[0].len;
+        size_t full = len & ~((size_t)63);
+        size_t tailLen = len - full;
+        size_t total = full + ((tailLen <= (64 - 9)) ? 64 : 128);
+        uint64_t bits = ((uint64_t)len) << 3;
+        for (lane = 0; lane < 8; ++lane) {
+            const uint8_t *data = (const uint8_t *)(msgs[lane < count ? lane : 0].data);
+            memcpy(tail[lane], data + full, tailLen);
+            tail[lane][tailLen] = 0x80;
+            memset(tail[lane] + tailLen + 1, 0, total - full - tailLen - 1 - 8);
+            for (index = 0; index < 8; ++index)
+                tail[lane][total - full - 1 - index] = (uint8_t)(bits >> (index * 8));
+            for (index = 0; index < 8; ++index)
+                h[index][lane] = pgm_read_dword(sha256IV + index);
+        }
+        for (size_t offset = 0; offset < total; offset += 64) {
+            for (lane = 0; lane < 8; ++lane) {
+                const uint8_t *block;
+                if (offset < full)
+                    block = ((const uint8_t *)(msgs[lane < count ? lane : 0].data)) + offset;
+                else
+                    block = tail[lane] + (offset - full);
+                for (index = 0; index < 16; ++index) {
+                    uint32_t word;
+                    memcpy(&word, block + index * 4, 4);
+                    w[index][lane] = be32toh(word);
+                }
+            }
+            sha256CompressLanes(h, w);
+        }
+        clean(tail);
+    } else {
+        SHA256 first;
+        memset(h, 0, sizeof(h));
+        for (lane = 0; lane < count; ++lane) {
+            first.reset();
+            first.update(msgs[lane].data, msgs[lane].len);
+            first.finalize(w, 32);
+            for (index = 0; index < 8; ++index)
+                h[index][lane] = be32toh(w[0][index]);
+        }
+    }
+
+    // The second pass takes the hash words straight from the first.
+    for (index = 0; index < 8; ++index) {
+        uint32_t pad = pgm_read_dword(sha256dPad + index);
+        uint32_t iv = pgm_read_dword(sha256IV + index);
+        for (lane = 0; lane < 8; ++lane) {
+            w[index][lane] = h[index][lane];
+            w[index + 8][lane] = pad;
+            h[index][lane] = iv;
+        }
+    }
+    sha256CompressLanes(h, w);
+
+    for (lane = 0; lane < count; ++lane) {
+        for (index = 0; index < 8; ++index) {
+            uint32_t word = htobe32(h[index][lane]);
+            memcpy(out + lane * 32 + index * 4, &word, 4);
+        }
+    }
+    clean(h);
+    clean(w);
+}
+
+#endif
+
+/**
+ * \brief Computes SHA-256d for a batch of independent messages.
+ *
+ * \param msgs Array of \a count messages to hash.
+ * \param count Number of messages in the batch.
+ * \param out Buffer that receives the 32-byte hashes, one after the other.
+ *
+ * Each result is the same as sha256d() on that message alone.  On x86
+ * CPU's that have AVX2 but not the SHA extensions, eight messages are
+ * hashed at a time in vector lanes.  The second pass always runs in
+ * lanes, and so does the first pass when all eight messages have the
+ * same length.  Otherwise this is a loop over sha256d().
+ *
+ * \sa sha256d(), hashMany()
+ */
+void SHA256::sha256dMany(const Message *msgs, size_t count, uint8_t *out)
+{
+#if defined(CRYPTO_SHA256_LANES_AVX2)
+    if (count > 1 && sha256UseLanes()) {
+        while (count > 0) {
+            size_t n = count < 8 ? count : 8;
+            sha256dLanes(msgs, n, out);
+            msgs += n;
+            out += n * 32;
+            count -= n;
+        }
+        return;
+    }
+#endif
+    for (size_t posn = 0; posn < count; ++posn)
+        sha256d(out + posn * 32, msgs[posn].data, msgs[posn].len);
+}
+
+/**
+ * \brief Determine if this platform's SHA-256 instructions are being used.
+ *
+ * \return Returns true if SHA256 (and SHA224) objects compress blocks with
+ * the CPU's SHA-256 instructions, or false if the portable implementation
+ * is in use.
+ *
+ * \sa setAccelerated()
+ */
+bool SHA256::isAccelerated()
+{
+#if defined(CRYPTO_SHA256_ACCEL)
+    return sha256UseAccel();
+#else
+    return false;
+#endif
+}
+
+/**
+ * \brief Enables or disables the hardware SHA-256 implementation.
+ *
+ * \param enable Set to true to use the CPU's SHA-256 instructions if it
+ * has them, or false to force the portable implementation.
+ *
+ * \return Returns the new value of isAccelerated(), which is false if
+ * \a enable is true but the CPU lacks the instructions.
+ *
+ * This affects every SHA256 and SHA224 object and is mainly intended for
+ * benchmarking and testing the two implementations against each other.
+ * Do not call it while another thread is hashing.
+ */
+bool SHA256::setAccelerated(bool enable)
+{
+#if defined(CRYPTO_SHA256_ACCEL)
+    sha256Accel = (enable && sha256AccelSupported()) ? 1 : 0;
+    return sha256Accel != 0;
+#else
+    (void)enable;
+    return false;
+#endif
+}
+
+/**
+ * \brief Pads the last chunk of input and processes it, leaving the
+ * final hash value in state.h in host byte order.
+ */
+void SHA256::padChunk()
+{
+    // We may need two padding chunks if there isn't enough room
+    // in the first for the padding and length.
+    uint8_t *wbytes = (uint8_t *)state.w;
+    if (state.chunkSize <= (64 - 9)) {
+        wbytes[state.chunkSize] = 0x80;
+        memset(wbytes + state.chunkSize + 1, 0x00, 64 - 8 - (state.chunkSize + 1));
+        state.w[14] = htobe32((uint32_t)(state.length >> 32));
+        state.w[15] = htobe32((uint32_t)state.length);
+        processChunk();
+    } else {
+        wbytes[state.chunkSize] = 0x80;
+        memset(wbytes + state.chunkSize + 1, 0x00, 64 - (state.chunkSize + 1));
+        processChunk();
+        memset(wbytes, 0x00, 64 - 8);
+        state.w[14] = htobe32((uint32_t)(state.length >> 32));
+        state.w[15] = htobe32((uint32_t)state.length);
+        processChunk();
+    }
+}
+
 /**
  * \brief Processes a single 512-bit chunk with the core SHA-256 algorithm.
  *
@@ -173,25 +680,12 @@ void SHA256::finalizeHMAC(const void *key, size_t keyLen, void *hash, size_t has
  */
 void SHA256::processChunk()
 {
-    // Round constants for SHA-256.
-    static uint32_t const k[64] PROGMEM = {
-        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
-        0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
-        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
-        0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
-        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
-        0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
-        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
-        0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
-        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
-        0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
-        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
-        0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
-        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
-        0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
-        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
-        0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
-    };
+#if defined(CRYPTO_SHA256_ACCEL)
+    if (sha256UseAccel()) {
+        sha256AccelCompress(state.h, (const uint8_t *)state.w, 1);
+        return;
+    }
+#endif
 
     // Convert the first 16 words from big endian to host byte order.
     uint8_t index;
@@ -211,7 +705,7 @@ void SHA256::processChunk()
     // Perform the first 16 rounds of the compression function main loop.
     uint32_t temp1, temp2;
     for (index = 0; index < 16; ++index) {
-        temp1 = h + pgm_read_dword(k + index) + state.w[index] +
+        temp1 = h + pgm_read_dword(sha256K + index) + state.w[index] +
                 (rightRotate6(e) ^ rightRotate11(e) ^ rightRotate25(e)) +
                 ((e & f) ^ ((~e) & g));
         temp2 = (rightRotate2(a) ^ rightRotate13(a) ^ rightRotate22(a)) +
@@ -239,7 +733,7 @@ void SHA256::processChunk()
                 (rightRotate17(temp2) ^ rightRotate19(temp2) ^ (temp2 >> 10));
 
         // Perform the round.
-        temp1 = h + pgm_read_dword(k + index) + temp1 +
+        temp1 = h + pgm_read_dword(sha256K + index) + temp1 +
                 (rightRotate6(e) ^ rightRotate11(e) ^ rightRotate25(e)) +
                 ((e & f) ^ ((~e) & g));
         temp2 = (rightRotate2(a) ^ rightRotate13(a) ^ rightRotate22(a)) +
@@ -43,18 +43,35 @@ public:
     void resetHMAC(const void *key, size_t keyLen);
     void finalizeHMAC(const void *key, size_t keyLen, void *hash, size_t hashLen);
 
+    void hashMany(const Message *msgs, size_t count, uint8_t *out);
+
     static const size_t HASH_SIZE  = 32;
     static const size_t BLOCK_SIZE = 64;
 
-protected:
-    struct {
+    static bool isAccelerated();
+    static bool setAccelerated(bool enable);
+
+    static void sha256d(void *hash, const void *data, size_t len);
+    static void sha256dMany(const Message *msgs, size_t count, uint8_t *out);
+
+    struct State {
         uint32_t h[8];
         uint32_t w[16];
         uint64_t length;
         uint8_t chunkSize;
-    } state;
+    };
 
+    void copyStateFrom(const SHA256 &other);
+    void saveState(State &saved) const;
+    void restoreState(const State &saved);
+
+protected:
+    State state;
+
+    void padChunk();
     void processChunk();
+
+    friend class RIPEMD160;
 };
 
 #endif
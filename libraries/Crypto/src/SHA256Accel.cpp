@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2026 The cryptnox-sdk-arduino contributors.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "utility/SHA256Accel.h"
+#include "utility/CPUFeatures.h"
+
+// Hardware SHA-256 compression functions.  SHA256::processChunk() only
+// calls these after sha256AccelSupported() has returned true.
+
+#if defined(CRYPTO_SHA256_X86)
+
+#include <immintrin.h>
+
+bool sha256AccelSupported()
+{
+    return cpuHasFeatures(CRYPTO_CPU_SHA);
+}
+
+__attribute__((target("sha,sse4.1,ssse3")))
+void sha256AccelCompress(uint32_t h[8], const uint8_t *data, size_t blocks)
+{
+    const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i state0, state1, msg, tmp;
+    __m128i w[4];
+
+    // The rounds instruction wants the state as ABEF and CDGH.
+    tmp = _mm_loadu_si128((const __m128i *)&h[0]);
+    state1 = _mm_loadu_si128((const __m128i *)&h[4]);
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);
+    state1 = _mm_shuffle_epi32(state1, 0x1B);
+    state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    while (blocks > 0) {
+        __m128i abef = state0;
+        __m128i cdgh = state1;
+        uint8_t index;
+
+        // Four rounds per iteration; w[] holds the last 16 schedule words.
+        for (index = 0; index < 16; ++index) {
+            if (index < 4) {
+                msg = _mm_loadu_si128((const __m128i *)(data + index * 16));
+                w[index] = _mm_shuffle_epi8(msg, mask);
+            } else {
+                msg = _mm_sha256msg1_epu32(w[index & 3], w[(index + 1) & 3]);
+                msg = _mm_add_epi32
+                    (msg, _mm_alignr_epi8(w[(index + 3) & 3], w[(index + 2) & 3], 4));
+                w[index & 3] = _mm_sha256msg2_epu32(msg, w[(index + 3) & 3]);
+            }
+            msg = _mm_add_epi32
+                (w[index & 3], _mm_load_si128((const __m128i *)&sha256K[index * 4]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+            msg = _mm_shuffle_epi32(msg, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+        }
+
+        state0 = _mm_add_epi32(state0, abef);
+        state1 = _mm_add_epi32(state1, cdgh);
+        data += 64;
+        --blocks;
+    }
+
+    // Back to ABCD and EFGH.
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+    _mm_storeu_si128((__m128i *)&h[0], state0);
+    _mm_storeu_si128((__m128i *)&h[4], state1);
+}
+
+#elif defined(CRYPTO_SHA256_ARMV8)
+
+#if !defined(__clang__)
+#pragma GCC push_options
+#pragma GCC target("+crypto")
+#endif
+#include <arm_neon.h>
+#if !defined(__clang__)
+#pragma GCC pop_options
+#endif
+#if defined(__linux__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+
+#if defined(__clang__)
+#define SHA256_ACCEL_TARGET __attribute__((target("sha2")))
+#else
+#define SHA256_ACCEL_TARGET __attribute__((target("+crypto")))
+#endif
+
+bool sha256AccelSupported()
+{
+#if defined(__linux__) && defined(HWCAP_SHA2)
+    return (getauxval(AT_HWCAP) & HWCAP_SHA2) != 0;
+#elif defined(__APPLE__) || defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO)
+    return true;
+#else
+    return false;
+#endif
+}
+
+SHA256_ACCEL_TARGET
+void sha256AccelCompress(uint32_t h[8], const uint8_t *data, size_t blocks)
+{
+    uint32x4_t state0 = vld1q_u32(&h[0]);
+    uint32x4_t state1 = vld1q_u32(&h[4]);
+    uint32x4_t w[4];
+    uint32x4_t msg, prev;
+
+    while (blocks > 0) {
+        uint32x4_t abcd = state0;
+        uint32x4_t efgh = state1;
+        uint8_t index;
+
+        // Four rounds per iteration; w[] holds the last 16 schedule words.
+        for (index = 0; index < 16; ++index) {
+            if (index < 4) {
+                w[index] = vreinterpretq_u32_u8
+                    (vrev32q_u8(vld1q_u8(data + index * 16)));
+            } else {
+                w[index & 3] = vsha256su1q_u32
+                    (vsha256su0q_u32(w[index & 3], w[(index + 1) & 3]),
+                     w[(index + 2) & 3], w[(index + 3) & 3]);
+            }
+            msg = vaddq_u32(w[index & 3], vld1q_u32(&sha256K[index * 4]));
+            prev = state0;
+            state0 = vsha256hq_u32(state0, state1, msg);
+            state1 = vsha256h2q_u32(state1, prev, msg);
+        }
+
+        state0 = vaddq_u32(state0, abcd);
+        state1 = vaddq_u32(state1, efgh);
+        data += 64;
+        --blocks;
+    }
+
+    vst1q_u32(&h[0], state0);
+    vst1q_u32(&h[4], state1);
+}
+
+#endif
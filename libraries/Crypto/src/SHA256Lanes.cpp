@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2026 The cryptnox-sdk-arduino contributors.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "utility/SHA256Lanes.h"
+#include "utility/SHA256Accel.h"
+
+// Multi-buffer SHA-256 compression.  See utility/SHA256Lanes.h.
+
+#if defined(CRYPTO_SHA256_LANES_AVX2)
+
+#include <immintrin.h>
+
+#define sha256x8Add(a, b)   (_mm256_add_epi32((a), (b)))
+#define sha256x8Xor(a, b)   (_mm256_xor_si256((a), (b)))
+#define sha256x8Ror(a, n)   \
+    (_mm256_or_si256(_mm256_srli_epi32((a), (n)), \
+                     _mm256_slli_epi32((a), 32 - (n))))
+#define sha256x8Shr(a, n)   (_mm256_srli_epi32((a), (n)))
+
+// Performs one round on all lanes, with "kw" the round constant plus
+// the message word.  The caller rotates the roles of the variables.
+#define sha256x8Round(a, b, c, d, e, f, g, h, kw) \
+    do { \
+        __m256i _t1 = sha256x8Add \
+            (sha256x8Add((h), (kw)), \
+             sha256x8Add(sha256x8Xor(sha256x8Xor(sha256x8Ror((e), 6), \
+                                                 sha256x8Ror((e), 11)), \
+                                     sha256x8Ror((e), 25)), \
+                         sha256x8Xor(_mm256_and_si256((e), (f)), \
+                                     _mm256_andnot_si256((e), (g))))); \
+        __m256i _t2 = sha256x8Add \
+            (sha256x8Xor(sha256x8Xor(sha256x8Ror((a), 2), \
+                                     sha256x8Ror((a), 13)), \
+                         sha256x8Ror((a), 22)), \
+             sha256x8Xor(_mm256_and_si256((a), sha256x8Xor((b), (c))), \
+                         _mm256_and_si256((b), (c)))); \
+        (d) = sha256x8Add((d), _t1); \
+        (h) = sha256x8Add(_t1, _t2); \
+    } while (0)
+
+// Expands message word "t" in place in the 16-word circular buffer "m".
+#define sha256x8Expand(t) \
+    (m[(t) & 15] = sha256x8Add \
+        (sha256x8Add(m[(t) & 15], m[((t) - 7) & 15]), \
+         sha256x8Add(sha256x8Xor(sha256x8Xor(sha256x8Ror(m[((t) - 15) & 15], 7), \
+                                             sha256x8Ror(m[((t) - 15) & 15], 18)), \
+                                 sha256x8Shr(m[((t) - 15) & 15], 3)), \
+                     sha256x8Xor(sha256x8Xor(sha256x8Ror(m[((t) - 2) & 15], 17), \
+                                             sha256x8Ror(m[((t) - 2) & 15], 19)), \
+                                 sha256x8Shr(m[((t) - 2) & 15], 10)))))
+
+#define sha256x8NoExpand(t) ((void)0)
+
+#define sha256x8KW(t) \
+    (sha256x8Add(_mm256_set1_epi32((int)sha256K[(t)]), m[(t) & 15]))
+
+// Eight rounds starting at "t", after which the roles of the variables
+// are back where they started.
+#define sha256x8Rounds8(t, expand) \
+    do { \
+        sha256x8Round(a, b, c, d, e, f, g, h, (expand((t)), sha256x8KW((t)))); \
+        sha256x8Round(h, a, b, c, d, e, f, g, (expand((t) + 1), sha256x8KW((t) + 1))); \
+        sha256x8Round(g, h, a, b, c, d, e, f, (expand((t) + 2), sha256x8KW((t) + 2))); \
+        sha256x8Round(f, g, h, a, b, c, d, e, (expand((t) + 3), sha256x8KW((t) + 3))); \
+        sha256x8Round(e, f, g, h, a, b, c, d, (expand((t) + 4), sha256x8KW((t) + 4))); \
+        sha256x8Round(d, e, f, g, h, a, b, c, (expand((t) + 5), sha256x8KW((t) + 5))); \
+        sha256x8Round(c, d, e, f, g, h, a, b, (expand((t) + 6), sha256x8KW((t) + 6))); \
+        sha256x8Round(b, c, d, e, f, g, h, a, (expand((t) + 7), sha256x8KW((t) + 7))); \
+    } while (0)
+
+__attribute__((target("avx2")))
+void sha256CompressLanes(uint32_t state[8][8], const uint32_t block[16][8])
+{
+    __m256i hv[8];
+    __m256i m[16];
+    __m256i a, b, c, d, e, f, g, h;
+    uint8_t index;
+
+    for (index = 0; index < 8; ++index)
+        hv[index] = _mm256_loadu_si256((const __m256i *)state[index]);
+    for (index = 0; index < 16; ++index)
+        m[index] = _mm256_loadu_si256((const __m256i *)block[index]);
+    a = hv[0];
+    b = hv[1];
+    c = hv[2];
+    d = hv[3];
+    e = hv[4];
+    f = hv[5];
+    g = hv[6];
+    h = hv[7];
+
+    sha256x8Rounds8(0, sha256x8NoExpand);
+    sha256x8Rounds8(8, sha256x8NoExpand);
+    for (index = 16; index < 64; index += 8)
+        sha256x8Rounds8(index, sha256x8Expand);
+
+    hv[0] = sha256x8Add(hv[0], a);
+    hv[1] = sha256x8Add(hv[1], b);
+    hv[2] = sha256x8Add(hv[2], c);
+    hv[3] = sha256x8Add(hv[3], d);
+    hv[4] = sha256x8Add(hv[4], e);
+    hv[5] = sha256x8Add(hv[5], f);
+    hv[6] = sha256x8Add(hv[6], g);
+    hv[7] = sha256x8Add(hv[7], h);
+    for (index = 0; index < 8; ++index)
+        _mm256_storeu_si256((__m256i *)state[index], hv[index]);
+}
+
+#endif
@@ -22,6 +22,47 @@
 
 #include "SHA3.h"
 #include "Crypto.h"
+#include "utility/KeccakLanes.h"
+
+#if defined(CRYPTO_KECCAK_LANES)
+
+// Number of equal-length messages that are hashed in lockstep.
+#define SHA3_LANES 4
+
+// Hashes runs of equal-length messages side by side.  "core" is the
+// caller's own sponge, used as the first lane; the other lanes are local.
+static void sha3HashMany(KeccakCore &core, size_t capacity,
+                         const Hash::Message *msgs, size_t count,
+                         uint8_t *out, size_t hashSize)
+{
+    KeccakCore extra[SHA3_LANES - 1];
+    KeccakCore *cores[SHA3_LANES];
+    const void *data[SHA3_LANES];
+    void *hashes[SHA3_LANES];
+    cores[0] = &core;
+    for (uint8_t index = 1; index < SHA3_LANES; ++index) {
+        extra[index - 1].setCapacity(capacity);
+        cores[index] = &(extra[index - 1]);
+    }
+    while (count > 0) {
+        size_t n = 1;
+        while (n < SHA3_LANES && n < count && msgs[n].len == msgs[0].len)
+            ++n;
+        for (size_t index = 0; index < n; ++index) {
+            cores[index]->reset();
+            data[index] = msgs[index].data;
+            hashes[index] = out + index * hashSize;
+        }
+        KeccakCore::updateMany(cores, data, msgs[0].len, n);
+        KeccakCore::padMany(cores, 0x06, n);
+        KeccakCore::extractMany(cores, hashes, hashSize, n);
+        msgs += n;
+        out += n * hashSize;
+        count -= n;
+    }
+}
+
+#endif
 
 /**
  * \class SHA3_256 SHA3.h <SHA3.h>
@@ -105,6 +146,59 @@ void SHA3_256::finalizeHMAC(const void *key, size_t keyLen, void *hash, size_t h
     clean(temp);
 }
 
+void SHA3_256::hashMany(const Message *msgs, size_t count, uint8_t *out)
+{
+#if defined(CRYPTO_KECCAK_LANES)
+    // Consecutive messages of the same length are hashed in lockstep.
+    sha3HashMany(core, 512, msgs, count, out, 32);
+#else
+    hashEach<SHA3_256>(*this, msgs, count, out);
+#endif
+}
+
+/**
+ * \typedef SHA3_256::State
+ * \brief Saved copy of the internal state of a SHA3_256 object.
+ *
+ * \sa saveState(), restoreState()
+ */
+
+/**
+ * \brief Copies the hashing state of another SHA3-256 object into this one.
+ *
+ * \param other The object to copy the state from.
+ *
+ * \sa saveState(), restoreState(), KeccakCore::copyStateFrom()
+ */
+void SHA3_256::copyStateFrom(const SHA3_256 &other)
+{
+    core.copyStateFrom(other.core);
+}
+
+/**
+ * \brief Saves the hashing state of this object.
+ *
+ * \param saved Receives the state; clean() it once it is no longer needed.
+ *
+ * \sa restoreState(), copyStateFrom()
+ */
+void SHA3_256::saveState(State &saved) const
+{
+    core.saveState(saved);
+}
+
+/**
+ * \brief Restores a hashing state saved by saveState().
+ *
+ * \param saved The saved state.
+ *
+ * \sa saveState(), copyStateFrom()
+ */
+void SHA3_256::restoreState(const State &saved)
+{
+    core.restoreState(saved);
+}
+
 /**
  * \class SHA3_512 SHA3.h <SHA3.h>
  * \brief SHA3-512 hash algorithm.
@@ -186,3 +280,56 @@ void SHA3_512::finalizeHMAC(const void *key, size_t keyLen, void *hash, size_t h
     finalize(hash, hashLen);
     clean(temp);
 }
+
+void SHA3_512::hashMany(const Message *msgs, size_t count, uint8_t *out)
+{
+#if defined(CRYPTO_KECCAK_LANES)
+    // Consecutive messages of the same length are hashed in lockstep.
+    sha3HashMany(core, 1024, msgs, count, out, 64);
+#else
+    hashEach<SHA3_512>(*this, msgs, count, out);
+#endif
+}
+
+/**
+ * \typedef SHA3_512::State
+ * \brief Saved copy of the internal state of a SHA3_512 object.
+ *
+ * \sa saveState(), restoreState()
+ */
+
+/**
+ * \brief Copies the hashing state of another SHA3-512 object into this one.
+ *
+ * \param other The object to copy the state from.
+ *
+ * \sa saveState(), restoreState(), KeccakCore::copyStateFrom()
+ */
+void SHA3_512::copyStateFrom(const SHA3_512 &other)
+{
+    core.copyStateFrom(other.core);
+}
+
+/**
+ * \brief Saves the hashing state of this object.
+ *
+ * \param saved Receives the state; clean() it once it is no longer needed.
+ *
+ * \sa restoreState(), copyStateFrom()
+ */
+void SHA3_512::saveState(State &saved) const
+{
+    core.saveState(saved);
+}
+
+/**
+ * \brief Restores a hashing state saved by saveState().
+ *
+ * \param saved The saved state.
+ *
+ * \sa saveState(), copyStateFrom()
+ */
+void SHA3_512::restoreState(const State &saved)
+{
+    core.restoreState(saved);
+}
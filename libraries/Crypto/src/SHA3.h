@@ -44,9 +44,17 @@ public:
     void resetHMAC(const void *key, size_t keyLen);
     void finalizeHMAC(const void *key, size_t keyLen, void *hash, size_t hashLen);
 
+    void hashMany(const Message *msgs, size_t count, uint8_t *out);
+
     static const size_t HASH_SIZE  = 32;
     static const size_t BLOCK_SIZE = 136;
 
+    typedef KeccakCore::State State;
+
+    void copyStateFrom(const SHA3_256 &other);
+    void saveState(State &saved) const;
+    void restoreState(const State &saved);
+
 private:
     KeccakCore core;
 };
@@ -69,9 +77,17 @@ public:
     void resetHMAC(const void *key, size_t keyLen);
     void finalizeHMAC(const void *key, size_t keyLen, void *hash, size_t hashLen);
 
+    void hashMany(const Message *msgs, size_t count, uint8_t *out);
+
     static const size_t HASH_SIZE  = 64;
     static const size_t BLOCK_SIZE = 72;
 
+    typedef KeccakCore::State State;
+
+    void copyStateFrom(const SHA3_512 &other);
+    void saveState(State &saved) const;
+    void restoreState(const State &saved);
+
 private:
     KeccakCore core;
 };
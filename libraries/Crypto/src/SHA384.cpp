@@ -69,3 +69,8 @@ void SHA384::reset()
     state.lengthLow = 0;
     state.lengthHigh = 0;
 }
+
+void SHA384::hashMany(const Message *msgs, size_t count, uint8_t *out)
+{
+    hashEach<SHA384>(*this, msgs, count, out);
+}
@@ -25,6 +25,8 @@
 #include "utility/RotateUtil.h"
 #include "utility/EndianUtil.h"
 #include "utility/ProgMemUtil.h"
+#include "utility/SHA512Accel.h"
+#include "utility/CPUFeatures.h"
 #include <string.h>
 
 /**
@@ -33,6 +35,10 @@
  *
  * Reference: http://en.wikipedia.org/wiki/SHA-2
  *
+ * To hash many independent messages at once, use hashParallel() or
+ * hashMany().  On x86 CPUs with AVX2 they run four messages side by side
+ * in vector lanes.
+ *
  * \sa SHA224, SHA256, SHA3_512, BLAKE2b
  */
 
@@ -46,6 +52,44 @@
  * \brief Constant for the block size of SHA512.
  */
 
+// Initial hash value for SHA-512.
+static uint64_t const hashStart[8] PROGMEM = {
+    0x6A09E667F3BCC908ULL, 0xBB67AE8584CAA73BULL, 0x3C6EF372FE94F82BULL,
+    0xA54FF53A5F1D36F1ULL, 0x510E527FADE682D1ULL, 0x9B05688C2B3E6C1FULL,
+    0x1F83D9ABFB41BD6BULL, 0x5BE0CD19137E2179ULL
+};
+
+// Round constants for SHA-512.
+static uint64_t const k[80] PROGMEM = {
+    0x428A2F98D728AE22ULL, 0x7137449123EF65CDULL, 0xB5C0FBCFEC4D3B2FULL,
+    0xE9B5DBA58189DBBCULL, 0x3956C25BF348B538ULL, 0x59F111F1B605D019ULL,
+    0x923F82A4AF194F9BULL, 0xAB1C5ED5DA6D8118ULL, 0xD807AA98A3030242ULL,
+    0x12835B0145706FBEULL, 0x243185BE4EE4B28CULL, 0x550C7DC3D5FFB4E2ULL,
+    0x72BE5D74F27B896FULL, 0x80DEB1FE3B1696B1ULL, 0x9BDC06A725C71235ULL,
+    0xC19BF174CF692694ULL, 0xE49B69C19EF14AD2ULL, 0xEFBE4786384F25E3ULL,
+    0x0FC19DC68B8CD5B5ULL, 0x240CA1CC77AC9C65ULL, 0x2DE92C6F592B0275ULL,
+    0x4A7484AA6EA6E483ULL, 0x5CB0A9DCBD41FBD4ULL, 0x76F988DA831153B5ULL,
+    0x983E5152EE66DFABULL, 0xA831C66D2DB43210ULL, 0xB00327C898FB213FULL,
+    0xBF597FC7BEEF0EE4ULL, 0xC6E00BF33DA88FC2ULL, 0xD5A79147930AA725ULL,
+    0x06CA6351E003826FULL, 0x142929670A0E6E70ULL, 0x27B70A8546D22FFCULL,
+    0x2E1B21385C26C926ULL, 0x4D2C6DFC5AC42AEDULL, 0x53380D139D95B3DFULL,
+    0x650A73548BAF63DEULL, 0x766A0ABB3C77B2A8ULL, 0x81C2C92E47EDAEE6ULL,
+    0x92722C851482353BULL, 0xA2BFE8A14CF10364ULL, 0xA81A664BBC423001ULL,
+    0xC24B8B70D0F89791ULL, 0xC76C51A30654BE30ULL, 0xD192E819D6EF5218ULL,
+    0xD69906245565A910ULL, 0xF40E35855771202AULL, 0x106AA07032BBD1B8ULL,
+    0x19A4C116B8D2D0C8ULL, 0x1E376C085141AB53ULL, 0x2748774CDF8EEB99ULL,
+    0x34B0BCB5E19B48A8ULL, 0x391C0CB3C5C95A63ULL, 0x4ED8AA4AE3418ACBULL,
+    0x5B9CCA4F7763E373ULL, 0x682E6FF3D6B2B8A3ULL, 0x748F82EE5DEFB2FCULL,
+    0x78A5636F43172F60ULL, 0x84C87814A1F0AB72ULL, 0x8CC702081A6439ECULL,
+    0x90BEFFFA23631E28ULL, 0xA4506CEBDE82BDE9ULL, 0xBEF9A3F7B2C67915ULL,
+    0xC67178F2E372532BULL, 0xCA273ECEEA26619CULL, 0xD186B8C721C0C207ULL,
+    0xEADA7DD6CDE0EB1EULL, 0xF57D4F7FEE6ED178ULL, 0x06F067AA72176FBAULL,
+    0x0A637DC5A2C898A6ULL, 0x113F9804BEF90DAEULL, 0x1B710B35131C471BULL,
+    0x28DB77F523047D84ULL, 0x32CAAB7B40C72493ULL, 0x3C9EBE0A15C9BEBCULL,
+    0x431D67C49C100D4CULL, 0x4CC5D4BECB3E42B6ULL, 0x597F299CFC657E2AULL,
+    0x5FCB6FAB3AD6FAECULL, 0x6C44198C4A475817ULL
+};
+
 /**
  * \brief Constructs a SHA-512 hash object.
  */
@@ -75,11 +119,6 @@ size_t SHA512::blockSize() const
 
 void SHA512::reset()
 {
-    static uint64_t const hashStart[8] PROGMEM = {
-        0x6A09E667F3BCC908ULL, 0xBB67AE8584CAA73BULL, 0x3C6EF372FE94F82BULL,
-        0xA54FF53A5F1D36F1ULL, 0x510E527FADE682D1ULL, 0x9B05688C2B3E6C1FULL,
-        0x1F83D9ABFB41BD6BULL, 0x5BE0CD19137E2179ULL
-    };
     memcpy_P(state.h, hashStart, sizeof(hashStart));
     state.chunkSize = 0;
     state.lengthLow = 0;
@@ -169,6 +208,211 @@ void SHA512::finalizeHMAC(const void *key, size_t keyLen, void *hash, size_t has
     clean(temp);
 }
 
+#if defined(CRYPTO_SHA512_SIMD_SCHEDULE) || defined(CRYPTO_SHA512_LANES_AVX2)
+
+// Like clean(), but a word at a time.  clean() works a byte at a time,
+// which costs more than the vector code saves on these larger buffers.
+static void sha512Scrub(void *data, size_t size)
+{
+    volatile uint64_t *d = (volatile uint64_t *)data;
+    while (size >= 8) {
+        *d++ = 0;
+        size -= 8;
+    }
+    clean((void *)d, size);
+}
+
+#endif
+
+#if defined(CRYPTO_SHA512_LANES_AVX2)
+
+// Progress of one message through a lane of sha512CompressLanes().
+struct SHA512Lane
+{
+    const uint8_t *data;    // Message being hashed, which may be NULL if empty
+    bool idle;              // True once the batch has no message for the lane
+    size_t index;           // Position of the message in the batch
+    size_t fullBlocks;      // Number of whole blocks read from "data"
+    size_t block;           // Next block to compress
+    size_t totalBlocks;     // fullBlocks plus the 1 or 2 padding blocks
+    uint8_t tail[256];      // Last partial block with padding and length
+};
+
+// Loads the next message of the batch into a lane, or idles the lane.
+static void sha512StartLane(SHA512Lane &lane, uint64_t h[8][SHA512_LANES],
+                            uint8_t posn, const Hash::Message *msgs,
+                            size_t &next, size_t count)
+{
+    if (next >= count) {
+        lane.idle = true;
+        return;
+    }
+    size_t len = msgs[next].len;
+    size_t rem = len % 128;
+    size_t tailSize = (rem <= (128 - 17)) ? 128 : 256;
+    lane.data = (const uint8_t *)(msgs[next].data);
+    lane.idle = false;
+    lane.index = next++;
+    lane.fullBlocks = len / 128;
+    lane.block = 0;
+    lane.totalBlocks = lane.fullBlocks + tailSize / 128;
+    if (rem != 0)
+        memcpy(lane.tail, lane.data + lane.fullBlocks * 128, rem);
+    lane.tail[rem] = 0x80;
+    memset(lane.tail + rem + 1, 0, tailSize - 16 - (rem + 1));
+    uint64_t bits = htobe64(((uint64_t)len) >> 61);
+    memcpy(lane.tail + tailSize - 16, &bits, 8);
+    bits = htobe64(((uint64_t)len) << 3);
+    memcpy(lane.tail + tailSize - 8, &bits, 8);
+    for (uint8_t i = 0; i < 8; ++i)
+        h[i][posn] = hashStart[i];
+}
+
+// Hashes a batch four messages at a time, refilling each lane from the
+// batch as soon as its message is done so unequal lengths share the work.
+static void sha512HashLanes(uint8_t *out, const Hash::Message *msgs,
+                            size_t count)
+{
+    static uint8_t const idleBlock[128] = {0};
+    uint64_t h[8][SHA512_LANES];
+    SHA512Lane lanes[SHA512_LANES];
+    const uint8_t *blocks[SHA512_LANES];
+    size_t next = 0;
+    uint8_t posn;
+    bool active = true;
+
+    for (posn = 0; posn < SHA512_LANES; ++posn)
+        sha512StartLane(lanes[posn], h, posn, msgs, next, count);
+
+    while (active) {
+        for (posn = 0; posn < SHA512_LANES; ++posn) {
+            SHA512Lane &lane = lanes[posn];
+            if (lane.idle)
+                blocks[posn] = idleBlock;
+            else if (lane.block < lane.fullBlocks)
+                blocks[posn] = lane.data + lane.block * 128;
+            else
+                blocks[posn] = lane.tail + (lane.block - lane.fullBlocks) * 128;
+        }
+        sha512CompressLanes(h, blocks, k);
+
+        active = false;
+        for (posn = 0; posn < SHA512_LANES; ++posn) {
+            SHA512Lane &lane = lanes[posn];
+            if (lane.idle)
+                continue;
+            if (++lane.block == lane.totalBlocks) {
+                uint8_t *hash = out + lane.index * 64;
+                for (uint8_t i = 0; i < 8; ++i) {
+                    uint64_t word = htobe64(h[i][posn]);
+                    memcpy(hash + i * 8, &word, 8);
+                }
+                sha512StartLane(lane, h, posn, msgs, next, count);
+            }
+            if (!lane.idle)
+                active = true;
+        }
+    }
+
+    sha512Scrub(h, sizeof(h));
+    sha512Scrub(lanes, sizeof(lanes));
+}
+
+#endif
+
+/**
+ * \brief Hashes a batch of independent messages with SHA-512.
+ *
+ * \param hashes Points to the output buffer, which receives the 64-byte
+ * hash of message i at offset i * 64.
+ * \param data Array of \a count pointers to the messages.
+ * \param lens Array of \a count message lengths in bytes.
+ * \param count Number of messages in the batch.
+ *
+ * This is hashMany() for callers that keep the message pointers and
+ * lengths in separate arrays.  The result is the same as hashing each
+ * message with its own reset(), update() and finalize() sequence.
+ *
+ * \sa hashMany()
+ */
+void SHA512::hashParallel(void *hashes, const void *const *data,
+                          const size_t *lens, size_t count)
+{
+    Message msgs[16];
+    SHA512 hash;
+    uint8_t *out = (uint8_t *)hashes;
+    while (count > 0) {
+        size_t batch = (count < 16) ? count : 16;
+        for (size_t posn = 0; posn < batch; ++posn) {
+            msgs[posn].data = data[posn];
+            msgs[posn].len = lens[posn];
+        }
+        hash.hashMany(msgs, batch, out);
+        data += batch;
+        lens += batch;
+        out += batch * 64;
+        count -= batch;
+    }
+}
+
+void SHA512::hashMany(const Message *msgs, size_t count, uint8_t *out)
+{
+#if defined(CRYPTO_SHA512_LANES_AVX2)
+    if (count > 1 && cpuHasFeatures(CRYPTO_CPU_AVX2)) {
+        sha512HashLanes(out, msgs, count);
+        return;
+    }
+#endif
+    hashEach<SHA512>(*this, msgs, count, out);
+}
+
+/**
+ * \struct SHA512::State
+ * \brief Saved copy of the internal state of a SHA512 object.
+ *
+ * \sa saveState(), restoreState()
+ */
+
+/**
+ * \brief Copies the hashing state of another SHA512 object into this one.
+ *
+ * \param other The object to copy the state from.
+ *
+ * This object then carries on from wherever \a other had got to, so a
+ * prefix that many messages share only needs to be hashed once.
+ *
+ * \sa saveState(), restoreState()
+ */
+void SHA512::copyStateFrom(const SHA512 &other)
+{
+    state = other.state;
+}
+
+/**
+ * \brief Saves the hashing state of this object.
+ *
+ * \param saved Receives the state.  It is derived from the data hashed
+ * so far, so clean() it once it is no longer needed.
+ *
+ * \sa restoreState(), copyStateFrom()
+ */
+void SHA512::saveState(State &saved) const
+{
+    saved = state;
+}
+
+/**
+ * \brief Restores a hashing state saved by saveState().
+ *
+ * \param saved The saved state, which may be restored any number of times.
+ *
+ * \sa saveState(), copyStateFrom()
+ */
+void SHA512::restoreState(const State &saved)
+{
+    state = saved;
+}
+
 /**
  * \brief Processes a single 1024-bit chunk with the core SHA-512 algorithm.
  *
@@ -176,37 +420,6 @@ void SHA512::finalizeHMAC(const void *key, size_t keyLen, void *hash, size_t has
  */
 void SHA512::processChunk()
 {
-    // Round constants for SHA-512.
-    static uint64_t const k[80] PROGMEM = {
-        0x428A2F98D728AE22ULL, 0x7137449123EF65CDULL, 0xB5C0FBCFEC4D3B2FULL,
-        0xE9B5DBA58189DBBCULL, 0x3956C25BF348B538ULL, 0x59F111F1B605D019ULL,
-        0x923F82A4AF194F9BULL, 0xAB1C5ED5DA6D8118ULL, 0xD807AA98A3030242ULL,
-        0x12835B0145706FBEULL, 0x243185BE4EE4B28CULL, 0x550C7DC3D5FFB4E2ULL,
-        0x72BE5D74F27B896FULL, 0x80DEB1FE3B1696B1ULL, 0x9BDC06A725C71235ULL,
-        0xC19BF174CF692694ULL, 0xE49B69C19EF14AD2ULL, 0xEFBE4786384F25E3ULL,
-        0x0FC19DC68B8CD5B5ULL, 0x240CA1CC77AC9C65ULL, 0x2DE92C6F592B0275ULL,
-        0x4A7484AA6EA6E483ULL, 0x5CB0A9DCBD41FBD4ULL, 0x76F988DA831153B5ULL,
-        0x983E5152EE66DFABULL, 0xA831C66D2DB43210ULL, 0xB00327C898FB213FULL,
-        0xBF597FC7BEEF0EE4ULL, 0xC6E00BF33DA88FC2ULL, 0xD5A79147930AA725ULL,
-        0x06CA6351E003826FULL, 0x142929670A0E6E70ULL, 0x27B70A8546D22FFCULL,
-        0x2E1B21385C26C926ULL, 0x4D2C6DFC5AC42AEDULL, 0x53380D139D95B3DFULL,
-        0x650A73548BAF63DEULL, 0x766A0ABB3C77B2A8ULL, 0x81C2C92E47EDAEE6ULL,
-        0x92722C851482353BULL, 0xA2BFE8A14CF10364ULL, 0xA81A664BBC423001ULL,
-        0xC24B8B70D0F89791ULL, 0xC76C51A30654BE30ULL, 0xD192E819D6EF5218ULL,
-        0xD69906245565A910ULL, 0xF40E35855771202AULL, 0x106AA07032BBD1B8ULL,
-        0x19A4C116B8D2D0C8ULL, 0x1E376C085141AB53ULL, 0x2748774CDF8EEB99ULL,
-        0x34B0BCB5E19B48A8ULL, 0x391C0CB3C5C95A63ULL, 0x4ED8AA4AE3418ACBULL,
-        0x5B9CCA4F7763E373ULL, 0x682E6FF3D6B2B8A3ULL, 0x748F82EE5DEFB2FCULL,
-        0x78A5636F43172F60ULL, 0x84C87814A1F0AB72ULL, 0x8CC702081A6439ECULL,
-        0x90BEFFFA23631E28ULL, 0xA4506CEBDE82BDE9ULL, 0xBEF9A3F7B2C67915ULL,
-        0xC67178F2E372532BULL, 0xCA273ECEEA26619CULL, 0xD186B8C721C0C207ULL,
-        0xEADA7DD6CDE0EB1EULL, 0xF57D4F7FEE6ED178ULL, 0x06F067AA72176FBAULL,
-        0x0A637DC5A2C898A6ULL, 0x113F9804BEF90DAEULL, 0x1B710B35131C471BULL,
-        0x28DB77F523047D84ULL, 0x32CAAB7B40C72493ULL, 0x3C9EBE0A15C9BEBCULL,
-        0x431D67C49C100D4CULL, 0x4CC5D4BECB3E42B6ULL, 0x597F299CFC657E2AULL,
-        0x5FCB6FAB3AD6FAECULL, 0x6C44198C4A475817ULL
-    };
-
     // Convert the first 16 words from big endian to host byte order.
     uint8_t index;
     for (index = 0; index < 16; ++index)
@@ -222,6 +435,30 @@ void SHA512::processChunk()
     uint64_t g = state.h[6];
     uint64_t h = state.h[7];
 
+#if defined(CRYPTO_SHA512_SIMD_SCHEDULE)
+    // Expand the whole schedule two words at a time with the vector unit,
+    // leaving the rounds with one load per round instead of a serial
+    // expansion step.
+    uint64_t wk[80];
+    uint64_t temp1, temp2;
+    sha512ExpandSchedule(wk, state.w, k);
+    for (index = 0; index < 80; ++index) {
+        temp1 = h + wk[index] +
+                (rightRotate14_64(e) ^ rightRotate18_64(e) ^
+                 rightRotate41_64(e)) + ((e & f) ^ ((~e) & g));
+        temp2 = (rightRotate28_64(a) ^ rightRotate34_64(a) ^
+                 rightRotate39_64(a)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g;
+        g = f;
+        f = e;
+        e = d + temp1;
+        d = c;
+        c = b;
+        b = a;
+        a = temp1 + temp2;
+    }
+    sha512Scrub(wk, sizeof(wk));
+#else
     // Perform the first 16 rounds of the compression function main loop.
     uint64_t temp1, temp2;
     for (index = 0; index < 16; ++index) {
@@ -270,6 +507,8 @@ void SHA512::processChunk()
         a = temp1 + temp2;
     }
 
+#endif
+
     // Add the compressed chunk to the current hash value.
     state.h[0] += a;
     state.h[1] += b;
@@ -45,17 +45,28 @@ public:
     void resetHMAC(const void *key, size_t keyLen);
     void finalizeHMAC(const void *key, size_t keyLen, void *hash, size_t hashLen);
 
+    void hashMany(const Message *msgs, size_t count, uint8_t *out);
+
     static const size_t HASH_SIZE  = 64;
     static const size_t BLOCK_SIZE = 128;
 
-protected:
-    struct {
+    static void hashParallel(void *hashes, const void *const *data,
+                             const size_t *lens, size_t count);
+
+    struct State {
         uint64_t h[8];
         uint64_t w[16];
         uint64_t lengthLow;
         uint64_t lengthHigh;
         uint8_t chunkSize;
-    } state;
+    };
+
+    void copyStateFrom(const SHA512 &other);
+    void saveState(State &saved) const;
+    void restoreState(const State &saved);
+
+protected:
+    State state;
 
     void processChunk();
 
@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2026 The cryptnox-sdk-arduino contributors.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "utility/SHA512Accel.h"
+
+// SIMD helpers for SHA512.  See utility/SHA512Accel.h.
+
+#if defined(CRYPTO_SHA512_SIMD_SCHEDULE)
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <emmintrin.h>
+
+typedef __m128i sha512x2_t;
+
+#define sha512x2Load(p)         (_mm_loadu_si128((const __m128i *)(p)))
+#define sha512x2Mid(a, b)       \
+    (_mm_castpd_si128(_mm_shuffle_pd(_mm_castsi128_pd((a)), \
+                                     _mm_castsi128_pd((b)), 1)))
+#define sha512x2Store(p, x)     (_mm_storeu_si128((__m128i *)(p), (x)))
+#define sha512x2Add(a, b)       (_mm_add_epi64((a), (b)))
+#define sha512x2Xor(a, b)       (_mm_xor_si128((a), (b)))
+#define sha512x2Shr(a, n)       (_mm_srli_epi64((a), (n)))
+#define sha512x2Ror(a, n)       \
+    (_mm_or_si128(_mm_srli_epi64((a), (n)), _mm_slli_epi64((a), 64 - (n))))
+
+#else // __aarch64__
+
+#include <arm_neon.h>
+
+typedef uint64x2_t sha512x2_t;
+
+#define sha512x2Load(p)         (vld1q_u64((p)))
+#define sha512x2Mid(a, b)       (vextq_u64((a), (b), 1))
+#define sha512x2Store(p, x)     (vst1q_u64((p), (x)))
+#define sha512x2Add(a, b)       (vaddq_u64((a), (b)))
+#define sha512x2Xor(a, b)       (veorq_u64((a), (b)))
+#define sha512x2Shr(a, n)       (vshrq_n_u64((a), (n)))
+#define sha512x2Ror(a, n)       \
+    (vsriq_n_u64(vshlq_n_u64((a), 64 - (n)), (a), (n)))
+
+#endif
+
+void sha512ExpandSchedule(uint64_t wk[80], const uint64_t w[16],
+                          const uint64_t k[80])
+{
+    // x[i] holds schedule words 2i and 2i + 1 modulo 16.  The words that
+    // straddle two pairs are assembled with sha512x2Mid() rather than
+    // reloaded from memory, which would stall on store forwarding.
+    sha512x2_t x[8];
+    uint8_t index;
+
+    for (index = 0; index < 8; ++index) {
+        x[index] = sha512x2Load(w + index * 2);
+        sha512x2Store(wk + index * 2,
+                      sha512x2Add(x[index], sha512x2Load(k + index * 2)));
+    }
+
+    // Two words at a time: W[t + 1] needs W[t - 1] but not W[t].  The
+    // loop is unrolled so that x[] can live in registers.
+#define SHA512_EXPAND(i) \
+    do { \
+        sha512x2_t s0 = sha512x2Mid(x[(i)], x[((i) + 1) & 7]); \
+        sha512x2_t s1 = x[((i) + 7) & 7]; \
+        sha512x2_t v = sha512x2Mid(x[((i) + 4) & 7], x[((i) + 5) & 7]); \
+        s0 = sha512x2Xor(sha512x2Xor(sha512x2Ror(s0, 1), sha512x2Ror(s0, 8)), \
+                         sha512x2Shr(s0, 7)); \
+        s1 = sha512x2Xor(sha512x2Xor(sha512x2Ror(s1, 19), sha512x2Ror(s1, 61)), \
+                         sha512x2Shr(s1, 6)); \
+        v = sha512x2Add(sha512x2Add(x[(i)], s0), sha512x2Add(v, s1)); \
+        x[(i)] = v; \
+        sha512x2Store(wk + index * 2 + (i) * 2, \
+                      sha512x2Add(v, sha512x2Load(k + index * 2 + (i) * 2))); \
+    } while (0)
+    for (index = 8; index < 40; index += 8) {
+        SHA512_EXPAND(0);
+        SHA512_EXPAND(1);
+        SHA512_EXPAND(2);
+        SHA512_EXPAND(3);
+        SHA512_EXPAND(4);
+        SHA512_EXPAND(5);
+        SHA512_EXPAND(6);
+        SHA512_EXPAND(7);
+    }
+#undef SHA512_EXPAND
+}
+
+#endif // CRYPTO_SHA512_SIMD_SCHEDULE
+
+#if defined(CRYPTO_SHA512_LANES_AVX2)
+
+#include <immintrin.h>
+
+#define sha512x4Ror(a, n)   \
+    (_mm256_or_si256(_mm256_srli_epi64((a), (n)), _mm256_slli_epi64((a), 64 - (n))))
+
+__attribute__((target("avx2")))
+void sha512CompressLanes(uint64_t h[8][SHA512_LANES],
+                         const uint8_t *const blocks[SHA512_LANES],
+                         const uint64_t k[80])
+{
+    // Byte-swaps each 64-bit word from big endian.
+    const __m256i bswap = _mm256_set_epi64x
+        (0x08090a0b0c0d0e0fULL, 0x0001020304050607ULL,
+         0x08090a0b0c0d0e0fULL, 0x0001020304050607ULL);
+    __m256i w[16];
+    __m256i a, b, c, d, e, f, g, hh, temp1, temp2;
+    uint8_t index;
+
+    // Load the blocks with word i of every lane in w[i].
+    for (index = 0; index < 16; index += 4) {
+        __m256i r0 = _mm256_loadu_si256((const __m256i *)(blocks[0] + index * 8));
+        __m256i r1 = _mm256_loadu_si256((const __m256i *)(blocks[1] + index * 8));
+        __m256i r2 = _mm256_loadu_si256((const __m256i *)(blocks[2] + index * 8));
+        __m256i r3 = _mm256_loadu_si256((const __m256i *)(blocks[3] + index * 8));
+        __m256i t0 = _mm256_unpacklo_epi64(r0, r1);
+        __m256i t1 = _mm256_unpackhi_epi64(r0, r1);
+        __m256i t2 = _mm256_unpacklo_epi64(r2, r3);
+        __m256i t3 = _mm256_unpackhi_epi64(r2, r3);
+        w[index]     = _mm256_shuffle_epi8(_mm256_permute2x128_si256(t0, t2, 0x20), bswap);
+        w[index + 1] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(t1, t3, 0x20), bswap);
+        w[index + 2] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(t0, t2, 0x31), bswap);
+        w[index + 3] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(t1, t3, 0x31), bswap);
+    }
+
+    a  = _mm256_loadu_si256((const __m256i *)h[0]);
+    b  = _mm256_loadu_si256((const __m256i *)h[1]);
+    c  = _mm256_loadu_si256((const __m256i *)h[2]);
+    d  = _mm256_loadu_si256((const __m256i *)h[3]);
+    e  = _mm256_loadu_si256((const __m256i *)h[4]);
+    f  = _mm256_loadu_si256((const __m256i *)h[5]);
+    g  = _mm256_loadu_si256((const __m256i *)h[6]);
+    hh = _mm256_loadu_si256((const __m256i *)h[7]);
+
+    for (index = 0; index < 80; ++index) {
+        __m256i x;
+        if (index >= 16) {
+            // Expand the next word in place, as the portable code does.
+            __m256i s0 = w[(index - 15) & 0x0F];
+            __m256i s1 = w[(index - 2) & 0x0F];
+            s0 = _mm256_xor_si256(_mm256_xor_si256(sha512x4Ror(s0, 1), sha512x4Ror(s0, 8)),
+                                  _mm256_srli_epi64(s0, 7));
+            s1 = _mm256_xor_si256(_mm256_xor_si256(sha512x4Ror(s1, 19), sha512x4Ror(s1, 61)),
+                                  _mm256_srli_epi64(s1, 6));
+            w[index & 0x0F] = _mm256_add_epi64
+                (_mm256_add_epi64(w[index & 0x0F], s0),
+                 _mm256_add_epi64(w[(index - 7) & 0x0F], s1));
+        }
+        x = _mm256_add_epi64(w[index & 0x0F], _mm256_set1_epi64x((long long)k[index]));
+
+        temp1 = _mm256_xor_si256(_mm256_xor_si256(sha512x4Ror(e, 14), sha512x4Ror(e, 18)),
+                                 sha512x4Ror(e, 41));
+        temp1 = _mm256_add_epi64(_mm256_add_epi64(hh, x), temp1);
+        temp1 = _mm256_add_epi64
+            (temp1, _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g)));
+        temp2 = _mm256_xor_si256(_mm256_xor_si256(sha512x4Ror(a, 28), sha512x4Ror(a, 34)),
+                                 sha512x4Ror(a, 39));
+        temp2 = _mm256_add_epi64
+            (temp2, _mm256_xor_si256(_mm256_and_si256(a, _mm256_xor_si256(b, c)),
+                                     _mm256_and_si256(b, c)));
+        hh = g;
+        g = f;
+        f = e;
+        e = _mm256_add_epi64(d, temp1);
+        d = c;
+        c = b;
+        b = a;
+        a = _mm256_add_epi64(temp1, temp2);
+    }
+
+    _mm256_storeu_si256((__m256i *)h[0], _mm256_add_epi64(a,  _mm256_loadu_si256((const __m256i *)h[0])));
+    _mm256_storeu_si256((__m256i *)h[1], _mm256_add_epi64(b,  _mm256_loadu_si256((const __m256i *)h[1])));
+    _mm256_storeu_si256((__m256i *)h[2], _mm256_add_epi64(c,  _mm256_loadu_si256((const __m256i *)h[2])));
+    _mm256_storeu_si256((__m256i *)h[3], _mm256_add_epi64(d,  _mm256_loadu_si256((const __m256i *)h[3])));
+    _mm256_storeu_si256((__m256i *)h[4], _mm256_add_epi64(e,  _mm256_loadu_si256((const __m256i *)h[4])));
+    _mm256_storeu_si256((__m256i *)h[5], _mm256_add_epi64(f,  _mm256_loadu_si256((const __m256i *)h[5])));
+    _mm256_storeu_si256((__m256i *)h[6], _mm256_add_epi64(g,  _mm256_loadu_si256((const __m256i *)h[6])));
+    _mm256_storeu_si256((__m256i *)h[7], _mm256_add_epi64(hh, _mm256_loadu_si256((const __m256i *)h[7])));
+}
+
+#endif // CRYPTO_SHA512_LANES_AVX2
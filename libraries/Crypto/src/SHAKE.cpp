@@ -26,6 +26,10 @@
  * \class SHAKE SHAKE.h <SHAKE.h>
  * \brief Abstract base class for the SHAKE Extendable-Output Functions (XOFs).
  *
+ * When many independent outputs are needed, updateMany() and extendMany()
+ * absorb and squeeze a batch of SHAKE objects in lockstep, which lets
+ * the Keccak permutations run side by side in a vector unit.
+ *
  * Reference: http://en.wikipedia.org/wiki/SHA-3
  *
  * \sa SHAKE256, SHAKE128, SHA3_256
@@ -92,6 +96,81 @@ void SHAKE::clear()
     finalized = false;
 }
 
+// Number of XOF's that are handed to KeccakCore in one go.
+#define SHAKE_BATCH 8
+
+/**
+ * \brief Updates several SHAKE objects with the same amount of input
+ * data each.
+ *
+ * \param xofs Array of \a count SHAKE objects.
+ * \param data Array of \a count pointers to the input data for each object.
+ * \param len The number of bytes of input for each object.
+ * \param count The number of objects.
+ *
+ * The result is the same as calling update() on each object in turn,
+ * but objects with the same capacity that have absorbed the same amount
+ * of data so far are processed in lockstep, several permutations at a
+ * time on CPU's with a suitable vector unit.
+ *
+ * \sa extendMany(), KeccakCore::updateMany()
+ */
+void SHAKE::updateMany(SHAKE *const *xofs, const void *const *data,
+                       size_t len, size_t count)
+{
+    KeccakCore *cores[SHAKE_BATCH];
+    while (count > 0) {
+        size_t n = count < SHAKE_BATCH ? count : SHAKE_BATCH;
+        for (size_t index = 0; index < n; ++index) {
+            if (xofs[index]->finalized)
+                xofs[index]->reset();
+            cores[index] = &(xofs[index]->core);
+        }
+        KeccakCore::updateMany(cores, data, len, n);
+        xofs += n;
+        data += n;
+        count -= n;
+    }
+}
+
+/**
+ * \brief Generates the same amount of output data from several SHAKE
+ * objects.
+ *
+ * \param xofs Array of \a count SHAKE objects.
+ * \param data Array of \a count pointers to the output buffers for
+ * each object.
+ * \param len The number of bytes of output to generate for each object.
+ * \param count The number of objects.
+ *
+ * The result is the same as calling extend() on each object in turn.
+ * Objects that are still absorbing are finalized first, in lockstep.
+ *
+ * \sa updateMany(), KeccakCore::extractMany()
+ */
+void SHAKE::extendMany(SHAKE *const *xofs, uint8_t *const *data,
+                       size_t len, size_t count)
+{
+    KeccakCore *cores[SHAKE_BATCH];
+    while (count > 0) {
+        size_t n = count < SHAKE_BATCH ? count : SHAKE_BATCH;
+        size_t pending = 0;
+        for (size_t index = 0; index < n; ++index) {
+            if (!xofs[index]->finalized) {
+                cores[pending++] = &(xofs[index]->core);
+                xofs[index]->finalized = true;
+            }
+        }
+        KeccakCore::padMany(cores, 0x1F, pending);
+        for (size_t index = 0; index < n; ++index)
+            cores[index] = &(xofs[index]->core);
+        KeccakCore::extractMany(cores, (void *const *)data, len, n);
+        xofs += n;
+        data += n;
+        count -= n;
+    }
+}
+
 /**
  * \class SHAKE128 SHAKE.h <SHAKE.h>
  * \brief SHAKE Extendable-Output Function (XOF) with 128-bit security.
@@ -41,6 +41,11 @@ public:
 
     void clear();
 
+    static void updateMany(SHAKE *const *xofs, const void *const *data,
+                           size_t len, size_t count);
+    static void extendMany(SHAKE *const *xofs, uint8_t *const *data,
+                           size_t len, size_t count);
+
 protected:
     SHAKE(size_t capacity);
 
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2026 The cryptnox-sdk-arduino contributors.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef CRYPTO_BLAKE2LANES_H
+#define CRYPTO_BLAKE2LANES_H
+
+#include <inttypes.h>
+#include <stddef.h>
+
+// Multi-lane compression functions for the BLAKE2sp and BLAKE2bp tree
+// modes on native x86 builds.  Each leaf of the tree runs in its own
+// vector lane: eight 32-bit lanes for BLAKE2sp and four 64-bit lanes for
+// BLAKE2bp, both in one AVX2 register.  AVX2 is enabled per function and
+// probed at runtime.
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && \
+    !defined(CRYPTO_BLAKE2_NO_ACCEL)
+#define CRYPTO_BLAKE2_LANES_AVX2 1
+#endif
+
+#if defined(CRYPTO_BLAKE2_LANES_AVX2)
+
+// Compresses "stripes" consecutive 512-byte stripes of "data" into the
+// eight BLAKE2sp leaves.  Leaf i takes the i'th 64-byte block of every
+// stripe.  "h[j][i]" is word j of leaf i and "t" is the byte count of
+// each leaf before the first stripe.  None of the blocks can be final.
+void blake2sCompressLanes(uint32_t h[8][8], const uint8_t *data,
+                          size_t stripes, uint64_t t);
+
+// Same for the four BLAKE2bp leaves, which take 128-byte blocks.
+void blake2bCompressLanes(uint64_t h[8][4], const uint8_t *data,
+                          size_t stripes, uint64_t t);
+
+#endif
+
+#endif
@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2026 The cryptnox-sdk-arduino contributors.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef CRYPTO_CPUFEATURES_H
+#define CRYPTO_CPUFEATURES_H
+
+#include <inttypes.h>
+
+// Runtime CPU feature checks for the native vector and hardware backends.
+// The CPU is probed on the first call and the answer is kept for later
+// calls, so the hash code can ask on every batch.
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+
+#define CRYPTO_CPU_X86 1
+
+#define CRYPTO_CPU_AVX2     0x01    // AVX2, with the YMM state saved by the OS
+#define CRYPTO_CPU_SHA      0x02    // SHA extensions, with SSSE3 and SSE4.1
+
+// Returns true if the CPU has every CRYPTO_CPU_* feature in "features".
+bool cpuHasFeatures(uint8_t features);
+
+#endif
+
+#endif
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2026 The cryptnox-sdk-arduino contributors.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef CRYPTO_KECCAKLANES_H
+#define CRYPTO_KECCAKLANES_H
+
+#include <inttypes.h>
+#include <stddef.h>
+
+// Interleaved Keccak-f[1600] permutations that run several independent
+// sponge states side by side.  "A[i][lane]" is the i'th 64-bit word of
+// the lane's state, in the same order as KeccakCore::State::A.
+//
+// The two-lane version uses the baseline vector unit (SSE2 on x86,
+// NEON on AArch64).  The four-lane version uses AVX2 when the CPU has it,
+// probed at runtime, and two pairs of baseline vectors otherwise.  On
+// platforms without a vector unit nothing is defined, and KeccakCore
+// falls back to permuting one state at a time with its own code.
+
+#if (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)) || \
+     defined(__aarch64__)) && defined(__GNUC__) && \
+    !defined(CRYPTO_KECCAK_NO_ACCEL)
+#define CRYPTO_KECCAK_LANES 1
+#endif
+
+#if defined(CRYPTO_KECCAK_LANES)
+
+void keccakpLanes(uint64_t A[25][2]);
+void keccakpLanes(uint64_t A[25][4]);
+
+#endif
+
+#endif
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2026 The cryptnox-sdk-arduino contributors.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef CRYPTO_SHA256ACCEL_H
+#define CRYPTO_SHA256ACCEL_H
+
+#include <inttypes.h>
+#include <stddef.h>
+
+// Hardware SHA-256 backends for native builds.  The instructions are
+// enabled per function with target attributes, so the rest of the library
+// is still compiled for the baseline CPU and support is checked at runtime.
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && \
+    !defined(CRYPTO_SHA256_NO_ACCEL)
+#define CRYPTO_SHA256_X86 1
+#define CRYPTO_SHA256_ACCEL 1
+#elif defined(__aarch64__) && defined(__GNUC__) && \
+    !defined(CRYPTO_SHA256_NO_ACCEL)
+#define CRYPTO_SHA256_ARMV8 1
+#define CRYPTO_SHA256_ACCEL 1
+#endif
+
+// Round constants for SHA-256, defined in SHA256.cpp.  They are in
+// program memory on AVR, so read them there with pgm_read_dword().
+extern uint32_t const sha256K[64];
+
+#if defined(CRYPTO_SHA256_ACCEL)
+
+// Returns true if the CPU we are running on supports the backend.
+bool sha256AccelSupported();
+
+// Compresses "blocks" consecutive 64-byte blocks from "data" into "h".
+void sha256AccelCompress(uint32_t h[8], const uint8_t *data, size_t blocks);
+
+#endif
+
+#endif
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2026 The cryptnox-sdk-arduino contributors.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef CRYPTO_SHA256LANES_H
+#define CRYPTO_SHA256LANES_H
+
+#include <inttypes.h>
+#include <stddef.h>
+
+// Multi-buffer SHA-256 compression for native x86 builds without the
+// SHA extensions.  Eight independent SHA-256 states run side by side,
+// one per 32-bit lane of an AVX2 register.  AVX2 is enabled per function
+// and probed at runtime.
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && \
+    !defined(CRYPTO_SHA256_NO_ACCEL)
+#define CRYPTO_SHA256_LANES_AVX2 1
+#endif
+
+#if defined(CRYPTO_SHA256_LANES_AVX2)
+
+// Compresses one block into each of eight SHA-256 states.  "state[j][i]"
+// is word j of state i and "block[j][i]" is word j of the block for
+// state i, already converted to host byte order.
+void sha256CompressLanes(uint32_t state[8][8], const uint32_t block[16][8]);
+
+#endif
+
+#endif
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2026 The cryptnox-sdk-arduino contributors.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef CRYPTO_SHA512ACCEL_H
+#define CRYPTO_SHA512ACCEL_H
+
+#include <inttypes.h>
+#include <stddef.h>
+
+// SIMD helpers for SHA-512 on native builds.  The message schedule uses
+// the baseline vector unit (SSE2 on x86-64, NEON on AArch64) so it needs
+// no runtime check.  The four-lane compression function uses AVX2, which
+// is enabled per function and probed at runtime.
+
+#if (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__))) && \
+    defined(__GNUC__) && !defined(CRYPTO_SHA512_NO_ACCEL)
+#define CRYPTO_SHA512_SIMD_SCHEDULE 1
+#define CRYPTO_SHA512_LANES_AVX2 1
+#elif defined(__aarch64__) && defined(__GNUC__) && \
+    !defined(CRYPTO_SHA512_NO_ACCEL)
+#define CRYPTO_SHA512_SIMD_SCHEDULE 1
+#endif
+
+#if defined(CRYPTO_SHA512_SIMD_SCHEDULE)
+
+// Expands the 16 host-order words in "w" to the full 80-word schedule
+// and adds the round constants "k", writing the sums to "wk".
+void sha512ExpandSchedule(uint64_t wk[80], const uint64_t w[16],
+                          const uint64_t k[80]);
+
+#endif
+
+#if defined(CRYPTO_SHA512_LANES_AVX2)
+
+#define SHA512_LANES 4
+
+// Compresses one 128-byte block into each of four interleaved states.
+// "h[i][lane]" is word i of the lane's state and "blocks[lane]" points
+// to its block.
+void sha512CompressLanes(uint64_t h[8][SHA512_LANES],
+                         const uint8_t *const blocks[SHA512_LANES],
+                         const uint64_t k[80]);
+
+#endif
+
+#endif
@@ -0,0 +1,194 @@
+#include "HostBridgeClient.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief Map a numeric baud rate to its termios constant.
+ */
+static speed_t baudConstant(uint32_t baud) {
+    switch (baud) {
+    case 9600U:   return B9600;
+    case 19200U:  return B19200;
+    case 38400U:  return B38400;
+    case 57600U:  return B57600;
+    case 115200U: return B115200;
+    case 230400U: return B230400;
+    default:      return B0;
+    }
+}
+
+/**
+ * @brief Monotonic time in milliseconds.
+ */
+static uint64_t nowMs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000U) + ((uint64_t)ts.tv_nsec / 1000000U);
+}
+
+bool HostBridgeClient::open(const char* device, uint32_t baud) {
+    struct termios tio;
+    speed_t speed = baudConstant(baud);
+
+    close();
+    if (speed == B0) {
+        return false;
+    }
+    fd = ::open(device, O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    if (tcgetattr(fd, &tio) != 0) {
+        close();
+        return false;
+    }
+    cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cflag &= ~(tcflag_t)CSTOPB;
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+    if (tcsetattr(fd, TCSANOW, &tio) != 0) {
+        close();
+        return false;
+    }
+    (void)tcflush(fd, TCIOFLUSH);
+    rxLength = 0U;
+    rxOverflow = false;
+    inPos = 0U;
+    inLength = 0U;
+    return true;
+}
+
+void HostBridgeClient::close(void) {
+    if (fd >= 0) {
+        (void)::close(fd);
+        fd = -1;
+    }
+}
+
+bool HostBridgeClient::sendRequest(uint8_t type, const uint8_t* payload, size_t length,
+                                   uint8_t &seq) {
+    uint8_t encoded[HOSTBRIDGE_MAX_ENCODED + 1U];
+    size_t n;
+    size_t sent = 0U;
+
+    if (fd < 0) {
+        return false;
+    }
+    seq = nextSeq;
+    n = hostBridgeBuildFrame(type, seq, payload, length, encoded);
+    if (n == 0U) {
+        return false;
+    }
+    nextSeq++;
+
+    while (sent < n) {
+        ssize_t w = ::write(fd, &encoded[sent], n - sent);
+        if (w < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        sent += (size_t)w;
+    }
+    return true;
+}
+
+bool HostBridgeClient::readResponse(uint8_t &type, uint8_t &seq, uint8_t* payload,
+                                    size_t &length, uint32_t timeoutMs) {
+    const uint64_t deadline = nowMs() + timeoutMs;
+
+    if (fd < 0) {
+        return false;
+    }
+
+    for (;;) {
+        uint8_t c;
+
+        if (inPos == inLength) {
+            struct pollfd pfd;
+            uint64_t now = nowMs();
+            ssize_t got;
+
+            if (now >= deadline) {
+                return false;
+            }
+            pfd.fd = fd;
+            pfd.events = POLLIN;
+            pfd.revents = 0;
+            if (::poll(&pfd, 1, (int)(deadline - now)) <= 0) {
+                continue;
+            }
+            got = ::read(fd, inBuffer, sizeof(inBuffer));
+            if (got <= 0) {
+                continue;
+            }
+            inPos = 0U;
+            inLength = (size_t)got;
+        }
+
+        /* Bytes after the delimiter stay in inBuffer for the next call */
+        c = inBuffer[inPos];
+        inPos++;
+
+        if (c != 0U) {
+            if (rxLength < sizeof(rxBuffer)) {
+                rxBuffer[rxLength] = c;
+                rxLength++;
+            } else {
+                rxOverflow = true;
+            }
+            continue;
+        }
+
+        if ((rxOverflow == false) && (rxLength > 0U)) {
+            uint8_t frame[HOSTBRIDGE_MAX_ENCODED];
+            size_t n = hostBridgeParseFrame(rxBuffer, rxLength, frame);
+            rxLength = 0U;
+            if (n >= 3U) {
+                type = frame[0];
+                seq = frame[1];
+                length = n - 2U;
+                memcpy(payload, &frame[2], length);
+                return true;
+            }
+        }
+        rxLength = 0U;
+        rxOverflow = false;
+    }
+}
+
+bool HostBridgeClient::transact(uint8_t type, const uint8_t* request, size_t requestLength,
+                                uint8_t* response, size_t &responseLength, uint32_t timeoutMs) {
+    const uint64_t deadline = nowMs() + timeoutMs;
+    uint8_t seq;
+    uint8_t rxType;
+    uint8_t rxSeq;
+
+    if (sendRequest(type, request, requestLength, seq) == false) {
+        return false;
+    }
+    /* Stale responses use up the same budget, so they cannot extend the wait */
+    for (;;) {
+        uint64_t now = nowMs();
+        if (now >= deadline) {
+            return false;
+        }
+        if (readResponse(rxType, rxSeq, response, responseLength,
+                         (uint32_t)(deadline - now)) == false) {
+            return false;
+        }
+        if ((rxSeq == seq) && (rxType == (uint8_t)(type | HOSTBRIDGE_RESPONSE))) {
+            return true;
+        }
+    }
+}
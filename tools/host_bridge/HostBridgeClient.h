@@ -0,0 +1,84 @@
+#ifndef HOSTBRIDGECLIENT_H
+#define HOSTBRIDGECLIENT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../../examples/HostBridgeProtocol.h"
+
+/**
+ * @class HostBridgeClient
+ * @brief Host side of the reader's binary serial protocol (POSIX only).
+ *
+ * Requests may be pipelined: send several with sendRequest() and collect
+ * the answers with readResponse(), matching them on the returned seq.
+ */
+class HostBridgeClient {
+public:
+    HostBridgeClient()
+        : fd(-1), nextSeq(0U), rxLength(0U), rxOverflow(false), inPos(0U), inLength(0U) {}
+    ~HostBridgeClient() { close(); }
+
+    /**
+     * @brief Open and configure a serial port (raw, 8N1).
+     *
+     * @param device Path such as "/dev/ttyACM0".
+     * @param baud Baud rate, e.g. 115200.
+     * @return true on success.
+     */
+    bool open(const char* device, uint32_t baud);
+
+    /**
+     * @brief Close the port if open.
+     */
+    void close(void);
+
+    /**
+     * @brief Send one request.
+     *
+     * @param type HOSTBRIDGE_CMD_* value.
+     * @param payload Request payload, may be nullptr if length is 0.
+     * @param length Payload length, at most HOSTBRIDGE_MAX_PAYLOAD.
+     * @param[out] seq Sequence number the response will carry.
+     * @return true if the whole frame was written.
+     */
+    bool sendRequest(uint8_t type, const uint8_t* payload, size_t length, uint8_t &seq);
+
+    /**
+     * @brief Wait for the next valid response frame.
+     *
+     * Corrupt frames are skipped.
+     *
+     * @param[out] type Response type (request type | HOSTBRIDGE_RESPONSE).
+     * @param[out] seq Sequence number of the request answered.
+     * @param[out] payload Destination, at least HOSTBRIDGE_MAX_PAYLOAD bytes.
+     * @param[out] length Payload length, status byte included.
+     * @param timeoutMs Time to wait in milliseconds.
+     * @return true if a response was received in time.
+     */
+    bool readResponse(uint8_t &type, uint8_t &seq, uint8_t* payload, size_t &length,
+                      uint32_t timeoutMs);
+
+    /**
+     * @brief Send a request and wait for its response.
+     *
+     * Responses to other (earlier pipelined) requests are discarded. The
+     * timeout covers the whole call, however many of those arrive.
+     *
+     * @return true if the matching response arrived within timeoutMs.
+     */
+    bool transact(uint8_t type, const uint8_t* request, size_t requestLength,
+                  uint8_t* response, size_t &responseLength, uint32_t timeoutMs);
+
+private:
+    int fd;           /**< Serial port file descriptor, -1 when closed */
+    uint8_t nextSeq;  /**< Sequence number of the next request */
+    uint8_t rxBuffer[HOSTBRIDGE_MAX_ENCODED]; /**< Encoded bytes of the frame being received */
+    size_t rxLength;  /**< Bytes held in rxBuffer */
+    bool rxOverflow;  /**< Current frame is too long and will be dropped */
+    uint8_t inBuffer[256]; /**< Raw bytes read from the port, not yet consumed */
+    size_t inPos;     /**< Next unconsumed byte in inBuffer */
+    size_t inLength;  /**< Valid bytes in inBuffer */
+};
+
+#endif // HOSTBRIDGECLIENT_H
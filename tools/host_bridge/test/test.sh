@@ -0,0 +1,36 @@
+#!/usr/bin/env bash
+#
+# Builds and runs the host bridge test with the system compiler: the sketch's
+# bridge and wallet code on the host Arduino core from the BusIO tests, with
+# the simulated reader from tools/sim.
+
+set -e
+cd "$(dirname "$0")"
+
+ROOT=../../..
+LIBS=$ROOT/libraries
+BUSIO=$LIBS/Adafruit_BusIO
+CC=${CC:-gcc}
+CXX=${CXX:-g++}
+INCLUDES="-I$BUSIO/test/host -I$BUSIO -I$LIBS/Adafruit_PN532 \
+  -I$LIBS/Adafruit_PN532/test -I$LIBS/Crypto/src -I$LIBS/micro-ecc \
+  -I$ROOT/examples -I../../sim"
+CXXFLAGS="--std=c++14 -Wall -Wextra -DCRYPTNOX_HOST_BRIDGE $INCLUDES"
+SOURCES="$BUSIO/test/host/Arduino.cpp $BUSIO/Adafruit_SPIDevice.cpp \
+  $BUSIO/Adafruit_I2CDevice.cpp $LIBS/Adafruit_PN532/Adafruit_PN532.cpp \
+  $LIBS/Crypto/src/Crypto.cpp $LIBS/Crypto/src/Hash.cpp \
+  $LIBS/Crypto/src/SHA512.cpp $LIBS/Crypto/src/SHA512Accel.cpp \
+  $LIBS/Crypto/src/CPUFeatures.cpp \
+  $ROOT/examples/CryptnoxWallet.cpp $ROOT/examples/PN532Base.cpp \
+  $ROOT/examples/HostBridge.cpp $ROOT/examples/Trace.cpp \
+  ../HostBridgeClient.cpp"
+OUT=$(mktemp -d)
+trap 'rm -rf "$OUT"' EXIT
+
+echo "*** Building ***"
+$CC -c -o "$OUT/uECC.o" $LIBS/micro-ecc/uECC.c
+$CXX $CXXFLAGS -pthread -o "$OUT/test_host_bridge" test_host_bridge.cpp \
+  $SOURCES "$OUT/uECC.o"
+
+echo "*** Running tests ***"
+"$OUT/test_host_bridge"
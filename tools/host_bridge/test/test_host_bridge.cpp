@@ -0,0 +1,314 @@
+/**
+ * @file test_host_bridge.cpp
+ * @brief Host test of the bridge protocol.
+ *
+ * Checks the COBS/CRC framing, then feeds request frames to HostBridge and
+ * checks every response. The bridge runs the real CryptnoxWallet and PN532
+ * driver against the simulated reader and wallet card of tools/sim. Finally
+ * checks that HostBridgeClient::transact() keeps to its timeout while stale
+ * responses keep arriving on a pty.
+ */
+
+#include "HostBridge.h"
+#include "SimulatedReader.h"
+#include "../HostBridgeClient.h"
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#define PIN_CS 10
+
+static int failures = 0;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            failures++;                                                     \
+        }                                                                   \
+    } while (0)
+
+typedef std::vector<uint8_t> Bytes;
+
+/**
+ * @brief Serial port between the test and the bridge.
+ */
+class TestPort : public Stream {
+public:
+    std::deque<uint8_t> rx; /**< Bytes the bridge has not read yet */
+    Bytes tx;               /**< Everything the bridge wrote */
+
+    int available(void) override { return (int)rx.size(); }
+
+    int read(void) override {
+        if (rx.empty()) {
+            return -1;
+        }
+        uint8_t c = rx.front();
+        rx.pop_front();
+        return c;
+    }
+
+    size_t write(uint8_t c) override {
+        tx.push_back(c);
+        return 1U;
+    }
+
+    size_t write(const uint8_t* buffer, size_t size) override {
+        tx.insert(tx.end(), buffer, buffer + size);
+        return size;
+    }
+
+    void send(const Bytes& bytes) { rx.insert(rx.end(), bytes.begin(), bytes.end()); }
+};
+
+/**
+ * @brief Build an encoded request frame.
+ */
+static Bytes frame(uint8_t type, uint8_t seq, const Bytes& payload = Bytes()) {
+    uint8_t out[HOSTBRIDGE_MAX_ENCODED + 1U];
+    size_t n = hostBridgeBuildFrame(type, seq, payload.data(), payload.size(), out);
+    return Bytes(out, out + n);
+}
+
+/**
+ * @brief Decoded response.
+ */
+struct Response {
+    uint8_t type;
+    uint8_t seq;
+    Bytes payload;
+};
+
+/**
+ * @brief Split what the bridge wrote into checked frames.
+ */
+static std::vector<Response> responses(TestPort& port) {
+    std::vector<Response> out;
+    Bytes encoded;
+
+    for (uint8_t c : port.tx) {
+        if (c != 0U) {
+            encoded.push_back(c);
+            continue;
+        }
+        uint8_t decoded[HOSTBRIDGE_MAX_ENCODED];
+        size_t n = hostBridgeParseFrame(encoded.data(), encoded.size(), decoded);
+        CHECK(n >= 3U);
+        if (n >= 3U) {
+            out.push_back(Response{decoded[0], decoded[1], Bytes(decoded + 2, decoded + n)});
+        }
+        encoded.clear();
+    }
+    CHECK(encoded.empty());
+    port.tx.clear();
+    return out;
+}
+
+static uint32_t getU32(const uint8_t* in) {
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8U) | ((uint32_t)in[2] << 16U) |
+           ((uint32_t)in[3] << 24U);
+}
+
+static void testFraming(void) {
+    const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    uint8_t out[HOSTBRIDGE_MAX_ENCODED + 1U];
+    uint8_t decoded[HOSTBRIDGE_MAX_ENCODED];
+    uint8_t payload[HOSTBRIDGE_MAX_PAYLOAD + 1U];
+
+    /* CRC-16/CCITT-FALSE check value, also when fed in pieces */
+    CHECK(hostBridgeCrc16(check, sizeof(check)) == 0x29B1U);
+    CHECK(hostBridgeCrc16(check + 4, 5U, hostBridgeCrc16(check, 4U)) == 0x29B1U);
+
+    /* Every length, with zeros, without zeros and all zeros */
+    for (int fill = 0; fill < 3; fill++) {
+        for (size_t len = 0U; len <= HOSTBRIDGE_MAX_PAYLOAD; len++) {
+            for (size_t i = 0U; i < len; i++) {
+                payload[i] = (fill == 0) ? (uint8_t)i : (fill == 1) ? (uint8_t)(i | 1U) : 0U;
+            }
+            size_t n = hostBridgeBuildFrame(0x42U, (uint8_t)len, payload, len, out);
+            CHECK(n == len + 6U);
+            CHECK(out[n - 1U] == 0U);
+            CHECK(memchr(out, 0, n - 1U) == nullptr);
+            CHECK(hostBridgeParseFrame(out, n - 1U, decoded) == len + 2U);
+            CHECK((decoded[0] == 0x42U) && (decoded[1] == (uint8_t)len));
+            CHECK(memcmp(decoded + 2, payload, len) == 0);
+        }
+    }
+    CHECK(hostBridgeBuildFrame(0x42U, 0U, payload, HOSTBRIDGE_MAX_PAYLOAD + 1U, out) == 0U);
+
+    /* Any single flipped bit is caught */
+    size_t n = hostBridgeBuildFrame(0x01U, 7U, check, sizeof(check), out) - 1U;
+    for (size_t i = 0U; i < n; i++) {
+        for (uint8_t bit = 0U; bit < 8U; bit++) {
+            out[i] ^= (uint8_t)(1U << bit);
+            if (out[i] != 0U) {
+                CHECK(hostBridgeParseFrame(out, n, decoded) == 0U);
+            }
+            out[i] ^= (uint8_t)(1U << bit);
+        }
+    }
+
+    /* Truncated, malformed COBS and too short */
+    CHECK(hostBridgeParseFrame(out, n - 1U, decoded) == 0U);
+    const uint8_t badCode[] = {0x05U, 0x01U, 0x02U};
+    CHECK(hostBridgeParseFrame(badCode, sizeof(badCode), decoded) == 0U);
+    const uint8_t tooShort[] = {0x03U, 0x01U, 0x02U};
+    CHECK(hostBridgeParseFrame(tooShort, sizeof(tooShort), decoded) == 0U);
+}
+
+static void testDispatch(void) {
+    SimulatedReader card(PIN_CS);
+    TestPort port;
+    CryptnoxWallet wallet(PIN_CS, &SPI);
+    HostBridge bridge(port, wallet);
+    std::vector<Response> r;
+
+    CHECK(card.attach());
+    CHECK(wallet.begin());
+
+    /* INFO: firmware version and the statistics snapshot */
+    port.send(frame(HOSTBRIDGE_CMD_INFO, 1U));
+    bridge.poll();
+    r = responses(port);
+    CHECK(r.size() == 1U);
+    if (r.size() == 1U) {
+        CHECK(r[0].type == (HOSTBRIDGE_CMD_INFO | HOSTBRIDGE_RESPONSE));
+        CHECK(r[0].seq == 1U);
+        CHECK(r[0].payload.size() == 5U + PN532_STATS_SNAPSHOT_SIZE);
+        CHECK(r[0].payload[0] == HOSTBRIDGE_STATUS_OK);
+        CHECK(getU32(&r[0].payload[1]) == 0x32010607UL);
+    }
+
+    /* TAP: both public keys of the secure channel */
+    port.send(frame(HOSTBRIDGE_CMD_TAP, 2U));
+    bridge.poll();
+    r = responses(port);
+    CHECK(r.size() == 1U);
+    if (r.size() == 1U) {
+        CHECK(r[0].type == (HOSTBRIDGE_CMD_TAP | HOSTBRIDGE_RESPONSE));
+        CHECK(r[0].seq == 2U);
+        CHECK(r[0].payload.size() == 5U + (2U * HOSTBRIDGE_KEY_SIZE));
+        CHECK(r[0].payload[0] == HOSTBRIDGE_STATUS_OK);
+        CHECK(getU32(&r[0].payload[1]) > 0U);
+        if (r[0].payload.size() == 5U + (2U * HOSTBRIDGE_KEY_SIZE)) {
+            CHECK(memcmp(&r[0].payload[5], card.publicKey, 64U) == 0);
+            CHECK(memcmp(&r[0].payload[69], card.clientKey, 64U) == 0);
+            CHECK(uECC_valid_public_key(&r[0].payload[69], uECC_secp256r1()) != 0);
+        }
+    }
+
+    /* TAP on a card without the wallet application: no keys */
+    card.selectable = false;
+    port.send(frame(HOSTBRIDGE_CMD_TAP, 3U));
+    bridge.poll();
+    r = responses(port);
+    CHECK((r.size() == 1U) && (r[0].payload.size() == 5U));
+    CHECK((r.size() == 1U) && (r[0].payload[0] == HOSTBRIDGE_STATUS_FAILED));
+    card.selectable = true;
+
+    /* SIGN is reserved, unknown types are unsupported, INFO takes no payload */
+    port.send(frame(HOSTBRIDGE_CMD_SIGN, 4U, Bytes(32U, 0xAAU)));
+    port.send(frame(0x7FU, 5U));
+    port.send(frame(HOSTBRIDGE_CMD_INFO, 6U, Bytes{0x01U}));
+    bridge.poll();
+    r = responses(port);
+    CHECK(r.size() == 3U);
+    if (r.size() == 3U) {
+        CHECK((r[0].seq == 4U) && (r[0].payload.size() == 1U));
+        CHECK(r[0].payload[0] == HOSTBRIDGE_STATUS_UNSUPPORTED);
+        CHECK((r[1].seq == 5U) && (r[1].type == 0xFFU));
+        CHECK(r[1].payload[0] == HOSTBRIDGE_STATUS_UNSUPPORTED);
+        CHECK((r[2].seq == 6U) && (r[2].payload[0] == HOSTBRIDGE_STATUS_BAD_REQUEST));
+    }
+
+    /* Dropped silently: bad CRC, a response, an overlong frame, empty frames */
+    Bytes bad = frame(HOSTBRIDGE_CMD_INFO, 7U);
+    bad[1] ^= 0x01U;
+    port.send(bad);
+    port.send(frame(HOSTBRIDGE_CMD_INFO | HOSTBRIDGE_RESPONSE, 8U, Bytes{0x00U}));
+    port.send(Bytes(HOSTBRIDGE_MAX_ENCODED + 10U, 0x11U));
+    port.send(Bytes{0x00U, 0x00U, 0x00U});
+    /* Pipelined requests, split across polls, are answered in order */
+    Bytes pipelined = frame(HOSTBRIDGE_CMD_SIGN, 9U);
+    Bytes second = frame(HOSTBRIDGE_CMD_INFO, 10U);
+    pipelined.insert(pipelined.end(), second.begin(), second.end());
+    port.send(Bytes(pipelined.begin(), pipelined.begin() + 5));
+    bridge.poll();
+    port.send(Bytes(pipelined.begin() + 5, pipelined.end()));
+    bridge.poll();
+    r = responses(port);
+    CHECK(r.size() == 2U);
+    if (r.size() == 2U) {
+        CHECK((r[0].seq == 9U) && (r[0].type == (HOSTBRIDGE_CMD_SIGN | HOSTBRIDGE_RESPONSE)));
+        CHECK((r[1].seq == 10U) && (r[1].type == (HOSTBRIDGE_CMD_INFO | HOSTBRIDGE_RESPONSE)));
+    }
+
+    CHECK(card.pn532.badFrames == 0);
+    hostReset();
+}
+
+static void testClientTimeout(void) {
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    HostBridgeClient client;
+    uint8_t response[HOSTBRIDGE_MAX_PAYLOAD];
+    size_t responseLength = 0U;
+
+    CHECK(master >= 0);
+    if ((master < 0) || (grantpt(master) != 0) || (unlockpt(master) != 0)) {
+        printf("test_host_bridge: no pty, client checks skipped\n");
+        return;
+    }
+    CHECK(client.open(ptsname(master), 115200U));
+
+    /* A stale response ahead of the matching one is skipped */
+    Bytes stale = frame(HOSTBRIDGE_CMD_TAP | HOSTBRIDGE_RESPONSE, 0x55U, Bytes{0x00U});
+    Bytes match = frame(HOSTBRIDGE_CMD_INFO | HOSTBRIDGE_RESPONSE, 0U, Bytes{0x00U, 0x01U});
+    CHECK(write(master, stale.data(), stale.size()) == (ssize_t)stale.size());
+    CHECK(write(master, match.data(), match.size()) == (ssize_t)match.size());
+    CHECK(client.transact(HOSTBRIDGE_CMD_INFO, nullptr, 0U, response, responseLength, 500U));
+    CHECK((responseLength == 2U) && (response[1] == 0x01U));
+
+    /* Stale responses every 20 ms must not stretch a 100 ms timeout. The
+     * feeder gives up after a second so a regression fails instead of hanging */
+    std::atomic<bool> feeding(true);
+    std::thread feeder([&]() {
+        for (int i = 0; feeding && (i < 50); i++) {
+            (void)!write(master, stale.data(), stale.size());
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+    });
+    auto start = std::chrono::steady_clock::now();
+    bool got = client.transact(HOSTBRIDGE_CMD_INFO, nullptr, 0U, response, responseLength, 100U);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    feeding = false;
+    feeder.join();
+    CHECK(!got);
+    /* nowMs() truncates, so the call may end up to a millisecond early */
+    CHECK(elapsed >= 99);
+    CHECK(elapsed < 300);
+
+    client.close();
+    close(master);
+}
+
+int main(void) {
+    testFraming();
+    testDispatch();
+    testClientTimeout();
+
+    if (failures != 0) {
+        printf("test_host_bridge: %d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("test_host_bridge: OK\n");
+    return 0;
+}
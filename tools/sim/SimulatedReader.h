@@ -0,0 +1,114 @@
+#ifndef SIMULATEDREADER_H
+#define SIMULATEDREADER_H
+
+/**
+ * @file SimulatedReader.h
+ * @brief PN532 reader with a simulated Cryptnox wallet card, for host runs.
+ *
+ * Puts the emulated PN532 of the driver tests on the host core's hardware
+ * SPI bus, so a CryptnoxWallet built for SPI talks to it unchanged. The card
+ * in the field answers SELECT, GET CARD CERTIFICATE and OPEN SECURE CHANNEL
+ * like a wallet card, with a fresh P-256 ephemeral key; the certificate
+ * signature is filler and is not checked by the SDK.
+ */
+
+#include "BusIO_Host.h"
+#include "FakePN532.h"
+#include "uECC.h"
+
+#include <vector>
+
+/**
+ * @class SimulatedReader
+ * @brief Emulated PN532 plus the wallet card in its field.
+ */
+class SimulatedReader {
+public:
+    FakePN532 pn532;        /**< Emulated PN532 */
+    bool selectable;        /**< Card answers SELECT of the wallet applet */
+    uint8_t publicKey[64];  /**< Card ephemeral key sent in the certificate */
+    uint8_t privateKey[32]; /**< Its private half */
+    uint8_t clientKey[64];  /**< Key the reader sent with OPEN SECURE CHANNEL */
+    int apdus;              /**< APDUs the card received */
+
+    /**
+     * @param cs Chip select pin the wallet's PN532 driver uses.
+     */
+    explicit SimulatedReader(uint8_t cs)
+        : selectable(true), apdus(0), csPin(cs) {
+        memset(publicKey, 0, sizeof(publicKey));
+        memset(privateKey, 0, sizeof(privateKey));
+        memset(clientKey, 0, sizeof(clientKey));
+    }
+
+    /**
+     * @brief Reset the host core and wire the PN532 to its SPI bus.
+     *
+     * @return true if the card key could be generated.
+     */
+    bool attach(void) {
+        hostReset();
+        hostSetSPIPeer(spiPeer, this);
+        hostSetPinOutput(pinOutput, this);
+        pn532.apduHandler = cardApdu;
+        pn532.apduContext = this;
+        return uECC_make_key(publicKey, privateKey, uECC_secp256r1()) != 0;
+    }
+
+private:
+    uint8_t csPin; /**< Chip select; rising ends an SPI transaction */
+
+    static uint8_t spiPeer(void* context, uint8_t data) {
+        return ((SimulatedReader*)context)->pn532.spiByte(data);
+    }
+
+    static void pinOutput(void* context, uint8_t pin, uint8_t value) {
+        SimulatedReader* reader = (SimulatedReader*)context;
+        if ((pin == reader->csPin) && (value == HIGH)) {
+            reader->pn532.spiEnd();
+        }
+    }
+
+    static std::vector<uint8_t> cardApdu(void* context, const std::vector<uint8_t>& apdu) {
+        SimulatedReader* card = (SimulatedReader*)context;
+        std::vector<uint8_t> reply;
+
+        card->apdus++;
+        if (apdu.size() < 5U) {
+            return std::vector<uint8_t>{0x67U, 0x00U};
+        }
+        if (apdu[1] == 0xA4U) { /* SELECT */
+            return card->selectable ? std::vector<uint8_t>{0x90U, 0x00U}
+                                    : std::vector<uint8_t>{0x6AU, 0x82U};
+        }
+        if (card->selectable == false) {
+            return std::vector<uint8_t>{0x6DU, 0x00U};
+        }
+        switch (apdu[1]) {
+        case 0xF8U: /* GET CARD CERTIFICATE: 'C', nonce, key, signature */
+            if (apdu.size() < 13U) {
+                return std::vector<uint8_t>{0x67U, 0x00U};
+            }
+            reply.push_back('C');
+            reply.insert(reply.end(), apdu.begin() + 5, apdu.begin() + 13);
+            reply.push_back(0x04U);
+            reply.insert(reply.end(), card->publicKey, card->publicKey + 64);
+            reply.insert(reply.end(), 72U, 0x30U);
+            break;
+        case 0x10U: /* OPEN SECURE CHANNEL: the salt */
+            if (apdu.size() < 70U) {
+                return std::vector<uint8_t>{0x67U, 0x00U};
+            }
+            memcpy(card->clientKey, &apdu[6], 64U);
+            reply.insert(reply.end(), 32U, 0x5AU);
+            break;
+        default:
+            return std::vector<uint8_t>{0x6DU, 0x00U};
+        }
+        reply.push_back(0x90U);
+        reply.push_back(0x00U);
+        return reply;
+    }
+};
+
+#endif // SIMULATEDREADER_H
@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+"""Static worst-case stack report for the SDK entry points.
+
+Reads the call graph files GCC writes with ``-fcallgraph-info=su`` (one
+``.ci`` file per translation unit) and prints, for every public SDK call,
+the deepest stack the call can reach: its own frame plus the worst chain of
+callees. Frames marked dynamic (VLAs, alloca) or calls through pointers and
+into code without call graph info (e.g. precompiled core objects) make the
+figure a lower bound and are flagged.
+
+Build each configuration with the extra flags, e.g. with arduino-cli:
+
+    arduino-cli compile -b arduino:renesas_uno:unor4wifi examples \\
+        --build-path build/r4 \\
+        --build-property "compiler.cpp.extra_flags=-fstack-usage -fcallgraph-info=su" \\
+        --build-property "compiler.c.extra_flags=-fstack-usage -fcallgraph-info=su"
+
+then report one or more configurations against a budget in bytes:
+
+    tools/stack_report.py --budget 1536 uno=build/uno r4=build/r4
+
+-fcallgraph-info needs GCC 10 or later. The AVR core ships avr-gcc 7.3, so
+build AVR configurations with -fstack-usage only. For a build directory
+without .ci files the report falls back to the .su files: each entry point
+then counts its own frame only, and the figure is flagged as a lower bound.
+
+The exit status is 1 if any entry point exceeds the budget.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+NODE_RE = re.compile(r'node: \{ title: "([^"]+)" label: "([^"]*)"')
+EDGE_RE = re.compile(r'edge: \{ sourcename: "([^"]+)" targetname: "([^"]+)"')
+SIZE_RE = re.compile(r'(\d+) bytes \((\w+(?:,\w+)?)\)')
+SU_RE = re.compile(r'^(.*):(\d+):(\d+):(.*)\t(\d+)\t(\w+(?:,\w+)?)$')
+
+DEFAULT_ROOTS = r'^(bool|void|int|uint\w*|size_t)? ?(CryptnoxWallet|PN532Base)::'
+
+
+class Graph:
+    def __init__(self):
+        self.frames = {}   # symbol -> (bytes, qualifier)
+        self.names = {}    # symbol -> demangled name
+        self.calls = {}    # symbol -> set of callee symbols
+        self.callgraph = True
+
+    def load(self, path):
+        with open(path, encoding='utf-8', errors='replace') as f:
+            for line in f:
+                m = NODE_RE.search(line)
+                if m:
+                    sym, label = m.groups()
+                    parts = label.split('\\n')
+                    self.names.setdefault(sym, parts[0])
+                    s = SIZE_RE.search(label)
+                    if s:
+                        self.frames[sym] = (int(s.group(1)), s.group(2))
+                    continue
+                m = EDGE_RE.search(line)
+                if m:
+                    self.calls.setdefault(m.group(1), set()).add(m.group(2))
+
+    def load_su(self, path):
+        """Load frame sizes from a -fstack-usage file, without callees."""
+        self.callgraph = False
+        with open(path, encoding='utf-8', errors='replace') as f:
+            for line in f:
+                m = SU_RE.match(line.rstrip('\n'))
+                if m:
+                    where, row, col, name, size, qual = m.groups()
+                    sym = '%s:%s:%s:%s' % (where, row, col, name)
+                    self.names[sym] = name
+                    self.frames[sym] = (int(size), qual)
+
+    def worst(self, sym, memo, active):
+        """Return (bytes, path, flags) for the deepest chain from sym."""
+        if sym in memo:
+            return memo[sym]
+        if sym in active:
+            return 0, [], {'recursive'}
+        frame, qual = self.frames.get(sym, (0, None))
+        flags = set()
+        if not self.callgraph:
+            flags.add('frame only, no call graph')
+        if qual is None:
+            flags.add('unknown:' + self.names.get(sym, sym))
+        elif qual != 'static':
+            flags.add('dynamic:' + self.names.get(sym, sym))
+
+        active.add(sym)
+        best = (0, [], set())
+        for callee in sorted(self.calls.get(sym, ())):
+            sub = self.worst(callee, memo, active)
+            flags |= sub[2]
+            if sub[0] > best[0]:
+                best = sub
+        active.discard(sym)
+
+        result = (frame + best[0], [sym] + best[1], flags)
+        memo[sym] = result
+        return result
+
+
+def load_config(directory):
+    graph = Graph()
+    ci, su = [], []
+    for root, _, files in os.walk(directory):
+        for name in files:
+            if name.endswith('.ci'):
+                ci.append(os.path.join(root, name))
+            elif name.endswith('.su'):
+                su.append(os.path.join(root, name))
+    if ci:
+        for path in ci:
+            graph.load(path)
+    elif su:
+        for path in su:
+            graph.load_su(path)
+    else:
+        sys.exit('%s: no .ci or .su files, build with -fstack-usage '
+                 '(and -fcallgraph-info=su on GCC 10+)' % directory)
+    return graph
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__.split('\n\n')[0])
+    parser.add_argument('configs', nargs='+', metavar='NAME=BUILD_DIR',
+                        help='build configuration to report')
+    parser.add_argument('--budget', type=int, default=0,
+                        help='stack budget in bytes per entry point')
+    parser.add_argument('--roots', default=DEFAULT_ROOTS,
+                        help='regex selecting entry points by demangled name')
+    parser.add_argument('--path', action='store_true',
+                        help='print the deepest call chain of each entry point')
+    parser.add_argument('-v', '--verbose', action='store_true',
+                        help='list every callee without stack info')
+    args = parser.parse_args()
+
+    roots = re.compile(args.roots)
+    over = False
+    for config in args.configs:
+        name, _, directory = config.partition('=')
+        if not directory:
+            name, directory = os.path.basename(config.rstrip('/')), config
+        graph = load_config(directory)
+        memo = {}
+
+        print('== %s (%s)' % (name, directory))
+        entries = sorted(s for s in graph.frames
+                         if roots.search(graph.names.get(s, '')))
+        peak = 0
+        for sym in entries:
+            total, path, flags = graph.worst(sym, memo, set())
+            peak = max(peak, total)
+            mark = ''
+            if args.budget and total > args.budget:
+                mark = '  OVER BUDGET'
+                over = True
+            bound = '>=' if flags else '  '
+            print('%s%6d  %s%s' % (bound, total, graph.names[sym], mark))
+            if args.path:
+                for step in path:
+                    print('            %6d  %s' % (graph.frames.get(step, (0,))[0],
+                                                 graph.names.get(step, step)))
+            unknown = sorted(f for f in flags if f.startswith('unknown:'))
+            for flag in sorted(flags):
+                if args.verbose or not flag.startswith('unknown:'):
+                    print('            note: %s' % flag)
+            if unknown and not args.verbose:
+                print('            note: %d callees without stack info '
+                      '(-v lists them)' % len(unknown))
+        if args.budget:
+            print('   peak %d of %d bytes budget, %d bytes headroom' %
+                  (peak, args.budget, args.budget - peak))
+        print()
+
+    return 1 if over else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
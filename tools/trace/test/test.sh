@@ -0,0 +1,37 @@
+#!/usr/bin/env bash
+#
+# Builds the wallet and the PN532 driver with CRYPTNOX_TRACE on the host
+# Arduino core from the BusIO tests and traces one tap of the simulated card
+# from tools/sim. Pass a file name to keep the trace:
+#
+#     tools/trace/test/test.sh /tmp/tap.json
+
+set -e
+TRACE_OUT=${1:+$(cd "$(dirname "$1")" && pwd)/$(basename "$1")}
+cd "$(dirname "$0")"
+
+ROOT=../../..
+LIBS=$ROOT/libraries
+BUSIO=$LIBS/Adafruit_BusIO
+CC=${CC:-gcc}
+CXX=${CXX:-g++}
+INCLUDES="-I$BUSIO/test/host -I$BUSIO -I$LIBS/Adafruit_PN532 \
+  -I$LIBS/Adafruit_PN532/test -I$LIBS/Crypto/src -I$LIBS/micro-ecc \
+  -I$ROOT/examples -I../../sim"
+CXXFLAGS="--std=c++14 -Wall -Wextra -DCRYPTNOX_TRACE $INCLUDES"
+SOURCES="$BUSIO/test/host/Arduino.cpp $BUSIO/Adafruit_SPIDevice.cpp \
+  $BUSIO/Adafruit_I2CDevice.cpp $LIBS/Adafruit_PN532/Adafruit_PN532.cpp \
+  $LIBS/Crypto/src/Crypto.cpp $LIBS/Crypto/src/Hash.cpp \
+  $LIBS/Crypto/src/SHA512.cpp $LIBS/Crypto/src/SHA512Accel.cpp \
+  $LIBS/Crypto/src/CPUFeatures.cpp \
+  $ROOT/examples/CryptnoxWallet.cpp $ROOT/examples/PN532Base.cpp \
+  $ROOT/examples/Trace.cpp"
+OUT=$(mktemp -d)
+trap 'rm -rf "$OUT"' EXIT
+
+echo "*** Building ***"
+$CC -c -o "$OUT/uECC.o" $LIBS/micro-ecc/uECC.c
+$CXX $CXXFLAGS -o "$OUT/test_trace" test_trace.cpp $SOURCES "$OUT/uECC.o"
+
+echo "*** Running tests ***"
+"$OUT/test_trace" $TRACE_OUT
@@ -0,0 +1,147 @@
+/**
+ * @file test_trace.cpp
+ * @brief Host run of one traced card tap.
+ *
+ * Builds the wallet and the PN532 driver with CRYPTNOX_TRACE for the host
+ * and taps the simulated wallet card of tools/sim once, between
+ * Trace::begin() and Trace::end() as the example sketch does. Checks that
+ * the trace holds the wallet, crypto and driver level spans, nested inside
+ * processCard and without dropped events. Times are from the host core's
+ * simulated clock, which only advances in the driver's delays and polls.
+ *
+ * Pass a file name to keep the trace for chrome://tracing or Perfetto.
+ */
+
+#include "CryptnoxWallet.h"
+#include "SimulatedReader.h"
+#include "Trace.h"
+
+#include <set>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#define PIN_CS 10
+
+static int failures = 0;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            failures++;                                                     \
+        }                                                                   \
+    } while (0)
+
+/**
+ * @brief Print sink that keeps the trace text.
+ */
+class StringPrint : public Print {
+public:
+    std::string text; /**< Everything written */
+
+    size_t write(uint8_t c) override {
+        text += (char)c;
+        return 1U;
+    }
+};
+
+/**
+ * @brief One "complete" event of the trace.
+ */
+struct Span {
+    std::string name;
+    std::string category;
+    unsigned long ts;
+    unsigned long dur;
+};
+
+/**
+ * @brief Parse the events Trace::end() writes, one per line.
+ */
+static std::vector<Span> parse(const std::string& text, bool& dropped) {
+    std::vector<Span> spans;
+    size_t pos = 0U;
+
+    dropped = false;
+    while (pos < text.size()) {
+        size_t eol = text.find('\n', pos);
+        std::string line = text.substr(pos, (eol == std::string::npos) ? std::string::npos : eol - pos);
+        char name[64];
+        char category[32];
+        unsigned long ts;
+        unsigned long dur;
+
+        if (sscanf(line.c_str(), "{\"name\":\"%63[^\"]\",\"cat\":\"%31[^\"]\",\"ph\":\"X\",\"ts\":%lu,\"dur\":%lu",
+                   name, category, &ts, &dur) == 4) {
+            spans.push_back(Span{name, category, ts, dur});
+        } else if (line.find("trace_dropped") != std::string::npos) {
+            dropped = true;
+        }
+        pos = (eol == std::string::npos) ? text.size() : eol + 1U;
+    }
+    return spans;
+}
+
+int main(int argc, char** argv) {
+    SimulatedReader reader(PIN_CS);
+    CryptnoxWallet wallet(PIN_CS, &SPI);
+    StringPrint sink;
+    bool dropped;
+
+    CHECK(reader.attach());
+    CHECK(wallet.begin());
+
+    Trace::begin(sink);
+    CHECK(wallet.processCard());
+    Trace::end();
+
+    CHECK(sink.text.compare(0, 2, "[\r") == 0);
+    CHECK(sink.text.find("]") != std::string::npos);
+    std::vector<Span> spans = parse(sink.text, dropped);
+    CHECK(!dropped);
+
+    /* processCard ends last, so its span is the final one */
+    CHECK(!spans.empty() && (spans.back().name == "processCard"));
+    if (spans.empty()) {
+        return 1;
+    }
+    const Span& tap = spans.back();
+
+    std::set<std::string> names;
+    int driverSpans = 0;
+    for (const Span& span : spans) {
+        names.insert(span.name);
+        CHECK(span.ts >= tap.ts);
+        CHECK(span.ts + span.dur <= tap.ts + tap.dur);
+        if (span.category == "pn532") {
+            driverSpans++;
+        }
+    }
+    for (const char* name : {"selectApdu", "getCardCertificate", "openSecureChannel",
+                             "mutuallyAuthenticate", "sendAPDU", "inListPassiveTarget",
+                             "uECC_make_key", "SHA512", "sendCommandCheckAck",
+                             "waitready", "readdata"}) {
+        if (names.count(name) == 0U) {
+            printf("test_trace: no \"%s\" span\n", name);
+            failures++;
+        }
+    }
+
+    if (argc > 1) {
+        FILE* out = fopen(argv[1], "w");
+        CHECK(out != nullptr);
+        if (out != nullptr) {
+            fputs(sink.text.c_str(), out);
+            fclose(out);
+        }
+    }
+
+    if (failures != 0) {
+        printf("test_trace: %d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("test_trace: OK (%u spans, %d from the driver, tap %lu us simulated)\n",
+           (unsigned)spans.size(), driverSpans, tap.dur);
+    return 0;
+}